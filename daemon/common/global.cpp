@@ -24,11 +24,13 @@
  */
 
 #include "common/global.hpp"
+#include "common/timer-wheel.hpp"
 
 namespace nfd {
 
 static thread_local unique_ptr<boost::asio::io_service> g_ioService;
 static thread_local unique_ptr<Scheduler> g_scheduler;
+static thread_local unique_ptr<TimerWheel> g_timerWheel;
 static boost::asio::io_service* g_mainIoService = nullptr;
 static boost::asio::io_service* g_ribIoService = nullptr;
 
@@ -50,10 +52,20 @@ getScheduler()
   return *g_scheduler;
 }
 
+TimerWheel&
+getTimerWheel()
+{
+  if (g_timerWheel == nullptr) {
+    g_timerWheel = make_unique<TimerWheel>(getScheduler());
+  }
+  return *g_timerWheel;
+}
+
 #ifdef NFD_WITH_TESTS
 void
 resetGlobalIoService()
 {
+  g_timerWheel.reset();
   g_scheduler.reset();
   g_ioService.reset();
 }
@@ -31,6 +31,8 @@
 
 namespace nfd {
 
+class TimerWheel;
+
 /** \brief Returns the global io_service instance for the calling thread.
  */
 boost::asio::io_service&
@@ -41,6 +43,13 @@ getGlobalIoService();
 Scheduler&
 getScheduler();
 
+/** \brief Returns the global TimerWheel instance for the calling thread.
+ *
+ *  The TimerWheel is driven by the global Scheduler of the same thread.
+ */
+TimerWheel&
+getTimerWheel();
+
 boost::asio::io_service&
 getMainIoService();
 
@@ -64,7 +73,7 @@ void
 runOnRibIoService(const std::function<void()>& f);
 
 #ifdef NFD_WITH_TESTS
-/** \brief Destroy the global io_service instance.
+/** \brief Destroy the global io_service instance, along with the global Scheduler and TimerWheel.
  *
  *  It will be recreated at the next invocation of getGlobalIoService().
  */
@@ -0,0 +1,142 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "slab-pool.hpp"
+
+#include <mutex>
+
+#if defined(__SANITIZE_ADDRESS__)
+#define NFD_SLAB_POOL_PASSTHROUGH
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define NFD_SLAB_POOL_PASSTHROUGH
+#endif
+#endif
+
+namespace nfd {
+
+namespace {
+
+size_t
+roundBlockSize(size_t size)
+{
+  // each block must be able to hold a free list link and be suitably aligned
+  constexpr size_t alignment = alignof(std::max_align_t);
+  size = std::max(size, sizeof(void*));
+  return (size + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+SlabPool::SlabPool(size_t blockSize, size_t nBlocksPerSlab)
+  : m_blockSize(roundBlockSize(blockSize))
+  , m_nBlocksPerSlab(nBlocksPerSlab)
+{
+  BOOST_ASSERT(nBlocksPerSlab > 0);
+}
+
+SlabPool::~SlabPool()
+{
+  for (void* slab : m_slabs) {
+    ::operator delete(slab);
+  }
+}
+
+bool
+SlabPool::accommodate(size_t size) noexcept
+{
+  if (size <= m_blockSize) {
+    return true;
+  }
+  if (m_isBlockSizeFixed) {
+    return false;
+  }
+  m_blockSize = roundBlockSize(size);
+  return true;
+}
+
+void*
+SlabPool::allocate()
+{
+#ifdef NFD_SLAB_POOL_PASSTHROUGH
+  void* ptr = ::operator new(m_blockSize);
+  ++m_capacity;
+#else
+  if (m_freeList == nullptr) {
+    auto slab = static_cast<uint8_t*>(::operator new(m_blockSize * m_nBlocksPerSlab));
+    m_slabs.push_back(slab);
+    // thread the new blocks onto the free list, in address order
+    for (size_t i = m_nBlocksPerSlab; i > 0; --i) {
+      auto block = reinterpret_cast<FreeBlock*>(slab + (i - 1) * m_blockSize);
+      block->next = m_freeList;
+      m_freeList = block;
+    }
+    m_capacity += m_nBlocksPerSlab;
+  }
+
+  FreeBlock* block = m_freeList;
+  m_freeList = block->next;
+  void* ptr = block;
+#endif // NFD_SLAB_POOL_PASSTHROUGH
+
+  m_isBlockSizeFixed = true;
+  ++m_nAllocated;
+  return ptr;
+}
+
+void
+SlabPool::deallocate(void* ptr) noexcept
+{
+  BOOST_ASSERT(ptr != nullptr);
+  BOOST_ASSERT(m_nAllocated > 0);
+  --m_nAllocated;
+
+#ifdef NFD_SLAB_POOL_PASSTHROUGH
+  ::operator delete(ptr);
+  --m_capacity;
+#else
+  auto block = static_cast<FreeBlock*>(ptr);
+  block->next = m_freeList;
+  m_freeList = block;
+#endif // NFD_SLAB_POOL_PASSTHROUGH
+}
+
+namespace detail {
+
+SlabPool&
+makeSlabPool()
+{
+  // pools of exited threads stay reachable, so that they are not reported as leaks
+  static auto* pools = new std::vector<SlabPool*>;
+  static std::mutex mutex;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  pools->push_back(new SlabPool);
+  return *pools->back();
+}
+
+} // namespace detail
+
+} // namespace nfd
@@ -0,0 +1,201 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_COMMON_SLAB_POOL_HPP
+#define NFD_DAEMON_COMMON_SLAB_POOL_HPP
+
+#include "core/common.hpp"
+
+namespace nfd {
+
+/** \brief a pool of fixed-size memory blocks, carved out of large slabs
+ *
+ *  Freed blocks are kept in a free list and reused by subsequent allocations, so that
+ *  steady-state insertion and deletion of table entries does not involve the system allocator.
+ *  Slabs are retained until the pool is destroyed, so the pool grows to its peak occupancy.
+ *
+ *  When compiled with AddressSanitizer, every block is individually allocated with
+ *  `::operator new`, so that memory errors can still be detected.
+ *
+ *  \warning SlabPool is not thread-safe.
+ */
+class SlabPool : noncopyable
+{
+public:
+  /** \param blockSize minimum size of each block in bytes
+   *  \param nBlocksPerSlab number of blocks allocated at once when the free list is empty
+   */
+  explicit
+  SlabPool(size_t blockSize = 0, size_t nBlocksPerSlab = 256);
+
+  ~SlabPool();
+
+  /** \return a block of at least getBlockSize() bytes, aligned for any fundamental type
+   *  \throw std::bad_alloc memory allocation failure
+   */
+  void*
+  allocate();
+
+  /** \brief return a block to the pool
+   *  \pre \p ptr was obtained from allocate() of this pool
+   */
+  void
+  deallocate(void* ptr) noexcept;
+
+  size_t
+  getBlockSize() const noexcept
+  {
+    return m_blockSize;
+  }
+
+  /** \brief raise the block size to at least \p size, if no block has been allocated yet
+   *  \return whether blocks can hold \p size bytes
+   */
+  bool
+  accommodate(size_t size) noexcept;
+
+  /** \return number of blocks in use
+   */
+  size_t
+  size() const noexcept
+  {
+    return m_nAllocated;
+  }
+
+  /** \return number of blocks in use or in the free list
+   */
+  size_t
+  capacity() const noexcept
+  {
+    return m_capacity;
+  }
+
+private:
+  struct FreeBlock
+  {
+    FreeBlock* next;
+  };
+
+  size_t m_blockSize;
+  size_t m_nBlocksPerSlab;
+  std::vector<void*> m_slabs;
+  FreeBlock* m_freeList = nullptr;
+  size_t m_nAllocated = 0;
+  size_t m_capacity = 0;
+  bool m_isBlockSizeFixed = false;
+};
+
+namespace detail {
+
+/** \brief create a SlabPool that is never destroyed
+ */
+SlabPool&
+makeSlabPool();
+
+} // namespace detail
+
+/** \return the SlabPool of the calling thread shared by all objects allocated under \p Tag
+ *
+ *  Each thread has its own pool, so that threads owning separate tables can allocate entries
+ *  without synchronization. Therefore, an object must be deallocated by the thread that allocated it.
+ *  The pool is never destroyed, so that objects can be safely deallocated during static destruction.
+ */
+template<typename Tag>
+SlabPool&
+getSlabPool()
+{
+  static thread_local SlabPool& pool = detail::makeSlabPool();
+  return pool;
+}
+
+/** \brief a standard allocator that obtains single objects from a SlabPool
+ *  \tparam T object type
+ *  \tparam Tag identifies the pool; it is retained when the allocator is rebound to another type,
+ *              so that list nodes and shared_ptr control blocks share the pool of their element
+ *
+ *  The block size of the pool is determined by the largest type allocated before its first block.
+ *  Allocations of arrays, or of objects larger than the block size of the pool,
+ *  are forwarded to `::operator new`.
+ */
+template<typename T, typename Tag = T>
+class SlabAllocator
+{
+public:
+  using value_type = T;
+
+  template<typename U>
+  struct rebind
+  {
+    using other = SlabAllocator<U, Tag>;
+  };
+
+  SlabAllocator() noexcept = default;
+
+  template<typename U>
+  SlabAllocator(const SlabAllocator<U, Tag>&) noexcept
+  {
+  }
+
+  T*
+  allocate(size_t n)
+  {
+    static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned types are not supported");
+    SlabPool& pool = getSlabPool<Tag>();
+    if (n == 1 && pool.accommodate(sizeof(T))) {
+      return static_cast<T*>(pool.allocate());
+    }
+    return static_cast<T*>(::operator new(n * sizeof(T)));
+  }
+
+  void
+  deallocate(T* ptr, size_t n) noexcept
+  {
+    SlabPool& pool = getSlabPool<Tag>();
+    if (n == 1 && sizeof(T) <= pool.getBlockSize()) {
+      pool.deallocate(ptr);
+    }
+    else {
+      ::operator delete(ptr);
+    }
+  }
+
+  template<typename U>
+  friend bool
+  operator==(const SlabAllocator&, const SlabAllocator<U, Tag>&) noexcept
+  {
+    return true;
+  }
+
+  template<typename U>
+  friend bool
+  operator!=(const SlabAllocator&, const SlabAllocator<U, Tag>&) noexcept
+  {
+    return false;
+  }
+};
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_COMMON_SLAB_POOL_HPP
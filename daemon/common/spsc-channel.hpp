@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_COMMON_SPSC_CHANNEL_HPP
+#define NFD_DAEMON_COMMON_SPSC_CHANNEL_HPP
+
+#include "spsc-ring.hpp"
+
+#include <boost/asio/io_service.hpp>
+
+namespace nfd {
+
+/** \brief an SpscRing whose consumer runs on an io_service
+ *
+ *  After pushing items, the producer calls notify(), which posts a handler to the consumer's
+ *  io_service unless one is already pending. The handler calls drain() to take the items.
+ *  Thus a burst of items costs a single handler invocation on the consumer thread.
+ *
+ *  \warning push() and notify() must only be called by the producer thread,
+ *           and drain() by the consumer thread.
+ */
+template<typename T>
+class SpscChannel : noncopyable
+{
+public:
+  explicit
+  SpscChannel(size_t capacity)
+    : m_ring(capacity)
+  {
+  }
+
+  size_t
+  capacity() const noexcept
+  {
+    return m_ring.capacity();
+  }
+
+  /** \return number of items in the channel
+   *  \sa SpscRing::size
+   */
+  size_t
+  size() const noexcept
+  {
+    return m_ring.size();
+  }
+
+  /** \brief append \p item to the channel
+   *  \return true if \p item has been moved into the channel, false if the channel is full
+   *          (in which case \p item is left unchanged)
+   */
+  bool
+  push(T&& item)
+  {
+    return m_ring.push(std::move(item));
+  }
+
+  /** \brief ensure a handler is pending on the consumer's \p io
+   *  \param drain a handler that calls drain()
+   */
+  template<typename Handler>
+  void
+  notify(boost::asio::io_service& io, Handler&& drain)
+  {
+    // pairs with the fence in drain(): either the consumer sees the pushed items,
+    // or the producer sees that no handler is pending
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!m_isDrainPending.exchange(true)) {
+      io.post(std::forward<Handler>(drain));
+    }
+  }
+
+  /** \brief take up to \p limit items, invoking \p handle on each of them
+   *  \return true if items remain, in which case the caller must post another handler that
+   *          calls drain(), so that other handlers on the consumer's io_service can run meanwhile
+   */
+  template<typename Handler>
+  bool
+  drain(size_t limit, Handler&& handle)
+  {
+    m_isDrainPending.store(false);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    T item;
+    for (size_t i = 0; i < limit && m_ring.pop(item); ++i) {
+      handle(item);
+    }
+
+    return !m_ring.empty() && !m_isDrainPending.exchange(true);
+  }
+
+private:
+  SpscRing<T> m_ring;
+  std::atomic<bool> m_isDrainPending{false};
+};
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_COMMON_SPSC_CHANNEL_HPP
@@ -0,0 +1,153 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_COMMON_SPSC_RING_HPP
+#define NFD_DAEMON_COMMON_SPSC_RING_HPP
+
+#include "core/common.hpp"
+
+#include <atomic>
+
+namespace nfd {
+
+/** \brief a bounded lock-free queue between one producer thread and one consumer thread
+ *
+ *  The capacity is rounded up to a power of two. push() and pop() never block or allocate memory.
+ *  The positions written by the producer and by the consumer live in separate cache lines,
+ *  and each side caches the last seen position of the other side, so that the shared cache lines
+ *  are only touched when the ring appears to be full or empty.
+ *
+ *  \tparam T element type, which must be default-constructible and move-assignable
+ *  \warning push() must only be called by the producer thread, and pop() by the consumer thread.
+ */
+template<typename T>
+class SpscRing : noncopyable
+{
+public:
+  /** \throw std::invalid_argument \p capacity is zero
+   */
+  explicit
+  SpscRing(size_t capacity)
+    : m_buffer(roundCapacity(capacity))
+    , m_mask(m_buffer.size() - 1)
+  {
+  }
+
+  size_t
+  capacity() const noexcept
+  {
+    return m_buffer.size();
+  }
+
+  /** \return number of elements in the ring
+   *  \note The value may be outdated by the time it is returned, if called while the other thread
+   *        is operating on the ring.
+   */
+  size_t
+  size() const noexcept
+  {
+    // m_tail is loaded first, so that it cannot have passed the loaded value of m_head
+    size_t tail = m_tail.load(std::memory_order_acquire);
+    return m_head.load(std::memory_order_acquire) - tail;
+  }
+
+  bool
+  empty() const noexcept
+  {
+    return size() == 0;
+  }
+
+  /** \brief append \p item to the ring, to be called by the producer thread
+   *  \return true if \p item has been moved into the ring, false if the ring is full
+   *          (in which case \p item is left unchanged)
+   */
+  bool
+  push(T&& item)
+  {
+    size_t head = m_head.load(std::memory_order_relaxed);
+    if (head - m_producerTail == m_buffer.size()) {
+      m_producerTail = m_tail.load(std::memory_order_acquire);
+      if (head - m_producerTail == m_buffer.size()) {
+        return false;
+      }
+    }
+
+    m_buffer[head & m_mask] = std::move(item);
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /** \brief remove the oldest element from the ring, to be called by the consumer thread
+   *  \return true if the element has been moved into \p item, false if the ring is empty
+   */
+  bool
+  pop(T& item)
+  {
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail == m_consumerHead) {
+      m_consumerHead = m_head.load(std::memory_order_acquire);
+      if (tail == m_consumerHead) {
+        return false;
+      }
+    }
+
+    T& slot = m_buffer[tail & m_mask];
+    item = std::move(slot);
+    // release resources held by the moved-from element now, rather than when the slot is reused
+    slot = T();
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+private:
+  static size_t
+  roundCapacity(size_t capacity)
+  {
+    if (capacity == 0) {
+      NDN_THROW(std::invalid_argument("SpscRing capacity must be positive"));
+    }
+    size_t n = 1;
+    while (n < capacity) {
+      n <<= 1;
+    }
+    return n;
+  }
+
+private:
+  static constexpr size_t CACHE_LINE_SIZE = 64;
+
+  std::vector<T> m_buffer;
+  const size_t m_mask;
+
+  alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_head{0}; ///< next position to write
+  size_t m_producerTail = 0; ///< producer's copy of m_tail
+
+  alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_tail{0}; ///< next position to read
+  size_t m_consumerHead = 0; ///< consumer's copy of m_head
+};
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_COMMON_SPSC_RING_HPP
@@ -0,0 +1,348 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "timer-wheel.hpp"
+
+namespace nfd {
+
+namespace {
+
+template<typename L>
+void
+initList(L& head) noexcept
+{
+  head.prev = head.next = &head;
+}
+
+template<typename L>
+bool
+isEmpty(const L& head) noexcept
+{
+  return head.next == &head;
+}
+
+template<typename L>
+void
+linkBefore(L& head, L& node) noexcept
+{
+  node.prev = head.prev;
+  node.next = &head;
+  head.prev->next = &node;
+  head.prev = &node;
+}
+
+template<typename L>
+void
+unlink(L& node) noexcept
+{
+  node.prev->next = node.next;
+  node.next->prev = node.prev;
+  node.prev = node.next = nullptr;
+}
+
+/** \brief move all nodes of list \p from to the end of list \p to
+ */
+template<typename L>
+void
+spliceAll(L& from, L& to) noexcept
+{
+  if (isEmpty(from)) {
+    return;
+  }
+  from.next->prev = to.prev;
+  to.prev->next = from.next;
+  from.prev->next = &to;
+  to.prev = from.prev;
+  initList(from);
+}
+
+} // namespace
+
+void
+TimerWheel::Timer::cancel() noexcept
+{
+  if (m_wheel == nullptr) {
+    return;
+  }
+
+  unlink<Link>(*this);
+  --m_wheel->m_nPending;
+  m_wheel = nullptr;
+
+  // the callback may own the object containing this timer, so it is destructed last
+  std::function<void()> callback;
+  callback.swap(m_callback);
+}
+
+template<typename F>
+void
+TimerWheel::forEachList(const F& f)
+{
+  f(m_due);
+  for (auto& level : m_slots) {
+    for (auto& slot : level) {
+      f(slot);
+    }
+  }
+}
+
+TimerWheel::TimerWheel(Scheduler& scheduler, time::nanoseconds granularity)
+  : m_scheduler(scheduler)
+  , m_granularity(granularity)
+  , m_origin(time::steady_clock::now())
+{
+  if (granularity <= 0_ns) {
+    NDN_THROW(std::invalid_argument("TimerWheel granularity must be positive"));
+  }
+
+  forEachList([] (Link& head) { initList(head); });
+}
+
+TimerWheel::~TimerWheel()
+{
+  forEachList([this] (Link& head) {
+    while (!isEmpty(head)) {
+      auto& timer = static_cast<Timer&>(*head.next);
+      unlink(*head.next);
+      --m_nPending;
+      timer.m_wheel = nullptr;
+      std::function<void()> callback;
+      callback.swap(timer.m_callback);
+    }
+  });
+}
+
+void
+TimerWheel::setGranularity(time::nanoseconds granularity)
+{
+  if (granularity <= 0_ns) {
+    NDN_THROW(std::invalid_argument("TimerWheel granularity must be positive"));
+  }
+  if (granularity == m_granularity) {
+    return;
+  }
+
+  std::vector<std::pair<Timer*, time::steady_clock::TimePoint>> timers;
+  timers.reserve(m_nPending);
+  forEachList([&] (Link& head) {
+    while (!isEmpty(head)) {
+      auto& timer = static_cast<Timer&>(*head.next);
+      unlink(*head.next);
+      timers.emplace_back(&timer, toTimePoint(timer.m_expiry));
+    }
+  });
+
+  m_granularity = granularity;
+  m_origin = time::steady_clock::now();
+  m_nextTick = 0;
+  m_tickEvent.cancel();
+  m_isWakeArmed = false;
+
+  for (const auto& [timer, deadline] : timers) {
+    timer->m_expiry = toTick(deadline, true);
+    insert(*timer);
+  }
+  if (m_nPending > 0) {
+    wakeAt(findWakeTick());
+  }
+}
+
+void
+TimerWheel::schedule(Timer& timer, time::nanoseconds after, std::function<void()> callback)
+{
+  timer.cancel();
+
+  auto now = time::steady_clock::now();
+  if (m_nPending == 0) {
+    // nothing is lost by skipping ticks while the wheel is idle
+    m_nextTick = std::max(m_nextTick, toTick(now, false));
+  }
+
+  timer.m_wheel = this;
+  timer.m_expiry = toTick(now + std::max(after, 0_ns), true);
+  timer.m_callback = std::move(callback);
+  ++m_nPending;
+  insert(timer);
+
+  // the Scheduler event must fire at the expiry tick (immediately if the tick has been processed),
+  // or at the next cascade if the timer is placed in a higher level
+  uint64_t nextCascade = (m_nextTick & SLOT_MASK) == 0 ? m_nextTick : (m_nextTick | SLOT_MASK) + 1;
+  wakeAt(std::min(timer.m_expiry, nextCascade));
+}
+
+uint64_t
+TimerWheel::toTick(time::steady_clock::TimePoint t, bool roundUp) const
+{
+  if (t <= m_origin) {
+    return 0;
+  }
+  auto elapsed = static_cast<uint64_t>((t - m_origin).count());
+  auto granularity = static_cast<uint64_t>(m_granularity.count());
+  return (elapsed + (roundUp ? granularity - 1 : 0)) / granularity;
+}
+
+void
+TimerWheel::insert(Timer& timer)
+{
+  if (timer.m_expiry < m_nextTick) {
+    linkBefore<Link>(m_due, timer);
+    return;
+  }
+  uint64_t delta = timer.m_expiry - m_nextTick;
+
+  size_t level = 0;
+  while (level < N_LEVELS - 1 && delta >= (uint64_t{1} << (SLOT_BITS * (level + 1)))) {
+    ++level;
+  }
+  constexpr uint64_t maxDelta = (uint64_t{1} << (SLOT_BITS * N_LEVELS)) - 1;
+  if (delta > maxDelta) {
+    timer.m_expiry = m_nextTick + maxDelta;
+  }
+
+  Link& slot = m_slots[level][(timer.m_expiry >> (SLOT_BITS * level)) & SLOT_MASK];
+  linkBefore<Link>(slot, timer);
+}
+
+void
+TimerWheel::cascade(size_t level)
+{
+  Link& slot = m_slots[level][(m_nextTick >> (SLOT_BITS * level)) & SLOT_MASK];
+  Link batch;
+  initList(batch);
+  spliceAll(slot, batch);
+
+  while (!isEmpty(batch)) {
+    auto& timer = static_cast<Timer&>(*batch.next);
+    unlink(*batch.next);
+    insert(timer);
+  }
+}
+
+void
+TimerWheel::expire(Link& slot)
+{
+  // detach the whole slot first, because callbacks can arm timers that belong to the same slot
+  // in the next round
+  Link batch;
+  initList(batch);
+  spliceAll(slot, batch);
+
+  try {
+    while (!isEmpty(batch)) {
+      auto& timer = static_cast<Timer&>(*batch.next);
+      unlink(*batch.next);
+      --m_nPending;
+      timer.m_wheel = nullptr;
+
+      std::function<void()> callback;
+      callback.swap(timer.m_callback);
+      callback();
+    }
+  }
+  catch (...) {
+    // remaining timers fire at the next tick
+    spliceAll(batch, m_slots[0][m_nextTick & SLOT_MASK]);
+    wakeAt(m_nextTick);
+    throw;
+  }
+}
+
+void
+TimerWheel::advance(uint64_t tick)
+{
+  while (m_nextTick <= tick) {
+    if (m_nPending == 0) {
+      m_nextTick = tick + 1;
+      return;
+    }
+
+    size_t index = m_nextTick & SLOT_MASK;
+    if (index == 0) {
+      // level 0 has completed a round: bring down timers from higher levels
+      for (size_t level = 1; level < N_LEVELS; ++level) {
+        cascade(level);
+        if (((m_nextTick >> (SLOT_BITS * level)) & SLOT_MASK) != 0) {
+          break;
+        }
+      }
+    }
+
+    ++m_nextTick;
+    expire(m_slots[0][index]);
+
+    // skip empty slots, but stop at the next cascade
+    if ((m_nextTick & SLOT_MASK) != 0) {
+      uint64_t limit = std::min(tick + 1, (m_nextTick | SLOT_MASK) + 1);
+      while (m_nextTick < limit && isEmpty(m_slots[0][m_nextTick & SLOT_MASK])) {
+        ++m_nextTick;
+      }
+    }
+  }
+}
+
+uint64_t
+TimerWheel::findWakeTick() const
+{
+  BOOST_ASSERT(m_nPending > 0);
+
+  if ((m_nextTick & SLOT_MASK) == 0) {
+    return m_nextTick;
+  }
+
+  uint64_t nextCascade = (m_nextTick | SLOT_MASK) + 1;
+  for (uint64_t t = m_nextTick; t < nextCascade; ++t) {
+    if (!isEmpty(m_slots[0][t & SLOT_MASK])) {
+      return t;
+    }
+  }
+  return nextCascade;
+}
+
+void
+TimerWheel::wakeAt(uint64_t tick)
+{
+  if (m_isWakeArmed && m_wakeTick <= tick) {
+    return;
+  }
+
+  m_isWakeArmed = true;
+  m_wakeTick = tick;
+  auto delay = std::max(toTimePoint(tick) - time::steady_clock::now(), time::steady_clock::duration::zero());
+  m_tickEvent = m_scheduler.schedule(delay, [this] { onTick(); });
+}
+
+void
+TimerWheel::onTick()
+{
+  m_isWakeArmed = false;
+  expire(m_due);
+  advance(toTick(time::steady_clock::now(), false));
+
+  if (m_nPending > 0) {
+    wakeAt(findWakeTick());
+  }
+}
+
+} // namespace nfd
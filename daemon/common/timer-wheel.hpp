@@ -0,0 +1,217 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_COMMON_TIMER_WHEEL_HPP
+#define NFD_DAEMON_COMMON_TIMER_WHEEL_HPP
+
+#include "core/common.hpp"
+
+#include <array>
+
+namespace nfd {
+
+/** \brief a hierarchical timing wheel for high-frequency timers
+ *
+ *  Time is divided into ticks of a configurable granularity. Each timer is kept in a slot of
+ *  one of several levels according to how far away its deadline is, and moves down to lower
+ *  levels as the deadline approaches. Arming and cancelling a timer take constant time,
+ *  and all timers of a tick are expired together in one batch.
+ *
+ *  The wheel is driven by a single Scheduler event, which is armed only while timers are pending.
+ *  A timer never fires before its deadline, and normally fires within one granularity after it.
+ *  Deadlines more than 2^32 ticks away are clamped.
+ *
+ *  The Scheduler remains more suitable for infrequent timers that need exact deadlines.
+ *
+ *  \warning TimerWheel is not thread-safe.
+ */
+class TimerWheel : noncopyable
+{
+private:
+  struct Link
+  {
+    Link* prev = nullptr;
+    Link* next = nullptr;
+  };
+
+public:
+  /** \brief a timer that can be armed on a TimerWheel
+   *
+   *  The timer is meant to be embedded in the object that owns it, so that arming and cancelling
+   *  it never allocates memory. Similar to scheduler::ScopedEventId, it is cancelled when destroyed.
+   */
+  class Timer : private Link, noncopyable
+  {
+  public:
+    Timer() = default;
+
+    ~Timer()
+    {
+      cancel();
+    }
+
+    /** \return whether the timer is armed and has not fired
+     */
+    bool
+    isPending() const noexcept
+    {
+      return m_wheel != nullptr;
+    }
+
+    explicit
+    operator bool() const noexcept
+    {
+      return isPending();
+    }
+
+    /** \brief cancel the timer
+     *
+     *  This has no effect if the timer is not pending, including after it has fired.
+     */
+    void
+    cancel() noexcept;
+
+  private:
+    TimerWheel* m_wheel = nullptr;
+    uint64_t m_expiry = 0;
+    std::function<void()> m_callback;
+
+    friend TimerWheel;
+  };
+
+  static constexpr time::nanoseconds DEFAULT_GRANULARITY = 1_ms;
+
+  explicit
+  TimerWheel(Scheduler& scheduler, time::nanoseconds granularity = DEFAULT_GRANULARITY);
+
+  /** \brief destructor
+   *
+   *  Pending timers are cancelled without invoking their callbacks.
+   */
+  ~TimerWheel();
+
+  time::nanoseconds
+  getGranularity() const noexcept
+  {
+    return m_granularity;
+  }
+
+  /** \brief change the granularity
+   *
+   *  Pending timers are redistributed and keep their deadlines, rounded up to the new granularity.
+   *
+   *  \throw std::invalid_argument \p granularity is not positive
+   */
+  void
+  setGranularity(time::nanoseconds granularity);
+
+  /** \brief arm \p timer to invoke \p callback after \p after
+   *
+   *  If \p timer is pending, it is cancelled first. The callback is never invoked synchronously.
+   *  It may re-arm the timer, or destroy the object that contains the timer.
+   */
+  void
+  schedule(Timer& timer, time::nanoseconds after, std::function<void()> callback);
+
+  /** \return number of pending timers
+   */
+  size_t
+  size() const noexcept
+  {
+    return m_nPending;
+  }
+
+private:
+  uint64_t
+  toTick(time::steady_clock::TimePoint t, bool roundUp) const;
+
+  time::steady_clock::TimePoint
+  toTimePoint(uint64_t tick) const
+  {
+    return m_origin + m_granularity * static_cast<int64_t>(tick);
+  }
+
+  /** \brief put \p timer in the slot that corresponds to its expiry tick,
+   *         or in the due list if that tick has been processed
+   */
+  void
+  insert(Timer& timer);
+
+  /** \brief re-insert all timers in a slot of \p level into lower levels
+   */
+  void
+  cascade(size_t level);
+
+  /** \brief invoke callbacks of all timers in \p slot
+   */
+  void
+  expire(Link& slot);
+
+  /** \brief process all ticks up to and including \p tick
+   */
+  void
+  advance(uint64_t tick);
+
+  /** \return earliest tick at which there may be something to do
+   *  \pre m_nPending > 0
+   */
+  uint64_t
+  findWakeTick() const;
+
+  /** \brief ensure the Scheduler event fires no later than \p tick
+   */
+  void
+  wakeAt(uint64_t tick);
+
+  void
+  onTick();
+
+  /** \brief invoke \p f on the list head of every slot and of the due list
+   */
+  template<typename F>
+  void
+  forEachList(const F& f);
+
+private:
+  static constexpr unsigned SLOT_BITS = 8;
+  static constexpr size_t N_SLOTS = size_t{1} << SLOT_BITS;
+  static constexpr uint64_t SLOT_MASK = N_SLOTS - 1;
+  static constexpr size_t N_LEVELS = 4;
+
+  Scheduler& m_scheduler;
+  time::nanoseconds m_granularity;
+  time::steady_clock::TimePoint m_origin; ///< time point of tick 0
+  uint64_t m_nextTick = 0; ///< the first tick that has not been processed
+  size_t m_nPending = 0;
+  std::array<std::array<Link, N_SLOTS>, N_LEVELS> m_slots; ///< list heads of each slot
+  Link m_due; ///< list head of timers that expire at a tick that has been processed
+  scheduler::ScopedEventId m_tickEvent;
+  uint64_t m_wakeTick = 0; ///< tick at which m_tickEvent fires, meaningful only if m_isWakeArmed
+  bool m_isWakeArmed = false;
+};
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_COMMON_TIMER_WHEEL_HPP
@@ -0,0 +1,159 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// This is an adaptation of wyhash (final version 4) by Wang Yi <godspeed_china@yeah.net>,
+// which has been released into the public domain. Original source code is available at
+// https://github.com/wangyi-fudan/wyhash
+//
+// wyhash processes input in 8-byte words with a 64x64->128 bit multiply as its only
+// mixing primitive, which makes it considerably faster than CityHash on the short
+// strings (typically less than 32 bytes) that make up name components.
+//
+// Functions in this file are not suitable for cryptography, nor are hash values portable
+// across platforms of different endianness.
+
+#ifndef NFD_DAEMON_COMMON_WYHASH_HPP
+#define NFD_DAEMON_COMMON_WYHASH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace nfd::wyhash {
+
+namespace detail {
+
+inline constexpr uint64_t SECRET[] = {
+  0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL, 0x8ebc6af09c88c6e3ULL, 0x589965cc75374cc3ULL,
+};
+
+/** \brief computes the 128-bit product of \p a and \p b, returning the low half in \p a
+ *         and the high half in \p b
+ */
+inline void
+multiply(uint64_t& a, uint64_t& b) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+  __uint128_t r = a;
+  r *= b;
+  a = static_cast<uint64_t>(r);
+  b = static_cast<uint64_t>(r >> 64);
+#else
+  uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+  uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+  uint64_t t = rl + (rm0 << 32);
+  uint64_t c = t < rl;
+  uint64_t lo = t + (rm1 << 32);
+  c += lo < t;
+  a = lo;
+  b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+inline uint64_t
+mix(uint64_t a, uint64_t b) noexcept
+{
+  multiply(a, b);
+  return a ^ b;
+}
+
+inline uint64_t
+read8(const uint8_t* p) noexcept
+{
+  uint64_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline uint64_t
+read4(const uint8_t* p) noexcept
+{
+  uint32_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+/** \brief reads 1 to 3 bytes
+ */
+inline uint64_t
+read3(const uint8_t* p, size_t k) noexcept
+{
+  return (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[k >> 1]) << 8) | p[k - 1];
+}
+
+} // namespace detail
+
+/** \brief computes 64-bit hash value of a byte array
+ *  \param seed an arbitrary value; different seeds yield unrelated hash functions
+ */
+inline uint64_t
+hash64(const void* buf, size_t len, uint64_t seed = 0) noexcept
+{
+  using namespace detail;
+
+  const uint8_t* p = reinterpret_cast<const uint8_t*>(buf);
+  seed ^= mix(seed ^ SECRET[0], SECRET[1]);
+  uint64_t a = 0, b = 0;
+
+  if (len <= 16) {
+    if (len >= 4) {
+      a = (read4(p) << 32) | read4(p + ((len >> 3) << 2));
+      b = (read4(p + len - 4) << 32) | read4(p + len - 4 - ((len >> 3) << 2));
+    }
+    else if (len > 0) {
+      a = read3(p, len);
+    }
+  }
+  else {
+    size_t i = len;
+    if (i > 48) {
+      uint64_t see1 = seed, see2 = seed;
+      do {
+        seed = mix(read8(p) ^ SECRET[1], read8(p + 8) ^ seed);
+        see1 = mix(read8(p + 16) ^ SECRET[2], read8(p + 24) ^ see1);
+        see2 = mix(read8(p + 32) ^ SECRET[3], read8(p + 40) ^ see2);
+        p += 48;
+        i -= 48;
+      } while (i > 48);
+      seed ^= see1 ^ see2;
+    }
+    while (i > 16) {
+      seed = mix(read8(p) ^ SECRET[1], read8(p + 8) ^ seed);
+      i -= 16;
+      p += 16;
+    }
+    a = read8(p + i - 16);
+    b = read8(p + i - 8);
+  }
+
+  a ^= SECRET[1];
+  b ^= seed;
+  multiply(a, b);
+  return mix(a ^ SECRET[0] ^ len, b ^ SECRET[1]);
+}
+
+} // namespace nfd::wyhash
+
+#endif // NFD_DAEMON_COMMON_WYHASH_HPP
@@ -0,0 +1,104 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "aqm-codel.hpp"
+#include "common/logger.hpp"
+
+#include <cmath>
+
+namespace nfd::face {
+
+NFD_LOG_INIT(CoDelAqm);
+
+const std::string CoDelAqm::AQM_NAME = "codel";
+NFD_REGISTER_AQM(CoDelAqm);
+
+CoDelAqm::CoDelAqm(const Options& options)
+  : Aqm(options)
+{
+}
+
+Aqm::Verdict
+CoDelAqm::beforeEnqueue(size_t, time::steady_clock::TimePoint)
+{
+  // CoDel acts only on dequeue; the send queue capacity bounds the queue otherwise
+  return Verdict::PASS;
+}
+
+Aqm::Verdict
+CoDelAqm::afterDequeue(time::nanoseconds sojournTime, size_t queueSize,
+                       time::steady_clock::TimePoint now)
+{
+  bool isAboveTarget = false;
+  if (sojournTime < m_options.target || queueSize == 0) {
+    // went below target, or the queue was drained; stay below for at least one interval
+    m_firstAboveTime = {};
+  }
+  else if (m_firstAboveTime == time::steady_clock::TimePoint()) {
+    // just went above target; if we stay above for at least one interval, signal congestion
+    m_firstAboveTime = now + m_options.interval;
+  }
+  else if (now >= m_firstAboveTime) {
+    isAboveTarget = true;
+  }
+
+  if (m_isSignaling) {
+    if (!isAboveTarget) {
+      NFD_LOG_DEBUG("sojourn time below target, leaving signaling state after " << m_count);
+      m_isSignaling = false;
+      return Verdict::PASS;
+    }
+    if (now >= m_signalNext) {
+      ++m_count;
+      m_signalNext = controlLaw(m_signalNext);
+      return Verdict::CONGESTED;
+    }
+    return Verdict::PASS;
+  }
+
+  if (isAboveTarget) {
+    m_isSignaling = true;
+    // If the signaling state was left recently, resume at the previous rate of signals rather
+    // than starting over, since the congestion is likely to be the same
+    uint32_t delta = m_count - m_lastCount;
+    m_count = delta > 1 && now - m_signalNext < 16 * m_options.interval ? delta : 1;
+    m_lastCount = m_count;
+    m_signalNext = controlLaw(now);
+    NFD_LOG_DEBUG("sojourn time above target for one interval, entering signaling state with count="
+                  << m_count);
+    return Verdict::CONGESTED;
+  }
+
+  return Verdict::PASS;
+}
+
+time::steady_clock::TimePoint
+CoDelAqm::controlLaw(time::steady_clock::TimePoint t) const
+{
+  return t + time::nanoseconds(static_cast<time::nanoseconds::rep>(
+               m_options.interval.count() / std::sqrt(m_count)));
+}
+
+} // namespace nfd::face
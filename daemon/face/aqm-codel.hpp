@@ -0,0 +1,75 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_AQM_CODEL_HPP
+#define NFD_DAEMON_FACE_AQM_CODEL_HPP
+
+#include "aqm.hpp"
+
+namespace nfd::face {
+
+/**
+ * \brief Controlled Delay (CoDel) active queue management
+ *
+ * Congestion is signaled once the sojourn time of dequeued packets has stayed above
+ * Options::target for at least Options::interval. While it stays above, congestion is signaled
+ * at intervals that shrink with the inverse square root of the number of signals so far.
+ *
+ * \sa https://datatracker.ietf.org/doc/html/rfc8289
+ */
+class CoDelAqm final : public Aqm
+{
+public:
+  explicit
+  CoDelAqm(const Options& options);
+
+  Verdict
+  beforeEnqueue(size_t queueSize, time::steady_clock::TimePoint now) final;
+
+  Verdict
+  afterDequeue(time::nanoseconds sojournTime, size_t queueSize, time::steady_clock::TimePoint now) final;
+
+public:
+  static const std::string AQM_NAME;
+
+private:
+  time::steady_clock::TimePoint
+  controlLaw(time::steady_clock::TimePoint t) const;
+
+NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /// time when the sojourn time will have stayed above target for one interval, or zero
+  time::steady_clock::TimePoint m_firstAboveTime;
+  /// time to signal congestion next while in the signaling state
+  time::steady_clock::TimePoint m_signalNext;
+  /// number of congestion signals in the current signaling state
+  uint32_t m_count = 0;
+  /// value of m_count when the previous signaling state was entered
+  uint32_t m_lastCount = 0;
+  bool m_isSignaling = false;
+};
+
+} // namespace nfd::face
+
+#endif // NFD_DAEMON_FACE_AQM_CODEL_HPP
@@ -0,0 +1,141 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "aqm-pie.hpp"
+#include "common/logger.hpp"
+
+#include <ndn-cxx/util/random.hpp>
+
+namespace nfd::face {
+
+NFD_LOG_INIT(PieAqm);
+
+const std::string PieAqm::AQM_NAME = "pie";
+NFD_REGISTER_AQM(PieAqm);
+
+PieAqm::PieAqm(const Options& options)
+  : Aqm(options)
+  , m_burstAllowance(MAX_BURST)
+{
+}
+
+Aqm::Verdict
+PieAqm::beforeEnqueue(size_t queueSize, time::steady_clock::TimePoint now)
+{
+  if (queueSize == 0) {
+    m_qdelay = 0_ns;
+  }
+  updateProbability(now);
+
+  if (m_burstAllowance > 0_ns) {
+    return Verdict::PASS;
+  }
+  if (m_qdelayOld < m_options.target / 2 && m_probability < 0.2) {
+    return Verdict::PASS;
+  }
+  if (queueSize <= MIN_QUEUE_SIZE) {
+    return Verdict::PASS;
+  }
+
+  std::uniform_real_distribution<double> dist(0.0, 1.0);
+  if (dist(ndn::random::getRandomNumberEngine()) >= m_probability) {
+    return Verdict::PASS;
+  }
+  return m_probability <= MAX_MARK_PROBABILITY ? Verdict::CONGESTED : Verdict::DROP;
+}
+
+Aqm::Verdict
+PieAqm::afterDequeue(time::nanoseconds sojournTime, size_t, time::steady_clock::TimePoint)
+{
+  m_qdelay = sojournTime;
+  return Verdict::PASS;
+}
+
+void
+PieAqm::updateProbability(time::steady_clock::TimePoint now)
+{
+  if (m_nextUpdate == time::steady_clock::TimePoint()) {
+    m_nextUpdate = now + UPDATE_PERIOD;
+    return;
+  }
+
+  // after a long idle period, a single update suffices as the queueing delay has stayed constant
+  if (now - m_nextUpdate > 8 * UPDATE_PERIOD) {
+    m_nextUpdate = now - UPDATE_PERIOD;
+  }
+
+  for (; now >= m_nextUpdate; m_nextUpdate += UPDATE_PERIOD) {
+    double qdelay = time::duration<double>(m_qdelay).count();
+    double delta = ALPHA * (qdelay - time::duration<double>(m_options.target).count()) +
+                   BETA * (qdelay - time::duration<double>(m_qdelayOld).count());
+
+    // auto-tune the controller: small probabilities change in small steps
+    if (m_probability < 0.000001) {
+      delta /= 2048;
+    }
+    else if (m_probability < 0.00001) {
+      delta /= 512;
+    }
+    else if (m_probability < 0.0001) {
+      delta /= 128;
+    }
+    else if (m_probability < 0.001) {
+      delta /= 32;
+    }
+    else if (m_probability < 0.01) {
+      delta /= 8;
+    }
+    else if (m_probability < 0.1) {
+      delta /= 2;
+    }
+    // avoid large swings once the probability is high
+    if (m_probability >= 0.1 && delta > 0.02) {
+      delta = 0.02;
+    }
+    // an unusually large delay needs a faster response
+    if (m_qdelay > 250_ms) {
+      delta += 0.02;
+    }
+
+    m_probability = std::clamp(m_probability + delta, 0.0, 1.0);
+
+    // decay the probability exponentially while the queue stays empty
+    if (m_qdelay == 0_ns && m_qdelayOld == 0_ns) {
+      m_probability *= 0.98;
+    }
+
+    m_burstAllowance = std::max(m_burstAllowance - UPDATE_PERIOD, 0_ns);
+    if (m_probability == 0.0 && m_qdelay < m_options.target / 2 &&
+        m_qdelayOld < m_options.target / 2) {
+      m_burstAllowance = MAX_BURST;
+    }
+
+    m_qdelayOld = m_qdelay;
+  }
+
+  NFD_LOG_TRACE("qdelay=" << m_qdelay << " probability=" << m_probability);
+}
+
+} // namespace nfd::face
@@ -0,0 +1,83 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_AQM_PIE_HPP
+#define NFD_DAEMON_FACE_AQM_PIE_HPP
+
+#include "aqm.hpp"
+
+namespace nfd::face {
+
+/**
+ * \brief Proportional Integral controller Enhanced (PIE) active queue management
+ *
+ * Every UPDATE_PERIOD, a congestion probability is adjusted in proportion to how far the
+ * queueing delay is from Options::target and how fast it is changing. Arriving packets signal
+ * congestion with that probability. The queueing delay is the sojourn time of the most recently
+ * dequeued packet. Packets are marked only while the probability is at most MAX_MARK_PROBABILITY,
+ * and dropped above it, as the queue is then likely filled by flows that do not react to marks.
+ *
+ * \sa https://datatracker.ietf.org/doc/html/rfc8033
+ */
+class PieAqm final : public Aqm
+{
+public:
+  explicit
+  PieAqm(const Options& options);
+
+  Verdict
+  beforeEnqueue(size_t queueSize, time::steady_clock::TimePoint now) final;
+
+  Verdict
+  afterDequeue(time::nanoseconds sojournTime, size_t queueSize, time::steady_clock::TimePoint now) final;
+
+public:
+  static const std::string AQM_NAME;
+
+  static constexpr time::nanoseconds UPDATE_PERIOD = 15_ms;
+  static constexpr time::nanoseconds MAX_BURST = 150_ms;
+  static constexpr double ALPHA = 0.125; ///< weight of the delay error, in Hz
+  static constexpr double BETA = 1.25; ///< weight of the delay change, in Hz
+  static constexpr double MAX_MARK_PROBABILITY = 0.1;
+  /// a queue of at most this many octets is never subject to congestion signals
+  static constexpr size_t MIN_QUEUE_SIZE = 2 * 1500;
+
+NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /** \brief recompute the congestion probability once per UPDATE_PERIOD elapsed
+   */
+  void
+  updateProbability(time::steady_clock::TimePoint now);
+
+NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  double m_probability = 0.0;
+  time::nanoseconds m_qdelay = 0_ns;
+  time::nanoseconds m_qdelayOld = 0_ns;
+  time::nanoseconds m_burstAllowance;
+  time::steady_clock::TimePoint m_nextUpdate;
+};
+
+} // namespace nfd::face
+
+#endif // NFD_DAEMON_FACE_AQM_PIE_HPP
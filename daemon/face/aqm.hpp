@@ -0,0 +1,188 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_AQM_HPP
+#define NFD_DAEMON_FACE_AQM_HPP
+
+#include "face-common.hpp"
+
+namespace nfd::face {
+
+/**
+ * \brief Represents an active queue management (AQM) algorithm of a face send queue
+ *
+ * An AQM algorithm observes packets as they enter and leave a send queue, and decides from the
+ * queueing delay which packets should signal congestion to the consumers. The send queue either
+ * marks those packets with a congestion mark, or drops them if marking is disabled.
+ */
+class Aqm : noncopyable
+{
+public:
+  struct Options
+  {
+    /** \brief acceptable standing queueing delay
+     */
+    time::nanoseconds target = 5_ms;
+
+    /** \brief period over which the queueing delay must stay above \p target before the
+     *         algorithm reacts, which should be on the order of a worst-case round-trip time
+     */
+    time::nanoseconds interval = 100_ms;
+
+    /** \brief capacity of the send queue in octets; packets beyond it are dropped
+     */
+    size_t capacity = 200 * 1024;
+
+    /** \brief packets are held in the send queue while the transport has at least this many
+     *         octets queued
+     */
+    size_t transportQueueLimit = 16 * 1024;
+  };
+
+  /** \brief decision about a packet
+   */
+  enum class Verdict {
+    PASS,      ///< forward the packet as is
+    CONGESTED, ///< signal congestion with the packet: mark it if allowed, otherwise drop it
+    DROP,      ///< drop the packet
+  };
+
+public: // registry
+  template<typename A>
+  static void
+  registerAqm(const std::string& aqmName = A::AQM_NAME)
+  {
+    BOOST_ASSERT(!aqmName.empty());
+    auto r = getRegistry().insert_or_assign(aqmName, [] (const Options& options) {
+      return make_unique<A>(options);
+    });
+    BOOST_VERIFY(r.second);
+  }
+
+  /** \return an AQM algorithm identified by \p aqmName,
+   *          or nullptr if \p aqmName is unknown
+   */
+  static unique_ptr<Aqm>
+  create(const std::string& aqmName, const Options& options);
+
+  /** \return a list of available AQM algorithm names
+   */
+  static std::set<std::string>
+  getAqmNames();
+
+public: // defaults for new faces
+  /** \brief name of the AQM algorithm of faces created without one in FaceParams, empty if none
+   */
+  static const std::string&
+  getDefaultAqmName() noexcept
+  {
+    return s_defaultAqmName;
+  }
+
+  /** \brief options of the AQM algorithm of faces created without them in FaceParams
+   */
+  static const Options&
+  getDefaultOptions() noexcept
+  {
+    return s_defaultOptions;
+  }
+
+  static void
+  setDefault(const std::string& aqmName, const Options& options)
+  {
+    s_defaultAqmName = aqmName;
+    s_defaultOptions = options;
+  }
+
+public:
+  virtual
+  ~Aqm() = default;
+
+  const Options&
+  getOptions() const
+  {
+    return m_options;
+  }
+
+  /** \brief changes the options, keeping the state of the algorithm
+   */
+  void
+  setOptions(const Options& options)
+  {
+    m_options = options;
+  }
+
+  /** \brief invoked before a packet is appended to the send queue
+   *  \param queueSize octets in the send queue, excluding the packet
+   *  \param now current time
+   */
+  virtual Verdict
+  beforeEnqueue(size_t queueSize, time::steady_clock::TimePoint now) = 0;
+
+  /** \brief invoked after a packet is removed from the head of the send queue
+   *  \param sojournTime time the packet spent in the send queue
+   *  \param queueSize octets remaining in the send queue
+   *  \param now current time
+   */
+  virtual Verdict
+  afterDequeue(time::nanoseconds sojournTime, size_t queueSize, time::steady_clock::TimePoint now) = 0;
+
+protected:
+  explicit
+  Aqm(const Options& options)
+    : m_options(options)
+  {
+  }
+
+protected:
+  Options m_options;
+
+private:
+  using CreateFunc = std::function<unique_ptr<Aqm>(const Options&)>;
+  using Registry = std::map<std::string, CreateFunc>; // indexed by AQM name
+
+  static Registry&
+  getRegistry();
+
+  static std::string s_defaultAqmName;
+  static Options s_defaultOptions;
+};
+
+} // namespace nfd::face
+
+/** \brief registers an AQM algorithm
+ *  \param A a subclass of nfd::face::Aqm
+ */
+#define NFD_REGISTER_AQM(A)                      \
+static class NfdAuto ## A ## AqmRegistrationClass \
+{                                                \
+public:                                          \
+  NfdAuto ## A ## AqmRegistrationClass()         \
+  {                                              \
+    ::nfd::face::Aqm::registerAqm<A>();          \
+  }                                              \
+} g_nfdAuto ## A ## AqmRegistrationVariable
+
+#endif // NFD_DAEMON_FACE_AQM_HPP
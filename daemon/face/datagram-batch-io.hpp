@@ -0,0 +1,454 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_DATAGRAM_BATCH_IO_HPP
+#define NFD_DAEMON_FACE_DATAGRAM_BATCH_IO_HPP
+
+#include "datagram-buffer-pool.hpp"
+
+#include <boost/asio/error.hpp>
+
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#ifdef __linux__
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#endif
+
+namespace nfd::face {
+
+#ifdef __linux__
+namespace detail {
+// socket options of UDP generic segmentation/receive offload, which older libc headers lack
+#ifdef UDP_SEGMENT
+inline constexpr int SO_UDP_SEGMENT = UDP_SEGMENT;
+#else
+inline constexpr int SO_UDP_SEGMENT = 103; // since Linux 4.18
+#endif
+#ifdef UDP_GRO
+inline constexpr int SO_UDP_GRO = UDP_GRO;
+#else
+inline constexpr int SO_UDP_GRO = 104; // since Linux 5.0
+#endif
+} // namespace detail
+#endif // __linux__
+
+/** \brief receives and sends several datagrams per system call
+ *
+ *  On Linux, this uses recvmmsg(2) and sendmmsg(2). Elsewhere, it falls back to one
+ *  non-blocking system call per datagram, which still saves a trip through the io_service.
+ *
+ *  On Linux UDP sockets, segmentation offload can additionally be enabled. Consecutive packets
+ *  of equal size toward the same destination are then sent as one UDP_SEGMENT (GSO) message,
+ *  which the kernel or the NIC splits into datagrams, and datagrams coalesced by UDP_GRO on
+ *  receive are split back before they are handed to the callback.
+ *
+ *  Operations never block: they return boost::asio::error::would_block if the socket is not ready.
+ *  They are meant to be invoked after an asynchronous wait on the socket (with null_buffers).
+ *
+ *  \tparam Protocol a datagram-based protocol in Boost.Asio
+ */
+template<class Protocol>
+class DatagramBatchIo : noncopyable
+{
+public:
+  using protocol = Protocol;
+
+  static constexpr size_t MAX_BATCH_SIZE = 64;
+
+  /// maximum number of packets coalesced into one GSO message
+  static constexpr size_t MAX_GSO_SEGMENTS = 64;
+
+  /// maximum total size of packets coalesced into one GSO message, which is the largest UDP payload
+  static constexpr size_t MAX_GSO_SIZE = 65507;
+
+  /** \param batchSize maximum number of datagrams per system call, between 1 and MAX_BATCH_SIZE
+   */
+  explicit
+  DatagramBatchIo(size_t batchSize);
+
+  size_t
+  getBatchSize() const noexcept
+  {
+    return m_batchSize;
+  }
+
+  /** \brief enable UDP generic segmentation offload on send and generic receive offload on receive
+   *
+   *  Each of them is enabled if the socket supports it. While GRO is enabled, each receive buffer
+   *  is large enough for a coalesced datagram of 64 KiB.
+   *  GSO is disabled again if the kernel rejects a coalesced message, e.g., because the packets
+   *  exceed the path MTU or the NIC cannot offload checksums.
+   *
+   *  \return whether either of them has been enabled
+   */
+  bool
+  enableSegmentationOffload(typename protocol::socket& socket);
+
+  bool
+  isGsoEnabled() const noexcept
+  {
+    return m_isGsoEnabled;
+  }
+
+  bool
+  isGroEnabled() const noexcept
+  {
+    return m_isGroEnabled;
+  }
+
+  /** \brief size of each receive buffer, which is larger than MAX_NDN_PACKET_SIZE while GRO is enabled
+   */
+  size_t
+  getReceiveBufferSize() const noexcept
+  {
+    return m_bufferSize;
+  }
+
+  /** \brief receive up to getBatchSize() datagrams, invoking \p onDatagram on each of them
+   *
+   *  \p onDatagram is invoked as `onDatagram(span<const uint8_t> datagram, const endpoint& sender)`,
+   *  once per segment of a datagram coalesced by GRO.
+   *  The datagram is stored in a buffer that is reused by the next receive().
+   *  \return error of the system call, or success if at least one datagram has been received
+   */
+  template<typename Callback>
+  boost::system::error_code
+  receive(typename protocol::socket& socket, Callback&& onDatagram)
+  {
+    return receiveImpl(socket,
+                       [this] (size_t i) { return &m_buffers[i * m_bufferSize]; },
+                       [&] (size_t i, span<const uint8_t> datagram) { onDatagram(datagram, m_senders[i]); });
+  }
+
+  /** \brief receive up to getBatchSize() datagrams directly into buffers obtained from \p pool
+   *
+   *  \p onDatagram is invoked as
+   *  `onDatagram(const shared_ptr<ndn::Buffer>& buffer, span<const uint8_t> datagram, const endpoint& sender)`,
+   *  where \p datagram lies within \p buffer. A buffer into which a datagram has been received
+   *  is not used again by this object, so that packets can refer to it.
+   *
+   *  \pre pool.getBufferSize() >= getReceiveBufferSize()
+   */
+  template<typename Callback>
+  boost::system::error_code
+  receive(typename protocol::socket& socket, DatagramBufferPool& pool, Callback&& onDatagram);
+
+  /** \brief send \p packets, in batches of up to getBatchSize() datagrams
+   *  \param destination destination of every datagram, or nullptr if the socket is connected
+   *  \param[out] error set to the error that prevented sending the first unsent packet
+   *  \return number of packets sent, which is packets.size() unless \p error is set
+   */
+  size_t
+  send(typename protocol::socket& socket, span<const Block> packets,
+       const typename protocol::endpoint* destination, boost::system::error_code& error)
+  {
+    return sendImpl(socket, packets, [destination] (size_t) { return destination; }, error);
+  }
+
+  /** \brief send each of \p packets to the corresponding element of \p destinations
+   *  \pre destinations.size() >= packets.size()
+   */
+  size_t
+  send(typename protocol::socket& socket, span<const Block> packets,
+       span<const typename protocol::endpoint> destinations, boost::system::error_code& error)
+  {
+    BOOST_ASSERT(destinations.size() >= packets.size());
+    return sendImpl(socket, packets, [destinations] (size_t i) { return &destinations[i]; }, error);
+  }
+
+private:
+  /** \param getBuffer returns the receive buffer of the i-th message
+   *  \param onDatagram invoked with the index of the message and each datagram received in it
+   */
+  template<typename GetBuffer, typename Callback>
+  boost::system::error_code
+  receiveImpl(typename protocol::socket& socket, const GetBuffer& getBuffer, const Callback& onDatagram);
+
+  /** \param getDestination returns the destination of the i-th packet, or nullptr
+   */
+  template<typename GetDestination>
+  size_t
+  sendImpl(typename protocol::socket& socket, span<const Block> packets,
+           const GetDestination& getDestination, boost::system::error_code& error);
+
+private:
+  const size_t m_batchSize;
+  size_t m_bufferSize = ndn::MAX_NDN_PACKET_SIZE; ///< size of each receive buffer
+  std::vector<uint8_t> m_buffers; ///< m_batchSize receive buffers of m_bufferSize octets
+  std::vector<typename protocol::endpoint> m_senders;
+  std::vector<shared_ptr<ndn::Buffer>> m_poolBuffers; ///< receive buffers obtained from a pool
+  bool m_isGsoEnabled = false;
+  bool m_isGroEnabled = false;
+#ifdef __linux__
+  /// control message buffer, which holds either UDP_SEGMENT (uint16_t) or UDP_GRO (int)
+  using ControlBuffer = std::aligned_storage_t<CMSG_SPACE(sizeof(int)), alignof(::cmsghdr)>;
+
+  std::vector<::mmsghdr> m_msgs;
+  std::vector<::iovec> m_iovecs; ///< MAX_GSO_SEGMENTS per message while GSO is enabled
+  std::vector<ControlBuffer> m_controls; ///< one per message while GSO or GRO is enabled
+  std::vector<size_t> m_msgPackets; ///< number of packets in each message being sent
+#endif
+};
+
+template<class P>
+DatagramBatchIo<P>::DatagramBatchIo(size_t batchSize)
+  : m_batchSize(batchSize)
+  , m_buffers(batchSize * ndn::MAX_NDN_PACKET_SIZE)
+  , m_senders(batchSize)
+#ifdef __linux__
+  , m_msgs(batchSize)
+  , m_iovecs(batchSize)
+  , m_msgPackets(batchSize)
+#endif
+{
+  BOOST_ASSERT(batchSize >= 1 && batchSize <= MAX_BATCH_SIZE);
+}
+
+template<class P>
+bool
+DatagramBatchIo<P>::enableSegmentationOffload(typename protocol::socket& socket)
+{
+#ifdef __linux__
+  // setting a zero default segment size succeeds only if the kernel supports UDP_SEGMENT
+  int zero = 0;
+  m_isGsoEnabled = ::setsockopt(socket.native_handle(), IPPROTO_UDP, detail::SO_UDP_SEGMENT,
+                                &zero, sizeof(zero)) == 0;
+  int one = 1;
+  m_isGroEnabled = ::setsockopt(socket.native_handle(), IPPROTO_UDP, detail::SO_UDP_GRO,
+                                &one, sizeof(one)) == 0;
+
+  if (m_isGsoEnabled) {
+    m_iovecs.resize(m_batchSize * MAX_GSO_SEGMENTS);
+  }
+  if (m_isGroEnabled) {
+    m_bufferSize = std::numeric_limits<uint16_t>::max();
+    m_buffers.resize(m_batchSize * m_bufferSize);
+  }
+  if (m_isGsoEnabled || m_isGroEnabled) {
+    m_controls.resize(m_batchSize);
+  }
+#endif
+  return m_isGsoEnabled || m_isGroEnabled;
+}
+
+template<class P>
+template<typename Callback>
+boost::system::error_code
+DatagramBatchIo<P>::receive(typename protocol::socket& socket, DatagramBufferPool& pool,
+                            Callback&& onDatagram)
+{
+  BOOST_ASSERT(pool.getBufferSize() >= m_bufferSize);
+  m_poolBuffers.resize(m_batchSize);
+
+  size_t nUsed = 0;
+  auto error = receiveImpl(socket,
+    [&] (size_t i) {
+      if (m_poolBuffers[i] == nullptr) {
+        m_poolBuffers[i] = pool.acquire();
+      }
+      return m_poolBuffers[i]->data();
+    },
+    [&] (size_t i, span<const uint8_t> datagram) {
+      nUsed = i + 1;
+      onDatagram(m_poolBuffers[i], datagram, m_senders[i]);
+    });
+
+  // datagrams are received into consecutive messages
+  for (size_t i = 0; i < nUsed; ++i) {
+    m_poolBuffers[i].reset();
+  }
+  return error;
+}
+
+template<class P>
+template<typename GetBuffer, typename Callback>
+boost::system::error_code
+DatagramBatchIo<P>::receiveImpl(typename protocol::socket& socket, const GetBuffer& getBuffer,
+                                const Callback& onDatagram)
+{
+#ifdef __linux__
+  for (size_t i = 0; i < m_batchSize; ++i) {
+    m_iovecs[i] = {getBuffer(i), m_bufferSize};
+    m_msgs[i] = {};
+    m_msgs[i].msg_hdr.msg_name = m_senders[i].data();
+    m_msgs[i].msg_hdr.msg_namelen = static_cast<socklen_t>(m_senders[i].capacity());
+    m_msgs[i].msg_hdr.msg_iov = &m_iovecs[i];
+    m_msgs[i].msg_hdr.msg_iovlen = 1;
+    if (m_isGroEnabled) {
+      m_msgs[i].msg_hdr.msg_control = &m_controls[i];
+      m_msgs[i].msg_hdr.msg_controllen = sizeof(ControlBuffer);
+    }
+  }
+
+  int n = ::recvmmsg(socket.native_handle(), m_msgs.data(), static_cast<unsigned>(m_batchSize),
+                     MSG_DONTWAIT, nullptr);
+  if (n < 0) {
+    return {errno, boost::system::system_category()};
+  }
+
+  for (int i = 0; i < n; ++i) {
+    ::msghdr& hdr = m_msgs[i].msg_hdr;
+    m_senders[i].resize(hdr.msg_namelen);
+    auto datagram = ndn::make_span(static_cast<const uint8_t*>(m_iovecs[i].iov_base), m_msgs[i].msg_len);
+
+    // a datagram coalesced by GRO consists of segments of equal size, except that the last one
+    // can be shorter
+    size_t segmentSize = datagram.size();
+    if (m_isGroEnabled) {
+      for (auto cmsg = CMSG_FIRSTHDR(&hdr); cmsg != nullptr; cmsg = CMSG_NXTHDR(&hdr, cmsg)) {
+        if (cmsg->cmsg_level == IPPROTO_UDP && cmsg->cmsg_type == detail::SO_UDP_GRO) {
+          int gsoSize = 0;
+          std::memcpy(&gsoSize, CMSG_DATA(cmsg), sizeof(gsoSize));
+          if (gsoSize > 0) {
+            segmentSize = static_cast<size_t>(gsoSize);
+          }
+        }
+      }
+    }
+
+    for (size_t offset = 0; offset < datagram.size(); offset += segmentSize) {
+      onDatagram(i, datagram.subspan(offset, std::min(segmentSize, datagram.size() - offset)));
+    }
+  }
+  return {};
+#else
+  boost::system::error_code error;
+  socket.non_blocking(true, error);
+  if (error) {
+    return error;
+  }
+
+  for (size_t i = 0; i < m_batchSize; ++i) {
+    auto buffer = ndn::make_span(getBuffer(i), m_bufferSize);
+    size_t nBytes = socket.receive_from(boost::asio::buffer(buffer.data(), buffer.size()),
+                                        m_senders[i], 0, error);
+    if (error) {
+      return i == 0 ? error : boost::system::error_code{};
+    }
+    onDatagram(i, buffer.first(nBytes));
+  }
+  return {};
+#endif
+}
+
+template<class P>
+template<typename GetDestination>
+size_t
+DatagramBatchIo<P>::sendImpl(typename protocol::socket& socket, span<const Block> packets,
+                             const GetDestination& getDestination, boost::system::error_code& error)
+{
+  error.clear();
+  size_t nSent = 0;
+
+#ifdef __linux__
+  auto isSameDestination = [] (const auto* a, const auto* b) {
+    return a == b || (a != nullptr && b != nullptr && *a == *b);
+  };
+
+  while (nSent < packets.size()) {
+    size_t nMsgs = 0;
+    size_t nIovecs = 0;
+    for (size_t i = nSent; nMsgs < m_batchSize && i < packets.size(); ++nMsgs) {
+      auto destination = getDestination(i);
+      size_t first = i;
+      size_t segmentSize = packets[i].size();
+      size_t totalSize = 0;
+
+      // with GSO, consecutive packets of equal size toward the same destination share a message,
+      // which may end with one shorter packet
+      do {
+        const Block& packet = packets[i];
+        m_iovecs[nIovecs++] = {const_cast<uint8_t*>(packet.data()), packet.size()};
+        totalSize += packet.size();
+        ++i;
+      } while (m_isGsoEnabled && segmentSize == packets[i - 1].size() &&
+               i < packets.size() && i - first < MAX_GSO_SEGMENTS &&
+               packets[i].size() <= segmentSize && totalSize + packets[i].size() <= MAX_GSO_SIZE &&
+               isSameDestination(getDestination(i), destination));
+
+      ::mmsghdr& msg = m_msgs[nMsgs];
+      msg = {};
+      if (destination != nullptr) {
+        msg.msg_hdr.msg_name = const_cast<void*>(static_cast<const void*>(destination->data()));
+        msg.msg_hdr.msg_namelen = static_cast<socklen_t>(destination->size());
+      }
+      msg.msg_hdr.msg_iov = &m_iovecs[nIovecs - (i - first)];
+      msg.msg_hdr.msg_iovlen = i - first;
+      m_msgPackets[nMsgs] = i - first;
+
+      if (i - first > 1) {
+        msg.msg_hdr.msg_control = &m_controls[nMsgs];
+        msg.msg_hdr.msg_controllen = CMSG_SPACE(sizeof(uint16_t));
+        auto cmsg = CMSG_FIRSTHDR(&msg.msg_hdr);
+        cmsg->cmsg_level = IPPROTO_UDP;
+        cmsg->cmsg_type = detail::SO_UDP_SEGMENT;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+        auto gsoSize = static_cast<uint16_t>(segmentSize);
+        std::memcpy(CMSG_DATA(cmsg), &gsoSize, sizeof(gsoSize));
+      }
+    }
+
+    int n = ::sendmmsg(socket.native_handle(), m_msgs.data(), static_cast<unsigned>(nMsgs), MSG_DONTWAIT);
+    if (n < 0) {
+      int errorCode = errno;
+      if (m_msgPackets[0] > 1 && (errorCode == EINVAL || errorCode == EIO)) {
+        // the kernel refused to segment the first message, so stop coalescing and retry
+        m_isGsoEnabled = false;
+        continue;
+      }
+      error.assign(errorCode, boost::system::system_category());
+      break;
+    }
+    for (int k = 0; k < n; ++k) {
+      nSent += m_msgPackets[k];
+    }
+  }
+#else
+  socket.non_blocking(true, error);
+  for (; !error && nSent < packets.size(); ++nSent) {
+    auto buffer = boost::asio::buffer(packets[nSent].data(), packets[nSent].size());
+    if (auto destination = getDestination(nSent); destination != nullptr) {
+      socket.send_to(buffer, *destination, 0, error);
+    }
+    else {
+      socket.send(buffer, 0, error);
+    }
+    if (error) {
+      break;
+    }
+  }
+#endif
+
+  return nSent;
+}
+
+} // namespace nfd::face
+
+#endif // NFD_DAEMON_FACE_DATAGRAM_BATCH_IO_HPP
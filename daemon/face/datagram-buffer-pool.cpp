@@ -0,0 +1,65 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "datagram-buffer-pool.hpp"
+
+namespace nfd::face {
+
+size_t DatagramBufferPool::s_transportPoolCapacity = 0;
+
+DatagramBufferPool::DatagramBufferPool(size_t capacity, size_t bufferSize)
+  : m_bufferSize(bufferSize)
+{
+  BOOST_ASSERT(capacity > 0);
+
+  m_buffers.reserve(capacity);
+  for (size_t i = 0; i < capacity; ++i) {
+    m_buffers.push_back(make_shared<ndn::Buffer>(m_bufferSize));
+  }
+}
+
+shared_ptr<ndn::Buffer>
+DatagramBufferPool::acquire()
+{
+  // buffers are handed out in round-robin order, so the next one is the least recently used
+  size_t first = m_next;
+  size_t nProbes = std::min(MAX_PROBES, m_buffers.size());
+  for (size_t i = 0; i < nProbes; ++i) {
+    auto& buffer = m_buffers[m_next];
+    m_next = (m_next + 1) % m_buffers.size();
+    if (buffer.use_count() == 1) {
+      ++m_nHits;
+      return buffer;
+    }
+  }
+
+  // replace the least recently used buffer, which its packets keep alive
+  ++m_nMisses;
+  m_next = (first + 1) % m_buffers.size();
+  m_buffers[first] = make_shared<ndn::Buffer>(m_bufferSize);
+  return m_buffers[first];
+}
+
+} // namespace nfd::face
@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_DATAGRAM_BUFFER_POOL_HPP
+#define NFD_DAEMON_FACE_DATAGRAM_BUFFER_POOL_HPP
+
+#include "core/common.hpp"
+
+namespace nfd::face {
+
+/** \brief a pool of preallocated receive buffers that are recycled once no packet refers to them
+ *
+ *  A datagram is received directly into a buffer obtained from acquire(), and the received packet
+ *  is a Block that refers to that buffer, so that the packet is neither allocated nor copied.
+ *  The pool retains a reference to each of its buffers: a buffer is free again when the pool holds
+ *  the only reference, i.e., after every Block referring to it has been released.
+ *
+ *  If the next few buffers are all in use, e.g., because packets are held in the Content Store,
+ *  acquire() allocates a replacement buffer and counts a miss. The replaced buffer leaves the pool
+ *  and is deallocated with its last packet.
+ *
+ *  A pool may be used by only one thread.
+ */
+class DatagramBufferPool : noncopyable
+{
+public:
+  /// number of buffers examined by acquire() before it allocates a replacement
+  static constexpr size_t MAX_PROBES = 4;
+
+  /** \param capacity number of buffers, must be positive
+   *  \param bufferSize size of each buffer
+   */
+  explicit
+  DatagramBufferPool(size_t capacity, size_t bufferSize = ndn::MAX_NDN_PACKET_SIZE);
+
+  /** \brief obtain a buffer of getBufferSize() octets that no packet refers to
+   */
+  shared_ptr<ndn::Buffer>
+  acquire();
+
+  size_t
+  getCapacity() const noexcept
+  {
+    return m_buffers.size();
+  }
+
+  size_t
+  getBufferSize() const noexcept
+  {
+    return m_bufferSize;
+  }
+
+  /** \brief number of acquire() calls that returned a recycled buffer
+   */
+  uint64_t
+  getNHits() const noexcept
+  {
+    return m_nHits;
+  }
+
+  /** \brief number of acquire() calls that allocated a buffer because the pool was exhausted
+   */
+  uint64_t
+  getNMisses() const noexcept
+  {
+    return m_nMisses;
+  }
+
+  /** \brief capacity of the pool of each newly created datagram transport, 0 if pools are not used
+   */
+  static size_t
+  getTransportPoolCapacity() noexcept
+  {
+    return s_transportPoolCapacity;
+  }
+
+  static void
+  setTransportPoolCapacity(size_t capacity) noexcept
+  {
+    s_transportPoolCapacity = capacity;
+  }
+
+private:
+  std::vector<shared_ptr<ndn::Buffer>> m_buffers;
+  const size_t m_bufferSize;
+  size_t m_next = 0; ///< index of the buffer to examine first
+  uint64_t m_nHits = 0;
+  uint64_t m_nMisses = 0;
+
+  static size_t s_transportPoolCapacity;
+};
+
+} // namespace nfd::face
+
+#endif // NFD_DAEMON_FACE_DATAGRAM_BUFFER_POOL_HPP
@@ -0,0 +1,468 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_DATAGRAM_PUMP_HPP
+#define NFD_DAEMON_FACE_DATAGRAM_PUMP_HPP
+
+#include "datagram-batch-io.hpp"
+#include "io-thread.hpp"
+#include "common/spsc-channel.hpp"
+
+#include <boost/asio/socket_base.hpp>
+
+#include <array>
+#include <future>
+#include <unistd.h>
+
+namespace nfd::face {
+
+/** \brief moves datagrams between a socket serviced by an IoThread and the forwarding thread
+ *
+ *  The pump operates on a duplicate of the transport's socket descriptor, registered with the
+ *  I/O thread's io_service. Received datagrams are parsed on the I/O thread and passed to the
+ *  forwarding thread through an RX ring; packets to be sent are passed to the I/O thread
+ *  through a TX ring. Both rings are bounded: a packet that does not fit is dropped and counted.
+ *
+ *  \warning Except where noted, member functions must be invoked on the forwarding thread,
+ *           which is also where the pump must be destroyed.
+ */
+template<class Protocol>
+class DatagramPump : public std::enable_shared_from_this<DatagramPump<Protocol>>, noncopyable
+{
+public:
+  using protocol = Protocol;
+  using ReceiveCallback = std::function<void(const Block& packet, const typename protocol::endpoint& sender)>;
+  using ErrorCallback = std::function<void(const boost::system::error_code& error)>;
+
+  /** \param socket the transport's socket, which must be open; it is not modified
+   *  \param batchSize maximum number of datagrams received or sent per system call
+   *  \param wantSegmentationOffload whether to enable UDP GSO/GRO, see DatagramBatchIo
+   */
+  DatagramPump(shared_ptr<IoThread> thread, typename protocol::socket& socket, size_t ringCapacity,
+               size_t batchSize = 1, bool wantSegmentationOffload = false);
+
+  /** \brief close the duplicate sockets, after waiting for pending I/O handlers to complete
+   */
+  ~DatagramPump();
+
+  /** \brief send packets to \p destination through a duplicate of \p socket,
+   *         instead of through the receiving socket
+   *  \pre send() has not been invoked
+   */
+  void
+  setSendSocket(typename protocol::socket& socket, const typename protocol::endpoint& destination);
+
+  /** \brief start receiving
+   *
+   *  \p onReceive is invoked with an invalid Block if a datagram cannot be parsed as a TLV element.
+   *  Neither callback is invoked after stop().
+   */
+  void
+  start(ReceiveCallback onReceive, ErrorCallback onError);
+
+  /** \brief stop receiving and sending
+   *
+   *  Packets that are in the rings are discarded.
+   */
+  void
+  stop();
+
+  /** \brief enqueue \p packet to be sent on the I/O thread
+   *  \return false if \p packet is dropped because the TX ring is full
+   */
+  bool
+  send(const Block& packet);
+
+  size_t
+  getRxDepth() const noexcept
+  {
+    return m_rx.size();
+  }
+
+  size_t
+  getTxDepth() const noexcept
+  {
+    return m_tx.size();
+  }
+
+  /** \return number of received packets dropped because the RX ring was full
+   *  \note This can be invoked on any thread.
+   */
+  uint64_t
+  getRxDrops() const noexcept
+  {
+    return m_nRxDrops.load(std::memory_order_relaxed);
+  }
+
+private:
+  struct RxItem
+  {
+    Block packet;
+    typename protocol::endpoint sender;
+  };
+
+  static void
+  duplicate(typename protocol::socket& from, typename protocol::socket& to);
+
+  void
+  drainRx();
+
+  void
+  postError(const boost::system::error_code& error);
+
+private: // invoked on the I/O thread
+  void
+  asyncReceive();
+
+  void
+  handleReceive(const boost::system::error_code& error, size_t nBytesReceived);
+
+  void
+  handleReadable(const boost::system::error_code& error);
+
+  /** \brief parse a received datagram and pass it to the forwarding thread
+   */
+  void
+  pushDatagram(span<const uint8_t> datagram, const typename protocol::endpoint& sender);
+
+  void
+  asyncSend(const Block& packet);
+
+  void
+  drainTx();
+
+  void
+  closeSockets();
+
+private:
+  static constexpr size_t DRAIN_LIMIT = 64;
+
+  shared_ptr<IoThread> m_thread;
+  boost::asio::io_service& m_io; ///< the I/O thread's io_service
+  boost::asio::io_service& m_mainIo;
+
+  // accessed on the I/O thread after start()
+  typename protocol::socket m_socket;
+  typename protocol::socket m_sendSocket;
+  typename protocol::endpoint m_destination;
+  typename protocol::endpoint m_sender;
+  std::array<uint8_t, ndn::MAX_NDN_PACKET_SIZE> m_receiveBuffer;
+  unique_ptr<DatagramBatchIo<protocol>> m_batchIo; ///< non-null if batching or segmentation offload is used
+  std::vector<Block> m_sendBatch;
+
+  SpscChannel<RxItem> m_rx;
+  SpscChannel<Block> m_tx;
+  std::atomic<uint64_t> m_nRxDrops{0};
+
+  // accessed on the forwarding thread
+  ReceiveCallback m_onReceive;
+  ErrorCallback m_onError;
+  bool m_isStopped = false;
+};
+
+template<class P>
+DatagramPump<P>::DatagramPump(shared_ptr<IoThread> thread, typename protocol::socket& socket,
+                              size_t ringCapacity, size_t batchSize, bool wantSegmentationOffload)
+  : m_thread(std::move(thread))
+  , m_io(m_thread->getIoService())
+  , m_mainIo(m_thread->getMainIoService())
+  , m_socket(m_io)
+  , m_sendSocket(m_io)
+  , m_rx(ringCapacity)
+  , m_tx(ringCapacity)
+{
+  duplicate(socket, m_socket);
+  if (batchSize > 1 || wantSegmentationOffload) {
+    m_batchIo = make_unique<DatagramBatchIo<protocol>>(batchSize);
+    if (wantSegmentationOffload && !m_batchIo->enableSegmentationOffload(m_socket) && batchSize == 1) {
+      m_batchIo.reset();
+    }
+  }
+}
+
+template<class P>
+DatagramPump<P>::~DatagramPump()
+{
+  if (m_io.stopped()) {
+    // I/O thread has terminated, so pending handlers will never run
+    closeSockets();
+    return;
+  }
+
+  // Closing the sockets on the I/O thread causes the completion handlers of outstanding
+  // operations to be queued; the handler posted afterwards runs after all of them,
+  // at which point no handler refers to this pump anymore.
+  std::promise<void> done;
+  m_io.post([this, &done] {
+    closeSockets();
+    m_io.post([&done] { done.set_value(); });
+  });
+  done.get_future().wait();
+}
+
+template<class P>
+void
+DatagramPump<P>::duplicate(typename protocol::socket& from, typename protocol::socket& to)
+{
+  int fd = ::dup(from.native_handle());
+  if (fd < 0) {
+    NDN_THROW_ERRNO(std::runtime_error("Cannot duplicate socket descriptor"));
+  }
+  boost::system::error_code error;
+  to.assign(from.local_endpoint().protocol(), fd, error);
+  if (error) {
+    ::close(fd);
+    NDN_THROW(boost::system::system_error(error, "Cannot assign socket to I/O thread"));
+  }
+}
+
+template<class P>
+void
+DatagramPump<P>::setSendSocket(typename protocol::socket& socket, const typename protocol::endpoint& destination)
+{
+  duplicate(socket, m_sendSocket);
+  m_destination = destination;
+}
+
+template<class P>
+void
+DatagramPump<P>::start(ReceiveCallback onReceive, ErrorCallback onError)
+{
+  m_onReceive = std::move(onReceive);
+  m_onError = std::move(onError);
+  m_io.post([this] { asyncReceive(); });
+}
+
+template<class P>
+void
+DatagramPump<P>::stop()
+{
+  if (m_isStopped) {
+    return;
+  }
+  m_isStopped = true;
+  m_io.post([this] { closeSockets(); });
+}
+
+template<class P>
+bool
+DatagramPump<P>::send(const Block& packet)
+{
+  if (m_isStopped || !m_tx.push(Block(packet))) {
+    return false;
+  }
+  m_tx.notify(m_io, [this] { drainTx(); });
+  return true;
+}
+
+template<class P>
+void
+DatagramPump<P>::drainRx()
+{
+  bool hasMore = m_rx.drain(DRAIN_LIMIT, [this] (RxItem& item) {
+    if (!m_isStopped) {
+      m_onReceive(item.packet, item.sender);
+    }
+  });
+
+  if (hasMore) {
+    m_mainIo.post([self = this->weak_from_this()] {
+      if (auto pump = self.lock(); pump != nullptr) {
+        pump->drainRx();
+      }
+    });
+  }
+}
+
+template<class P>
+void
+DatagramPump<P>::postError(const boost::system::error_code& error)
+{
+  m_mainIo.post([self = this->weak_from_this(), error] {
+    if (auto pump = self.lock(); pump != nullptr && !pump->m_isStopped) {
+      pump->m_onError(error);
+    }
+  });
+}
+
+template<class P>
+void
+DatagramPump<P>::asyncReceive()
+{
+  if (!m_socket.is_open()) {
+    return;
+  }
+
+  if (m_batchIo != nullptr) {
+    m_socket.async_receive(boost::asio::null_buffers(),
+                           [this] (const auto& error, size_t) { handleReadable(error); });
+  }
+  else {
+    m_socket.async_receive_from(boost::asio::buffer(m_receiveBuffer), m_sender,
+                                [this] (const auto& error, size_t nBytesReceived) {
+                                  handleReceive(error, nBytesReceived);
+                                });
+  }
+}
+
+template<class P>
+void
+DatagramPump<P>::handleReceive(const boost::system::error_code& error, size_t nBytesReceived)
+{
+  if (error == boost::asio::error::operation_aborted) {
+    return;
+  }
+
+  if (error) {
+    postError(error);
+  }
+  else {
+    pushDatagram(ndn::make_span(m_receiveBuffer).first(nBytesReceived), m_sender);
+  }
+
+  asyncReceive();
+}
+
+template<class P>
+void
+DatagramPump<P>::handleReadable(const boost::system::error_code& error)
+{
+  if (error == boost::asio::error::operation_aborted) {
+    return;
+  }
+
+  if (error) {
+    postError(error);
+  }
+  else {
+    auto recvError = m_batchIo->receive(m_socket, [this] (auto datagram, const auto& sender) {
+      pushDatagram(datagram, sender);
+    });
+    if (recvError && recvError != boost::asio::error::would_block &&
+        recvError != boost::asio::error::try_again) {
+      postError(recvError);
+    }
+  }
+
+  asyncReceive();
+}
+
+template<class P>
+void
+DatagramPump<P>::pushDatagram(span<const uint8_t> datagram, const typename protocol::endpoint& sender)
+{
+  auto [isOk, element] = Block::fromBuffer(datagram);
+  if (!isOk || element.size() != datagram.size()) {
+    element = Block();
+  }
+
+  if (m_rx.push(RxItem{std::move(element), sender})) {
+    m_rx.notify(m_mainIo, [self = this->weak_from_this()] {
+      if (auto pump = self.lock(); pump != nullptr) {
+        pump->drainRx();
+      }
+    });
+  }
+  else {
+    m_nRxDrops.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+template<class P>
+void
+DatagramPump<P>::drainTx()
+{
+  auto& socket = m_sendSocket.is_open() ? m_sendSocket : m_socket;
+  bool hasMore = m_tx.drain(DRAIN_LIMIT, [&] (Block& packet) {
+    if (!socket.is_open()) {
+      return;
+    }
+    if (m_batchIo != nullptr) {
+      m_sendBatch.push_back(std::move(packet));
+    }
+    else {
+      asyncSend(packet);
+    }
+  });
+
+  if (!m_sendBatch.empty()) {
+    boost::system::error_code error;
+    size_t nSent = m_batchIo->send(socket, m_sendBatch, m_sendSocket.is_open() ? &m_destination : nullptr,
+                                   error);
+    if (error && error != boost::asio::error::would_block && error != boost::asio::error::try_again) {
+      postError(error);
+      ++nSent;
+    }
+    // packets that could not be sent immediately are handed to the asynchronous path
+    for (size_t i = nSent; i < m_sendBatch.size(); ++i) {
+      asyncSend(m_sendBatch[i]);
+    }
+    m_sendBatch.clear();
+  }
+
+  // once the sockets are closed, the destructor may be waiting for handlers to complete,
+  // so no handler may be posted anymore
+  if (hasMore && socket.is_open()) {
+    m_io.post([this] { drainTx(); });
+  }
+}
+
+template<class P>
+void
+DatagramPump<P>::asyncSend(const Block& packet)
+{
+  auto& socket = m_sendSocket.is_open() ? m_sendSocket : m_socket;
+  // 'packet' is copied into the handler to retain the underlying Buffer
+  auto handler = [this, packet] (const boost::system::error_code& error, size_t) {
+    if (error && error != boost::asio::error::operation_aborted) {
+      postError(error);
+    }
+  };
+  if (&socket == &m_sendSocket) {
+    socket.async_send_to(boost::asio::buffer(packet), m_destination, std::move(handler));
+  }
+  else {
+    socket.async_send(boost::asio::buffer(packet), std::move(handler));
+  }
+}
+
+template<class P>
+void
+DatagramPump<P>::closeSockets()
+{
+  boost::system::error_code error;
+  if (m_socket.is_open()) {
+    m_socket.cancel(error);
+    m_socket.close(error);
+  }
+  if (m_sendSocket.is_open()) {
+    m_sendSocket.cancel(error);
+    m_sendSocket.close(error);
+  }
+}
+
+} // namespace nfd::face
+
+#endif // NFD_DAEMON_FACE_DATAGRAM_PUMP_HPP
@@ -27,6 +27,9 @@
 #define NFD_DAEMON_FACE_DATAGRAM_TRANSPORT_HPP
 
 #include "transport.hpp"
+#include "datagram-batch-io.hpp"
+#include "datagram-buffer-pool.hpp"
+#include "datagram-pump.hpp"
 #include "socket-utils.hpp"
 #include "common/global.hpp"
 
@@ -38,6 +41,19 @@ struct Unicast {};
 struct Multicast {};
 
 /** \brief Implements Transport for datagram-based protocols.
+ *
+ *  If an IoThreadPool exists when the transport is constructed, socket I/O is performed
+ *  on one of its threads through a DatagramPump, and the transport itself only deals with
+ *  parsed packets on the forwarding thread.
+ *
+ *  Otherwise, if the batch size is greater than one, the transport waits for the socket to become
+ *  readable and then receives up to that many datagrams with one system call. Packets sent
+ *  during one round of the io_service are likewise queued and sent with as few system calls
+ *  as possible.
+ *
+ *  If DatagramBufferPool::getTransportPoolCapacity() is positive when the transport is constructed
+ *  without an IoThreadPool, datagrams are received directly into buffers of a DatagramBufferPool,
+ *  and each received packet refers to the buffer it was received into instead of a copy.
  *
  *  \tparam Protocol a datagram-based protocol in Boost.Asio
  */
@@ -50,9 +66,14 @@ public:
   /** \brief Construct datagram transport.
    *
    *  \param socket Protocol-specific socket for the created transport
+   *  \param batchSize maximum number of datagrams received or sent per system call,
+   *                   between 1 and DatagramBatchIo::MAX_BATCH_SIZE
+   *  \param wantSegmentationOffload whether to enable UDP GSO/GRO where supported,
+   *                                 see DatagramBatchIo::enableSegmentationOffload
    */
   explicit
-  DatagramTransport(typename protocol::socket&& socket);
+  DatagramTransport(typename protocol::socket&& socket, size_t batchSize = 1,
+                    bool wantSegmentationOffload = false);
 
   ssize_t
   getSendQueueLength() override;
@@ -70,6 +91,9 @@ protected:
   void
   doSend(const Block& packet) override;
 
+  void
+  doSendGathered(const GatheredPacket& packet) override;
+
   void
   handleSend(const boost::system::error_code& error, size_t nBytesSent);
 
@@ -79,6 +103,23 @@ protected:
   void
   processErrorCode(const boost::system::error_code& error);
 
+  /** \brief send packets to \p destination through \p socket, instead of through m_socket
+   *
+   *  This must be invoked by the subclass constructor, if at all.
+   */
+  void
+  setSendDestination(typename protocol::socket& socket, const typename protocol::endpoint& destination);
+
+  /** \brief deliver a packet received by the pump
+   */
+  void
+  receivePumpedPacket(const Block& packet, const typename protocol::endpoint& sender);
+
+  /** \brief close the socket, and the pump if any
+   */
+  void
+  closeSocket();
+
   bool
   hasRecentlyReceived() const;
 
@@ -88,22 +129,60 @@ protected:
   static EndpointId
   makeEndpointId(const typename protocol::endpoint& ep);
 
+private:
+  /** \brief deliver a datagram that has been received into a buffer of m_bufferPool
+   *  \param datagram the datagram, which lies within \p buffer
+   */
+  void
+  receivePooledDatagram(const shared_ptr<ndn::Buffer>& buffer, span<const uint8_t> datagram);
+
+  /** \brief deliver \p element decoded from a datagram of \p datagramSize octets
+   */
+  void
+  receiveElement(bool isOk, const Block& element, size_t datagramSize);
+
+  void
+  asyncReceive();
+
+  /** \brief receive a batch of datagrams after the socket becomes readable
+   */
+  void
+  handleReadable(const boost::system::error_code& error);
+
+  /** \brief send queued packets in batches
+   */
+  void
+  flushSendQueue();
+
 protected:
   typename protocol::socket m_socket;
   typename protocol::endpoint m_sender;
+  shared_ptr<DatagramPump<protocol>> m_pump; ///< non-null if I/O is performed on an IoThread
 
   NFD_LOG_MEMBER_DECL();
 
 private:
   std::array<uint8_t, ndn::MAX_NDN_PACKET_SIZE> m_receiveBuffer;
+  unique_ptr<DatagramBufferPool> m_bufferPool; ///< non-null if datagrams are received into pooled buffers
+  shared_ptr<ndn::Buffer> m_pooledReceiveBuffer; ///< pooled buffer of the pending receive without batching
   bool m_hasRecentlyReceived;
+
+  typename protocol::socket* m_txSocket; ///< socket used for sending
+  std::optional<typename protocol::endpoint> m_txDestination; ///< if set, sending uses send_to
+
+  unique_ptr<DatagramBatchIo<protocol>> m_batchIo; ///< non-null if batching or segmentation offload is used
+  std::vector<Block> m_sendQueue;
+  bool m_isFlushPending = false;
+  bool m_isWaitingWritable = false;
 };
 
 
 template<class T, class U>
-DatagramTransport<T, U>::DatagramTransport(typename DatagramTransport::protocol::socket&& socket)
+DatagramTransport<T, U>::DatagramTransport(typename DatagramTransport::protocol::socket&& socket,
+                                           size_t batchSize, bool wantSegmentationOffload)
   : m_socket(std::move(socket))
   , m_hasRecentlyReceived(false)
+  , m_txSocket(&m_socket)
 {
   boost::asio::socket_base::send_buffer_size sendBufferSizeOption;
   boost::system::error_code error;
@@ -116,10 +195,70 @@ DatagramTransport<T, U>::DatagramTransport(typename DatagramTransport::protocol:
     this->setSendQueueCapacity(sendBufferSizeOption.value());
   }
 
-  m_socket.async_receive_from(boost::asio::buffer(m_receiveBuffer), m_sender,
-                              [this] (auto&&... args) {
-                                this->handleReceive(std::forward<decltype(args)>(args)...);
-                              });
+  if (auto pool = IoThreadPool::get(); pool != nullptr) {
+    m_pump = make_shared<DatagramPump<protocol>>(pool->next(), m_socket, pool->getRingCapacity(),
+                                                 batchSize, wantSegmentationOffload);
+    m_pump->start([this] (const auto& packet, const auto& sender) { receivePumpedPacket(packet, sender); },
+                  [this] (const auto& error) { processErrorCode(error); });
+    return;
+  }
+
+  if (batchSize > 1 || wantSegmentationOffload) {
+    m_batchIo = make_unique<DatagramBatchIo<protocol>>(batchSize);
+    if (wantSegmentationOffload) {
+      if (m_batchIo->enableSegmentationOffload(m_socket)) {
+        NFD_LOG_FACE_DEBUG("Segmentation offload: GSO=" << m_batchIo->isGsoEnabled() <<
+                           " GRO=" << m_batchIo->isGroEnabled());
+      }
+      else if (batchSize == 1) {
+        m_batchIo.reset();
+      }
+    }
+  }
+
+  if (size_t capacity = DatagramBufferPool::getTransportPoolCapacity(); capacity > 0) {
+    m_bufferPool = make_unique<DatagramBufferPool>(capacity, m_batchIo != nullptr ?
+                                                   m_batchIo->getReceiveBufferSize() :
+                                                   ndn::MAX_NDN_PACKET_SIZE);
+  }
+  asyncReceive();
+}
+
+template<class T, class U>
+void
+DatagramTransport<T, U>::setSendDestination(typename protocol::socket& socket,
+                                            const typename protocol::endpoint& destination)
+{
+  m_txSocket = &socket;
+  m_txDestination = destination;
+  if (m_pump != nullptr) {
+    m_pump->setSendSocket(socket, destination);
+  }
+}
+
+template<class T, class U>
+void
+DatagramTransport<T, U>::asyncReceive()
+{
+  if (m_batchIo != nullptr) {
+    m_socket.async_receive(boost::asio::null_buffers(),
+                           [this] (const auto& error, size_t) { this->handleReadable(error); });
+  }
+  else if (m_bufferPool != nullptr) {
+    if (m_pooledReceiveBuffer == nullptr) {
+      m_pooledReceiveBuffer = m_bufferPool->acquire();
+    }
+    m_socket.async_receive_from(boost::asio::buffer(*m_pooledReceiveBuffer), m_sender,
+                                [this] (auto&&... args) {
+                                  this->handleReceive(std::forward<decltype(args)>(args)...);
+                                });
+  }
+  else {
+    m_socket.async_receive_from(boost::asio::buffer(m_receiveBuffer), m_sender,
+                                [this] (auto&&... args) {
+                                  this->handleReceive(std::forward<decltype(args)>(args)...);
+                                });
+  }
 }
 
 template<class T, class U>
@@ -139,13 +278,7 @@ DatagramTransport<T, U>::doClose()
 {
   NFD_LOG_FACE_TRACE(__func__);
 
-  if (m_socket.is_open()) {
-    // Cancel all outstanding operations and close the socket.
-    // Use the non-throwing variants and ignore errors, if any.
-    boost::system::error_code error;
-    m_socket.cancel(error);
-    m_socket.close(error);
-  }
+  closeSocket();
 
   // Ensure that the Transport stays alive at least until
   // all pending handlers are dispatched
@@ -160,11 +293,102 @@ DatagramTransport<T, U>::doSend(const Block& packet)
 {
   NFD_LOG_FACE_TRACE(__func__);
 
-  m_socket.async_send(boost::asio::buffer(packet),
-                      // 'packet' is copied into the lambda to retain the underlying Buffer
-                      [this, packet] (auto&&... args) {
-                        this->handleSend(std::forward<decltype(args)>(args)...);
-                      });
+  if (m_pump != nullptr) {
+    if (!m_pump->send(packet)) {
+      ++this->nOutRingDrops;
+    }
+    this->nOutRingDepth.set(m_pump->getTxDepth());
+    return;
+  }
+
+  if (m_batchIo != nullptr) {
+    m_sendQueue.push_back(packet);
+    if (!m_isFlushPending && !m_isWaitingWritable) {
+      m_isFlushPending = true;
+      getGlobalIoService().post([this] { flushSendQueue(); });
+    }
+    return;
+  }
+
+  // 'packet' is copied into the lambda to retain the underlying Buffer
+  auto handler = [this, packet] (auto&&... args) {
+    this->handleSend(std::forward<decltype(args)>(args)...);
+  };
+  if (m_txDestination) {
+    m_txSocket->async_send_to(boost::asio::buffer(packet), *m_txDestination, std::move(handler));
+  }
+  else {
+    m_txSocket->async_send(boost::asio::buffer(packet), std::move(handler));
+  }
+}
+
+template<class T, class U>
+void
+DatagramTransport<T, U>::doSendGathered(const GatheredPacket& packet)
+{
+  if (m_pump != nullptr || m_batchIo != nullptr) {
+    // the send ring and the send queue hold contiguous packets
+    return Transport::doSendGathered(packet);
+  }
+
+  NFD_LOG_FACE_TRACE(__func__);
+
+  // both parts are written into one datagram with a single gathering send
+  std::array<boost::asio::const_buffer, 2> buffers{
+    boost::asio::buffer(packet.header.data(), packet.header.size()),
+    boost::asio::buffer(packet.payload.data(), packet.payload.size()),
+  };
+  // 'packet' is copied into the lambda to retain the underlying Buffers
+  auto handler = [this, packet] (auto&&... args) {
+    this->handleSend(std::forward<decltype(args)>(args)...);
+  };
+  if (m_txDestination) {
+    m_txSocket->async_send_to(buffers, *m_txDestination, std::move(handler));
+  }
+  else {
+    m_txSocket->async_send(buffers, std::move(handler));
+  }
+}
+
+template<class T, class U>
+void
+DatagramTransport<T, U>::flushSendQueue()
+{
+  m_isFlushPending = false;
+
+  size_t nDone = 0;
+  while (nDone < m_sendQueue.size() && m_txSocket->is_open()) {
+    boost::system::error_code error;
+    nDone += m_batchIo->send(*m_txSocket, ndn::make_span(m_sendQueue).subspan(nDone),
+                             m_txDestination ? &*m_txDestination : nullptr, error);
+    if (!error) {
+      continue;
+    }
+
+    if (error == boost::asio::error::would_block || error == boost::asio::error::try_again) {
+      m_isWaitingWritable = true;
+      m_txSocket->async_send(boost::asio::null_buffers(), [this] (const auto& error, size_t) {
+        m_isWaitingWritable = false;
+        if (error) {
+          m_sendQueue.clear();
+          return this->processErrorCode(error);
+        }
+        this->flushSendQueue();
+      });
+      break;
+    }
+
+    // the first unsent packet caused the error; skip it and carry on, unless the face fails
+    ++nDone;
+    processErrorCode(error);
+  }
+
+  if (m_txSocket->is_open()) {
+    m_sendQueue.erase(m_sendQueue.begin(), m_sendQueue.begin() + nDone);
+  }
+  else {
+    m_sendQueue.clear();
+  }
 }
 
 template<class T, class U>
@@ -178,12 +402,34 @@ DatagramTransport<T, U>::receiveDatagram(span<const uint8_t> buffer,
   NFD_LOG_FACE_TRACE("Received: " << buffer.size() << " bytes from " << m_sender);
 
   auto [isOk, element] = Block::fromBuffer(buffer);
+  receiveElement(isOk, element, buffer.size());
+}
+
+template<class T, class U>
+void
+DatagramTransport<T, U>::receivePooledDatagram(const shared_ptr<ndn::Buffer>& buffer,
+                                               span<const uint8_t> datagram)
+{
+  this->nInPoolHits.set(m_bufferPool->getNHits());
+  this->nInPoolMisses.set(m_bufferPool->getNMisses());
+
+  NFD_LOG_FACE_TRACE("Received: " << datagram.size() << " bytes from " << m_sender);
+
+  // the decoded element refers to the pooled buffer, which may extend beyond the datagram
+  auto [isOk, element] = Block::fromBuffer(buffer, static_cast<size_t>(datagram.data() - buffer->data()));
+  receiveElement(isOk, element, datagram.size());
+}
+
+template<class T, class U>
+void
+DatagramTransport<T, U>::receiveElement(bool isOk, const Block& element, size_t datagramSize)
+{
   if (!isOk) {
     NFD_LOG_FACE_WARN("Failed to parse incoming packet from " << m_sender);
     // This packet won't extend the face lifetime
     return;
   }
-  if (element.size() != buffer.size()) {
+  if (element.size() != datagramSize) {
     NFD_LOG_FACE_WARN("Received datagram size and decoded element size don't match");
     // This packet won't extend the face lifetime
     return;
@@ -193,17 +439,99 @@ DatagramTransport<T, U>::receiveDatagram(span<const uint8_t> buffer,
   this->receive(element, makeEndpointId(m_sender));
 }
 
+template<class T, class U>
+void
+DatagramTransport<T, U>::receivePumpedPacket(const Block& packet,
+                                             const typename protocol::endpoint& sender)
+{
+  m_sender = sender;
+  this->nInRingDrops.set(m_pump->getRxDrops());
+  this->nInRingDepth.set(m_pump->getRxDepth());
+
+  if (!packet.isValid()) {
+    NFD_LOG_FACE_WARN("Failed to parse incoming packet from " << m_sender);
+    // This packet won't extend the face lifetime
+    return;
+  }
+
+  NFD_LOG_FACE_TRACE("Received: " << packet.size() << " bytes from " << m_sender);
+  m_hasRecentlyReceived = true;
+  this->receive(packet, makeEndpointId(m_sender));
+}
+
+template<class T, class U>
+void
+DatagramTransport<T, U>::closeSocket()
+{
+  if (m_pump != nullptr) {
+    m_pump->stop();
+  }
+
+  if (m_socket.is_open()) {
+    // Cancel all outstanding operations and close the socket.
+    // Use the non-throwing variants and ignore errors, if any.
+    boost::system::error_code error;
+    m_socket.cancel(error);
+    m_socket.close(error);
+  }
+}
+
 template<class T, class U>
 void
 DatagramTransport<T, U>::handleReceive(const boost::system::error_code& error, size_t nBytesReceived)
 {
-  receiveDatagram(ndn::make_span(m_receiveBuffer).first(nBytesReceived), error);
+  if (m_bufferPool != nullptr) {
+    // the buffer now belongs to the received packet, if any
+    auto buffer = std::move(m_pooledReceiveBuffer);
+    if (error) {
+      processErrorCode(error);
+    }
+    else {
+      receivePooledDatagram(buffer, ndn::make_span(buffer->data(), nBytesReceived));
+    }
+  }
+  else {
+    receiveDatagram(ndn::make_span(m_receiveBuffer).first(nBytesReceived), error);
+  }
 
   if (m_socket.is_open())
-    m_socket.async_receive_from(boost::asio::buffer(m_receiveBuffer), m_sender,
-                                [this] (auto&&... args) {
-                                  this->handleReceive(std::forward<decltype(args)>(args)...);
-                                });
+    asyncReceive();
+}
+
+template<class T, class U>
+void
+DatagramTransport<T, U>::handleReadable(const boost::system::error_code& error)
+{
+  if (error) {
+    processErrorCode(error);
+  }
+  else {
+    boost::system::error_code recvError;
+    if (m_bufferPool != nullptr) {
+      recvError = m_batchIo->receive(m_socket, *m_bufferPool,
+                                     [this] (const auto& buffer, auto datagram, const auto& sender) {
+        if (m_socket.is_open()) {
+          m_sender = sender;
+          this->receivePooledDatagram(buffer, datagram);
+        }
+      });
+    }
+    else {
+      recvError = m_batchIo->receive(m_socket, [this] (auto datagram, const auto& sender) {
+        if (m_socket.is_open()) {
+          m_sender = sender;
+          this->receiveDatagram(datagram, {});
+        }
+      });
+    }
+    if (recvError && recvError != boost::asio::error::would_block &&
+        recvError != boost::asio::error::try_again) {
+      processErrorCode(recvError);
+    }
+  }
+
+  if (m_socket.is_open())
+    asyncReceive();
 }
 
 template<class T, class U>
@@ -0,0 +1,209 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "egress-scheduler.hpp"
+#include "common/global.hpp"
+#include "fw/scope-prefix.hpp"
+
+#include <cmath>
+
+namespace nfd::face {
+
+NFD_LOG_INIT(EgressScheduler);
+
+EgressScheduler::EgressScheduler(const Options& options, std::function<void(const Packet&)> send)
+  : m_options(options)
+  , m_send(std::move(send))
+  , m_queues(options.classes.size() + 2)
+  , m_tokens(static_cast<double>(options.burst))
+  , m_lastRefill(time::steady_clock::now())
+{
+  BOOST_ASSERT(m_options.rate > 0);
+  BOOST_ASSERT(m_options.burst > 0);
+
+  for (size_t i = 0; i < m_options.classes.size(); ++i) {
+    const auto& tc = m_options.classes[i];
+    m_queues[i + 1].quantum = QUANTUM * std::max<uint32_t>(tc.weight, 1);
+    for (const auto& prefix : tc.prefixes) {
+      m_prefixes.emplace_back(prefix, i + 1);
+    }
+  }
+  m_queues.back().quantum = QUANTUM * std::max<uint32_t>(m_options.defaultWeight, 1);
+}
+
+EgressScheduler::Verdict
+EgressScheduler::schedule(const Interest& interest)
+{
+  return scheduleImpl(interest, interest.getName(), interest.wireEncode().size());
+}
+
+EgressScheduler::Verdict
+EgressScheduler::schedule(const Data& data)
+{
+  return scheduleImpl(data, data.getName(), data.wireEncode().size());
+}
+
+EgressScheduler::Verdict
+EgressScheduler::schedule(const lp::Nack& nack)
+{
+  return scheduleImpl(nack, nack.getInterest().getName(), nack.getInterest().wireEncode().size());
+}
+
+template<typename Pkt>
+EgressScheduler::Verdict
+EgressScheduler::scheduleImpl(const Pkt& pkt, const Name& name, size_t size)
+{
+  refill();
+  if (m_nQueued == 0 && m_tokens >= std::min<double>(size, m_options.burst)) {
+    m_tokens -= size;
+    return Verdict::SEND;
+  }
+
+  size_t index = classify(name);
+  auto& queue = m_queues[index];
+  if (queue.packets.size() >= m_options.queueLimit) {
+    NFD_LOG_DEBUG("queue " << index << " full, drop " << name);
+    return Verdict::DROPPED;
+  }
+
+  queue.packets.push_back({pkt, size});
+  ++m_nQueued;
+  if (index > 0 && !queue.isActive) {
+    queue.isActive = true;
+    m_activeQueues.push_back(index);
+  }
+
+  // while packets are waiting, the refill timer is armed and will release them
+  if (!m_refillTimer) {
+    dequeue();
+  }
+  return Verdict::QUEUED;
+}
+
+size_t
+EgressScheduler::classify(const Name& name) const
+{
+  if (scope_prefix::LOCALHOST.isPrefixOf(name) || scope_prefix::LOCALHOP.isPrefixOf(name)) {
+    return 0;
+  }
+
+  size_t index = m_queues.size() - 1;
+  size_t matchLength = 0;
+  for (const auto& [prefix, i] : m_prefixes) {
+    if (prefix.size() >= matchLength && prefix.isPrefixOf(name)) {
+      index = i;
+      matchLength = prefix.size();
+    }
+  }
+  return index;
+}
+
+void
+EgressScheduler::refill()
+{
+  auto now = time::steady_clock::now();
+  auto elapsed = time::duration_cast<time::duration<double>>(now - m_lastRefill);
+  m_tokens = std::min(m_tokens + elapsed.count() * m_options.rate,
+                      static_cast<double>(m_options.burst));
+  m_lastRefill = now;
+}
+
+void
+EgressScheduler::dequeue()
+{
+  refill();
+
+  auto& management = m_queues.front();
+  while (!management.packets.empty()) {
+    if (!sendHead(0)) {
+      return;
+    }
+  }
+
+  while (!m_activeQueues.empty()) {
+    size_t index = m_activeQueues.front();
+    auto& queue = m_queues[index];
+    if (queue.packets.front().size > queue.deficit) {
+      // the queue has used up its share of this round
+      queue.deficit += queue.quantum;
+      m_activeQueues.pop_front();
+      m_activeQueues.push_back(index);
+      continue;
+    }
+
+    queue.deficit -= queue.packets.front().size;
+    if (!sendHead(index)) {
+      queue.deficit += queue.packets.front().size;
+      return;
+    }
+
+    if (queue.packets.empty()) {
+      queue.deficit = 0;
+      queue.isActive = false;
+      m_activeQueues.pop_front();
+    }
+  }
+}
+
+bool
+EgressScheduler::sendHead(size_t index)
+{
+  auto& queue = m_queues[index];
+  size_t size = queue.packets.front().size;
+  double shortage = std::min<double>(size, m_options.burst) - m_tokens;
+  if (shortage > 0) {
+    auto wait = time::nanoseconds(static_cast<time::nanoseconds::rep>(
+                  std::ceil(shortage * 1e9 / m_options.rate)));
+    getTimerWheel().schedule(m_refillTimer, std::max(wait, getTimerWheel().getGranularity()),
+                             [this] { dequeue(); });
+    return false;
+  }
+
+  m_tokens -= size;
+  Entry entry = std::move(queue.packets.front());
+  queue.packets.pop_front();
+  --m_nQueued;
+  m_send(entry.packet);
+  return true;
+}
+
+void
+EgressScheduler::flush()
+{
+  m_refillTimer.cancel();
+  for (auto& queue : m_queues) {
+    while (!queue.packets.empty()) {
+      Entry entry = std::move(queue.packets.front());
+      queue.packets.pop_front();
+      --m_nQueued;
+      m_send(entry.packet);
+    }
+    queue.deficit = 0;
+    queue.isActive = false;
+  }
+  m_activeQueues.clear();
+}
+
+} // namespace nfd::face
@@ -0,0 +1,198 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_EGRESS_SCHEDULER_HPP
+#define NFD_DAEMON_FACE_EGRESS_SCHEDULER_HPP
+
+#include "face-common.hpp"
+#include "common/timer-wheel.hpp"
+
+#include <ndn-cxx/lp/nack.hpp>
+
+#include <deque>
+#include <variant>
+
+namespace nfd::face {
+
+/**
+ * \brief Shapes and schedules the network-layer packets sent on a face
+ *
+ * Outgoing packets spend tokens from a token bucket that refills at a configured rate, which
+ * limits the throughput of the face to that rate after an initial burst. Packets that cannot be
+ * sent right away wait in per-class queues:
+ * \li management traffic under /localhost and /localhop has strict priority over other classes;
+ * \li every other packet belongs to the configured class with the longest matching prefix,
+ *     or to the default class, and the classes share the rate by Deficit Round Robin
+ *     in proportion to their weights.
+ */
+class EgressScheduler : noncopyable
+{
+public:
+  /** \brief a class of traffic sharing a queue
+   */
+  struct TrafficClass
+  {
+    std::string name;
+    std::vector<Name> prefixes;
+    uint32_t weight = 1;
+  };
+
+  struct Options
+  {
+    /** \brief rate of the token bucket in octets per second
+     */
+    uint64_t rate = 0;
+
+    /** \brief depth of the token bucket in octets, which must fit the largest packet
+     */
+    size_t burst = 64 * 1024;
+
+    /** \brief maximum number of packets waiting in each class; packets beyond it are dropped
+     */
+    size_t queueLimit = 1000;
+
+    /** \brief weight of the default class
+     */
+    uint32_t defaultWeight = 1;
+
+    std::vector<TrafficClass> classes;
+  };
+
+  using Packet = std::variant<Interest, Data, lp::Nack>;
+
+  /** \brief decision about a packet given to the scheduler
+   */
+  enum class Verdict {
+    SEND,    ///< the caller should send the packet right away
+    QUEUED,  ///< the packet is queued and will be passed to the send callback later
+    DROPPED, ///< the packet is dropped because its class queue is full
+  };
+
+  /** \brief octets that a class of weight 1 may send in each round
+   */
+  static constexpr size_t QUANTUM = 1500;
+
+  /** \param options scheduler options, where \p options.rate must be positive
+   *  \param send callback that sends a packet released from a queue
+   */
+  EgressScheduler(const Options& options, std::function<void(const Packet&)> send);
+
+  const Options&
+  getOptions() const
+  {
+    return m_options;
+  }
+
+  Verdict
+  schedule(const Interest& interest);
+
+  Verdict
+  schedule(const Data& data);
+
+  Verdict
+  schedule(const lp::Nack& nack);
+
+  /** \brief passes all queued packets to the send callback regardless of the token bucket
+   */
+  void
+  flush();
+
+  /** \return number of packets waiting in all queues
+   */
+  size_t
+  size() const
+  {
+    return m_nQueued;
+  }
+
+NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /** \return index of the queue of packets under \p name,
+   *          where 0 is the management queue and the last one is the default class
+   */
+  size_t
+  classify(const Name& name) const;
+
+  /** \return number of packets waiting in queue \p index
+   */
+  size_t
+  getQueueLength(size_t index) const
+  {
+    return m_queues.at(index).packets.size();
+  }
+
+private:
+  template<typename Pkt>
+  Verdict
+  scheduleImpl(const Pkt& pkt, const Name& name, size_t size);
+
+  /** \brief adds the tokens earned since the last refill
+   */
+  void
+  refill();
+
+  /** \brief sends queued packets while tokens suffice, then waits for the bucket to refill
+   */
+  void
+  dequeue();
+
+  /** \brief sends the head packet of queue \p index if the token bucket allows it
+   *  \retval false the token bucket does not have enough tokens
+   */
+  bool
+  sendHead(size_t index);
+
+private:
+  struct Entry
+  {
+    Packet packet;
+    size_t size;
+  };
+
+  struct Queue
+  {
+    std::deque<Entry> packets;
+    size_t quantum = QUANTUM;
+    size_t deficit = 0;
+    bool isActive = false; ///< whether the queue is in the round-robin list
+  };
+
+  Options m_options;
+  std::function<void(const Packet&)> m_send;
+
+  /** \brief prefixes of configured classes and the indices of their queues
+   */
+  std::vector<std::pair<Name, size_t>> m_prefixes;
+  std::vector<Queue> m_queues;
+  std::deque<size_t> m_activeQueues;
+  size_t m_nQueued = 0;
+
+  double m_tokens;
+  time::steady_clock::TimePoint m_lastRefill;
+  TimerWheel::Timer m_refillTimer;
+};
+
+} // namespace nfd::face
+
+#endif // NFD_DAEMON_FACE_EGRESS_SCHEDULER_HPP
@@ -38,12 +38,14 @@ namespace nfd::face {
 NFD_LOG_INIT(EthernetChannel);
 
 EthernetChannel::EthernetChannel(shared_ptr<const ndn::net::NetworkInterface> localEndpoint,
-                                 time::nanoseconds idleTimeout)
+                                 time::nanoseconds idleTimeout,
+                                 EthernetBackend backend)
   : m_localEndpoint(std::move(localEndpoint))
   , m_isListening(false)
   , m_socket(getGlobalIoService())
   , m_pcap(m_localEndpoint->getName())
   , m_idleFaceTimeout(idleTimeout)
+  , m_backend(backend)
 #ifdef _DEBUG
   , m_nDropped(0)
 #endif
@@ -84,14 +86,38 @@ EthernetChannel::listen(const FaceCreatedCallback& onFaceCreated,
   }
   m_isListening = true;
 
-  try {
-    m_pcap.activate(DLT_EN10MB);
-    m_socket.assign(m_pcap.getFd());
+  if (m_backend == EthernetBackend::XDP) {
+#ifdef NFD_HAVE_AF_XDP
+    try {
+      m_xdp = XdpSocket::open(m_localEndpoint->getName(), m_localEndpoint->getIndex());
+      m_socket.assign(m_xdp->getFd());
+    }
+    catch (const XdpSocket::Error& e) {
+      NDN_THROW_NESTED(Error(e.what()));
+    }
+    // frames from peers that already have a face are claimed by their transports,
+    // the remaining frames addressed to this host come from new peers, see updateFilter()
+    m_xdpSubscription = m_xdp->subscribe([=] (auto frame) {
+      if (frame.size() >= ethernet::HDR_LEN &&
+          ethernet::Address(frame.data()) == m_localEndpoint->getEthernetAddress()) {
+        handleFrame(frame, onFaceCreated, onFaceCreationFailed);
+      }
+      return true;
+    }, true);
+#else
+    NDN_THROW(Error("The xdp backend is not available on this platform"));
+#endif
   }
-  catch (const PcapHelper::Error& e) {
-    NDN_THROW_NESTED(Error(e.what()));
+  else {
+    try {
+      m_pcap.activate(DLT_EN10MB);
+      m_socket.assign(m_pcap.getFd());
+    }
+    catch (const PcapHelper::Error& e) {
+      NDN_THROW_NESTED(Error(e.what()));
+    }
+    updateFilter();
   }
-  updateFilter();
 
   asyncRead(onFaceCreated, onFaceCreationFailed);
   NFD_LOG_CHAN_DEBUG("Started listening");
@@ -119,21 +145,21 @@ EthernetChannel::handleRead(const boost::system::error_code& error,
     return;
   }
 
+#ifdef NFD_HAVE_AF_XDP
+  if (m_xdp != nullptr) {
+    // frames are offered to every transport that shares the socket, then to this channel
+    m_xdp->receive();
+    asyncRead(onFaceCreated, onReceiveFailed);
+    return;
+  }
+#endif
+
   auto [pkt, readErr] = m_pcap.readNextPacket();
   if (pkt.empty()) {
     NFD_LOG_CHAN_WARN("Read error: " << readErr);
   }
   else {
-    auto [eh, frameErr] = ethernet::checkFrameHeader(pkt, m_localEndpoint->getEthernetAddress(),
-                                                     m_localEndpoint->getEthernetAddress());
-    if (eh == nullptr) {
-      NFD_LOG_CHAN_DEBUG(frameErr);
-    }
-    else {
-      ethernet::Address sender(eh->ether_shost);
-      pkt = pkt.subspan(ethernet::HDR_LEN);
-      processIncomingPacket(pkt, sender, onFaceCreated, onReceiveFailed);
-    }
+    handleFrame(pkt, onFaceCreated, onReceiveFailed);
   }
 
 #ifdef _DEBUG
@@ -146,6 +172,22 @@ EthernetChannel::handleRead(const boost::system::error_code& error,
   asyncRead(onFaceCreated, onReceiveFailed);
 }
 
+void
+EthernetChannel::handleFrame(span<const uint8_t> frame,
+                             const FaceCreatedCallback& onFaceCreated,
+                             const FaceCreationFailedCallback& onReceiveFailed)
+{
+  auto [eh, frameErr] = ethernet::checkFrameHeader(frame, m_localEndpoint->getEthernetAddress(),
+                                                   m_localEndpoint->getEthernetAddress());
+  if (eh == nullptr) {
+    NFD_LOG_CHAN_DEBUG(frameErr);
+    return;
+  }
+
+  ethernet::Address sender(eh->ether_shost);
+  processIncomingPacket(frame.subspan(ethernet::HDR_LEN), sender, onFaceCreated, onReceiveFailed);
+}
+
 void
 EthernetChannel::processIncomingPacket(span<const uint8_t> packet,
                                        const ethernet::Address& sender,
@@ -200,7 +242,8 @@ EthernetChannel::createFace(const ethernet::Address& remoteEndpoint,
 
   auto linkService = make_unique<GenericLinkService>(options);
   auto transport = make_unique<UnicastEthernetTransport>(*m_localEndpoint, remoteEndpoint,
-                                                         params.persistency, m_idleFaceTimeout);
+                                                         params.persistency, m_idleFaceTimeout,
+                                                         m_backend);
   auto face = make_shared<Face>(std::move(linkService), std::move(transport));
   face->setChannel(weak_from_this());
 
@@ -217,7 +260,7 @@ EthernetChannel::createFace(const ethernet::Address& remoteEndpoint,
 void
 EthernetChannel::updateFilter()
 {
-  if (!isListening())
+  if (!isListening() || m_backend == EthernetBackend::XDP)
     return;
 
   std::string filter = "(ether proto " + to_string(ethernet::ETHERTYPE_NDN) +
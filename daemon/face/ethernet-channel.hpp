@@ -28,6 +28,7 @@
 
 #include "channel.hpp"
 #include "ethernet-protocol.hpp"
+#include "ethernet-transport.hpp"
 #include "pcap-helper.hpp"
 
 #include <boost/asio/posix/stream_descriptor.hpp>
@@ -59,9 +60,14 @@ public:
    *
    * To enable creation of faces upon incoming connections,
    * one needs to explicitly call EthernetChannel::listen method.
+   *
+   * \param backend backend of the transports of faces created by this channel; the channel
+   *                itself listens through the XDP socket of its faces if \p backend is XDP,
+   *                and through libpcap otherwise
    */
   EthernetChannel(shared_ptr<const ndn::net::NetworkInterface> localEndpoint,
-                  time::nanoseconds idleTimeout);
+                  time::nanoseconds idleTimeout,
+                  EthernetBackend backend = EthernetBackend::PCAP);
 
   bool
   isListening() const final
@@ -110,6 +116,11 @@ private:
              const FaceCreatedCallback& onFaceCreated,
              const FaceCreationFailedCallback& onReceiveFailed);
 
+  void
+  handleFrame(span<const uint8_t> frame,
+              const FaceCreatedCallback& onFaceCreated,
+              const FaceCreationFailedCallback& onReceiveFailed);
+
   void
   processIncomingPacket(span<const uint8_t> packet,
                         const ethernet::Address& sender,
@@ -130,6 +141,12 @@ private:
   PcapHelper m_pcap;
   std::map<ethernet::Address, shared_ptr<Face>> m_channelFaces;
   const time::nanoseconds m_idleFaceTimeout; ///< Timeout for automatic closure of idle on-demand faces
+  const EthernetBackend m_backend;
+#ifdef NFD_HAVE_AF_XDP
+  shared_ptr<XdpSocket> m_xdp; ///< non-null if listening with the XDP backend
+  /// receives the frames that are not claimed by any face
+  XdpSocket::Subscription m_xdpSubscription;
+#endif
 
 #ifdef _DEBUG
   /// number of frames dropped by the kernel, as reported by libpcap
@@ -57,6 +57,7 @@ EthernetFactory::doProcessConfig(OptionalConfigSection configSection,
 {
   // ether
   // {
+  //   backend pcap
   //   listen yes
   //   idle_timeout 600
   //   mcast yes
@@ -71,6 +72,7 @@ EthernetFactory::doProcessConfig(OptionalConfigSection configSection,
   //   }
   // }
 
+  EthernetBackend backend = EthernetBackend::PCAP;
   UnicastConfig unicastConfig;
   MulticastConfig mcastConfig;
 
@@ -82,7 +84,30 @@ EthernetFactory::doProcessConfig(OptionalConfigSection configSection,
       const std::string& key = pair.first;
       const ConfigSection& value = pair.second;
 
-      if (key == "listen") {
+      if (key == "backend") {
+        const std::string& valueStr = value.get_value<std::string>();
+        if (valueStr == "pcap") {
+          backend = EthernetBackend::PCAP;
+        }
+        else if (valueStr == "packet_ring") {
+#ifdef __linux__
+          backend = EthernetBackend::PACKET_RING;
+#else
+          NDN_THROW(ConfigFile::Error("face_system.ether.backend: 'packet_ring' is only available on Linux"));
+#endif
+        }
+        else if (valueStr == "xdp") {
+#ifdef NFD_HAVE_AF_XDP
+          backend = EthernetBackend::XDP;
+#else
+          NDN_THROW(ConfigFile::Error("face_system.ether.backend: 'xdp' is not available on this platform"));
+#endif
+        }
+        else {
+          NDN_THROW(ConfigFile::Error("face_system.ether.backend: '" + valueStr + "' is not supported"));
+        }
+      }
+      else if (key == "listen") {
         unicastConfig.wantListen = ConfigFile::parseYesNo(pair, "face_system.ether");
       }
       else if (key == "idle_timeout") {
@@ -123,6 +148,13 @@ EthernetFactory::doProcessConfig(OptionalConfigSection configSection,
     return;
   }
 
+  if (m_backend != backend) {
+    NFD_LOG_INFO("changing backend from " << m_backend << " to " << backend);
+    if (!m_channels.empty() || !m_mcastFaces.empty()) {
+      NFD_LOG_WARN("Backend setting applies to new Ethernet channels and faces only");
+    }
+  }
+
   if (unicastConfig.isEnabled) {
     if (m_unicastConfig.wantListen && !unicastConfig.wantListen && !m_channels.empty()) {
       NFD_LOG_WARN("Cannot stop listening on Ethernet channels");
@@ -158,6 +190,7 @@ EthernetFactory::doProcessConfig(OptionalConfigSection configSection,
 
   // Even if there's no configuration change, we still need to re-apply configuration because
   // netifs may have changed.
+  m_backend = backend;
   m_unicastConfig = unicastConfig;
   m_mcastConfig = mcastConfig;
   this->applyConfig(context);
@@ -222,7 +255,7 @@ EthernetFactory::createChannel(const shared_ptr<const ndn::net::NetworkInterface
   if (it != m_channels.end())
     return it->second;
 
-  auto channel = std::make_shared<EthernetChannel>(localEndpoint, idleTimeout);
+  auto channel = std::make_shared<EthernetChannel>(localEndpoint, idleTimeout, m_backend);
   m_channels[localEndpoint->getName()] = channel;
   return channel;
 }
@@ -250,7 +283,8 @@ EthernetFactory::createMulticastFace(const ndn::net::NetworkInterface& netif,
   opts.allowReassembly = true;
 
   auto linkService = make_unique<GenericLinkService>(opts);
-  auto transport = make_unique<MulticastEthernetTransport>(netif, address, m_mcastConfig.linkType);
+  auto transport = make_unique<MulticastEthernetTransport>(netif, address, m_mcastConfig.linkType,
+                                                           m_backend);
   auto face = make_shared<Face>(std::move(linkService), std::move(transport));
 
   m_mcastFaces[key] = face;
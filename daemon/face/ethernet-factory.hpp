@@ -50,6 +50,8 @@ public:
    *
    * \return always a valid pointer to a EthernetChannel object, an exception
    *         is thrown if it cannot be created.
+   * The unicast faces of the channel use the backend selected in face_system.ether.
+   *
    * \throw PcapHelper::Error channel creation failed
    */
   shared_ptr<EthernetChannel>
@@ -104,6 +106,8 @@ private:
 private:
   std::map<std::string, shared_ptr<EthernetChannel>> m_channels; ///< ifname => channel
 
+  EthernetBackend m_backend = EthernetBackend::PCAP;
+
   struct UnicastConfig
   {
     bool isEnabled = false;
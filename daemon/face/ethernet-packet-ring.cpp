@@ -0,0 +1,227 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ethernet-packet-ring.hpp"
+#include "ethernet-protocol.hpp"
+
+#include "common/privilege-helper.hpp"
+
+#include <pcap/pcap.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include <linux/filter.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <boost/endian/conversion.hpp>
+
+#if !defined(PCAP_NETMASK_UNKNOWN)
+#define PCAP_NETMASK_UNKNOWN  0xffffffff
+#endif
+
+namespace nfd::face {
+
+/// offset of the frame data within a transmit slot
+static constexpr size_t TX_DATA_OFFSET = TPACKET_ALIGN(sizeof(tpacket3_hdr));
+
+PacketRing::PacketRing(const std::string& interfaceName, int interfaceIndex)
+{
+  auto fail = [&] (const std::string& what) {
+    int errorCode = errno;
+    if (m_map != nullptr) {
+      ::munmap(m_map, m_mapSize);
+    }
+    if (m_fd >= 0) {
+      ::close(m_fd);
+    }
+    NDN_THROW(Error(what + " on " + interfaceName + ": " + std::strerror(errorCode)));
+  };
+
+  // the socket receives nothing until it is bound, after the rings have been set up
+  PrivilegeHelper::runElevated([this] {
+    m_fd = ::socket(AF_PACKET, SOCK_RAW, 0);
+  });
+  if (m_fd < 0) {
+    fail("socket(AF_PACKET)");
+  }
+
+  int version = TPACKET_V3;
+  if (::setsockopt(m_fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0) {
+    fail("setsockopt(PACKET_VERSION)");
+  }
+
+  tpacket_req3 rxReq{};
+  rxReq.tp_block_size = RX_BLOCK_SIZE;
+  rxReq.tp_block_nr = RX_BLOCK_COUNT;
+  rxReq.tp_frame_size = TPACKET_ALIGNMENT << 7;
+  rxReq.tp_frame_nr = RX_BLOCK_SIZE / rxReq.tp_frame_size * RX_BLOCK_COUNT;
+  rxReq.tp_retire_blk_tov = RX_BLOCK_TIMEOUT;
+  if (::setsockopt(m_fd, SOL_PACKET, PACKET_RX_RING, &rxReq, sizeof(rxReq)) < 0) {
+    fail("setsockopt(PACKET_RX_RING)");
+  }
+
+  // a TPACKET_V3 transmit ring (Linux 4.11+) consists of fixed-size slots, like TPACKET_V2
+  tpacket_req3 txReq{};
+  txReq.tp_block_size = TX_FRAME_SIZE * 4;
+  txReq.tp_block_nr = TX_FRAME_COUNT / 4;
+  txReq.tp_frame_size = TX_FRAME_SIZE;
+  txReq.tp_frame_nr = TX_FRAME_COUNT;
+  if (::setsockopt(m_fd, SOL_PACKET, PACKET_TX_RING, &txReq, sizeof(txReq)) < 0) {
+    fail("setsockopt(PACKET_TX_RING)");
+  }
+
+  // receive rings precede transmit rings in the mapping
+  m_mapSize = RX_BLOCK_SIZE * RX_BLOCK_COUNT + TX_FRAME_SIZE * TX_FRAME_COUNT;
+  void* map = ::mmap(nullptr, m_mapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_LOCKED, m_fd, 0);
+  if (map == MAP_FAILED) {
+    // locking the mapping may exceed RLIMIT_MEMLOCK
+    map = ::mmap(nullptr, m_mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+  }
+  if (map == MAP_FAILED) {
+    fail("mmap");
+  }
+  m_map = static_cast<uint8_t*>(map);
+  m_txRing = m_map + RX_BLOCK_SIZE * RX_BLOCK_COUNT;
+
+#ifdef PACKET_IGNORE_OUTGOING
+  // optional (Linux 4.20+), outgoing frames are otherwise skipped by receive()
+  int one = 1;
+  ::setsockopt(m_fd, SOL_PACKET, PACKET_IGNORE_OUTGOING, &one, sizeof(one));
+#endif
+
+  sockaddr_ll sll{};
+  sll.sll_family = AF_PACKET;
+  sll.sll_protocol = boost::endian::native_to_big(ethernet::ETHERTYPE_NDN);
+  sll.sll_ifindex = interfaceIndex;
+  if (::bind(m_fd, reinterpret_cast<sockaddr*>(&sll), sizeof(sll)) < 0) {
+    fail("bind");
+  }
+}
+
+PacketRing::~PacketRing()
+{
+  ::munmap(m_map, m_mapSize);
+  ::close(m_fd);
+}
+
+int
+PacketRing::getFd() const
+{
+  int fd = ::dup(m_fd);
+  if (fd < 0) {
+    NDN_THROW(Error("dup: "s + std::strerror(errno)));
+  }
+  return fd;
+}
+
+void
+PacketRing::setPacketFilter(const char* filter) const
+{
+  pcap_t* dead = pcap_open_dead(DLT_EN10MB, ethernet::HDR_LEN + ndn::MAX_NDN_PACKET_SIZE);
+  if (dead == nullptr) {
+    NDN_THROW(Error("pcap_open_dead failed"));
+  }
+
+  bpf_program prog;
+  if (pcap_compile(dead, &prog, filter, 1, PCAP_NETMASK_UNKNOWN) < 0) {
+    std::string what = "pcap_compile: "s + pcap_geterr(dead);
+    pcap_close(dead);
+    NDN_THROW(Error(what));
+  }
+  pcap_close(dead);
+
+  // struct bpf_insn of libpcap has the same layout as struct sock_filter of the kernel
+  sock_fprog fprog{};
+  fprog.len = static_cast<unsigned short>(prog.bf_len);
+  fprog.filter = reinterpret_cast<sock_filter*>(prog.bf_insns);
+  int ret = ::setsockopt(m_fd, SOL_SOCKET, SO_ATTACH_FILTER, &fprog, sizeof(fprog));
+  int errorCode = errno;
+  pcap_freecode(&prog);
+  if (ret < 0) {
+    NDN_THROW(Error("setsockopt(SO_ATTACH_FILTER): "s + std::strerror(errorCode)));
+  }
+}
+
+uint8_t*
+PacketRing::getTxFrame(size_t frameSize)
+{
+  BOOST_ASSERT(frameSize <= getMaxFrameSize());
+
+  auto hdr = reinterpret_cast<tpacket3_hdr*>(m_txRing + m_txFrame * TX_FRAME_SIZE);
+  auto status = __atomic_load_n(&hdr->tp_status, __ATOMIC_ACQUIRE);
+  // a frame that the kernel has rejected (TP_STATUS_WRONG_FORMAT) is dropped, its slot is reused
+  if (status == TP_STATUS_SEND_REQUEST || status == TP_STATUS_SENDING) {
+    return nullptr;
+  }
+
+  m_txFrameSize = frameSize;
+  return reinterpret_cast<uint8_t*>(hdr) + TX_DATA_OFFSET;
+}
+
+void
+PacketRing::commitTxFrame()
+{
+  auto hdr = reinterpret_cast<tpacket3_hdr*>(m_txRing + m_txFrame * TX_FRAME_SIZE);
+  hdr->tp_len = static_cast<uint32_t>(m_txFrameSize);
+  hdr->tp_snaplen = static_cast<uint32_t>(m_txFrameSize);
+  hdr->tp_next_offset = 0;
+  __atomic_store_n(&hdr->tp_status, TP_STATUS_SEND_REQUEST, __ATOMIC_RELEASE);
+
+  m_txFrame = (m_txFrame + 1) % TX_FRAME_COUNT;
+  ++m_nUnflushed;
+}
+
+int
+PacketRing::flush()
+{
+  m_nUnflushed = 0;
+  if (::sendto(m_fd, nullptr, 0, MSG_DONTWAIT, nullptr, 0) < 0) {
+    return errno;
+  }
+  return 0;
+}
+
+size_t
+PacketRing::getMaxFrameSize() const noexcept
+{
+  return TX_FRAME_SIZE - TX_DATA_OFFSET;
+}
+
+size_t
+PacketRing::getNDropped()
+{
+  // the kernel resets its statistics whenever they are read
+  tpacket_stats_v3 stats{};
+  socklen_t len = sizeof(stats);
+  if (::getsockopt(m_fd, SOL_PACKET, PACKET_STATISTICS, &stats, &len) == 0) {
+    m_nDropped += stats.tp_drops;
+  }
+  return m_nDropped;
+}
+
+} // namespace nfd::face
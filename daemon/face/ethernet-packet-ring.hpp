@@ -0,0 +1,184 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_ETHERNET_PACKET_RING_HPP
+#define NFD_DAEMON_FACE_ETHERNET_PACKET_RING_HPP
+
+#include "core/common.hpp"
+
+#ifndef __linux__
+#error "Cannot include this file when AF_PACKET sockets are not available"
+#endif
+
+#include <linux/if_packet.h>
+
+namespace nfd::face {
+
+/**
+ * @brief An AF_PACKET socket with TPACKET_V3 receive and transmit rings mapped into memory.
+ *
+ * The kernel fills receive blocks of many frames each, and hands a whole block to userspace
+ * when it is full or when its retire timeout expires; receive() processes every block that is
+ * ready, without any system call. Frames to transmit are written into the transmit ring
+ * directly, and flush() asks the kernel to send all of them with one system call.
+ *
+ * The socket only receives frames with the NDN EtherType that arrive on the interface; frames
+ * sent by this host and frames with a VLAN tag are ignored. A BPF filter can narrow this further.
+ */
+class PacketRing : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  /// size of each receive block
+  static constexpr size_t RX_BLOCK_SIZE = 1 << 18;
+  /// number of receive blocks, which together hold as much as the libpcap buffer
+  static constexpr size_t RX_BLOCK_COUNT = 16;
+  /// maximum time, in milliseconds, that a partially filled receive block is held by the kernel
+  static constexpr unsigned RX_BLOCK_TIMEOUT = 1;
+  /// size of each transmit frame slot, which fits an Ethernet header and a maximum-size packet
+  static constexpr size_t TX_FRAME_SIZE = 1 << 14;
+  /// number of transmit frame slots
+  static constexpr size_t TX_FRAME_COUNT = 128;
+
+  /**
+   * @brief Open the socket on an interface and map its rings.
+   * @throw Error on any error
+   */
+  PacketRing(const std::string& interfaceName, int interfaceIndex);
+
+  ~PacketRing();
+
+  /**
+   * @brief Obtain a duplicate of the socket file descriptor, which becomes readable when a
+   *        receive block is ready. It is the caller's responsibility to close the fd.
+   */
+  int
+  getFd() const;
+
+  /**
+   * @brief Install a BPF filter on the socket.
+   * @param filter Null-terminated string containing the BPF program source, see pcap-filter(7)
+   * @throw Error on any error
+   */
+  void
+  setPacketFilter(const char* filter) const;
+
+  /**
+   * @brief Invoke @p onFrame on each received frame, including its Ethernet header,
+   *        and return the receive blocks to the kernel.
+   *
+   * @p onFrame is invoked as `onFrame(span<const uint8_t> frame)`. The frame is valid only
+   * until @p onFrame returns.
+   * @return number of frames received
+   */
+  template<typename Callback>
+  size_t
+  receive(Callback&& onFrame);
+
+  /**
+   * @brief Obtain the next free transmit slot for a frame of @p frameSize octets.
+   * @return pointer to where the frame must be written, or nullptr if the transmit ring is full
+   * @pre frameSize <= getMaxFrameSize()
+   */
+  uint8_t*
+  getTxFrame(size_t frameSize);
+
+  /**
+   * @brief Queue the frame written into the slot returned by the last getTxFrame().
+   */
+  void
+  commitTxFrame();
+
+  /**
+   * @brief Ask the kernel to send every queued frame, without blocking.
+   * @return errno of the failed system call, or 0 on success
+   */
+  int
+  flush();
+
+  /// number of queued frames that have not been flushed
+  size_t
+  getNUnflushedFrames() const noexcept
+  {
+    return m_nUnflushed;
+  }
+
+  size_t
+  getMaxFrameSize() const noexcept;
+
+  /**
+   * @brief Get the number of frames dropped by the kernel because the receive ring was full.
+   */
+  size_t
+  getNDropped();
+
+private:
+  int m_fd = -1;
+  uint8_t* m_map = nullptr;
+  size_t m_mapSize = 0;
+  uint8_t* m_txRing = nullptr;
+  size_t m_rxBlock = 0; ///< index of the next receive block to process
+  size_t m_txFrame = 0; ///< index of the next transmit slot
+  size_t m_txFrameSize = 0; ///< size of the frame written into the slot returned by getTxFrame()
+  size_t m_nUnflushed = 0;
+  size_t m_nDropped = 0;
+};
+
+template<typename Callback>
+size_t
+PacketRing::receive(Callback&& onFrame)
+{
+  size_t nFrames = 0;
+  while (true) {
+    auto block = reinterpret_cast<tpacket_block_desc*>(m_map + m_rxBlock * RX_BLOCK_SIZE);
+    if ((__atomic_load_n(&block->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER) == 0) {
+      break;
+    }
+
+    auto frame = reinterpret_cast<const uint8_t*>(block) + block->hdr.bh1.offset_to_first_pkt;
+    for (uint32_t i = 0; i < block->hdr.bh1.num_pkts; ++i) {
+      auto hdr = reinterpret_cast<const tpacket3_hdr*>(frame);
+      auto sll = reinterpret_cast<const sockaddr_ll*>(frame + TPACKET_ALIGN(sizeof(tpacket3_hdr)));
+      if (sll->sll_pkttype != PACKET_OUTGOING && (hdr->tp_status & TP_STATUS_VLAN_VALID) == 0) {
+        ++nFrames;
+        onFrame(span<const uint8_t>(frame + hdr->tp_mac, hdr->tp_snaplen));
+      }
+      frame += hdr->tp_next_offset;
+    }
+
+    __atomic_store_n(&block->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+    m_rxBlock = (m_rxBlock + 1) % RX_BLOCK_COUNT;
+  }
+  return nFrames;
+}
+
+} // namespace nfd::face
+
+#endif // NFD_DAEMON_FACE_ETHERNET_PACKET_RING_HPP
@@ -37,24 +37,75 @@ namespace nfd::face {
 
 NFD_LOG_INIT(EthernetTransport);
 
+std::ostream&
+operator<<(std::ostream& os, EthernetBackend backend)
+{
+  switch (backend) {
+    case EthernetBackend::PCAP:
+      return os << "pcap";
+    case EthernetBackend::PACKET_RING:
+      return os << "packet_ring";
+    case EthernetBackend::XDP:
+      return os << "xdp";
+  }
+  return os << "none";
+}
+
 EthernetTransport::EthernetTransport(const ndn::net::NetworkInterface& localEndpoint,
-                                     const ethernet::Address& remoteEndpoint)
+                                     const ethernet::Address& remoteEndpoint,
+                                     EthernetBackend backend)
   : m_socket(getGlobalIoService())
   , m_pcap(localEndpoint.getName())
   , m_srcAddress(localEndpoint.getEthernetAddress())
   , m_destAddress(remoteEndpoint)
   , m_interfaceName(localEndpoint.getName())
+  , m_backend(backend)
   , m_hasRecentlyReceived(false)
 #ifdef _DEBUG
   , m_nDropped(0)
 #endif
 {
-  try {
-    m_pcap.activate(DLT_EN10MB);
-    m_socket.assign(m_pcap.getFd());
+  std::copy(m_destAddress.begin(), m_destAddress.end(), m_frameHeader.begin());
+  std::copy(m_srcAddress.begin(), m_srcAddress.end(), m_frameHeader.begin() + ethernet::ADDR_LEN);
+  uint16_t ethertype = boost::endian::native_to_big(ethernet::ETHERTYPE_NDN);
+  std::memcpy(m_frameHeader.data() + 2 * ethernet::ADDR_LEN, &ethertype, ethernet::TYPE_LEN);
+
+  if (backend == EthernetBackend::PACKET_RING) {
+#ifdef __linux__
+    try {
+      m_ring = make_unique<PacketRing>(localEndpoint.getName(), localEndpoint.getIndex());
+      m_socket.assign(m_ring->getFd());
+    }
+    catch (const PacketRing::Error& e) {
+      NDN_THROW_NESTED(Error(e.what()));
+    }
+#else
+    NDN_THROW(Error("The packet_ring backend is only available on Linux"));
+#endif
   }
-  catch (const PcapHelper::Error& e) {
-    NDN_THROW_NESTED(Error(e.what()));
+  else if (backend == EthernetBackend::XDP) {
+#ifdef NFD_HAVE_AF_XDP
+    try {
+      m_xdp = XdpSocket::open(localEndpoint.getName(), localEndpoint.getIndex());
+      m_socket.assign(m_xdp->getFd());
+    }
+    catch (const XdpSocket::Error& e) {
+      NDN_THROW_NESTED(Error(e.what()));
+    }
+    m_xdpSubscription = m_xdp->subscribe([this] (auto frame) { return claimFrame(frame); });
+#else
+    NDN_THROW(Error("The xdp backend is not available on this platform"));
+#endif
+  }
+  else {
+    try {
+      m_pcap.activate(DLT_EN10MB);
+      m_socket.assign(m_pcap.getFd());
+      m_txBatch = make_unique<EthernetTxBatch>(m_pcap);
+    }
+    catch (const PcapHelper::Error& e) {
+      NDN_THROW_NESTED(Error(e.what()));
+    }
   }
 
   // Set initial transport state based upon the state of the underlying NetworkInterface
@@ -67,7 +118,7 @@ EthernetTransport::EthernetTransport(const ndn::net::NetworkInterface& localEndp
 
   m_netifMtuChangedConn = localEndpoint.onMtuChanged.connect(
     [this] (uint32_t, uint32_t mtu) {
-      setMtu(mtu);
+      setMtu(computeMtu(mtu));
     });
 
   asyncRead();
@@ -86,6 +137,7 @@ EthernetTransport::doClose()
     m_socket.close(error);
   }
   m_pcap.close();
+  // m_ring and m_xdp stay mapped until destruction, as frames may be processed in this round
 
   // Ensure that the Transport stays alive at least
   // until all pending handlers are dispatched
@@ -94,6 +146,34 @@ EthernetTransport::doClose()
   });
 }
 
+void
+EthernetTransport::setPacketFilter(const char* filter) const
+{
+#ifdef NFD_HAVE_AF_XDP
+  if (m_xdp != nullptr) {
+    // frames are filtered by claimFrame()
+    return;
+  }
+#endif
+#ifdef __linux__
+  if (m_ring != nullptr) {
+    return m_ring->setPacketFilter(filter);
+  }
+#endif
+  m_pcap.setPacketFilter(filter);
+}
+
+ssize_t
+EthernetTransport::computeMtu(uint32_t netifMtu) const
+{
+#ifdef NFD_HAVE_AF_XDP
+  if (m_xdp != nullptr) {
+    return std::min<ssize_t>(netifMtu, m_xdp->getMaxFrameSize() - ethernet::HDR_LEN);
+  }
+#endif
+  return netifMtu;
+}
+
 void
 EthernetTransport::handleNetifStateChange(ndn::net::InterfaceState netifState)
 {
@@ -113,36 +193,113 @@ EthernetTransport::doSend(const Block& packet)
 {
   NFD_LOG_FACE_TRACE(__func__);
 
-  sendPacket(packet);
+  sendPacketToBackend({packet.data(), packet.size()});
 }
 
 void
-EthernetTransport::sendPacket(const ndn::Block& block)
+EthernetTransport::doSendGathered(const GatheredPacket& packet)
 {
-  ndn::EncodingBuffer buffer(block);
+  NFD_LOG_FACE_TRACE(__func__);
+
+  // both parts are copied straight into the frame
+  sendPacketToBackend(packet.header, packet.payload);
+}
 
-  // pad with zeroes if the payload is too short
-  if (block.size() < ethernet::MIN_DATA_LEN) {
-    static const uint8_t padding[ethernet::MIN_DATA_LEN] = {};
-    buffer.appendBytes(ndn::make_span(padding).subspan(block.size()));
+void
+EthernetTransport::sendPacketToBackend(span<const uint8_t> packet, span<const uint8_t> packetTail)
+{
+#ifdef NFD_HAVE_AF_XDP
+  if (m_xdp != nullptr) {
+    return sendPacketToRing(*m_xdp, packet, packetTail);
+  }
+#endif
+#ifdef __linux__
+  if (m_ring != nullptr) {
+    return sendPacketToRing(*m_ring, packet, packetTail);
   }
+#endif
+  sendPacketToRing(*m_txBatch, packet, packetTail);
+}
 
-  // construct and prepend the ethernet header
-  uint16_t ethertype = boost::endian::native_to_big(ethernet::ETHERTYPE_NDN);
-  buffer.prependBytes({reinterpret_cast<const uint8_t*>(&ethertype), ethernet::TYPE_LEN});
-  buffer.prependBytes(m_srcAddress);
-  buffer.prependBytes(m_destAddress);
-
-  // send the frame
-  int sent = pcap_inject(m_pcap, buffer.data(), buffer.size());
-  if (sent < 0)
-    handleError("Send operation failed: " + m_pcap.getLastError());
-  else if (static_cast<size_t>(sent) < buffer.size())
-    handleError("Failed to send the full frame: size=" + to_string(buffer.size()) +
-                " sent=" + to_string(sent));
-  else
-    // print block size because we don't want to count the padding in buffer
-    NFD_LOG_FACE_TRACE("Successfully sent: " << block.size() << " bytes");
+template<typename Ring>
+void
+EthernetTransport::sendPacketToRing(Ring& ring, span<const uint8_t> packet, span<const uint8_t> packetTail)
+{
+  size_t packetSize = packet.size() + packetTail.size();
+  size_t payloadSize = std::max(packetSize, ethernet::MIN_DATA_LEN);
+  size_t frameSize = ethernet::HDR_LEN + payloadSize;
+  if (frameSize > ring.getMaxFrameSize()) {
+    NFD_LOG_FACE_WARN("Dropping frame of " << frameSize << " bytes: too large for the TX ring");
+    ++nOutDrops;
+    return;
+  }
+
+  uint8_t* frame = ring.getTxFrame(frameSize);
+  if (frame == nullptr) {
+    // the ring is full of frames that have not been flushed or are still being sent
+    flushRing(ring);
+    frame = ring.getTxFrame(frameSize);
+    if (frame == nullptr) {
+      NFD_LOG_FACE_DEBUG("TX ring full, dropping frame");
+      ++nOutDrops;
+      return;
+    }
+  }
+
+  // copy the prebuilt ethernet header, then the payload padded with zeroes if it is too short
+  std::copy(m_frameHeader.begin(), m_frameHeader.end(), frame);
+  auto payload = std::copy(packet.begin(), packet.end(), frame + ethernet::HDR_LEN);
+  payload = std::copy(packetTail.begin(), packetTail.end(), payload);
+  std::fill(payload, frame + frameSize, 0);
+  ring.commitTxFrame();
+  NFD_LOG_FACE_TRACE("Queued: " << packetSize << " bytes");
+
+  if (!m_isFlushPending) {
+    m_isFlushPending = true;
+    getGlobalIoService().post([this, &ring] {
+      m_isFlushPending = false;
+      if (m_socket.is_open()) {
+        flushRing(ring);
+      }
+    });
+  }
+}
+
+template<typename Ring>
+void
+EthernetTransport::flushRing(Ring& ring)
+{
+  if (ring.getNUnflushedFrames() == 0) {
+    return;
+  }
+
+  int errorCode = ring.flush();
+  if (errorCode == 0) {
+    return;
+  }
+
+  if (errorCode != EAGAIN && errorCode != EWOULDBLOCK && errorCode != ENOBUFS && errorCode != EBUSY) {
+    handleError("Send operation failed: "s + std::strerror(errorCode));
+    return;
+  }
+
+  // the device queue is full: keep the remaining frames queued rather than failing the face,
+  // and send them as soon as the socket becomes writable again
+  ++nOutWouldBlock;
+  NFD_LOG_FACE_DEBUG("Device queue full, " << ring.getNUnflushedFrames() << " frame(s) deferred");
+  if (!m_isWaitingWritable) {
+    m_isWaitingWritable = true;
+    m_socket.async_write_some(boost::asio::null_buffers(), [this, &ring] (const auto& e, auto) {
+      // as in handleRead(), the Transport may already have been destructed if the wait was aborted
+      if (e == boost::asio::error::operation_aborted) {
+        return;
+      }
+      m_isWaitingWritable = false;
+      if (m_socket.is_open()) {
+        flushRing(ring);
+      }
+    });
+  }
 }
 
 void
@@ -167,31 +324,108 @@ EthernetTransport::handleRead(const boost::system::error_code& error)
     return;
   }
 
+  receiveFrames();
+  if (!m_socket.is_open()) {
+    return;
+  }
+
+#ifdef _DEBUG
+  size_t nDropped = getNDropped();
+  if (nDropped - m_nDropped > 0)
+    NFD_LOG_FACE_DEBUG("Detected " << nDropped - m_nDropped << " dropped frame(s)");
+  m_nDropped = nDropped;
+#endif
+
+  asyncRead();
+}
+
+void
+EthernetTransport::receiveFrames()
+{
+#ifdef NFD_HAVE_AF_XDP
+  if (m_xdp != nullptr) {
+    // frames are offered to every transport and channel that shares the socket
+    m_xdp->receive();
+    return;
+  }
+#endif
+#ifdef __linux__
+  if (m_ring != nullptr) {
+    // process every frame in every ready block, unless the transport is closed meanwhile
+    m_ring->receive([this] (auto frame) {
+      if (m_socket.is_open()) {
+        handleFrame(frame);
+      }
+    });
+    return;
+  }
+#endif
+
   auto [pkt, readErr] = m_pcap.readNextPacket();
   if (pkt.empty()) {
     NFD_LOG_FACE_WARN("Read error: " << readErr);
   }
   else {
-    auto [eh, frameErr] = ethernet::checkFrameHeader(pkt, m_srcAddress,
-                                                     m_destAddress.isMulticast() ? m_destAddress : m_srcAddress);
-    if (eh == nullptr) {
-      NFD_LOG_FACE_WARN(frameErr);
-    }
-    else {
-      ethernet::Address sender(eh->ether_shost);
-      pkt = pkt.subspan(ethernet::HDR_LEN);
-      receivePayload(pkt, sender);
-    }
+    handleFrame(pkt);
+  }
+}
+
+#ifdef NFD_HAVE_AF_XDP
+bool
+EthernetTransport::claimFrame(span<const uint8_t> frame)
+{
+  if (frame.size() < ethernet::HDR_LEN) {
+    return false;
+  }
+
+  // same criteria as the BPF filters of the subclasses
+  auto eh = reinterpret_cast<const ether_header*>(frame.data());
+  ethernet::Address dest(eh->ether_dhost);
+  ethernet::Address sender(eh->ether_shost);
+  bool isOurs = m_destAddress.isMulticast() ?
+                dest == m_destAddress && sender != m_srcAddress :
+                dest == m_srcAddress && sender == m_destAddress;
+  if (!isOurs) {
+    return false;
   }
 
+  if (m_socket.is_open()) {
+    handleFrame(frame);
+  }
+  return true;
+}
+#endif
+
 #ifdef _DEBUG
-  size_t nDropped = m_pcap.getNDropped();
-  if (nDropped - m_nDropped > 0)
-    NFD_LOG_FACE_DEBUG("Detected " << nDropped - m_nDropped << " dropped frame(s)");
-  m_nDropped = nDropped;
+size_t
+EthernetTransport::getNDropped()
+{
+#ifdef NFD_HAVE_AF_XDP
+  if (m_xdp != nullptr) {
+    return m_xdp->getNDropped();
+  }
+#endif
+#ifdef __linux__
+  if (m_ring != nullptr) {
+    return m_ring->getNDropped();
+  }
+#endif
+  return m_pcap.getNDropped();
+}
 #endif
 
-  asyncRead();
+void
+EthernetTransport::handleFrame(span<const uint8_t> frame)
+{
+  auto [eh, frameErr] = ethernet::checkFrameHeader(frame, m_srcAddress,
+                                                   m_destAddress.isMulticast() ? m_destAddress : m_srcAddress);
+  if (eh == nullptr) {
+    NFD_LOG_FACE_WARN(frameErr);
+    return;
+  }
+
+  ethernet::Address sender(eh->ether_shost);
+  receivePayload(frame.subspan(ethernet::HDR_LEN), sender);
 }
 
 void
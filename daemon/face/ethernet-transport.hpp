@@ -27,18 +27,66 @@
 #define NFD_DAEMON_FACE_ETHERNET_TRANSPORT_HPP
 
 #include "ethernet-protocol.hpp"
+#include "ethernet-tx-batch.hpp"
 #include "pcap-helper.hpp"
 #include "transport.hpp"
 
+#ifdef __linux__
+#include "ethernet-packet-ring.hpp"
+#endif
+#ifdef NFD_HAVE_AF_XDP
+#include "ethernet-xdp-socket.hpp"
+#endif
+
 #include <boost/asio/posix/stream_descriptor.hpp>
 #include <ndn-cxx/net/network-interface.hpp>
 
 namespace nfd::face {
 
+/**
+ * @brief Mechanism through which an EthernetTransport sends and receives frames
+ */
+enum class EthernetBackend {
+  PCAP, ///< libpcap, frames sent in batches, see EthernetTxBatch
+  PACKET_RING, ///< AF_PACKET socket with TPACKET_V3 rings, see PacketRing (Linux only)
+  XDP, ///< AF_XDP socket shared by all faces on the interface, see XdpSocket (Linux 5.9+)
+};
+
+std::ostream&
+operator<<(std::ostream& os, EthernetBackend backend);
+
+/**
+ * @brief Counters provided by EthernetTransport
+ * @note The type name 'EthernetTransportCounters' is implementation detail.
+ *       Use 'EthernetTransport::Counters' in public API.
+ */
+class EthernetTransportCounters : public virtual Transport::Counters
+{
+public:
+  /**
+   * @brief Count of outgoing frames dropped because the backend had no room for them,
+   *        or because they were too large for the backend
+   */
+  PacketCounter nOutDrops;
+
+  /**
+   * @brief Count of flushes that the kernel could not complete because the device queue
+   *        was full (EAGAIN, ENOBUFS, or EBUSY)
+   *
+   * The frames that were not sent stay queued and are sent when the socket becomes writable.
+   */
+  PacketCounter nOutWouldBlock;
+};
+
 /**
  * @brief Base class for Ethernet-based Transports
+ *
+ * Outgoing frames are written into the transmit ring or batch of the backend, and are handed
+ * to the kernel once per io_service round, so that all frames sent by the forwarding thread in
+ * one round need a single system call.
  */
 class EthernetTransport : public Transport
+                        , protected virtual EthernetTransportCounters
 {
 public:
   class Error : public std::runtime_error
@@ -47,6 +95,14 @@ public:
     using std::runtime_error::runtime_error;
   };
 
+  /**
+   * @brief Counters provided by EthernetTransport
+   */
+  using Counters = EthernetTransportCounters;
+
+  const Counters&
+  getCounters() const final;
+
   /**
    * @brief Processes the payload of an incoming frame
    * @param payload Payload bytes, starting from the first byte after the Ethernet header
@@ -56,12 +112,33 @@ public:
   receivePayload(span<const uint8_t> payload, const ethernet::Address& sender);
 
 protected:
+  /**
+   * @throw Error the backend is unavailable or cannot be initialized
+   */
   EthernetTransport(const ndn::net::NetworkInterface& localEndpoint,
-                    const ethernet::Address& remoteEndpoint);
+                    const ethernet::Address& remoteEndpoint,
+                    EthernetBackend backend);
 
   void
   doClose() final;
 
+  /**
+   * @brief Install a BPF filter on the receiving socket.
+   *
+   * The XDP backend ignores the filter and applies equivalent criteria itself.
+   *
+   * @throw PcapHelper::Error or PacketRing::Error on any error
+   */
+  void
+  setPacketFilter(const char* filter) const;
+
+  /**
+   * @brief Compute the MTU of the transport from the MTU of the network interface,
+   *        which the XDP backend limits to the size of a UMEM frame
+   */
+  ssize_t
+  computeMtu(uint32_t netifMtu) const;
+
   bool
   hasRecentlyReceived() const
   {
@@ -81,11 +158,8 @@ private:
   void
   doSend(const Block& packet) final;
 
-  /**
-   * @brief Sends the specified TLV block on the network wrapped in an Ethernet frame
-   */
   void
-  sendPacket(const ndn::Block& block);
+  doSendGathered(const GatheredPacket& packet) final;
 
   void
   asyncRead();
@@ -93,6 +167,52 @@ private:
   void
   handleRead(const boost::system::error_code& error);
 
+  void
+  receiveFrames();
+
+  /**
+   * @brief Processes a received frame, including its Ethernet header
+   */
+  void
+  handleFrame(span<const uint8_t> frame);
+
+  /**
+   * @brief Writes a frame carrying @p packet, which may be gathered from two parts,
+   *        into the transmit ring; the ring is flushed once per io_service round
+   * @tparam Ring EthernetTxBatch, PacketRing, or XdpSocket
+   */
+  template<typename Ring>
+  void
+  sendPacketToRing(Ring& ring, span<const uint8_t> packet, span<const uint8_t> packetTail = {});
+
+  /**
+   * @brief Dispatches to sendPacketToRing() with the ring of the backend in use
+   */
+  void
+  sendPacketToBackend(span<const uint8_t> packet, span<const uint8_t> packetTail = {});
+
+  /**
+   * @brief Hands the queued frames to the kernel; if the device queue is full,
+   *        retries when the socket becomes writable
+   */
+  template<typename Ring>
+  void
+  flushRing(Ring& ring);
+
+#ifdef NFD_HAVE_AF_XDP
+  /**
+   * @brief Processes a frame received by the XDP socket if it belongs to this transport
+   * @return whether the frame belongs to this transport
+   */
+  bool
+  claimFrame(span<const uint8_t> frame);
+#endif
+
+#ifdef _DEBUG
+  size_t
+  getNDropped();
+#endif
+
   void
   handleError(const std::string& errorMessage);
 
@@ -102,17 +222,36 @@ protected:
   ethernet::Address m_srcAddress;
   ethernet::Address m_destAddress;
   std::string m_interfaceName;
+  const EthernetBackend m_backend;
 
 private:
   signal::ScopedConnection m_netifStateChangedConn;
   signal::ScopedConnection m_netifMtuChangedConn;
   bool m_hasRecentlyReceived;
+  /// Ethernet header of every outgoing frame, built once for the (source, destination) pair
+  std::array<uint8_t, ethernet::HDR_LEN> m_frameHeader;
+  bool m_isFlushPending = false;
+  bool m_isWaitingWritable = false;
+  unique_ptr<EthernetTxBatch> m_txBatch; ///< non-null if the PCAP backend is used
+#ifdef __linux__
+  unique_ptr<PacketRing> m_ring; ///< non-null if the PACKET_RING backend is used
+#endif
+#ifdef NFD_HAVE_AF_XDP
+  shared_ptr<XdpSocket> m_xdp; ///< non-null if the XDP backend is used
+  XdpSocket::Subscription m_xdpSubscription;
+#endif
 #ifdef _DEBUG
-  /// number of frames dropped by the kernel, as reported by libpcap
+  /// number of frames dropped by the kernel, as reported by the backend
   size_t m_nDropped;
 #endif
 };
 
+inline const EthernetTransport::Counters&
+EthernetTransport::getCounters() const
+{
+  return *this;
+}
+
 } // namespace nfd::face
 
 #endif // NFD_DAEMON_FACE_ETHERNET_TRANSPORT_HPP
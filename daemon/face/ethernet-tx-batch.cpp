@@ -0,0 +1,99 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ethernet-tx-batch.hpp"
+
+#include <pcap/pcap.h>
+
+namespace nfd::face {
+
+EthernetTxBatch::EthernetTxBatch(const PcapHelper& pcap)
+  : m_pcap(pcap)
+  , m_arena(MAX_BATCH_SIZE * SLOT_SIZE)
+{
+#ifdef __linux__
+  m_fd = pcap_get_selectable_fd(m_pcap);
+  BOOST_ASSERT(m_fd >= 0);
+
+  // each message refers to its own slot for the lifetime of the batch
+  for (size_t i = 0; i < MAX_BATCH_SIZE; ++i) {
+    m_iov[i].iov_base = &m_arena[i * SLOT_SIZE];
+    m_iov[i].iov_len = 0;
+    m_msgs[i] = {};
+    m_msgs[i].msg_hdr.msg_iov = &m_iov[i];
+    m_msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+#endif
+}
+
+uint8_t*
+EthernetTxBatch::getTxFrame(size_t frameSize)
+{
+  BOOST_ASSERT(frameSize <= SLOT_SIZE);
+
+  if (m_nQueued == MAX_BATCH_SIZE) {
+    return nullptr;
+  }
+  m_txFrameSize = frameSize;
+  return &m_arena[m_nQueued * SLOT_SIZE];
+}
+
+void
+EthernetTxBatch::commitTxFrame()
+{
+#ifdef __linux__
+  m_iov[m_nQueued].iov_len = m_txFrameSize;
+#else
+  m_frameSizes[m_nQueued] = m_txFrameSize;
+#endif
+  ++m_nQueued;
+}
+
+int
+EthernetTxBatch::flush()
+{
+  while (m_nSent < m_nQueued) {
+#ifdef __linux__
+    int n = ::sendmmsg(m_fd, &m_msgs[m_nSent], m_nQueued - m_nSent, MSG_DONTWAIT);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return errno;
+    }
+    m_nSent += n;
+#else
+    if (pcap_inject(m_pcap, &m_arena[m_nSent * SLOT_SIZE], m_frameSizes[m_nSent]) < 0) {
+      return errno != 0 ? errno : EIO;
+    }
+    ++m_nSent;
+#endif
+  }
+
+  m_nQueued = m_nSent = 0;
+  return 0;
+}
+
+} // namespace nfd::face
@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_ETHERNET_TX_BATCH_HPP
+#define NFD_DAEMON_FACE_ETHERNET_TX_BATCH_HPP
+
+#include "pcap-helper.hpp"
+
+#ifdef __linux__
+#include <sys/socket.h>
+#endif
+
+namespace nfd::face {
+
+/**
+ * @brief A batch of outgoing frames for the pcap backend of EthernetTransport.
+ *
+ * Frames are written into slots of an arena that is allocated once, and flush() hands all of
+ * them to the kernel at once. On Linux, the pcap handle is backed by an AF_PACKET socket and
+ * flush() uses a single sendmmsg(2) call; elsewhere it falls back to one pcap_inject(3pcap)
+ * call per frame.
+ *
+ * The interface mirrors the transmit side of PacketRing, so that EthernetTransport drives all
+ * backends the same way. Frames that the kernel refuses to take because the device queue is
+ * full stay in the batch and are sent by the next flush().
+ */
+class EthernetTxBatch : noncopyable
+{
+public:
+  /// maximum number of frames in a batch
+  static constexpr size_t MAX_BATCH_SIZE = 32;
+  /// size of each frame slot, which fits an Ethernet header and a maximum-size packet
+  static constexpr size_t SLOT_SIZE = 1 << 14;
+
+  /**
+   * @param pcap an activated pcap handle, which must outlive the batch
+   */
+  explicit
+  EthernetTxBatch(const PcapHelper& pcap);
+
+  /**
+   * @brief Obtain the next free slot for a frame of @p frameSize octets.
+   * @return pointer to where the frame must be written, or nullptr if the batch is full
+   * @pre frameSize <= getMaxFrameSize()
+   */
+  uint8_t*
+  getTxFrame(size_t frameSize);
+
+  /**
+   * @brief Queue the frame written into the slot returned by the last getTxFrame().
+   */
+  void
+  commitTxFrame();
+
+  /**
+   * @brief Send every queued frame, without blocking.
+   * @return errno of the failed call, or 0 if every frame has been sent
+   */
+  int
+  flush();
+
+  /// number of queued frames that have not been sent
+  size_t
+  getNUnflushedFrames() const noexcept
+  {
+    return m_nQueued - m_nSent;
+  }
+
+  static constexpr size_t
+  getMaxFrameSize() noexcept
+  {
+    return SLOT_SIZE;
+  }
+
+private:
+  const PcapHelper& m_pcap;
+  std::vector<uint8_t> m_arena;
+#ifdef __linux__
+  int m_fd;
+  std::array<iovec, MAX_BATCH_SIZE> m_iov;
+  std::array<mmsghdr, MAX_BATCH_SIZE> m_msgs;
+#else
+  std::array<size_t, MAX_BATCH_SIZE> m_frameSizes;
+#endif
+  size_t m_nQueued = 0; ///< number of frames in the batch, including those already sent
+  size_t m_nSent = 0; ///< number of frames at the front of the batch that have been sent
+  size_t m_txFrameSize = 0; ///< size of the frame written into the slot returned by getTxFrame()
+};
+
+} // namespace nfd::face
+
+#endif // NFD_DAEMON_FACE_ETHERNET_TX_BATCH_HPP
@@ -0,0 +1,459 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ethernet-xdp-socket.hpp"
+#include "ethernet-protocol.hpp"
+
+#include "common/privilege-helper.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <map>
+
+#include <linux/bpf.h>
+#include <linux/if_link.h>
+#include <linux/if_xdp.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <boost/endian/conversion.hpp>
+
+namespace nfd::face {
+
+static int
+bpf(int cmd, bpf_attr& attr)
+{
+  return static_cast<int>(::syscall(__NR_bpf, cmd, &attr, sizeof(attr)));
+}
+
+static constexpr bpf_insn
+makeInsn(uint8_t code, uint8_t dst, uint8_t src, int16_t off, int32_t imm)
+{
+  return {code, dst, src, off, imm};
+}
+
+/**
+ * @brief Build the XDP program, which redirects frames with the NDN EtherType to the socket
+ *        in the XSKMAP @p mapFd for the receive queue, and passes every other frame.
+ */
+static std::vector<bpf_insn>
+makeXdpProgram(int mapFd)
+{
+  // the EtherType as loaded from the frame into a register
+  const int32_t ethertype = boost::endian::native_to_big(ethernet::ETHERTYPE_NDN);
+
+  return {
+    // r2 = ctx->data; r3 = ctx->data_end
+    makeInsn(BPF_LDX | BPF_W | BPF_MEM, BPF_REG_2, BPF_REG_1, offsetof(xdp_md, data), 0),
+    makeInsn(BPF_LDX | BPF_W | BPF_MEM, BPF_REG_3, BPF_REG_1, offsetof(xdp_md, data_end), 0),
+    // if (data + HDR_LEN > data_end) goto pass
+    makeInsn(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_4, BPF_REG_2, 0, 0),
+    makeInsn(BPF_ALU64 | BPF_ADD | BPF_K, BPF_REG_4, 0, 0, ethernet::HDR_LEN),
+    makeInsn(BPF_JMP | BPF_JGT | BPF_X, BPF_REG_4, BPF_REG_3, 8, 0),
+    // if (ether_type != ETHERTYPE_NDN) goto pass; VLAN-tagged frames are passed as well
+    makeInsn(BPF_LDX | BPF_H | BPF_MEM, BPF_REG_4, BPF_REG_2, 2 * ethernet::ADDR_LEN, 0),
+    makeInsn(BPF_JMP | BPF_JNE | BPF_K, BPF_REG_4, 0, 6, ethertype),
+    // return bpf_redirect_map(map, ctx->rx_queue_index, XDP_PASS)
+    makeInsn(BPF_LDX | BPF_W | BPF_MEM, BPF_REG_2, BPF_REG_1, offsetof(xdp_md, rx_queue_index), 0),
+    makeInsn(BPF_LD | BPF_DW | BPF_IMM, BPF_REG_1, BPF_PSEUDO_MAP_FD, 0, mapFd),
+    makeInsn(0, 0, 0, 0, 0),
+    makeInsn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_3, 0, 0, XDP_PASS),
+    makeInsn(BPF_JMP | BPF_CALL, 0, 0, 0, BPF_FUNC_redirect_map),
+    makeInsn(BPF_JMP | BPF_EXIT, 0, 0, 0, 0),
+    // pass: return XDP_PASS
+    makeInsn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_0, 0, 0, XDP_PASS),
+    makeInsn(BPF_JMP | BPF_EXIT, 0, 0, 0, 0),
+  };
+}
+
+shared_ptr<XdpSocket>
+XdpSocket::open(const std::string& interfaceName, int interfaceIndex)
+{
+  static std::map<int, std::weak_ptr<XdpSocket>> sockets; // ifindex => socket
+
+  auto& weak = sockets[interfaceIndex];
+  auto socket = weak.lock();
+  if (socket == nullptr) {
+    socket.reset(new XdpSocket(interfaceName, interfaceIndex));
+    weak = socket;
+  }
+  return socket;
+}
+
+XdpSocket::XdpSocket(const std::string& interfaceName, int interfaceIndex)
+{
+  auto fail = [&] (const std::string& what) {
+    int errorCode = errno;
+    close();
+    NDN_THROW(Error(what + " on " + interfaceName + ": " + std::strerror(errorCode)));
+  };
+
+  auto mapRing = [&] (Ring& ring, const xdp_ring_offset& off, size_t descSize, off_t pgoff) {
+    ring.mapSize = off.desc + RING_SIZE * descSize;
+    ring.map = ::mmap(nullptr, ring.mapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, pgoff);
+    if (ring.map == MAP_FAILED) {
+      ring.map = nullptr;
+      fail("mmap(ring)");
+    }
+    auto base = static_cast<uint8_t*>(ring.map);
+    ring.producer = reinterpret_cast<uint32_t*>(base + off.producer);
+    ring.consumer = reinterpret_cast<uint32_t*>(base + off.consumer);
+    ring.flags = reinterpret_cast<uint32_t*>(base + off.flags);
+    ring.descs = base + off.desc;
+  };
+
+  void* umem = ::mmap(nullptr, FRAME_SIZE * FRAME_COUNT, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+  if (umem == MAP_FAILED) {
+    fail("mmap(umem)");
+  }
+  m_umem = static_cast<uint8_t*>(umem);
+
+  // registering the UMEM pins its pages, and the XDP program requires CAP_NET_ADMIN or CAP_BPF
+  PrivilegeHelper::runElevated([&] {
+    m_fd = ::socket(AF_XDP, SOCK_RAW, 0);
+    if (m_fd < 0) {
+      fail("socket(AF_XDP)");
+    }
+
+    xdp_umem_reg reg{};
+    reg.addr = reinterpret_cast<uint64_t>(m_umem);
+    reg.len = FRAME_SIZE * FRAME_COUNT;
+    reg.chunk_size = FRAME_SIZE;
+    if (::setsockopt(m_fd, SOL_XDP, XDP_UMEM_REG, &reg, sizeof(reg)) < 0) {
+      fail("setsockopt(XDP_UMEM_REG)");
+    }
+
+    int ringSize = RING_SIZE;
+    for (int opt : {XDP_UMEM_FILL_RING, XDP_UMEM_COMPLETION_RING, XDP_RX_RING, XDP_TX_RING}) {
+      if (::setsockopt(m_fd, SOL_XDP, opt, &ringSize, sizeof(ringSize)) < 0) {
+        fail("setsockopt(SOL_XDP, " + to_string(opt) + ")");
+      }
+    }
+
+    xdp_mmap_offsets off{};
+    socklen_t optlen = sizeof(off);
+    if (::getsockopt(m_fd, SOL_XDP, XDP_MMAP_OFFSETS, &off, &optlen) < 0) {
+      fail("getsockopt(XDP_MMAP_OFFSETS)");
+    }
+    mapRing(m_fillRing, off.fr, sizeof(uint64_t), XDP_UMEM_PGOFF_FILL_RING);
+    mapRing(m_completionRing, off.cr, sizeof(uint64_t), XDP_UMEM_PGOFF_COMPLETION_RING);
+    mapRing(m_rxRing, off.rx, sizeof(xdp_desc), XDP_PGOFF_RX_RING);
+    mapRing(m_txRing, off.tx, sizeof(xdp_desc), XDP_PGOFF_TX_RING);
+
+    // the first half of the UMEM is handed to the kernel for receiving, the second half is for sending
+    auto fillAddrs = static_cast<uint64_t*>(m_fillRing.descs);
+    for (size_t i = 0; i < RING_SIZE; ++i) {
+      fillAddrs[i] = i * FRAME_SIZE;
+    }
+    __atomic_store_n(m_fillRing.producer, RING_SIZE, __ATOMIC_RELEASE);
+    m_freeTxFrames.reserve(FRAME_COUNT - RING_SIZE);
+    for (size_t i = RING_SIZE; i < FRAME_COUNT; ++i) {
+      m_freeTxFrames.push_back(i * FRAME_SIZE);
+    }
+
+    sockaddr_xdp sxdp{};
+    sxdp.sxdp_family = AF_XDP;
+    sxdp.sxdp_ifindex = interfaceIndex;
+    sxdp.sxdp_queue_id = QUEUE_ID;
+    sxdp.sxdp_flags = XDP_USE_NEED_WAKEUP | XDP_ZEROCOPY;
+    m_isZeroCopy = true;
+    if (::bind(m_fd, reinterpret_cast<sockaddr*>(&sxdp), sizeof(sxdp)) < 0) {
+      // the driver does not support zero-copy mode
+      sxdp.sxdp_flags = XDP_USE_NEED_WAKEUP | XDP_COPY;
+      m_isZeroCopy = false;
+      if (::bind(m_fd, reinterpret_cast<sockaddr*>(&sxdp), sizeof(sxdp)) < 0) {
+        fail("bind");
+      }
+    }
+
+    bpf_attr attr{};
+    attr.map_type = BPF_MAP_TYPE_XSKMAP;
+    attr.key_size = sizeof(uint32_t);
+    attr.value_size = sizeof(int);
+    attr.max_entries = QUEUE_ID + 1;
+    m_mapFd = bpf(BPF_MAP_CREATE, attr);
+    if (m_mapFd < 0) {
+      fail("bpf(BPF_MAP_CREATE)");
+    }
+
+    uint32_t key = QUEUE_ID;
+    attr = {};
+    attr.map_fd = m_mapFd;
+    attr.key = reinterpret_cast<uint64_t>(&key);
+    attr.value = reinterpret_cast<uint64_t>(&m_fd);
+    if (bpf(BPF_MAP_UPDATE_ELEM, attr) < 0) {
+      fail("bpf(BPF_MAP_UPDATE_ELEM)");
+    }
+
+    auto insns = makeXdpProgram(m_mapFd);
+    static const char license[] = "GPL";
+    attr = {};
+    attr.prog_type = BPF_PROG_TYPE_XDP;
+    attr.insn_cnt = static_cast<uint32_t>(insns.size());
+    attr.insns = reinterpret_cast<uint64_t>(insns.data());
+    attr.license = reinterpret_cast<uint64_t>(license);
+    m_progFd = bpf(BPF_PROG_LOAD, attr);
+    if (m_progFd < 0) {
+      fail("bpf(BPF_PROG_LOAD)");
+    }
+
+    // a BPF link (Linux 5.9+) detaches the program when its fd is closed, even if NFD crashes
+    attr = {};
+    attr.link_create.prog_fd = m_progFd;
+    attr.link_create.target_ifindex = interfaceIndex;
+    attr.link_create.attach_type = BPF_XDP;
+    m_linkFd = bpf(BPF_LINK_CREATE, attr);
+    if (m_linkFd < 0) {
+      fail("bpf(BPF_LINK_CREATE)");
+    }
+  });
+}
+
+XdpSocket::~XdpSocket()
+{
+  close();
+}
+
+void
+XdpSocket::close()
+{
+  for (int* fd : {&m_linkFd, &m_progFd, &m_mapFd}) {
+    if (*fd >= 0) {
+      ::close(*fd);
+      *fd = -1;
+    }
+  }
+  for (Ring* ring : {&m_fillRing, &m_completionRing, &m_rxRing, &m_txRing}) {
+    if (ring->map != nullptr) {
+      ::munmap(ring->map, ring->mapSize);
+      *ring = {};
+    }
+  }
+  if (m_fd >= 0) {
+    ::close(m_fd);
+    m_fd = -1;
+  }
+  if (m_umem != nullptr) {
+    ::munmap(m_umem, FRAME_SIZE * FRAME_COUNT);
+    m_umem = nullptr;
+  }
+}
+
+int
+XdpSocket::getFd() const
+{
+  int fd = ::dup(m_fd);
+  if (fd < 0) {
+    NDN_THROW(Error("dup: "s + std::strerror(errno)));
+  }
+  return fd;
+}
+
+XdpSocket::Subscription
+XdpSocket::subscribe(FrameHandler handler, bool isFallback)
+{
+  auto it = isFallback ? m_handlers.insert(m_handlers.end(), std::move(handler))
+                       : m_handlers.insert(m_handlers.begin(), std::move(handler));
+  return Subscription(shared_from_this(), it);
+}
+
+void
+XdpSocket::unsubscribe(std::list<FrameHandler>::iterator it)
+{
+  if (m_isDispatching) {
+    // erased after the frame has been dispatched, to keep the iteration valid
+    *it = nullptr;
+    m_hasCancelledHandlers = true;
+  }
+  else {
+    m_handlers.erase(it);
+  }
+}
+
+size_t
+XdpSocket::receive()
+{
+  uint32_t rxConsumer = *m_rxRing.consumer;
+  uint32_t nFrames = __atomic_load_n(m_rxRing.producer, __ATOMIC_ACQUIRE) - rxConsumer;
+  if (nFrames == 0) {
+    return 0;
+  }
+
+  // every UMEM frame for receiving is either in the fill ring, used by the kernel, or in the
+  // RX ring, thus the fill ring always has room for the frames that are returned
+  auto rxDescs = static_cast<const xdp_desc*>(m_rxRing.descs);
+  auto fillAddrs = static_cast<uint64_t*>(m_fillRing.descs);
+  uint32_t fillProducer = *m_fillRing.producer;
+
+  m_isDispatching = true;
+  for (uint32_t i = 0; i < nFrames; ++i) {
+    const auto& desc = rxDescs[(rxConsumer + i) % RING_SIZE];
+    span<const uint8_t> frame(m_umem + desc.addr, desc.len);
+    for (const auto& handler : m_handlers) {
+      if (handler && handler(frame)) {
+        break;
+      }
+    }
+    // in aligned mode, the address may point past the start of the UMEM frame
+    fillAddrs[(fillProducer + i) % RING_SIZE] = desc.addr & ~static_cast<uint64_t>(FRAME_SIZE - 1);
+  }
+  m_isDispatching = false;
+  if (m_hasCancelledHandlers) {
+    m_handlers.remove_if([] (const auto& handler) { return !handler; });
+    m_hasCancelledHandlers = false;
+  }
+
+  __atomic_store_n(m_rxRing.consumer, rxConsumer + nFrames, __ATOMIC_RELEASE);
+  __atomic_store_n(m_fillRing.producer, fillProducer + nFrames, __ATOMIC_RELEASE);
+  if (__atomic_load_n(m_fillRing.flags, __ATOMIC_ACQUIRE) & XDP_RING_NEED_WAKEUP) {
+    ::recvfrom(m_fd, nullptr, 0, MSG_DONTWAIT, nullptr, nullptr);
+  }
+  return nFrames;
+}
+
+uint8_t*
+XdpSocket::getTxFrame(size_t frameSize)
+{
+  BOOST_ASSERT(frameSize <= getMaxFrameSize());
+
+  if (m_freeTxFrames.empty()) {
+    reclaimTxFrames();
+    if (m_freeTxFrames.empty()) {
+      return nullptr;
+    }
+  }
+
+  m_txFrameSize = frameSize;
+  return m_umem + m_freeTxFrames.back();
+}
+
+void
+XdpSocket::commitTxFrame()
+{
+  // the TX ring has as many descriptors as there are UMEM frames for sending, so it is never full
+  auto& desc = static_cast<xdp_desc*>(m_txRing.descs)[m_txProducer % RING_SIZE];
+  desc.addr = m_freeTxFrames.back();
+  desc.len = static_cast<uint32_t>(m_txFrameSize);
+  desc.options = 0;
+  m_freeTxFrames.pop_back();
+
+  ++m_txProducer;
+}
+
+int
+XdpSocket::flush()
+{
+  __atomic_store_n(m_txRing.producer, m_txProducer, __ATOMIC_RELEASE);
+
+  int errorCode = 0;
+  while (true) {
+    uint32_t consumer = __atomic_load_n(m_txRing.consumer, __ATOMIC_ACQUIRE);
+    if (consumer == m_txProducer ||
+        (m_isZeroCopy && !(__atomic_load_n(m_txRing.flags, __ATOMIC_ACQUIRE) & XDP_RING_NEED_WAKEUP))) {
+      break;
+    }
+    if (::sendto(m_fd, nullptr, 0, MSG_DONTWAIT, nullptr, 0) < 0) {
+      errorCode = errno;
+      // in copy mode, the kernel sends a limited batch of frames per system call and then fails
+      // with EAGAIN, which also happens when the device is busy, in which case no progress is made
+      if (errorCode != EAGAIN || __atomic_load_n(m_txRing.consumer, __ATOMIC_ACQUIRE) == consumer) {
+        break;
+      }
+      errorCode = 0;
+    }
+    else if (m_isZeroCopy) {
+      // the driver sends the frames asynchronously
+      break;
+    }
+  }
+
+  reclaimTxFrames();
+  return errorCode;
+}
+
+void
+XdpSocket::reclaimTxFrames()
+{
+  uint32_t consumer = *m_completionRing.consumer;
+  uint32_t nCompleted = __atomic_load_n(m_completionRing.producer, __ATOMIC_ACQUIRE) - consumer;
+  auto addrs = static_cast<const uint64_t*>(m_completionRing.descs);
+  for (uint32_t i = 0; i < nCompleted; ++i) {
+    m_freeTxFrames.push_back(addrs[(consumer + i) % RING_SIZE]);
+  }
+  __atomic_store_n(m_completionRing.consumer, consumer + nCompleted, __ATOMIC_RELEASE);
+}
+
+size_t
+XdpSocket::getMaxFrameSize() const noexcept
+{
+  return FRAME_SIZE - XDP_PACKET_HEADROOM;
+}
+
+size_t
+XdpSocket::getNDropped() const
+{
+  xdp_statistics stats{};
+  socklen_t len = sizeof(stats);
+  if (::getsockopt(m_fd, SOL_XDP, XDP_STATISTICS, &stats, &len) < 0) {
+    return 0;
+  }
+  return stats.rx_dropped + stats.rx_ring_full;
+}
+
+XdpSocket::Subscription::Subscription(Subscription&& other) noexcept
+  : m_socket(std::move(other.m_socket))
+  , m_it(other.m_it)
+{
+}
+
+XdpSocket::Subscription&
+XdpSocket::Subscription::operator=(Subscription&& other) noexcept
+{
+  if (this != &other) {
+    cancel();
+    m_socket = std::move(other.m_socket);
+    m_it = other.m_it;
+  }
+  return *this;
+}
+
+XdpSocket::Subscription::~Subscription()
+{
+  cancel();
+}
+
+void
+XdpSocket::Subscription::cancel()
+{
+  if (m_socket != nullptr) {
+    m_socket->unsubscribe(m_it);
+    m_socket = nullptr;
+  }
+}
+
+} // namespace nfd::face
@@ -0,0 +1,236 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_ETHERNET_XDP_SOCKET_HPP
+#define NFD_DAEMON_FACE_ETHERNET_XDP_SOCKET_HPP
+
+#include "core/common.hpp"
+
+#ifndef NFD_HAVE_AF_XDP
+#error "Cannot include this file when AF_XDP sockets are not available"
+#endif
+
+#include <list>
+
+namespace nfd::face {
+
+/**
+ * @brief An AF_XDP socket bound to the first receive queue of a network interface.
+ *
+ * An XDP program attached to the interface redirects every frame with the NDN EtherType that
+ * arrives on that queue into the socket; other frames continue through the kernel network stack.
+ * Frames are received from and transmitted through a memory area (UMEM) shared with the kernel,
+ * in batches. The socket is bound in zero-copy mode if the driver supports it, and in copy mode
+ * otherwise (e.g., on veth interfaces).
+ *
+ * Since an interface can have only one XDP program, the socket is shared by every transport and
+ * channel on the interface, see open(). Each received frame is offered to the subscribers in turn,
+ * until one of them claims it.
+ */
+class XdpSocket : noncopyable, public std::enable_shared_from_this<XdpSocket>
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  /// size of a UMEM frame, which holds one received or transmitted Ethernet frame
+  static constexpr size_t FRAME_SIZE = 4096;
+  /// number of UMEM frames, half of which are used for receiving and half for transmitting
+  static constexpr size_t FRAME_COUNT = 4096;
+  /// number of descriptors in each ring
+  static constexpr size_t RING_SIZE = FRAME_COUNT / 2;
+  /// receive queue that the socket is bound to
+  static constexpr uint32_t QUEUE_ID = 0;
+
+  /**
+   * @brief Handler of a received frame, including its Ethernet header.
+   * @return whether the frame is claimed; an unclaimed frame is offered to the next subscriber
+   */
+  using FrameHandler = std::function<bool(span<const uint8_t> frame)>;
+
+  /**
+   * @brief Keeps a FrameHandler subscribed, and the socket open, until destroyed.
+   */
+  class Subscription : noncopyable
+  {
+  public:
+    Subscription() = default;
+
+    Subscription(Subscription&& other) noexcept;
+
+    Subscription&
+    operator=(Subscription&& other) noexcept;
+
+    ~Subscription();
+
+    void
+    cancel();
+
+  private:
+    Subscription(shared_ptr<XdpSocket> socket, std::list<FrameHandler>::iterator it)
+      : m_socket(std::move(socket))
+      , m_it(it)
+    {
+    }
+
+  private:
+    shared_ptr<XdpSocket> m_socket;
+    std::list<FrameHandler>::iterator m_it;
+
+    friend XdpSocket;
+  };
+
+  /**
+   * @brief Open the socket on an interface, or return the socket already open on it.
+   * @throw Error on any error
+   */
+  static shared_ptr<XdpSocket>
+  open(const std::string& interfaceName, int interfaceIndex);
+
+  ~XdpSocket();
+
+  /**
+   * @brief Obtain a duplicate of the socket file descriptor, which becomes readable when
+   *        frames have been received. It is the caller's responsibility to close the fd.
+   */
+  int
+  getFd() const;
+
+  /**
+   * @brief Offer received frames to @p handler.
+   * @param isFallback if true, frames are offered to @p handler after every other subscriber
+   */
+  [[nodiscard]] Subscription
+  subscribe(FrameHandler handler, bool isFallback = false);
+
+  /**
+   * @brief Offer every received frame to the subscribers, and return the UMEM frames to the
+   *        kernel. The frame is valid only until the handler returns.
+   * @return number of frames received
+   */
+  size_t
+  receive();
+
+  /**
+   * @brief Obtain a free UMEM frame to transmit a frame of @p frameSize octets.
+   * @return pointer to where the frame must be written, or nullptr if no UMEM frame is free
+   * @pre frameSize <= getMaxFrameSize()
+   */
+  uint8_t*
+  getTxFrame(size_t frameSize);
+
+  /**
+   * @brief Queue the frame written into the UMEM frame returned by the last getTxFrame().
+   */
+  void
+  commitTxFrame();
+
+  /**
+   * @brief Ask the kernel to send every queued frame, without blocking, and reclaim the UMEM
+   *        frames of the frames that have been sent.
+   *
+   * Frames that the kernel cannot take because the device is busy remain queued.
+   * @return errno of the failed system call, or 0 on success
+   */
+  int
+  flush();
+
+  /// number of queued frames that the kernel has not taken yet
+  size_t
+  getNUnflushedFrames() const noexcept
+  {
+    return m_txProducer - __atomic_load_n(m_txRing.consumer, __ATOMIC_ACQUIRE);
+  }
+
+  /**
+   * @brief Get the maximum size of a frame, which is less than FRAME_SIZE because the kernel
+   *        reserves headroom in front of every received frame.
+   */
+  size_t
+  getMaxFrameSize() const noexcept;
+
+  /// whether the socket is bound in zero-copy mode
+  bool
+  isZeroCopy() const noexcept
+  {
+    return m_isZeroCopy;
+  }
+
+  /**
+   * @brief Get the number of frames dropped by the kernel because a ring was full.
+   */
+  size_t
+  getNDropped() const;
+
+private:
+  XdpSocket(const std::string& interfaceName, int interfaceIndex);
+
+  void
+  unsubscribe(std::list<FrameHandler>::iterator it);
+
+  void
+  reclaimTxFrames();
+
+  void
+  close();
+
+private:
+  /// a ring shared with the kernel
+  struct Ring
+  {
+    uint32_t* producer = nullptr;
+    uint32_t* consumer = nullptr;
+    uint32_t* flags = nullptr;
+    void* descs = nullptr;
+    void* map = nullptr;
+    size_t mapSize = 0;
+  };
+
+  int m_fd = -1;
+  int m_mapFd = -1;
+  int m_progFd = -1;
+  int m_linkFd = -1;
+  uint8_t* m_umem = nullptr;
+  Ring m_fillRing;
+  Ring m_completionRing;
+  Ring m_rxRing;
+  Ring m_txRing;
+  bool m_isZeroCopy = false;
+
+  std::vector<uint64_t> m_freeTxFrames; ///< addresses of UMEM frames available for transmission
+  uint32_t m_txProducer = 0; ///< producer index of the TX ring, including unflushed frames
+  size_t m_txFrameSize = 0; ///< size of the frame written into the frame returned by getTxFrame()
+
+  std::list<FrameHandler> m_handlers; ///< fallback handlers are at the end
+  bool m_isDispatching = false;
+  bool m_hasCancelledHandlers = false;
+};
+
+} // namespace nfd::face
+
+#endif // NFD_DAEMON_FACE_ETHERNET_XDP_SOCKET_HPP
@@ -72,6 +72,26 @@ constexpr ssize_t MIN_MTU = 64;
  */
 using EndpointId = uint64_t;
 
+/** \brief A link-layer packet whose wire encoding is split into a header and a payload,
+ *         which are gathered only when the packet is written to the underlying socket.
+ *
+ *  This allows a fragment to refer to a slice of the network-layer packet it carries instead of
+ *  containing a copy of it. Neither part needs to be a complete TLV element on its own.
+ */
+struct GatheredPacket
+{
+  size_t
+  size() const noexcept
+  {
+    return header.size() + payload.size();
+  }
+
+  ndn::ConstBufferPtr headerBuffer; ///< owns the memory of \p header
+  span<const uint8_t> header;
+  ndn::ConstBufferPtr payloadBuffer; ///< owns the memory of \p payload
+  span<const uint8_t> payload;
+};
+
 /** \brief Parameters used to set Transport properties or LinkService options on a newly created face.
  *
  *  Parameters are passed as a struct rather than individually, so that a future change in the list
@@ -86,6 +106,9 @@ struct FaceParams
   bool wantLocalFields = false;
   bool wantLpReliability = false;
   boost::logic::tribool wantCongestionMarking = boost::logic::indeterminate;
+  std::optional<std::string> aqmName; ///< empty string disables the send queue
+  std::optional<time::nanoseconds> aqmTarget;
+  std::optional<time::nanoseconds> aqmInterval;
 };
 
 /** \brief For internal use by FaceLogging macros.
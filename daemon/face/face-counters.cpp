@@ -36,10 +36,18 @@ FaceCounters::FaceCounters(const LinkService::Counters& linkServiceCounters,
   , nOutData(linkServiceCounters.nOutData)
   , nInNacks(linkServiceCounters.nInNacks)
   , nOutNacks(linkServiceCounters.nOutNacks)
+  , nEgressQueued(linkServiceCounters.nEgressQueued)
+  , nEgressDropped(linkServiceCounters.nEgressDropped)
   , nInPackets(transportCounters.nInPackets)
   , nOutPackets(transportCounters.nOutPackets)
   , nInBytes(transportCounters.nInBytes)
   , nOutBytes(transportCounters.nOutBytes)
+  , nInRingDrops(transportCounters.nInRingDrops)
+  , nOutRingDrops(transportCounters.nOutRingDrops)
+  , nInRingDepth(transportCounters.nInRingDepth)
+  , nOutRingDepth(transportCounters.nOutRingDepth)
+  , nInPoolHits(transportCounters.nInPoolHits)
+  , nInPoolMisses(transportCounters.nInPoolMisses)
   , m_linkServiceCounters(linkServiceCounters)
   , m_transportCounters(transportCounters)
 {
@@ -74,11 +74,19 @@ public:
   const PacketCounter& nOutData;
   const PacketCounter& nInNacks;
   const PacketCounter& nOutNacks;
+  const PacketCounter& nEgressQueued;
+  const PacketCounter& nEgressDropped;
 
   const PacketCounter& nInPackets;
   const PacketCounter& nOutPackets;
   const ByteCounter& nInBytes;
   const ByteCounter& nOutBytes;
+  const PacketCounter& nInRingDrops;
+  const PacketCounter& nOutRingDrops;
+  const SimpleCounter& nInRingDepth;
+  const SimpleCounter& nOutRingDepth;
+  const PacketCounter& nInPoolHits;
+  const PacketCounter& nInPoolMisses;
 
   /** \brief count of incoming Interests dropped due to HopLimit == 0
    */
@@ -88,6 +96,14 @@ public:
    */
   PacketCounter nOutHopLimitZero;
 
+  /** \brief count of incoming Interests rejected by the per-face Interest rate limit
+   */
+  PacketCounter nInInterestsRateLimited;
+
+  /** \brief count of incoming Interests rejected because a PIT quota was reached
+   */
+  PacketCounter nInInterestsOverQuota;
+
 private:
   const LinkService::Counters& m_linkServiceCounters;
   const Transport::Counters& m_transportCounters;
@@ -24,6 +24,8 @@
  */
 
 #include "face-system.hpp"
+#include "datagram-buffer-pool.hpp"
+#include "io-thread.hpp"
 #include "protocol-factory.hpp"
 #include "netdev-bound.hpp"
 #include "common/global.hpp"
@@ -37,11 +39,20 @@ const std::string CFGSEC_FACESYSTEM = "face_system";
 const std::string CFGSEC_GENERAL = "general";
 const std::string CFGSEC_GENERAL_FQ = CFGSEC_FACESYSTEM + ".general";
 const std::string CFGSEC_NETDEVBOUND = "netdev_bound";
+const std::string CFGSEC_EGRESS = "egress";
+const std::string CFGSEC_EGRESS_FQ = CFGSEC_FACESYSTEM + ".egress";
 
 FaceSystem::FaceSystem(FaceTable& faceTable, shared_ptr<ndn::net::NetworkMonitor> netmon)
   : m_faceTable(faceTable)
   , m_netmon(std::move(netmon))
 {
+  // faces are created by protocol factories and by FaceManager, but all of them go through here
+  m_faceAddConn = m_faceTable.afterAdd.connect([this] (const Face& face) {
+    if (m_egressOptions && face.getScope() == ndn::nfd::FACE_SCOPE_NON_LOCAL) {
+      face.getLinkService()->setEgressScheduler(m_egressOptions);
+    }
+  });
+
   auto pfCtorParams = this->makePFCtorParams();
   for (const auto& id : ProtocolFactory::listRegistered()) {
     NFD_LOG_TRACE("creating factory " << id);
@@ -112,12 +123,79 @@ FaceSystem::processConfig(const ConfigSection& configSection, bool isDryRun, con
       if (key == "enable_congestion_marking") {
         context.generalConfig.wantCongestionMarking = ConfigFile::parseYesNo(pair, CFGSEC_GENERAL_FQ);
       }
+      else if (key == "io_threads") {
+        context.generalConfig.nIoThreads = ConfigFile::parseNumber<size_t>(pair, CFGSEC_GENERAL_FQ);
+        ConfigFile::checkRange(context.generalConfig.nIoThreads, size_t{0}, size_t{64},
+                               key, CFGSEC_GENERAL_FQ);
+      }
+      else if (key == "io_ring_capacity") {
+        context.generalConfig.ioRingCapacity = ConfigFile::parseNumber<size_t>(pair, CFGSEC_GENERAL_FQ);
+        ConfigFile::checkRange(context.generalConfig.ioRingCapacity, size_t{16}, size_t{65536},
+                               key, CFGSEC_GENERAL_FQ);
+      }
+      else if (key == "stream_zero_copy_receive") {
+        context.generalConfig.wantZeroCopyReceive = ConfigFile::parseYesNo(pair, CFGSEC_GENERAL_FQ);
+      }
+      else if (key == "datagram_buffer_pool") {
+        context.generalConfig.datagramBufferPoolCapacity = ConfigFile::parseNumber<size_t>(pair, CFGSEC_GENERAL_FQ);
+        ConfigFile::checkRange(context.generalConfig.datagramBufferPoolCapacity, size_t{0}, size_t{65536},
+                               key, CFGSEC_GENERAL_FQ);
+      }
+      else if (key == "aqm") {
+        const auto& value = pair.second.get_value<std::string>();
+        if (value == "none") {
+          context.generalConfig.aqmName.clear();
+        }
+        else if (Aqm::getAqmNames().count(value) > 0) {
+          context.generalConfig.aqmName = value;
+        }
+        else {
+          NDN_THROW(ConfigFile::Error(CFGSEC_GENERAL_FQ + ".aqm: '" + value + "' is not supported"));
+        }
+      }
+      else if (key == "aqm_target") {
+        auto target = ConfigFile::parseNumber<uint32_t>(pair, CFGSEC_GENERAL_FQ);
+        ConfigFile::checkRange(target, uint32_t{1}, uint32_t{10000}, key, CFGSEC_GENERAL_FQ);
+        context.generalConfig.aqmOptions.target = time::milliseconds(target);
+      }
+      else if (key == "aqm_interval") {
+        auto interval = ConfigFile::parseNumber<uint32_t>(pair, CFGSEC_GENERAL_FQ);
+        ConfigFile::checkRange(interval, uint32_t{1}, uint32_t{60000}, key, CFGSEC_GENERAL_FQ);
+        context.generalConfig.aqmOptions.interval = time::milliseconds(interval);
+      }
+      else if (key == "aqm_queue_capacity") {
+        context.generalConfig.aqmOptions.capacity = ConfigFile::parseNumber<size_t>(pair, CFGSEC_GENERAL_FQ);
+        ConfigFile::checkRange(context.generalConfig.aqmOptions.capacity, size_t{8800}, size_t{1} << 30,
+                               key, CFGSEC_GENERAL_FQ);
+      }
       else {
         NDN_THROW(ConfigFile::Error("Unrecognized option " + CFGSEC_GENERAL_FQ + "." + key));
       }
     }
   }
 
+  // I/O threads must exist before factories create transports; as existing transports cannot
+  // be moved onto other threads, the number of threads cannot change afterwards
+  if (!isDryRun) {
+    const auto& general = context.generalConfig;
+    if (m_ioThreads == nullptr && general.nIoThreads > 0) {
+      m_ioThreads = make_unique<IoThreadPool>(general.nIoThreads, general.ioRingCapacity);
+    }
+    else if ((m_ioThreads == nullptr ? 0 : m_ioThreads->size()) != general.nIoThreads ||
+             (m_ioThreads != nullptr && m_ioThreads->getRingCapacity() != general.ioRingCapacity)) {
+      NFD_LOG_WARN("Changes to " << CFGSEC_GENERAL_FQ << ".io_threads and io_ring_capacity "
+                   "take effect after restart");
+    }
+    DatagramBufferPool::setTransportPoolCapacity(general.datagramBufferPoolCapacity);
+    Aqm::setDefault(general.aqmName, general.aqmOptions);
+  }
+
+  // process egress section before factories create faces
+  auto egressOptions = parseEgressConfig(configSection.get_child_optional(CFGSEC_EGRESS));
+  if (!isDryRun) {
+    m_egressOptions = std::move(egressOptions);
+  }
+
   // process in protocol factories
   for (const auto& [sectionName, factory] : m_factories) {
     std::set<std::string> oldProvidedSchemes = factory->getProvidedSchemes();
@@ -154,7 +232,7 @@ FaceSystem::processConfig(const ConfigSection& configSection, bool isDryRun, con
     }
 
     if (sectionName == CFGSEC_GENERAL || sectionName == CFGSEC_NETDEVBOUND ||
-        m_factories.count(sectionName) > 0) {
+        sectionName == CFGSEC_EGRESS || m_factories.count(sectionName) > 0) {
       continue;
     }
 
@@ -162,4 +240,66 @@ FaceSystem::processConfig(const ConfigSection& configSection, bool isDryRun, con
   }
 }
 
+std::optional<EgressScheduler::Options>
+FaceSystem::parseEgressConfig(OptionalConfigSection configSection)
+{
+  if (!configSection) {
+    return std::nullopt;
+  }
+
+  EgressScheduler::Options options;
+  for (const auto& pair : *configSection) {
+    const std::string& key = pair.first;
+    if (key == "rate") {
+      options.rate = ConfigFile::parseNumber<uint64_t>(pair, CFGSEC_EGRESS_FQ);
+    }
+    else if (key == "burst") {
+      options.burst = ConfigFile::parseNumber<size_t>(pair, CFGSEC_EGRESS_FQ);
+      ConfigFile::checkRange(options.burst, size_t{1500}, size_t{1} << 30, key, CFGSEC_EGRESS_FQ);
+    }
+    else if (key == "queue_limit") {
+      options.queueLimit = ConfigFile::parseNumber<size_t>(pair, CFGSEC_EGRESS_FQ);
+      ConfigFile::checkRange(options.queueLimit, size_t{1}, size_t{1} << 20, key, CFGSEC_EGRESS_FQ);
+    }
+    else if (key == "default_weight") {
+      options.defaultWeight = ConfigFile::parseNumber<uint32_t>(pair, CFGSEC_EGRESS_FQ);
+      ConfigFile::checkRange(options.defaultWeight, uint32_t{1}, uint32_t{1000}, key, CFGSEC_EGRESS_FQ);
+    }
+    else if (key == "class") {
+      EgressScheduler::TrafficClass tc;
+      tc.name = pair.second.get_value<std::string>();
+      const std::string sectionName = CFGSEC_EGRESS_FQ + ".class " + tc.name;
+      for (const auto& classPair : pair.second) {
+        if (classPair.first == "prefix") {
+          try {
+            tc.prefixes.emplace_back(classPair.second.get_value<std::string>());
+          }
+          catch (const ndn::tlv::Error&) {
+            NDN_THROW_NESTED(ConfigFile::Error("Invalid value for option " + sectionName + ".prefix"));
+          }
+        }
+        else if (classPair.first == "weight") {
+          tc.weight = ConfigFile::parseNumber<uint32_t>(classPair, sectionName);
+          ConfigFile::checkRange(tc.weight, uint32_t{1}, uint32_t{1000}, classPair.first, sectionName);
+        }
+        else {
+          NDN_THROW(ConfigFile::Error("Unrecognized option " + sectionName + "." + classPair.first));
+        }
+      }
+      if (tc.prefixes.empty()) {
+        NDN_THROW(ConfigFile::Error(sectionName + " must have at least one prefix"));
+      }
+      options.classes.push_back(std::move(tc));
+    }
+    else {
+      NDN_THROW(ConfigFile::Error("Unrecognized option " + CFGSEC_EGRESS_FQ + "." + key));
+    }
+  }
+
+  if (options.rate == 0) {
+    return std::nullopt;
+  }
+  return options;
+}
+
 } // namespace nfd::face
@@ -26,6 +26,8 @@
 #ifndef NFD_DAEMON_FACE_FACE_SYSTEM_HPP
 #define NFD_DAEMON_FACE_FACE_SYSTEM_HPP
 
+#include "aqm.hpp"
+#include "egress-scheduler.hpp"
 #include "network-predicate.hpp"
 #include "common/config-file.hpp"
 
@@ -39,6 +41,7 @@ class FaceTable;
 
 namespace face {
 
+class IoThreadPool;
 class NetdevBound;
 class ProtocolFactory;
 struct ProtocolFactoryCtorParams;
@@ -89,6 +92,12 @@ public:
   struct GeneralConfig
   {
     bool wantCongestionMarking = true;
+    size_t nIoThreads = 0; ///< number of I/O threads, 0 means I/O is performed on the main thread
+    size_t ioRingCapacity = 1024; ///< capacity of each RX and TX ring between I/O and main threads
+    bool wantZeroCopyReceive = false; ///< whether stream transports use zero-copy receive mode
+    size_t datagramBufferPoolCapacity = 0; ///< receive buffers per datagram transport, 0 disables pooling
+    std::string aqmName; ///< AQM algorithm of face send queues, empty if faces have no send queue
+    Aqm::Options aqmOptions;
   };
 
   /** \brief context for processing a config section in ProtocolFactory
@@ -100,6 +109,15 @@ public:
     bool isDryRun;
   };
 
+  /** \return options of the egress scheduler installed on non-local faces,
+   *          or nullopt if outgoing packets are not scheduled
+   */
+  const std::optional<EgressScheduler::Options>&
+  getEgressSchedulerOptions() const
+  {
+    return m_egressOptions;
+  }
+
 NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   ProtocolFactoryCtorParams
   makePFCtorParams();
@@ -109,6 +127,12 @@ private:
   processConfig(const ConfigSection& configSection, bool isDryRun,
                 const std::string& filename);
 
+  /** \brief parses the "egress" section
+   *  \return scheduler options, or nullopt if the section is absent or the rate is zero
+   */
+  static std::optional<EgressScheduler::Options>
+  parseEgressConfig(OptionalConfigSection configSection);
+
 NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /** \brief config section name => protocol factory
    */
@@ -116,14 +140,23 @@ NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   unique_ptr<NetdevBound> m_netdevBound;
 
 private:
+  /** \brief I/O threads used by transports, created at most once
+   */
+  unique_ptr<IoThreadPool> m_ioThreads;
+
   /** \brief scheme => protocol factory
    *
    *  The same protocol factory may be available under multiple schemes.
    */
   std::map<std::string, ProtocolFactory*> m_factoryByScheme;
 
+  /** \brief egress scheduler options applied to non-local faces created afterwards
+   */
+  std::optional<EgressScheduler::Options> m_egressOptions;
+
   FaceTable& m_faceTable;
   shared_ptr<ndn::net::NetworkMonitor> m_netmon;
+  signal::ScopedConnection m_faceAddConn;
 };
 
 } // namespace face
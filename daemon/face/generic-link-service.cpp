@@ -24,6 +24,7 @@
  */
 
 #include "generic-link-service.hpp"
+#include "common/global.hpp"
 
 #include <ndn-cxx/lp/pit-token.hpp>
 #include <ndn-cxx/lp/tags.hpp>
@@ -38,6 +39,20 @@ constexpr size_t CONGESTION_MARK_SIZE = tlv::sizeOfVarNumber(lp::tlv::Congestion
                                         tlv::sizeOfVarNumber(sizeof(uint64_t)) +        // length
                                         tlv::sizeOfNonNegativeInteger(UINT64_MAX);      // value
 
+static unique_ptr<Aqm>
+makeAqm(const GenericLinkService::Options& options)
+{
+  if (options.aqmName.empty()) {
+    return nullptr;
+  }
+
+  auto aqm = Aqm::create(options.aqmName, options.aqmOptions);
+  if (aqm == nullptr) {
+    NDN_THROW(std::invalid_argument("Unknown AQM algorithm " + options.aqmName));
+  }
+  return aqm;
+}
+
 GenericLinkService::GenericLinkService(const GenericLinkService::Options& options)
   : m_options(options)
   , m_fragmenter(m_options.fragmenterOptions, this)
@@ -46,6 +61,7 @@ GenericLinkService::GenericLinkService(const GenericLinkService::Options& option
   , m_lastSeqNo(-2)
   , m_nextMarkTime(time::steady_clock::time_point::max())
   , m_nMarkedSinceInMarkingState(0)
+  , m_aqm(makeAqm(m_options))
 {
   m_reassembler.beforeTimeout.connect([this] (auto&&...) { ++nReassemblyTimeouts; });
   m_reliability.onDroppedInterest.connect([this] (const auto& i) { notifyDroppedInterest(i); });
@@ -55,10 +71,22 @@ GenericLinkService::GenericLinkService(const GenericLinkService::Options& option
 void
 GenericLinkService::setOptions(const GenericLinkService::Options& options)
 {
+  bool isNewAqm = options.aqmName != m_options.aqmName;
   m_options = options;
   m_fragmenter.setOptions(m_options.fragmenterOptions);
   m_reassembler.setOptions(m_options.reassemblerOptions);
   m_reliability.setOptions(m_options.reliabilityOptions);
+  if (isNewAqm) {
+    m_aqm = makeAqm(m_options);
+  }
+  else if (m_aqm != nullptr) {
+    // a new instance would forget the congestion state of the current one
+    m_aqm->setOptions(m_options.aqmOptions);
+  }
+  if (m_aqm == nullptr && !m_sendQueue.empty()) {
+    // the send queue has been disabled, pass the remaining packets to the transport
+    drainSendQueue();
+  }
 }
 
 ssize_t
@@ -98,10 +126,39 @@ GenericLinkService::sendLpPacket(lp::Packet&& pkt)
     m_reliability.piggyback(pkt, mtu);
   }
 
+  if (m_aqm != nullptr) {
+    size_t size = pkt.wireEncode().size();
+    this->enqueuePacket(std::move(pkt), size);
+    return;
+  }
+
   if (m_options.allowCongestionMarking) {
     checkCongestionLevel(pkt);
   }
 
+  this->transmitPacket(pkt);
+}
+
+void
+GenericLinkService::sendLpFragment(LpFragmenter::FragmentSlice&& frag)
+{
+  if (m_aqm != nullptr) {
+    size_t size = frag.encode().size();
+    this->enqueuePacket(std::move(frag), size);
+    return;
+  }
+
+  if (m_options.allowCongestionMarking) {
+    checkCongestionLevel(frag.header);
+  }
+
+  this->transmitPacket(frag);
+}
+
+void
+GenericLinkService::transmitPacket(lp::Packet& pkt)
+{
+  const ssize_t mtu = getEffectiveMtu();
   auto block = pkt.wireEncode();
   if (mtu != MTU_UNLIMITED && block.size() > static_cast<size_t>(mtu)) {
     ++nOutOverMtu;
@@ -111,6 +168,102 @@ GenericLinkService::sendLpPacket(lp::Packet&& pkt)
   this->sendPacket(block);
 }
 
+void
+GenericLinkService::transmitPacket(const LpFragmenter::FragmentSlice& frag)
+{
+  const ssize_t mtu = getEffectiveMtu();
+  auto packet = frag.encode();
+  if (mtu != MTU_UNLIMITED && packet.size() > static_cast<size_t>(mtu)) {
+    ++nOutOverMtu;
+    NFD_LOG_FACE_WARN("attempted to send packet over MTU limit");
+    return;
+  }
+  this->sendPacket(packet);
+}
+
+void
+GenericLinkService::enqueuePacket(std::variant<lp::Packet, LpFragmenter::FragmentSlice>&& packet,
+                                  size_t size)
+{
+  BOOST_ASSERT(m_aqm != nullptr);
+
+  if (m_sendQueueSize + size > m_aqm->getOptions().capacity) {
+    ++nSendQueueOverflows;
+    NFD_LOG_FACE_DEBUG("send queue is full: DROP");
+    return;
+  }
+
+  const auto now = time::steady_clock::now();
+  auto verdict = m_aqm->beforeEnqueue(m_sendQueueSize, now);
+  if (verdict == Aqm::Verdict::DROP ||
+      (verdict == Aqm::Verdict::CONGESTED && !m_options.allowCongestionMarking)) {
+    ++nCongestionDropped;
+    NFD_LOG_FACE_DEBUG("send queue is congested on enqueue: DROP");
+    return;
+  }
+
+  m_sendQueue.push_back({std::move(packet), size, now, verdict == Aqm::Verdict::CONGESTED});
+  m_sendQueueSize += size;
+  this->drainSendQueue();
+}
+
+void
+GenericLinkService::drainSendQueue()
+{
+  // The transport queue length is queried once, and then estimated from the packets passed to
+  // the transport, to avoid a system call per packet. A transport that cannot report its queue
+  // length takes all packets right away.
+  ssize_t transportQueueLength = getTransport()->getSendQueueLength();
+  const auto now = time::steady_clock::now();
+
+  while (!m_sendQueue.empty()) {
+    if (m_aqm != nullptr && transportQueueLength >= 0 &&
+        static_cast<size_t>(transportQueueLength) >= m_aqm->getOptions().transportQueueLimit) {
+      break;
+    }
+
+    QueuedPacket entry = std::move(m_sendQueue.front());
+    m_sendQueue.pop_front();
+    m_sendQueueSize -= entry.size;
+
+    bool isCongested = entry.isCongested;
+    if (m_aqm != nullptr) {
+      auto verdict = m_aqm->afterDequeue(now - entry.enqueueTime, m_sendQueueSize, now);
+      if (verdict == Aqm::Verdict::DROP ||
+          (verdict == Aqm::Verdict::CONGESTED && !m_options.allowCongestionMarking)) {
+        ++nCongestionDropped;
+        NFD_LOG_FACE_DEBUG("send queue is congested on dequeue: DROP");
+        continue;
+      }
+      isCongested = isCongested || verdict == Aqm::Verdict::CONGESTED;
+    }
+
+    if (auto pkt = std::get_if<lp::Packet>(&entry.packet); pkt != nullptr) {
+      if (isCongested) {
+        markCongestion(*pkt);
+      }
+      this->transmitPacket(*pkt);
+    }
+    else {
+      auto& frag = std::get<LpFragmenter::FragmentSlice>(entry.packet);
+      if (isCongested) {
+        markCongestion(frag.header);
+      }
+      this->transmitPacket(frag);
+    }
+
+    if (transportQueueLength >= 0) {
+      transportQueueLength += entry.size;
+    }
+  }
+
+  if (!m_sendQueue.empty() && !m_drainTimer) {
+    getTimerWheel().schedule(m_drainTimer, getTimerWheel().getGranularity(), [this] {
+      drainSendQueue();
+    });
+  }
+}
+
 void
 GenericLinkService::doSendInterest(const Interest& interest)
 {
@@ -192,6 +345,9 @@ GenericLinkService::sendNetPacket(lp::Packet&& pkt, bool isInterest)
   // Make space for feature fields in fragments
   if (m_options.reliabilityOptions.isEnabled && mtu != MTU_UNLIMITED) {
     mtu -= LpReliability::RESERVED_HEADER_SPACE;
+    if (m_options.reliabilityOptions.allowAckRanges) {
+      mtu -= LpReliability::ACK_RANGES_RESERVED_SPACE;
+    }
   }
 
   if (m_options.allowCongestionMarking && mtu != MTU_UNLIMITED) {
@@ -201,7 +357,26 @@ GenericLinkService::sendNetPacket(lp::Packet&& pkt, bool isInterest)
   // An MTU of 0 is allowed but will cause all packets to be dropped before transmission
   BOOST_ASSERT(mtu == MTU_UNLIMITED || mtu >= 0);
 
-  if (m_options.allowFragmentation && mtu != MTU_UNLIMITED) {
+  if (m_options.allowFragmentation && mtu != MTU_UNLIMITED &&
+      !m_options.reliabilityOptions.isEnabled) {
+    // without reliability, fragments need not be retained for retransmission,
+    // hence they can refer to the wire encoding of the network-layer packet
+    auto [isOk, slices] = m_fragmenter.fragmentPacketZeroCopy(pkt, mtu);
+    if (!isOk) {
+      // fragmentation failed (warning is logged by LpFragmenter)
+      ++nFragmentationErrors;
+      return;
+    }
+    if (!slices.empty()) {
+      for (auto& slice : slices) {
+        slice.header.set<lp::SequenceField>(++m_lastSeqNo);
+        this->sendLpFragment(std::move(slice));
+      }
+      return;
+    }
+    frags.push_back(std::move(pkt));
+  }
+  else if (m_options.allowFragmentation && mtu != MTU_UNLIMITED) {
     bool isOk = false;
     std::tie(isOk, frags) = m_fragmenter.fragmentPacket(pkt, mtu);
     if (!isOk) {
@@ -265,9 +440,7 @@ GenericLinkService::checkCongestionLevel(lp::Packet& pkt)
     }
     // Mark packet if sendQueue stays above target for one interval
     else if (now >= m_nextMarkTime) {
-      pkt.set<lp::CongestionMarkField>(1);
-      ++nCongestionMarked;
-      NFD_LOG_FACE_DEBUG("LpPacket was marked as congested");
+      markCongestion(pkt);
 
       ++m_nMarkedSinceInMarkingState;
       // Decrease the marking interval by the inverse of the square root of the number of packets
@@ -286,6 +459,14 @@ GenericLinkService::checkCongestionLevel(lp::Packet& pkt)
   }
 }
 
+void
+GenericLinkService::markCongestion(lp::Packet& pkt)
+{
+  pkt.set<lp::CongestionMarkField>(1);
+  ++nCongestionMarked;
+  NFD_LOG_FACE_DEBUG("LpPacket was marked as congested");
+}
+
 void
 GenericLinkService::doReceivePacket(const Block& packet, const EndpointId& endpoint)
 {
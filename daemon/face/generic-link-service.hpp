@@ -26,11 +26,15 @@
 #ifndef NFD_DAEMON_FACE_GENERIC_LINK_SERVICE_HPP
 #define NFD_DAEMON_FACE_GENERIC_LINK_SERVICE_HPP
 
+#include "aqm.hpp"
 #include "link-service.hpp"
 #include "lp-fragmenter.hpp"
 #include "lp-reassembler.hpp"
 #include "lp-reliability.hpp"
 
+#include <deque>
+#include <variant>
+
 namespace nfd::face {
 
 /** \brief counters provided by GenericLinkService
@@ -87,6 +91,14 @@ public:
   /** \brief count of outgoing LpPackets that were marked with congestion marks
    */
   PacketCounter nCongestionMarked;
+
+  /** \brief count of outgoing LpPackets dropped by active queue management to signal congestion
+   */
+  PacketCounter nCongestionDropped;
+
+  /** \brief count of outgoing LpPackets dropped because the send queue was full
+   */
+  PacketCounter nSendQueueOverflows;
 };
 
 /** \brief GenericLinkService is a LinkService that implements the NDNLPv2 protocol
@@ -150,6 +162,23 @@ public:
      */
     size_t defaultCongestionThreshold = 65536;
 
+    /** \brief name of the active queue management algorithm of the send queue
+     *
+     *  If empty, outgoing packets are passed to the transport right away, and congestion is
+     *  detected from the transport send queue length as configured above.
+     *  Otherwise, outgoing packets wait in a send queue while the transport has
+     *  Aqm::Options::transportQueueLimit octets queued, and the named algorithm decides from
+     *  their queueing delay which packets signal congestion. These packets are marked if
+     *  \p allowCongestionMarking is true, and dropped otherwise.
+     *
+     *  \sa Aqm::getAqmNames()
+     */
+    std::string aqmName;
+
+    /** \brief options for active queue management
+     */
+    Aqm::Options aqmOptions;
+
     /** \brief enables self-learning forwarding support
      */
     bool allowSelfLearning = true;
@@ -206,6 +235,16 @@ NFD_PROTECTED_WITH_TESTS_ELSE_PRIVATE: // send path
   void
   sendLpPacket(lp::Packet&& pkt);
 
+  /** \brief send a fragment that refers to the network-layer packet instead of containing it
+   */
+  void
+  sendLpFragment(LpFragmenter::FragmentSlice&& frag);
+
+  /** \brief pass packets from the send queue to the transport until it has enough queued
+   */
+  void
+  drainSendQueue();
+
   void
   doSendInterest(const Interest& interest) NFD_OVERRIDE_WITH_TESTS_ELSE_FINAL;
 
@@ -242,6 +281,28 @@ private: // send path
   void
   checkCongestionLevel(lp::Packet& pkt);
 
+  /** \brief add a congestion mark to the packet
+   */
+  void
+  markCongestion(lp::Packet& pkt);
+
+  /** \brief append a packet to the send queue, unless active queue management drops it
+   *  \param packet LpPacket or fragment
+   *  \param size encoded size of \p packet
+   */
+  void
+  enqueuePacket(std::variant<lp::Packet, LpFragmenter::FragmentSlice>&& packet, size_t size);
+
+  /** \brief encode the packet and pass it to the transport, if it fits in the MTU
+   */
+  void
+  transmitPacket(lp::Packet& pkt);
+
+  /** \brief encode the fragment and pass it to the transport, if it fits in the MTU
+   */
+  void
+  transmitPacket(const LpFragmenter::FragmentSlice& frag);
+
 private: // receive path
   void
   doReceivePacket(const Block& packet, const EndpointId& endpoint) NFD_OVERRIDE_WITH_TESTS_ELSE_FINAL;
@@ -309,6 +370,24 @@ NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /// number of marked packets in the current incident of congestion
   size_t m_nMarkedSinceInMarkingState;
 
+  /** \brief a packet waiting in the send queue
+   */
+  struct QueuedPacket
+  {
+    std::variant<lp::Packet, LpFragmenter::FragmentSlice> packet;
+    size_t size;
+    time::steady_clock::TimePoint enqueueTime;
+    bool isCongested; ///< whether congestion was signaled on enqueue
+  };
+
+  /// active queue management of the send queue, nullptr if there is no send queue
+  unique_ptr<Aqm> m_aqm;
+  std::deque<QueuedPacket> m_sendQueue;
+  /// octets in the send queue
+  size_t m_sendQueueSize = 0;
+  /// polls the transport send queue length while packets are waiting in the send queue
+  TimerWheel::Timer m_drainTimer;
+
   friend LpReliability;
 };
 
@@ -0,0 +1,93 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "io-thread.hpp"
+#include "common/global.hpp"
+#include "common/logger.hpp"
+
+#include <boost/exception/diagnostic_information.hpp>
+
+namespace nfd::face {
+
+NFD_LOG_INIT(IoThread);
+
+IoThread::IoThread(size_t index, boost::asio::io_service& mainIo)
+  : m_index(index)
+  , m_mainIo(mainIo)
+  , m_thread([this] { run(); })
+{
+}
+
+IoThread::~IoThread()
+{
+  m_io.stop();
+  m_thread.join();
+}
+
+void
+IoThread::run()
+{
+  boost::asio::io_service::work work(m_io);
+  try {
+    m_io.run();
+  }
+  catch (const std::exception& e) {
+    NFD_LOG_FATAL("thread=" << m_index << " " << boost::diagnostic_information(e));
+    m_mainIo.stop();
+  }
+}
+
+IoThreadPool* IoThreadPool::s_instance = nullptr;
+
+IoThreadPool::IoThreadPool(size_t nThreads, size_t ringCapacity)
+  : m_ringCapacity(ringCapacity)
+{
+  BOOST_ASSERT(s_instance == nullptr);
+  BOOST_ASSERT(nThreads > 0);
+
+  auto& mainIo = getGlobalIoService();
+  m_threads.reserve(nThreads);
+  for (size_t i = 0; i < nThreads; ++i) {
+    m_threads.push_back(make_shared<IoThread>(i, mainIo));
+  }
+  NFD_LOG_INFO("Started " << nThreads << " I/O threads");
+
+  s_instance = this;
+}
+
+IoThreadPool::~IoThreadPool()
+{
+  s_instance = nullptr;
+}
+
+shared_ptr<IoThread>
+IoThreadPool::next()
+{
+  auto& thread = m_threads[m_next];
+  m_next = (m_next + 1) % m_threads.size();
+  return thread;
+}
+
+} // namespace nfd::face
@@ -0,0 +1,138 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_IO_THREAD_HPP
+#define NFD_DAEMON_FACE_IO_THREAD_HPP
+
+#include "core/common.hpp"
+
+#include <boost/asio/io_service.hpp>
+
+#include <thread>
+
+namespace nfd::face {
+
+/** \brief a thread that performs socket I/O on behalf of transports
+ *
+ *  The thread runs its own io_service. Transports that use it exchange packets with the
+ *  forwarding thread through SPSC rings, so that syscalls and TLV parsing do not compete
+ *  with table lookups on the forwarding thread.
+ */
+class IoThread : noncopyable
+{
+public:
+  /** \param mainIo io_service of the forwarding thread, stopped if the I/O thread fails
+   */
+  IoThread(size_t index, boost::asio::io_service& mainIo);
+
+  /** \brief stop the io_service and join the thread
+   *
+   *  Handlers that have not been invoked are destroyed along with the io_service.
+   */
+  ~IoThread();
+
+  size_t
+  getIndex() const noexcept
+  {
+    return m_index;
+  }
+
+  boost::asio::io_service&
+  getIoService() noexcept
+  {
+    return m_io;
+  }
+
+  boost::asio::io_service&
+  getMainIoService() noexcept
+  {
+    return m_mainIo;
+  }
+
+private:
+  void
+  run();
+
+private:
+  const size_t m_index;
+  boost::asio::io_service& m_mainIo;
+  boost::asio::io_service m_io;
+  std::thread m_thread;
+};
+
+/** \brief a set of I/O threads shared by all transports that support them
+ *
+ *  At most one pool exists at any time. When it exists, newly created datagram transports
+ *  perform their socket I/O on one of its threads, chosen in round-robin fashion.
+ */
+class IoThreadPool : noncopyable
+{
+public:
+  /** \brief create the pool and start \p nThreads threads
+   *  \param ringCapacity capacity of each RX and TX ring of a transport
+   *  \pre no other pool exists, nThreads > 0
+   */
+  IoThreadPool(size_t nThreads, size_t ringCapacity);
+
+  ~IoThreadPool();
+
+  /** \return the pool, or nullptr if none exists
+   */
+  static IoThreadPool*
+  get() noexcept
+  {
+    return s_instance;
+  }
+
+  size_t
+  size() const noexcept
+  {
+    return m_threads.size();
+  }
+
+  size_t
+  getRingCapacity() const noexcept
+  {
+    return m_ringCapacity;
+  }
+
+  /** \brief pick a thread for a new transport
+   *
+   *  The thread stays alive as long as the returned pointer is held, even after the pool is destroyed.
+   */
+  shared_ptr<IoThread>
+  next();
+
+private:
+  std::vector<shared_ptr<IoThread>> m_threads;
+  size_t m_ringCapacity;
+  size_t m_next = 0;
+
+  static IoThreadPool* s_instance;
+};
+
+} // namespace nfd::face
+
+#endif // NFD_DAEMON_FACE_IO_THREAD_HPP
@@ -50,12 +50,31 @@ LinkService::setFaceAndTransport(Face& face, Transport& transport)
   m_transport = &transport;
 }
 
+void
+LinkService::setEgressScheduler(const std::optional<EgressScheduler::Options>& options)
+{
+  if (m_egressScheduler != nullptr) {
+    m_egressScheduler->flush();
+    m_egressScheduler.reset();
+  }
+
+  if (options) {
+    m_egressScheduler = make_unique<EgressScheduler>(*options, [this] (const auto& packet) {
+      sendScheduledPacket(packet);
+    });
+  }
+}
+
 void
 LinkService::sendInterest(const Interest& interest)
 {
   BOOST_ASSERT(m_transport != nullptr);
   NFD_LOG_FACE_TRACE(__func__);
 
+  if (m_egressScheduler != nullptr && !countEgressVerdict(m_egressScheduler->schedule(interest))) {
+    return;
+  }
+
   ++this->nOutInterests;
 
   doSendInterest(interest);
@@ -67,6 +86,10 @@ LinkService::sendData(const Data& data)
   BOOST_ASSERT(m_transport != nullptr);
   NFD_LOG_FACE_TRACE(__func__);
 
+  if (m_egressScheduler != nullptr && !countEgressVerdict(m_egressScheduler->schedule(data))) {
+    return;
+  }
+
   ++this->nOutData;
 
   doSendData(data);
@@ -78,11 +101,52 @@ LinkService::sendNack(const ndn::lp::Nack& nack)
   BOOST_ASSERT(m_transport != nullptr);
   NFD_LOG_FACE_TRACE(__func__);
 
+  if (m_egressScheduler != nullptr && !countEgressVerdict(m_egressScheduler->schedule(nack))) {
+    return;
+  }
+
   ++this->nOutNacks;
 
   doSendNack(nack);
 }
 
+bool
+LinkService::countEgressVerdict(EgressScheduler::Verdict verdict)
+{
+  switch (verdict) {
+    case EgressScheduler::Verdict::SEND:
+      return true;
+    case EgressScheduler::Verdict::QUEUED:
+      ++this->nEgressQueued;
+      return false;
+    case EgressScheduler::Verdict::DROPPED:
+      NFD_LOG_FACE_DEBUG("egress queue full, drop packet");
+      ++this->nEgressDropped;
+      return false;
+  }
+  return false;
+}
+
+void
+LinkService::sendScheduledPacket(const EgressScheduler::Packet& packet)
+{
+  std::visit([this] (const auto& pkt) {
+    using Pkt = std::decay_t<decltype(pkt)>;
+    if constexpr (std::is_same_v<Pkt, Interest>) {
+      ++this->nOutInterests;
+      doSendInterest(pkt);
+    }
+    else if constexpr (std::is_same_v<Pkt, Data>) {
+      ++this->nOutData;
+      doSendData(pkt);
+    }
+    else {
+      ++this->nOutNacks;
+      doSendNack(pkt);
+    }
+  }, packet);
+}
+
 void
 LinkService::receiveInterest(const Interest& interest, const EndpointId& endpoint)
 {
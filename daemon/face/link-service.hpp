@@ -26,6 +26,7 @@
 #ifndef NFD_DAEMON_FACE_LINK_SERVICE_HPP
 #define NFD_DAEMON_FACE_LINK_SERVICE_HPP
 
+#include "egress-scheduler.hpp"
 #include "face-common.hpp"
 #include "transport.hpp"
 #include "common/counter.hpp"
@@ -66,6 +67,14 @@ public:
   /** \brief count of outgoing Nacks
    */
   PacketCounter nOutNacks;
+
+  /** \brief count of outgoing packets delayed in the queues of the egress scheduler
+   */
+  PacketCounter nEgressQueued;
+
+  /** \brief count of outgoing packets dropped by the egress scheduler because their queue was full
+   */
+  PacketCounter nEgressDropped;
 };
 
 /** \brief the upper part of a Face
@@ -112,6 +121,21 @@ public:
   virtual ssize_t
   getEffectiveMtu() const;
 
+  /** \brief enables the egress scheduler with \p options, or disables it if \p options is nullopt
+   *
+   *  Packets waiting in a scheduler that is disabled or replaced are sent right away.
+   */
+  void
+  setEgressScheduler(const std::optional<EgressScheduler::Options>& options);
+
+  /** \return the egress scheduler, or nullptr if outgoing packets are not scheduled
+   */
+  const EgressScheduler*
+  getEgressScheduler() const
+  {
+    return m_egressScheduler.get();
+  }
+
 public: // upper interface to be used by forwarding
   /** \brief Send Interest
    *  \pre setTransport has been called
@@ -175,6 +199,11 @@ protected: // lower interface to be invoked in subclass (send path termination)
   void
   sendPacket(const Block& packet);
 
+  /** \brief send a lower-layer packet gathered from a header and a payload via Transport
+   */
+  void
+  sendPacket(const GatheredPacket& packet);
+
 protected:
   void
   notifyDroppedInterest(const Interest& packet);
@@ -199,9 +228,22 @@ private: // lower interface to be overridden in subclass
   virtual void
   doReceivePacket(const Block& packet, const EndpointId& endpoint) = 0;
 
+private:
+  /** \brief counts the decision of the egress scheduler about an outgoing packet
+   *  \retval true the packet should be sent right away
+   */
+  bool
+  countEgressVerdict(EgressScheduler::Verdict verdict);
+
+  /** \brief sends a packet released by the egress scheduler
+   */
+  void
+  sendScheduledPacket(const EgressScheduler::Packet& packet);
+
 private:
   Face* m_face;
   Transport* m_transport;
+  unique_ptr<EgressScheduler> m_egressScheduler;
 };
 
 inline const Face*
@@ -246,6 +288,12 @@ LinkService::sendPacket(const Block& packet)
   m_transport->send(packet);
 }
 
+inline void
+LinkService::sendPacket(const GatheredPacket& packet)
+{
+  m_transport->send(packet);
+}
+
 std::ostream&
 operator<<(std::ostream& os, const FaceLogHelper<LinkService>& flh);
 
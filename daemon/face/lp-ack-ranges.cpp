@@ -0,0 +1,78 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "lp-ack-ranges.hpp"
+
+namespace nfd::face {
+
+AckRanges::AckRanges(const Block& wire)
+{
+  wireDecode(wire);
+}
+
+void
+AckRanges::wireDecode(const Block& wire)
+{
+  if (wire.type() != TLV_TYPE) {
+    NDN_THROW(tlv::Error("AckRanges", wire.type()));
+  }
+
+  m_ranges.clear();
+  m_valueSize = wire.value_size();
+
+  auto begin = wire.value_begin();
+  auto end = wire.value_end();
+  while (begin != end) {
+    uint64_t gap = 0;
+    uint64_t count = 0;
+    if (!tlv::readVarNumber(begin, end, gap) || !tlv::readVarNumber(begin, end, count)) {
+      NDN_THROW(tlv::Error("Truncated AckRanges"));
+    }
+    if (count == 0) {
+      NDN_THROW(tlv::Error("AckRanges cannot contain an empty range"));
+    }
+
+    lp::Sequence first = m_ranges.empty() ? gap : m_ranges.back().first + m_ranges.back().count + gap;
+    m_ranges.push_back({first, count});
+  }
+}
+
+bool
+AckRanges::append(lp::Sequence first, uint64_t count, size_t maxSize)
+{
+  BOOST_ASSERT(count > 0);
+
+  lp::Sequence gap = m_ranges.empty() ? first : first - (m_ranges.back().first + m_ranges.back().count);
+  size_t valueSize = m_valueSize + tlv::sizeOfVarNumber(gap) + tlv::sizeOfVarNumber(count);
+  if (tlv::sizeOfVarNumber(TLV_TYPE) + tlv::sizeOfVarNumber(valueSize) + valueSize > maxSize) {
+    return false;
+  }
+
+  m_ranges.push_back({first, count});
+  m_valueSize = valueSize;
+  return true;
+}
+
+} // namespace nfd::face
@@ -0,0 +1,133 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_LP_ACK_RANGES_HPP
+#define NFD_DAEMON_FACE_LP_ACK_RANGES_HPP
+
+#include "face-common.hpp"
+
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+#include <ndn-cxx/lp/field-decl.hpp>
+#include <ndn-cxx/lp/sequence.hpp>
+
+namespace nfd::face {
+
+/**
+ * \brief Represents an AckRanges header field, which acknowledges ranges of TxSequence numbers
+ *
+ * \code
+ * AckRanges = ACK-RANGES-TYPE TLV-LENGTH *(Gap Count)
+ * Gap       = VAR-NUMBER
+ * Count     = VAR-NUMBER ; at least 1
+ * \endcode
+ *
+ * Ranges are in ascending order. The first Gap is the first TxSequence of the first range, and
+ * every other Gap is the distance from the end of the previous range to the first TxSequence of
+ * the range. An LpPacket that carries a TxSequence and an AckRanges field, possibly empty,
+ * indicates that its sender understands AckRanges.
+ *
+ * ACK-RANGES-TYPE is an ignorable header field type, so that peers without support for this
+ * extension skip it.
+ */
+class AckRanges
+{
+public:
+  static constexpr uint64_t TLV_TYPE = 852;
+
+  struct Range
+  {
+    lp::Sequence first;
+    uint64_t count;
+  };
+
+  AckRanges() = default;
+
+  explicit
+  AckRanges(const Block& wire);
+
+  template<ndn::encoding::Tag TAG>
+  size_t
+  wireEncode(ndn::EncodingImpl<TAG>& encoder) const;
+
+  /** \throw ndn::tlv::Error the field is malformed
+   */
+  void
+  wireDecode(const Block& wire);
+
+  bool
+  empty() const
+  {
+    return m_ranges.empty();
+  }
+
+  const std::vector<Range>&
+  getRanges() const
+  {
+    return m_ranges;
+  }
+
+  /** \brief append a range if the encoded field stays within \p maxSize octets
+   *  \pre \p count is at least 1, and \p first is not before the end of the last range
+   *  \return whether the range was appended
+   */
+  bool
+  append(lp::Sequence first, uint64_t count, size_t maxSize = std::numeric_limits<size_t>::max());
+
+  /** \return size of the encoded field
+   */
+  size_t
+  size() const
+  {
+    return tlv::sizeOfVarNumber(TLV_TYPE) + tlv::sizeOfVarNumber(m_valueSize) + m_valueSize;
+  }
+
+private:
+  std::vector<Range> m_ranges;
+  size_t m_valueSize = 0;
+};
+
+template<ndn::encoding::Tag TAG>
+size_t
+AckRanges::wireEncode(ndn::EncodingImpl<TAG>& encoder) const
+{
+  size_t length = 0;
+  for (size_t i = m_ranges.size(); i-- > 0;) {
+    lp::Sequence gap = i == 0 ? m_ranges[i].first
+                              : m_ranges[i].first - (m_ranges[i - 1].first + m_ranges[i - 1].count);
+    length += encoder.prependVarNumber(m_ranges[i].count);
+    length += encoder.prependVarNumber(gap);
+  }
+  length += encoder.prependVarNumber(length);
+  length += encoder.prependVarNumber(TLV_TYPE);
+  return length;
+}
+
+/** \brief declares AckRanges as an NDNLPv2 header field
+ */
+using AckRangesField = lp::FieldDecl<lp::field_location_tags::Header, AckRanges, AckRanges::TLV_TYPE>;
+
+} // namespace nfd::face
+
+#endif // NFD_DAEMON_FACE_LP_ACK_RANGES_HPP
@@ -26,6 +26,7 @@
 #include "lp-fragmenter.hpp"
 #include "link-service.hpp"
 
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
 #include <ndn-cxx/encoding/tlv.hpp>
 
 namespace nfd::face {
@@ -74,18 +75,19 @@ LpFragmenter::getLinkService() const
   return m_linkService;
 }
 
-std::tuple<bool, std::vector<lp::Packet>>
-LpFragmenter::fragmentPacket(const lp::Packet& packet, size_t mtu)
+std::tuple<bool, LpFragmenter::Layout>
+LpFragmenter::computeLayout(const lp::Packet& packet, size_t mtu) const
 {
   BOOST_ASSERT(packet.has<lp::FragmentField>());
   BOOST_ASSERT(!packet.has<lp::FragIndexField>());
   BOOST_ASSERT(!packet.has<lp::FragCountField>());
 
-  if (MAX_SINGLE_FRAG_OVERHEAD + packet.wireEncode().size() <= mtu) {
+  const auto& packetWire = packet.wireEncode();
+  if (MAX_SINGLE_FRAG_OVERHEAD + packetWire.size() <= mtu) {
     // fast path: fragmentation not needed
     // To qualify for fast path, the packet must have space for adding a sequence number,
     // because another NDNLPv2 feature may require the sequence number.
-    return {true, {packet}};
+    return {true, {false, 0, 0, 1}};
   }
 
   auto [netPktBegin, netPktEnd] = packet.get<lp::FragmentField>();
@@ -93,7 +95,6 @@ LpFragmenter::fragmentPacket(const lp::Packet& packet, size_t mtu)
 
   // compute size of other NDNLPv2 headers to be placed on the first fragment
   size_t firstHeaderSize = 0;
-  const auto& packetWire = packet.wireEncode();
   if (packetWire.type() == lp::tlv::LpPacket) {
     for (const auto& element : packetWire.elements()) {
       if (element.type() != lp::tlv::Fragment) {
@@ -118,28 +119,104 @@ LpFragmenter::fragmentPacket(const lp::Packet& packet, size_t mtu)
     return {false, {}};
   }
 
+  return {true, {true, firstPayloadSize, payloadSize, fragCount}};
+}
+
+std::tuple<bool, std::vector<lp::Packet>>
+LpFragmenter::fragmentPacket(const lp::Packet& packet, size_t mtu)
+{
+  auto [isOk, layout] = computeLayout(packet, mtu);
+  if (!isOk) {
+    return {false, {}};
+  }
+  if (!layout.needsFragmentation) {
+    return {true, {packet}};
+  }
+
   // populate fragments
-  std::vector<lp::Packet> frags(fragCount);
+  auto [netPktBegin, netPktEnd] = packet.get<lp::FragmentField>();
+  std::vector<lp::Packet> frags(layout.fragCount);
   frags.front() = packet; // copy input packet to preserve other NDNLPv2 fields
   size_t fragIndex = 0;
   auto fragBegin = netPktBegin,
-       fragEnd = fragBegin + firstPayloadSize;
+       fragEnd = fragBegin + layout.firstPayloadSize;
   while (fragBegin < netPktEnd) {
     lp::Packet& frag = frags[fragIndex];
     frag.add<lp::FragIndexField>(fragIndex);
-    frag.add<lp::FragCountField>(fragCount);
+    frag.add<lp::FragCountField>(layout.fragCount);
     frag.set<lp::FragmentField>({fragBegin, fragEnd});
     BOOST_ASSERT(frag.wireEncode().size() <= mtu);
 
     ++fragIndex;
     fragBegin = fragEnd;
-    fragEnd = std::min(netPktEnd, fragBegin + payloadSize);
+    fragEnd = std::min(netPktEnd, fragBegin + layout.payloadSize);
+  }
+  BOOST_ASSERT(fragIndex == layout.fragCount);
+
+  return {true, frags};
+}
+
+std::tuple<bool, std::vector<LpFragmenter::FragmentSlice>>
+LpFragmenter::fragmentPacketZeroCopy(const lp::Packet& packet, size_t mtu)
+{
+  auto [isOk, layout] = computeLayout(packet, mtu);
+  if (!isOk) {
+    return {false, {}};
+  }
+  if (!layout.needsFragmentation) {
+    return {true, {}};
+  }
+
+  // the fragments refer to the Fragment element of the wire encoding, which owns its buffer
+  Block packetWire = packet.wireEncode();
+  packetWire.parse();
+  auto fragElement = packetWire.find(lp::tlv::Fragment);
+  BOOST_ASSERT(fragElement != packetWire.elements_end());
+  span<const uint8_t> netPkt(fragElement->value(), fragElement->value_size());
+
+  // the first fragment carries the other NDNLPv2 fields of the input packet
+  lp::Packet firstHeader(packet);
+  firstHeader.remove<lp::FragmentField>();
+
+  std::vector<FragmentSlice> frags;
+  frags.reserve(layout.fragCount);
+  size_t offset = 0;
+  size_t fragSize = layout.firstPayloadSize;
+  for (size_t fragIndex = 0; fragIndex < layout.fragCount; ++fragIndex) {
+    lp::Packet header = fragIndex == 0 ? std::move(firstHeader) : lp::Packet();
+    header.add<lp::FragIndexField>(fragIndex);
+    header.add<lp::FragCountField>(layout.fragCount);
+    frags.push_back({std::move(header), fragElement->getBuffer(), netPkt.subspan(offset, fragSize)});
+    BOOST_ASSERT(frags.back().encode().size() <= mtu);
+
+    offset += fragSize;
+    fragSize = std::min(netPkt.size() - offset, layout.payloadSize);
   }
-  BOOST_ASSERT(fragIndex == fragCount);
+  BOOST_ASSERT(offset == netPkt.size());
 
   return {true, frags};
 }
 
+GatheredPacket
+LpFragmenter::FragmentSlice::encode() const
+{
+  // header contains only header fields; the Fragment TLV-TYPE and TLV-LENGTH are appended
+  // and the TLV-LENGTH of LpPacket covers the payload too
+  Block headerWire = header.wireEncode();
+  size_t fragmentTlSize = tlv::sizeOfVarNumber(lp::tlv::Fragment) + tlv::sizeOfVarNumber(payload.size());
+  size_t lpLength = headerWire.value_size() + fragmentTlSize + payload.size();
+
+  ndn::EncodingBuffer encoder(tlv::sizeOfVarNumber(lp::tlv::LpPacket) + tlv::sizeOfVarNumber(lpLength) +
+                              headerWire.value_size() + fragmentTlSize, 0);
+  encoder.prependVarNumber(payload.size());
+  encoder.prependVarNumber(lp::tlv::Fragment);
+  encoder.prependBytes({headerWire.value(), headerWire.value_size()});
+  encoder.prependVarNumber(lpLength);
+  encoder.prependVarNumber(lp::tlv::LpPacket);
+
+  return {encoder.getBuffer(), {encoder.data(), encoder.size()}, buffer, payload};
+}
+
 std::ostream&
 operator<<(std::ostream& os, const FaceLogHelper<LpFragmenter>& flh)
 {
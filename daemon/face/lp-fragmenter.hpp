@@ -47,6 +47,23 @@ public:
     size_t nMaxFragments = 400;
   };
 
+  /** \brief a fragment that refers to a slice of the network-layer packet
+   *         instead of containing a copy of it
+   */
+  struct FragmentSlice
+  {
+    /** \brief encodes the fragment, copying only its header
+     *  \return the LpPacket TLV-TYPE and TLV-LENGTH, the header fields, and the Fragment
+     *          TLV-TYPE and TLV-LENGTH, followed by a reference to the payload
+     */
+    GatheredPacket
+    encode() const;
+
+    lp::Packet header; ///< NDNLPv2 header fields of the fragment, without Fragment field
+    ndn::ConstBufferPtr buffer; ///< owns the memory of \p payload
+    span<const uint8_t> payload; ///< slice of the network-layer packet carried by the fragment
+  };
+
   explicit
   LpFragmenter(const Options& options, const LinkService* linkService = nullptr);
 
@@ -71,6 +88,38 @@ public:
   std::tuple<bool, std::vector<lp::Packet>>
   fragmentPacket(const lp::Packet& packet, size_t mtu);
 
+  /** \brief fragments a network-layer packet into slices that refer to its wire encoding
+   *
+   *  The fragments are the same as those produced by fragmentPacket(), but the network-layer
+   *  packet is never copied: each fragment is sent as its encoded header followed by a slice of
+   *  \p packet, with Transport::send(const GatheredPacket&).
+   *
+   *  \param packet an LpPacket that contains a network-layer packet;
+   *                must have Fragment field, must not have FragIndex and FragCount fields
+   *  \param mtu maximum allowable LpPacket size after fragmentation and sequence number assignment
+   *  \return whether fragmentation succeeded, fragments without sequence number;
+   *          no fragment if the packet does not need fragmentation and can be sent as is
+   */
+  std::tuple<bool, std::vector<FragmentSlice>>
+  fragmentPacketZeroCopy(const lp::Packet& packet, size_t mtu);
+
+private:
+  /** \brief how a network-layer packet is divided into fragments
+   */
+  struct Layout
+  {
+    bool needsFragmentation; ///< if false, the packet is sent as is and other fields are unset
+    size_t firstPayloadSize; ///< payload size of the first fragment
+    size_t payloadSize; ///< payload size of other fragments, except the last one may be smaller
+    size_t fragCount;
+  };
+
+  /** \brief computes how \p packet is divided into fragments of at most \p mtu octets
+   *  \return whether fragmentation succeeded, the layout
+   */
+  std::tuple<bool, Layout>
+  computeLayout(const lp::Packet& packet, size_t mtu) const;
+
 private:
   Options m_options;
   const LinkService* m_linkService;
@@ -27,8 +27,6 @@
 #include "link-service.hpp"
 #include "common/global.hpp"
 
-#include <numeric>
-
 namespace nfd::face {
 
 NFD_LOG_INIT(LpReassembler);
@@ -80,12 +78,34 @@ LpReassembler::receiveFragment(EndpointId remoteEndpoint, const lp::Packet& pack
   lp::Sequence messageIdentifier = packet.get<lp::SequenceField>() - fragIndex;
   Key key(remoteEndpoint, messageIdentifier);
 
+  auto [fragBegin, fragEnd] = packet.get<lp::FragmentField>();
+  size_t fragSize = static_cast<size_t>(std::distance(fragBegin, fragEnd));
+
+  // all fragments but the last have the same size, so the fragments before the last one
+  // alone would exceed the maximum packet size
+  if (fragIndex + 1 < fragCount && (fragCount - 1) * fragSize > ndn::MAX_NDN_PACKET_SIZE) {
+    NFD_LOG_FACE_WARN("reassembly error, packet over size limit: DROP");
+    m_partialPackets.erase(key);
+    return {false, {}, {}};
+  }
+
   // add to PartialPacket
   PartialPacket& pp = m_partialPackets[key];
   if (pp.fragCount == 0) { // new PartialPacket
     pp.fragCount = fragCount;
-    pp.nReceivedFragments = 0;
-    pp.fragments.resize(fragCount);
+    pp.fragSizes.assign(fragCount, NOT_RECEIVED);
+    pp.fragOffsets.assign(fragCount, 0);
+    // size the slots after this fragment; unless it is the last one, the other fragments
+    // are normally no larger
+    size_t slotSize = std::max<size_t>(fragSize, 1);
+    if (fragCount * slotSize <= ndn::MAX_NDN_PACKET_SIZE) {
+      pp.slotSize = slotSize;
+      pp.buffer = make_shared<ndn::Buffer>(fragCount * slotSize);
+    }
+    else {
+      pp.buffer = make_shared<ndn::Buffer>();
+      pp.buffer->reserve(ndn::MAX_NDN_PACKET_SIZE);
+    }
   }
   else {
     if (fragCount != pp.fragCount) {
@@ -94,46 +114,114 @@ LpReassembler::receiveFragment(EndpointId remoteEndpoint, const lp::Packet& pack
     }
   }
 
-  if (pp.fragments[fragIndex].has<lp::SequenceField>()) {
+  if (pp.fragSizes[fragIndex] != NOT_RECEIVED) {
     NFD_LOG_FACE_TRACE("fragment already received: DROP");
     return {false, {}, {}};
   }
 
-  pp.fragments[fragIndex] = packet;
+  if (pp.nReceivedOctets + fragSize > ndn::MAX_NDN_PACKET_SIZE) {
+    NFD_LOG_FACE_WARN("reassembly error, packet over size limit: DROP");
+    m_partialPackets.erase(key);
+    return {false, {}, {}};
+  }
+
+  if (pp.slotSize > 0 && fragSize > pp.slotSize) {
+    growSlots(pp, fragSize);
+  }
+  if (pp.slotSize > 0) {
+    pp.fragOffsets[fragIndex] = fragIndex * pp.slotSize;
+    std::copy(fragBegin, fragEnd, pp.buffer->begin() + pp.fragOffsets[fragIndex]);
+  }
+  else {
+    // the capacity reserved for MAX_NDN_PACKET_SIZE is never exceeded, so this does not reallocate
+    pp.fragOffsets[fragIndex] = pp.buffer->size();
+    pp.buffer->insert(pp.buffer->end(), fragBegin, fragEnd);
+  }
+  pp.fragSizes[fragIndex] = fragSize;
+  pp.nReceivedOctets += fragSize;
   ++pp.nReceivedFragments;
+  if (fragIndex == 0) {
+    pp.firstFragment = packet;
+  }
 
   // check complete condition
   if (pp.nReceivedFragments == pp.fragCount) {
-    Block reassembled = doReassembly(key);
-    lp::Packet firstFrag(std::move(pp.fragments[0]));
-    m_partialPackets.erase(key);
-    return {true, reassembled, firstFrag};
+    // the PartialPacket is erased when the node goes out of scope, even if reassembly fails
+    auto node = m_partialPackets.extract(key);
+    Block reassembled = doReassembly(node.mapped());
+    return {true, reassembled, node.mapped().firstFragment};
   }
 
   // set drop timer
-  pp.dropTimer = getScheduler().schedule(m_options.reassemblyTimeout, [=] { timeoutPartialPacket(key); });
+  getTimerWheel().schedule(pp.dropTimer, m_options.reassemblyTimeout,
+                           [=] { timeoutPartialPacket(key); });
 
   return {false, {}, {}};
 }
 
+void
+LpReassembler::growSlots(PartialPacket& pp, size_t slotSize)
+{
+  auto buffer = make_shared<ndn::Buffer>();
+  bool isSlotted = pp.fragCount * slotSize <= ndn::MAX_NDN_PACKET_SIZE;
+  if (isSlotted) {
+    buffer->resize(pp.fragCount * slotSize);
+  }
+  else {
+    buffer->reserve(ndn::MAX_NDN_PACKET_SIZE);
+  }
+
+  for (size_t i = 0; i < pp.fragCount; ++i) {
+    if (pp.fragSizes[i] == NOT_RECEIVED) {
+      continue;
+    }
+    auto frag = pp.buffer->begin() + pp.fragOffsets[i];
+    if (isSlotted) {
+      pp.fragOffsets[i] = i * slotSize;
+      std::copy(frag, frag + pp.fragSizes[i], buffer->begin() + pp.fragOffsets[i]);
+    }
+    else {
+      pp.fragOffsets[i] = buffer->size();
+      buffer->insert(buffer->end(), frag, frag + pp.fragSizes[i]);
+    }
+  }
+  pp.buffer = std::move(buffer);
+  pp.slotSize = isSlotted ? slotSize : 0;
+}
+
 Block
-LpReassembler::doReassembly(const Key& key)
+LpReassembler::doReassembly(PartialPacket& pp)
 {
-  PartialPacket& pp = m_partialPackets[key];
+  // the gaps between fragments can be closed in place if no fragment is stored before
+  // the position it takes in the packet; this holds for slots, and for fragments appended
+  // in order, in which case it is a no-op if all fragments but the last have the same size
+  bool canCompactInPlace = true;
+  size_t pos = 0;
+  for (size_t i = 0; i < pp.fragCount && canCompactInPlace; ++i) {
+    canCompactInPlace = pp.fragOffsets[i] >= pos;
+    pos += pp.fragSizes[i];
+  }
 
-  size_t payloadSize = std::accumulate(pp.fragments.begin(), pp.fragments.end(), 0U,
-    [&] (size_t sum, const lp::Packet& pkt) -> size_t {
-      auto [fragBegin, fragEnd] = pkt.get<lp::FragmentField>();
-      return sum + std::distance(fragBegin, fragEnd);
-    });
+  if (!canCompactInPlace) {
+    auto buffer = make_shared<ndn::Buffer>(pp.nReceivedOctets);
+    auto it = buffer->begin();
+    for (size_t i = 0; i < pp.fragCount; ++i) {
+      auto frag = pp.buffer->begin() + pp.fragOffsets[i];
+      it = std::copy(frag, frag + pp.fragSizes[i], it);
+    }
+    return Block(buffer);
+  }
 
-  ndn::Buffer fragBuffer(payloadSize);
-  auto it = fragBuffer.begin();
-  for (const lp::Packet& frag : pp.fragments) {
-    auto [fragBegin, fragEnd] = frag.get<lp::FragmentField>();
-    it = std::copy(fragBegin, fragEnd, it);
+  auto it = pp.buffer->begin();
+  for (size_t i = 0; i < pp.fragCount; ++i) {
+    auto frag = pp.buffer->begin() + pp.fragOffsets[i];
+    if (it != frag) {
+      std::copy(frag, frag + pp.fragSizes[i], it);
+    }
+    it += pp.fragSizes[i];
   }
-  return Block(fragBuffer);
+
+  return Block(pp.buffer, pp.buffer->cbegin(), it);
 }
 
 void
@@ -148,6 +236,16 @@ LpReassembler::timeoutPartialPacket(const Key& key)
   m_partialPackets.erase(it);
 }
 
+size_t
+LpReassembler::getBufferCapacity() const
+{
+  size_t capacity = 0;
+  for (const auto& [key, pp] : m_partialPackets) {
+    capacity += pp.buffer->capacity();
+  }
+  return capacity;
+}
+
 std::ostream&
 operator<<(std::ostream& os, const FaceLogHelper<LpReassembler>& flh)
 {
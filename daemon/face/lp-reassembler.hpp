@@ -27,13 +27,28 @@
 #define NFD_DAEMON_FACE_LP_REASSEMBLER_HPP
 
 #include "face-common.hpp"
+#include "common/timer-wheel.hpp"
+#include "common/wyhash.hpp"
 
 #include <ndn-cxx/lp/packet.hpp>
 
+#include <unordered_map>
+
 namespace nfd::face {
 
 /**
  * \brief Reassembles fragmented network-layer packets
+ *
+ * The payloads of the fragments of a packet are copied directly into one contiguous buffer,
+ * which is allocated when the first fragment arrives and holds FragCount slots as large as
+ * that fragment. Fragment \p i is placed at offset \p i times the slot size, so that the
+ * packet is complete without further copying when all fragments but the last have the same
+ * size, as produced by LpFragmenter. If the slots would not fit in ndn::MAX_NDN_PACKET_SIZE,
+ * fragments are instead appended to the buffer in arrival order, and reordered when the packet
+ * is complete. Either way, the buffer of a partial packet never exceeds MAX_NDN_PACKET_SIZE,
+ * and a packet whose fragments exceed it is dropped. Partial packets are dropped by a
+ * TimerWheel timer.
+ *
  * \sa https://redmine.named-data.net/projects/nfd/wiki/NDNLPv2
  */
 class LpReassembler : noncopyable
@@ -97,16 +112,25 @@ public:
 
 private:
   /**
-   * \brief Holds all fragments of packet until reassembled
+   * \brief Holds the payloads of received fragments until the packet is reassembled
    */
   struct PartialPacket
   {
-    std::vector<lp::Packet> fragments;
-    size_t fragCount; ///< total fragments
-    size_t nReceivedFragments; ///< number of received fragments
-    scheduler::ScopedEventId dropTimer;
+    shared_ptr<ndn::Buffer> buffer;
+    /// if nonzero, fragment i is placed at offset i * slotSize;
+    /// if zero, fragments are appended to the buffer in arrival order
+    size_t slotSize = 0;
+    std::vector<size_t> fragSizes; ///< payload size of each fragment, or NOT_RECEIVED
+    std::vector<size_t> fragOffsets; ///< offset of each received fragment in the buffer
+    size_t nReceivedOctets = 0; ///< total payload size of received fragments
+    lp::Packet firstFragment; ///< kept for inspecting other NDNLPv2 headers
+    size_t fragCount = 0; ///< total fragments
+    size_t nReceivedFragments = 0; ///< number of received fragments
+    TimerWheel::Timer dropTimer;
   };
 
+  static constexpr size_t NOT_RECEIVED = std::numeric_limits<size_t>::max();
+
   /**
    * \brief Index key for PartialPackets
    */
@@ -115,16 +139,43 @@ private:
     lp::Sequence // message identifier (sequence of the first fragment)
   >;
 
-  Block
-  doReassembly(const Key& key);
+  struct KeyHash
+  {
+    size_t
+    operator()(const Key& key) const noexcept
+    {
+      lp::Sequence messageIdentifier = std::get<1>(key);
+      return wyhash::hash64(&messageIdentifier, sizeof(messageIdentifier), std::get<0>(key));
+    }
+  };
+
+  /**
+   * \brief Moves the fragments of \p pp into a new buffer with larger slots,
+   *        or appends them in a new buffer if the slots would not fit in MAX_NDN_PACKET_SIZE
+   */
+  static void
+  growSlots(PartialPacket& pp, size_t slotSize);
+
+  /**
+   * \brief Concatenates the fragments of a complete packet
+   * \throw tlv::Error the reassembled packet is malformed
+   */
+  static Block
+  doReassembly(PartialPacket& pp);
 
   void
   timeoutPartialPacket(const Key& key);
 
+NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /** \return octets allocated for the buffers of all partial packets
+   */
+  size_t
+  getBufferCapacity() const;
+
 private:
   Options m_options;
   const LinkService* m_linkService;
-  std::map<Key, PartialPacket> m_partialPackets;
+  std::unordered_map<Key, PartialPacket, KeyHash> m_partialPackets;
 };
 
 std::ostream&
@@ -32,10 +32,14 @@ namespace nfd::face {
 
 NFD_LOG_INIT(LpReliability);
 
+// Ack TLV-TYPE (3 octets) + TLV-LENGTH (1 octet) + lp::Sequence (8 octets)
+constexpr ssize_t ACK_SIZE = tlv::sizeOfVarNumber(lp::tlv::Ack) +
+                             tlv::sizeOfVarNumber(sizeof(lp::Sequence)) +
+                             sizeof(lp::Sequence);
+
 LpReliability::LpReliability(const LpReliability::Options& options, GenericLinkService* linkService)
   : m_options(options)
   , m_linkService(linkService)
-  , m_firstUnackedFrag(m_unackedFrags.begin())
   , m_lastTxSeqNo(-1) // set to "-1" to start TxSequence numbers at 0
 {
   BOOST_ASSERT(m_linkService != nullptr);
@@ -65,8 +69,8 @@ LpReliability::handleOutgoing(std::vector<lp::Packet>& frags, lp::Packet&& pkt,
 {
   BOOST_ASSERT(m_options.isEnabled);
 
-  auto unackedFragsIt = m_unackedFrags.begin();
   auto sendTime = time::steady_clock::now();
+  auto rtoDeadline = computeRtoDeadline();
 
   auto netPkt = make_shared<NetPkt>(std::move(pkt), isInterest);
   netPkt->unackedFrags.reserve(frags.size());
@@ -79,23 +83,20 @@ LpReliability::handleOutgoing(std::vector<lp::Packet>& frags, lp::Packet&& pkt,
     lp::Sequence txSeq = assignTxSequence(frag);
 
     // Store LpPacket for future retransmissions
-    unackedFragsIt = m_unackedFrags.try_emplace(unackedFragsIt, txSeq, frag);
-    unackedFragsIt->second.sendTime = sendTime;
-    auto rto = m_rttEst.getEstimatedRto();
-    lp::Sequence seq = frag.get<lp::SequenceField>();
-    NFD_LOG_FACE_TRACE("transmitting seq=" << seq << ", txseq=" << txSeq << ", rto=" <<
-                       time::duration_cast<time::milliseconds>(rto).count() << "ms");
-    unackedFragsIt->second.rtoTimer = getScheduler().schedule(rto, [=] {
-      onLpPacketLost(txSeq, true);
-    });
-    unackedFragsIt->second.netPkt = netPkt;
-
-    if (m_unackedFrags.size() == 1) {
-      m_firstUnackedFrag = m_unackedFrags.begin();
-    }
+    auto& unackedFrag = m_unackedFrags.emplace(txSeq, frag);
+    unackedFrag.sendTime = sendTime;
+    unackedFrag.rtoDeadline = rtoDeadline;
+    unackedFrag.netPkt = netPkt;
+    NFD_LOG_FACE_TRACE("transmitting seq=" << frag.get<lp::SequenceField>() << ", txseq=" << txSeq <<
+                       ", rto=" << time::duration_cast<time::milliseconds>(rtoDeadline - sendTime).count() <<
+                       "ms");
 
     // Add to associated NetPkt
-    netPkt->unackedFrags.push_back(unackedFragsIt);
+    netPkt->unackedFrags.push_back(txSeq);
+  }
+
+  if (!m_rtoTimer) {
+    scheduleRtoTimer();
   }
 }
 
@@ -109,52 +110,12 @@ LpReliability::processIncomingPacket(const lp::Packet& pkt)
 
   // Extract and parse Acks
   for (lp::Sequence ackTxSeq : pkt.list<lp::AckField>()) {
-    auto fragIt = m_unackedFrags.find(ackTxSeq);
-    if (fragIt == m_unackedFrags.end()) {
-      // Ignore an Ack for an unknown TxSequence number
-      NFD_LOG_FACE_DEBUG("received ack for unknown txseq=" << ackTxSeq);
-      continue;
-    }
-    auto& frag = fragIt->second;
-
-    // Cancel the RTO timer for the acknowledged fragment
-    frag.rtoTimer.cancel();
-
-    if (frag.retxCount == 0) {
-      NFD_LOG_FACE_TRACE("received ack for seq=" << frag.pkt.get<lp::SequenceField>() << ", txseq=" <<
-                         ackTxSeq << ", retx=0, rtt=" <<
-                         time::duration_cast<time::milliseconds>(now - frag.sendTime).count() << "ms");
-      // This sequence had no retransmissions, so use it to estimate the RTO
-      m_rttEst.addMeasurement(now - frag.sendTime);
-    }
-    else {
-      NFD_LOG_FACE_TRACE("received ack for seq=" << frag.pkt.get<lp::SequenceField>() << ", txseq=" <<
-                         ackTxSeq << ", retx=" << frag.retxCount);
-    }
+    processAck(ackTxSeq, now);
+  }
 
-    // Look for frags with TxSequence numbers < ackTxSeq (allowing for wraparound) and consider
-    // them lost if a configurable number of Acks containing greater TxSequence numbers have been
-    // received.
-    auto lostLpPackets = findLostLpPackets(fragIt);
-
-    // Remove the fragment from the map of unacknowledged fragments and from its associated network
-    // packet. Potentially increment the start of the window.
-    onLpPacketAcknowledged(fragIt);
-
-    // This set contains TxSequences that have been removed by onLpPacketLost below because they
-    // were part of a network packet that was removed due to a fragment exceeding retx, as well as
-    // any other TxSequences removed by onLpPacketLost. This prevents onLpPacketLost from being
-    // called later for an invalid iterator.
-    std::set<lp::Sequence> removedLpPackets;
-
-    // Resend or fail fragments considered lost. Potentially increment the start of the window.
-    for (lp::Sequence txSeq : lostLpPackets) {
-      if (removedLpPackets.find(txSeq) == removedLpPackets.end()) {
-        auto removedTxSeqs = onLpPacketLost(txSeq, false);
-        for (auto removedTxSeq : removedTxSeqs) {
-          removedLpPackets.insert(removedTxSeq);
-        }
-      }
+  if (m_options.allowAckRanges && pkt.has<AckRangesField>()) {
+    for (const auto& range : pkt.get<AckRangesField>().getRanges()) {
+      processAckRange(range, now);
     }
   }
 
@@ -162,29 +123,116 @@ LpReliability::processIncomingPacket(const lp::Packet& pkt)
   if (pkt.has<lp::FragmentField>() && pkt.has<lp::TxSequenceField>()) {
     NFD_LOG_FACE_TRACE("queueing ack for remote txseq=" << pkt.get<lp::TxSequenceField>());
     m_ackQueue.push(pkt.get<lp::TxSequenceField>());
+    m_isPeerAckRangesCapable = m_options.allowAckRanges && pkt.has<AckRangesField>();
+
+    if (m_lastRecvTime != time::steady_clock::TimePoint()) {
+      // exponentially weighted moving average with a weight of 1/8 for the new sample
+      time::nanoseconds interval = now - m_lastRecvTime;
+      m_recvInterval = m_recvInterval == 0_ns ? interval : (m_recvInterval * 7 + interval) / 8;
+    }
+    m_lastRecvTime = now;
 
     // Check for received frames with duplicate Sequences
     if (pkt.has<lp::SequenceField>()) {
       lp::Sequence pktSequence = pkt.get<lp::SequenceField>();
       isDuplicate = m_recentRecvSeqs.count(pktSequence) > 0;
       // Check for recent received Sequences to remove
-      auto now = time::steady_clock::now();
       auto rto = m_rttEst.getEstimatedRto();
-      while (!m_recentRecvSeqsQueue.empty() &&
-             now > m_recentRecvSeqs[m_recentRecvSeqsQueue.front()] + rto) {
-        m_recentRecvSeqs.erase(m_recentRecvSeqsQueue.front());
+      while (!m_recentRecvSeqsQueue.empty() && now > m_recentRecvSeqsQueue.front().second + rto) {
+        m_recentRecvSeqs.erase(m_recentRecvSeqsQueue.front().first);
         m_recentRecvSeqsQueue.pop();
       }
-      m_recentRecvSeqs.try_emplace(pktSequence, now);
-      m_recentRecvSeqsQueue.push(pktSequence);
+      if (m_recentRecvSeqs.insert(pktSequence)) {
+        m_recentRecvSeqsQueue.emplace(pktSequence, now);
+      }
     }
 
-    startIdleAckTimer();
+    // Send a full batch of Acks right away instead of waiting for the idle Ack timer
+    if (m_ackQueue.size() >= getAckBatchSize()) {
+      NFD_LOG_FACE_TRACE("sending batch of " << m_ackQueue.size() << " acks");
+      m_linkService->requestIdlePacket();
+    }
+
+    if (!m_ackQueue.empty()) {
+      startIdleAckTimer();
+    }
   }
 
   return !isDuplicate;
 }
 
+void
+LpReliability::processAck(lp::Sequence ackTxSeq, time::steady_clock::TimePoint now)
+{
+  auto frag = m_unackedFrags.find(ackTxSeq);
+  if (frag == nullptr) {
+    // Ignore an Ack for an unknown TxSequence number
+    NFD_LOG_FACE_DEBUG("received ack for unknown txseq=" << ackTxSeq);
+    return;
+  }
+
+  if (frag->retxCount == 0) {
+    NFD_LOG_FACE_TRACE("received ack for seq=" << frag->pkt.get<lp::SequenceField>() << ", txseq=" <<
+                       ackTxSeq << ", retx=0, rtt=" <<
+                       time::duration_cast<time::milliseconds>(now - frag->sendTime).count() << "ms");
+    // This sequence had no retransmissions, so use it to estimate the RTO
+    m_rttEst.addMeasurement(now - frag->sendTime);
+  }
+  else {
+    NFD_LOG_FACE_TRACE("received ack for seq=" << frag->pkt.get<lp::SequenceField>() << ", txseq=" <<
+                       ackTxSeq << ", retx=" << frag->retxCount);
+  }
+
+  // Look for frags with TxSequence numbers < ackTxSeq (allowing for wraparound) and consider
+  // them lost if a configurable number of Acks containing greater TxSequence numbers have been
+  // received.
+  auto lostLpPackets = findLostLpPackets(ackTxSeq);
+
+  // Remove the fragment from the window of unacknowledged fragments and from its associated
+  // network packet. Potentially advance the start of the window.
+  onLpPacketAcknowledged(ackTxSeq);
+
+  // Resend or fail fragments considered lost. A fragment may already have been removed by an
+  // earlier iteration, if it belongs to a network packet that exceeded the allowed number of
+  // retransmissions; TxSequences are never reused, so such a fragment is simply not found.
+  for (lp::Sequence txSeq : lostLpPackets) {
+    if (m_unackedFrags.count(txSeq) > 0) {
+      onLpPacketLost(txSeq, false);
+    }
+  }
+}
+
+void
+LpReliability::processAckRange(const AckRanges::Range& range, time::steady_clock::TimePoint now)
+{
+  if (m_unackedFrags.empty()) {
+    return;
+  }
+
+  // Only TxSequences in the current window can be acknowledged; retransmissions triggered by
+  // this range are appended after the current window and must not be matched against it.
+  lp::Sequence windowFirst = m_unackedFrags.getFirstTxSeq();
+  uint64_t windowSpan = m_unackedFrags.getEndTxSeq() - windowFirst;
+  auto processIfInWindow = [&] (lp::Sequence txSeq) {
+    if (txSeq - windowFirst < windowSpan) {
+      processAck(txSeq, now);
+    }
+  };
+
+  if (range.count <= windowSpan) {
+    for (uint64_t i = 0; i < range.count; ++i) {
+      processIfInWindow(range.first + i);
+    }
+  }
+  else {
+    for (uint64_t i = 0; i < windowSpan; ++i) {
+      if (windowFirst + i - range.first < range.count) {
+        processIfInWindow(windowFirst + i);
+      }
+    }
+  }
+}
+
 void
 LpReliability::piggyback(lp::Packet& pkt, ssize_t mtu)
 {
@@ -198,14 +246,21 @@ LpReliability::piggyback(lp::Packet& pkt, ssize_t mtu)
   ssize_t remainingSpace = (mtu == MTU_UNLIMITED ? ndn::MAX_NDN_PACKET_SIZE : mtu) - reservedSpace;
   remainingSpace -= pktSize;
 
+  if (m_options.allowAckRanges && m_isPeerAckRangesCapable) {
+    piggybackAckRanges(pkt, remainingSpace);
+    return;
+  }
+
+  // advertise support for AckRanges on fragments that the peer will acknowledge
+  if (m_options.allowAckRanges && pkt.has<lp::TxSequenceField>() &&
+      static_cast<ssize_t>(ACK_RANGES_RESERVED_SPACE) <= remainingSpace) {
+    pkt.add<AckRangesField>(AckRanges());
+    remainingSpace -= ACK_RANGES_RESERVED_SPACE;
+  }
+
   while (!m_ackQueue.empty()) {
     lp::Sequence ackTxSeq = m_ackQueue.front();
-    // Ack size = Ack TLV-TYPE (3 octets) + TLV-LENGTH (1 octet) + lp::Sequence (8 octets)
-    const ssize_t ackSize = tlv::sizeOfVarNumber(lp::tlv::Ack) +
-                            tlv::sizeOfVarNumber(sizeof(lp::Sequence)) +
-                            sizeof(lp::Sequence);
-
-    if (ackSize > remainingSpace) {
+    if (ACK_SIZE > remainingSpace) {
       break;
     }
 
@@ -213,7 +268,45 @@ LpReliability::piggyback(lp::Packet& pkt, ssize_t mtu)
 
     pkt.add<lp::AckField>(ackTxSeq);
     m_ackQueue.pop();
-    remainingSpace -= ackSize;
+    remainingSpace -= ACK_SIZE;
+  }
+}
+
+void
+LpReliability::piggybackAckRanges(lp::Packet& pkt, ssize_t remainingSpace)
+{
+  std::vector<lp::Sequence> acks;
+  acks.reserve(m_ackQueue.size());
+  while (!m_ackQueue.empty()) {
+    acks.push_back(m_ackQueue.front());
+    m_ackQueue.pop();
+  }
+  std::sort(acks.begin(), acks.end());
+  acks.erase(std::unique(acks.begin(), acks.end()), acks.end());
+
+  AckRanges ackRanges;
+  size_t maxSize = static_cast<size_t>(std::max<ssize_t>(remainingSpace, 0));
+  auto it = acks.begin();
+  while (it != acks.end()) {
+    auto rangeEnd = std::next(it);
+    while (rangeEnd != acks.end() && *rangeEnd == *std::prev(rangeEnd) + 1) {
+      ++rangeEnd;
+    }
+    if (!ackRanges.append(*it, std::distance(it, rangeEnd), maxSize)) {
+      break;
+    }
+    NFD_LOG_FACE_TRACE("piggybacking ack for remote txseq=" << *it << "-" << *std::prev(rangeEnd));
+    it = rangeEnd;
+  }
+
+  // Acks that did not fit are sent in a later packet
+  for (; it != acks.end(); ++it) {
+    m_ackQueue.push(*it);
+  }
+
+  if (!ackRanges.empty() ||
+      (pkt.has<lp::TxSequenceField>() && ackRanges.size() <= maxSize)) {
+    pkt.add<AckRangesField>(ackRanges);
   }
 }
 
@@ -222,12 +315,59 @@ LpReliability::assignTxSequence(lp::Packet& frag)
 {
   lp::Sequence txSeq = ++m_lastTxSeqNo;
   frag.set<lp::TxSequenceField>(txSeq);
-  if (!m_unackedFrags.empty() && m_lastTxSeqNo == m_firstUnackedFrag->first) {
+  if (!m_unackedFrags.empty() && m_lastTxSeqNo == m_unackedFrags.getFirstTxSeq()) {
     NDN_THROW(std::length_error("TxSequence range exceeded"));
   }
   return m_lastTxSeqNo;
 }
 
+time::steady_clock::TimePoint
+LpReliability::computeRtoDeadline()
+{
+  m_lastRtoDeadline = std::max(time::steady_clock::now() + m_rttEst.getEstimatedRto(),
+                               m_lastRtoDeadline);
+  return m_lastRtoDeadline;
+}
+
+void
+LpReliability::scheduleRtoTimer()
+{
+  if (m_unackedFrags.empty()) {
+    m_rtoTimer.cancel();
+    return;
+  }
+
+  auto deadline = m_unackedFrags.at(m_unackedFrags.getFirstTxSeq()).rtoDeadline;
+  auto after = std::max<time::nanoseconds>(deadline - time::steady_clock::now(), 0_ns);
+  getTimerWheel().schedule(m_rtoTimer, after, [this] { onRtoTimerExpired(); });
+}
+
+void
+LpReliability::onRtoTimerExpired()
+{
+  if (m_unackedFrags.empty()) {
+    return;
+  }
+
+  auto now = time::steady_clock::now();
+
+  // Deadlines are non-decreasing in TxSequence order, so the expired fragments are at the start of
+  // the window. Retransmissions are appended after endTxSeq and are not visited again.
+  lp::Sequence endTxSeq = m_unackedFrags.getEndTxSeq();
+  for (lp::Sequence txSeq = m_unackedFrags.getFirstTxSeq(); txSeq != endTxSeq; ++txSeq) {
+    auto frag = m_unackedFrags.find(txSeq);
+    if (frag == nullptr) {
+      continue;
+    }
+    if (frag->rtoDeadline > now) {
+      break;
+    }
+    onLpPacketLost(txSeq, true);
+  }
+
+  scheduleRtoTimer();
+}
+
 void
 LpReliability::startIdleAckTimer()
 {
@@ -236,51 +376,69 @@ LpReliability::startIdleAckTimer()
     return;
   }
 
-  m_idleAckTimer = getScheduler().schedule(m_options.idleAckTimerPeriod, [this] {
+  m_idleAckTimer = getScheduler().schedule(getIdleAckTimerPeriod(), [this] {
     while (!m_ackQueue.empty()) {
       m_linkService->requestIdlePacket();
     }
   });
 }
 
+time::nanoseconds
+LpReliability::getIdleAckTimerPeriod() const
+{
+  if (m_options.ackFrequency == 0 || m_recvInterval == 0_ns) {
+    return m_options.idleAckTimerPeriod;
+  }
+  return std::min(m_recvInterval * static_cast<int64_t>(m_options.ackFrequency),
+                  m_options.idleAckTimerPeriod);
+}
+
+size_t
+LpReliability::getAckBatchSize() const
+{
+  ssize_t mtu = m_linkService->getEffectiveMtu();
+  if (mtu == MTU_UNLIMITED) {
+    mtu = ndn::MAX_NDN_PACKET_SIZE;
+  }
+  // LpPacket TLV-TYPE (1 octet) + TLV-LENGTH (up to 3 octets)
+  size_t batchSize = std::max<ssize_t>((mtu - 4) / ACK_SIZE, 1);
+  if (m_options.ackFrequency > 0) {
+    batchSize = std::min(batchSize, m_options.ackFrequency);
+  }
+  return batchSize;
+}
+
 std::vector<lp::Sequence>
-LpReliability::findLostLpPackets(LpReliability::UnackedFrags::iterator ackIt)
+LpReliability::findLostLpPackets(lp::Sequence ackTxSeq)
 {
   std::vector<lp::Sequence> lostLpPackets;
 
-  for (auto it = m_firstUnackedFrag; ; ++it) {
-    if (it == m_unackedFrags.end()) {
-      it = m_unackedFrags.begin();
-    }
-
-    if (it->first == ackIt->first) {
-      break;
+  for (lp::Sequence txSeq = m_unackedFrags.getFirstTxSeq(); txSeq != ackTxSeq; ++txSeq) {
+    auto unackedFrag = m_unackedFrags.find(txSeq);
+    if (unackedFrag == nullptr) {
+      continue;
     }
 
-    auto& unackedFrag = it->second;
-    unackedFrag.nGreaterSeqAcks++;
-    NFD_LOG_FACE_TRACE("received ack=" << ackIt->first << " before=" << it->first <<
-                       ", before count=" << unackedFrag.nGreaterSeqAcks);
+    unackedFrag->nGreaterSeqAcks++;
+    NFD_LOG_FACE_TRACE("received ack=" << ackTxSeq << " before=" << txSeq <<
+                       ", before count=" << unackedFrag->nGreaterSeqAcks);
 
-    if (unackedFrag.nGreaterSeqAcks >= m_options.seqNumLossThreshold) {
-      lostLpPackets.push_back(it->first);
+    if (unackedFrag->nGreaterSeqAcks >= m_options.seqNumLossThreshold) {
+      lostLpPackets.push_back(txSeq);
     }
   }
 
   return lostLpPackets;
 }
 
-std::vector<lp::Sequence>
+void
 LpReliability::onLpPacketLost(lp::Sequence txSeq, bool isTimeout)
 {
-  BOOST_ASSERT(m_unackedFrags.count(txSeq) > 0);
-  auto txSeqIt = m_unackedFrags.find(txSeq);
+  auto txFrag = m_unackedFrags.find(txSeq);
+  BOOST_ASSERT(txFrag != nullptr);
 
-  auto& txFrag = txSeqIt->second;
-  txFrag.rtoTimer.cancel();
-  auto netPkt = txFrag.netPkt;
-  std::vector<lp::Sequence> removedThisTxSeq;
-  lp::Sequence seq = txFrag.pkt.get<lp::SequenceField>();
+  auto netPkt = txFrag->netPkt;
+  lp::Sequence seq = txFrag->pkt.get<lp::SequenceField>();
 
   if (isTimeout) {
     NFD_LOG_FACE_TRACE("rto timer expired for seq=" << seq << ", txseq=" << txSeq);
@@ -291,14 +449,11 @@ LpReliability::onLpPacketLost(lp::Sequence txSeq, bool isTimeout)
   }
 
   // Check if maximum number of retransmissions exceeded
-  if (txFrag.retxCount >= m_options.maxRetx) {
+  if (txFrag->retxCount >= m_options.maxRetx) {
     NFD_LOG_FACE_DEBUG("seq=" << seq << " exceeded allowed retransmissions: DROP");
-    // Delete all LpPackets of NetPkt from m_unackedFrags (except this one)
-    for (size_t i = 0; i < netPkt->unackedFrags.size(); i++) {
-      if (netPkt->unackedFrags[i] != txSeqIt) {
-        removedThisTxSeq.push_back(netPkt->unackedFrags[i]->first);
-        deleteUnackedFrag(netPkt->unackedFrags[i]);
-      }
+    // Delete all LpPackets of NetPkt from m_unackedFrags (including this one)
+    for (lp::Sequence fragTxSeq : netPkt->unackedFrags) {
+      m_unackedFrags.erase(fragTxSeq);
     }
 
     ++m_linkService->nRetxExhausted;
@@ -309,57 +464,46 @@ LpReliability::onLpPacketLost(lp::Sequence txSeq, bool isTimeout)
       auto frag = netPkt->pkt.get<lp::FragmentField>();
       onDroppedInterest(Interest(Block({frag.first, frag.second})));
     }
-
-    // Delete this LpPacket from m_unackedFrags
-    removedThisTxSeq.push_back(txSeqIt->first);
-    deleteUnackedFrag(txSeqIt);
   }
   else {
-    // Assign new TxSequence
-    lp::Sequence newTxSeq = assignTxSequence(txFrag.pkt);
-    netPkt->didRetx = true;
-
-    // Move fragment to new TxSequence mapping
-    auto hint = m_firstUnackedFrag != m_unackedFrags.end() && m_firstUnackedFrag->first > newTxSeq
-                ? m_firstUnackedFrag
-                : m_unackedFrags.end();
-    auto newTxFragIt = m_unackedFrags.try_emplace(hint, newTxSeq, txFrag.pkt);
-    auto& newTxFrag = newTxFragIt->second;
-    newTxFrag.retxCount = txFrag.retxCount + 1;
+    // Assign new TxSequence and move fragment to the end of the window
+    lp::Sequence newTxSeq = assignTxSequence(txFrag->pkt);
+    lp::Packet pkt = std::move(txFrag->pkt);
+    size_t retxCount = txFrag->retxCount + 1;
+    m_unackedFrags.erase(txSeq);
+
+    auto& newTxFrag = m_unackedFrags.emplace(newTxSeq, std::move(pkt));
+    newTxFrag.retxCount = retxCount;
+    newTxFrag.rtoDeadline = computeRtoDeadline();
     newTxFrag.netPkt = netPkt;
+    netPkt->didRetx = true;
 
     // Update associated NetPkt
-    auto fragInNetPkt = std::find(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(), txSeqIt);
+    auto fragInNetPkt = std::find(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(), txSeq);
     BOOST_ASSERT(fragInNetPkt != netPkt->unackedFrags.end());
-    *fragInNetPkt = newTxFragIt;
+    *fragInNetPkt = newTxSeq;
 
-    removedThisTxSeq.push_back(txSeqIt->first);
-    deleteUnackedFrag(txSeqIt);
+    NFD_LOG_FACE_TRACE("retransmitting seq=" << seq << ", txseq=" << newTxSeq << ", retx=" <<
+                       retxCount << ", rto=" <<
+                       time::duration_cast<time::milliseconds>(newTxFrag.rtoDeadline -
+                                                               time::steady_clock::now()).count() << "ms");
 
     // Retransmit fragment
     m_linkService->sendLpPacket(lp::Packet(newTxFrag.pkt));
 
-    auto rto = m_rttEst.getEstimatedRto();
-    NFD_LOG_FACE_TRACE("retransmitting seq=" << seq << ", txseq=" << newTxSeq << ", retx=" <<
-                       txFrag.retxCount << ", rto=" <<
-                       time::duration_cast<time::milliseconds>(rto).count() << "ms");
-
-    // Start RTO timer for this sequence
-    newTxFrag.rtoTimer = getScheduler().schedule(rto, [=] {
-      onLpPacketLost(newTxSeq, true);
-    });
+    if (!m_rtoTimer) {
+      scheduleRtoTimer();
+    }
   }
-
-  return removedThisTxSeq;
 }
 
 void
-LpReliability::onLpPacketAcknowledged(UnackedFrags::iterator fragIt)
+LpReliability::onLpPacketAcknowledged(lp::Sequence txSeq)
 {
-  auto netPkt = fragIt->second.netPkt;
+  auto netPkt = m_unackedFrags.at(txSeq).netPkt;
 
   // Remove from NetPkt unacked fragment list
-  auto fragInNetPkt = std::find(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(), fragIt);
+  auto fragInNetPkt = std::find(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(), txSeq);
   BOOST_ASSERT(fragInNetPkt != netPkt->unackedFrags.end());
   *fragInNetPkt = netPkt->unackedFrags.back();
   netPkt->unackedFrags.pop_back();
@@ -374,33 +518,13 @@ LpReliability::onLpPacketAcknowledged(UnackedFrags::iterator fragIt)
     }
   }
 
-  deleteUnackedFrag(fragIt);
-}
-
-void
-LpReliability::deleteUnackedFrag(UnackedFrags::iterator fragIt)
-{
-  lp::Sequence firstUnackedTxSeq = m_firstUnackedFrag->first;
-  lp::Sequence currentTxSeq = fragIt->first;
-  auto nextFragIt = m_unackedFrags.erase(fragIt);
-
-  if (!m_unackedFrags.empty() && firstUnackedTxSeq == currentTxSeq) {
-    // If "first" fragment in send window (allowing for wraparound), increment window begin
-    if (nextFragIt == m_unackedFrags.end()) {
-      m_firstUnackedFrag = m_unackedFrags.begin();
-    }
-    else {
-      m_firstUnackedFrag = nextFragIt;
-    }
-  }
-  else if (m_unackedFrags.empty()) {
-    m_firstUnackedFrag = m_unackedFrags.end();
-  }
+  m_unackedFrags.erase(txSeq);
 }
 
 LpReliability::UnackedFrag::UnackedFrag(lp::Packet pkt)
   : pkt(std::move(pkt))
   , sendTime(time::steady_clock::now())
+  , rtoDeadline(sendTime)
   , retxCount(0)
   , nGreaterSeqAcks(0)
 {
@@ -413,6 +537,183 @@ LpReliability::NetPkt::NetPkt(lp::Packet&& pkt, bool isInterest)
 {
 }
 
+LpReliability::UnackedFrag*
+LpReliability::UnackedFrags::find(lp::Sequence txSeq)
+{
+  if (txSeq - m_first >= m_span) {
+    return nullptr;
+  }
+  auto& s = slot(txSeq);
+  return s ? &*s : nullptr;
+}
+
+LpReliability::UnackedFrag&
+LpReliability::UnackedFrags::at(lp::Sequence txSeq)
+{
+  auto frag = find(txSeq);
+  if (frag == nullptr) {
+    NDN_THROW(std::out_of_range("TxSequence " + to_string(txSeq) + " is not in the window"));
+  }
+  return *frag;
+}
+
+LpReliability::UnackedFrag&
+LpReliability::UnackedFrags::emplace(lp::Sequence txSeq, lp::Packet pkt)
+{
+  if (empty()) {
+    m_first = txSeq;
+    m_span = 0;
+  }
+  BOOST_ASSERT(txSeq - m_first >= m_span);
+
+  size_t newSpan = txSeq - m_first + 1;
+  if (newSpan > capacity()) {
+    grow(newSpan);
+  }
+  m_span = newSpan;
+  ++m_size;
+  return slot(txSeq).emplace(std::move(pkt));
+}
+
+void
+LpReliability::UnackedFrags::erase(lp::Sequence txSeq)
+{
+  if (txSeq - m_first >= m_span || !slot(txSeq)) {
+    return;
+  }
+
+  slot(txSeq).reset();
+  if (--m_size == 0) {
+    m_span = 0;
+    return;
+  }
+
+  // If "first" fragment in send window (allowing for wraparound), advance window begin
+  while (!slot(m_first)) {
+    ++m_first;
+    --m_span;
+  }
+}
+
+void
+LpReliability::UnackedFrags::grow(size_t minCapacity)
+{
+  size_t newCapacity = std::max(capacity(), INITIAL_CAPACITY);
+  while (newCapacity < minCapacity) {
+    newCapacity *= 2;
+  }
+
+  std::vector<std::optional<UnackedFrag>> slots(newCapacity);
+  for (lp::Sequence txSeq = m_first; txSeq != getEndTxSeq(); ++txSeq) {
+    auto& s = slot(txSeq);
+    if (s) {
+      slots[txSeq & (newCapacity - 1)] = std::move(s);
+    }
+  }
+  m_slots = std::move(slots);
+}
+
+bool
+LpReliability::RecvSeqWindow::insert(lp::Sequence seq)
+{
+  if (m_size == 0) {
+    m_first = seq;
+    m_span = 0;
+  }
+
+  lp::Sequence offset = seq - m_first;
+  if (offset < m_span) {
+    if (test(seq)) {
+      return false;
+    }
+  }
+  else if (offset <= std::numeric_limits<lp::Sequence>::max() / 2) {
+    // ahead of the window: extend it, sliding it forward if it cannot grow any further
+    if (offset >= capacity() && capacity() < MAX_CAPACITY) {
+      grow(std::min<lp::Sequence>(offset + 1, MAX_CAPACITY));
+    }
+    if (offset >= capacity()) {
+      advance(seq - capacity() + 1);
+    }
+    m_span = seq - m_first + 1;
+  }
+  else {
+    // behind the window: extend it backward if it can hold the whole range
+    lp::Sequence newSpan = m_first - seq + m_span;
+    if (newSpan > MAX_CAPACITY) {
+      return false;
+    }
+    if (newSpan > capacity()) {
+      grow(newSpan);
+    }
+    m_first = seq;
+    m_span = newSpan;
+  }
+
+  flip(seq);
+  ++m_size;
+  return true;
+}
+
+void
+LpReliability::RecvSeqWindow::erase(lp::Sequence seq)
+{
+  if (count(seq) == 0) {
+    return;
+  }
+
+  flip(seq);
+  if (--m_size == 0) {
+    m_span = 0;
+    return;
+  }
+
+  while (!test(m_first)) {
+    ++m_first;
+    --m_span;
+  }
+}
+
+void
+LpReliability::RecvSeqWindow::grow(size_t minCapacity)
+{
+  size_t newCapacity = std::max(capacity(), INITIAL_CAPACITY);
+  while (newCapacity < minCapacity) {
+    newCapacity *= 2;
+  }
+
+  RecvSeqWindow grown;
+  grown.m_words.resize(newCapacity / 64);
+  grown.m_first = m_first;
+  grown.m_span = m_span;
+  grown.m_size = m_size;
+  for (lp::Sequence seq = m_first; seq != m_first + m_span; ++seq) {
+    if (test(seq)) {
+      grown.flip(seq);
+    }
+  }
+  *this = std::move(grown);
+}
+
+void
+LpReliability::RecvSeqWindow::advance(lp::Sequence newFirst)
+{
+  if (newFirst - m_first >= m_span) {
+    std::fill(m_words.begin(), m_words.end(), 0);
+    m_first = newFirst;
+    m_span = 0;
+    m_size = 0;
+    return;
+  }
+
+  for (; m_first != newFirst; ++m_first, --m_span) {
+    if (test(m_first)) {
+      flip(m_first);
+      --m_size;
+    }
+  }
+}
+
 std::ostream&
 operator<<(std::ostream& os, const FaceLogHelper<LpReliability>& flh)
 {
@@ -27,11 +27,14 @@
 #define NFD_DAEMON_FACE_LP_RELIABILITY_HPP
 
 #include "face-common.hpp"
+#include "lp-ack-ranges.hpp"
+#include "common/timer-wheel.hpp"
 
 #include <ndn-cxx/lp/packet.hpp>
 #include <ndn-cxx/lp/sequence.hpp>
 #include <ndn-cxx/util/rtt-estimator.hpp>
 
+#include <optional>
 #include <queue>
 
 namespace nfd::face {
@@ -50,6 +53,10 @@ public:
                                                   tlv::sizeOfVarNumber(sizeof(lp::Sequence)) +
                                                   sizeof(lp::Sequence);
 
+  /// empty AckRanges field, attached to fragments to advertise support for AckRanges
+  static constexpr size_t ACK_RANGES_RESERVED_SPACE = tlv::sizeOfVarNumber(AckRanges::TLV_TYPE) +
+                                                      tlv::sizeOfVarNumber(0);
+
   struct Options
   {
     /** \brief enables link-layer reliability
@@ -61,9 +68,28 @@ public:
     size_t maxRetx = 3;
 
     /** \brief period between sending pending Acks in an IDLE packet
+     *
+     *  If \p ackFrequency is nonzero, this is the upper bound of the adaptive period.
      */
     time::nanoseconds idleAckTimerPeriod = 5_ms;
 
+    /** \brief number of received fragments to acknowledge together
+     *
+     *  If nonzero, pending Acks are sent in an IDLE packet as soon as this many have accumulated,
+     *  and the idle Ack timer period adapts to the observed receive rate, so that the timer
+     *  expires after about the time needed to receive this many fragments.
+     *  If zero, Acks are sent when they fill an IDLE packet or when the idle Ack timer expires.
+     */
+    size_t ackFrequency = 0;
+
+    /** \brief enables the AckRanges extension
+     *
+     *  Outgoing fragments advertise support for AckRanges, and pending Acks are encoded as ranges
+     *  of TxSequence numbers instead of individual Ack fields whenever the peer has advertised
+     *  support in the fragment being acknowledged. Both peers must enable this option.
+     */
+    bool allowAckRanges = false;
+
     /** \brief a fragment is considered lost if this number of fragments with greater sequence
      *         numbers are acknowledged
      */
@@ -113,7 +139,8 @@ public:
 NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   class UnackedFrag;
   class NetPkt;
-  using UnackedFrags = std::map<lp::Sequence, UnackedFrag>;
+  class UnackedFrags;
+  class RecvSeqWindow;
 
   /** \brief assign TxSequence number to a fragment
    *  \param frag fragment to assign TxSequence to
@@ -123,48 +150,87 @@ NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   lp::Sequence
   assignTxSequence(lp::Packet& frag);
 
+  /** \brief compute the retransmission deadline of a fragment sent now
+   *
+   *  Deadlines never decrease in TxSequence order, even if the estimated RTO shrinks, so that
+   *  fragments time out in the order they were sent and a single timer can track all of them.
+   */
+  time::steady_clock::TimePoint
+  computeRtoDeadline();
+
+  /** \brief arm the RTO timer for the deadline of the first unacknowledged fragment
+   */
+  void
+  scheduleRtoTimer();
+
+  /** \brief retransmit (or give up on) every fragment whose deadline has passed
+   */
+  void
+  onRtoTimerExpired();
+
+  /** \brief process an Ack for \p ackTxSeq, which may be unknown
+   */
+  void
+  processAck(lp::Sequence ackTxSeq, time::steady_clock::TimePoint now);
+
+  /** \brief process the Acks of the TxSequences in \p range that are in the window
+   */
+  void
+  processAckRange(const AckRanges::Range& range, time::steady_clock::TimePoint now);
+
+  /** \brief attach pending Acks as an AckRanges field
+   *  \param pkt outgoing LpPacket
+   *  \param remainingSpace space available for the field
+   */
+  void
+  piggybackAckRanges(lp::Packet& pkt, ssize_t remainingSpace);
+
   /** \brief start the idle Ack timer
    *
    * This timer requests an IDLE packet to acknowledge pending fragments not already piggybacked.
-   * It is called regularly on a period configured in Options::idleAckTimerPeriod. This allows Acks
-   * to be returned to the sender, even if the link goes idle.
+   * It is called regularly on a period configured in Options::idleAckTimerPeriod, or adapted to
+   * the receive rate if Options::ackFrequency is set. This allows Acks to be returned to the
+   * sender, even if the link goes idle.
    */
   void
   startIdleAckTimer();
 
+  /** \brief period of the idle Ack timer
+   */
+  time::nanoseconds
+  getIdleAckTimerPeriod() const;
+
+  /** \brief number of queued Acks that are sent in an IDLE packet right away
+   *
+   *  This is the number of individual Acks that fill an IDLE packet at the current MTU,
+   *  or Options::ackFrequency if smaller.
+   */
+  size_t
+  getAckBatchSize() const;
+
   /** \brief find and mark as lost fragments where a configurable number of Acks
    *         (\p m_options.seqNumLossThreshold) have been received for greater TxSequence numbers
-   *  \param ackIt iterator pointing to acknowledged fragment
+   *  \param ackTxSeq TxSequence of the acknowledged fragment
    *  \return vector containing TxSequences of fragments marked lost by this mechanism
    */
   std::vector<lp::Sequence>
-  findLostLpPackets(UnackedFrags::iterator ackIt);
+  findLostLpPackets(lp::Sequence ackTxSeq);
 
   /** \brief resend (or give up on) a lost fragment
-   *  \return vector of the TxSequences of fragments removed due to a network packet being removed
-   */
-  std::vector<lp::Sequence>
-  onLpPacketLost(lp::Sequence txSeq, bool isTimeout);
-
-  /** \brief remove the fragment with the given sequence number from the map of unacknowledged
-   *         fragments, as well as its associated network packet (if any)
-   *  \param fragIt iterator to acknowledged fragment
    *
-   *  If the given TxSequence marks the beginning of the send window, the window will be incremented.
-   *  If the associated network packet has been fully transmitted, it will be removed.
+   *  If the fragment is given up on, all other fragments of its network packet are removed
+   *  from the window as well.
    */
   void
-  onLpPacketAcknowledged(UnackedFrags::iterator fragIt);
+  onLpPacketLost(lp::Sequence txSeq, bool isTimeout);
 
-  /** \brief delete a fragment from UnackedFrags and advance acknowledge window if necessary
-   *  \param fragIt iterator to an UnackedFrag, must be dereferencable
-   *  \post fragIt is not in m_unackedFrags
-   *  \post if was equal to m_firstUnackedFrag,
-   *        m_firstUnackedFrag is set to the UnackedFrag after fragIt with consideration of
-   *        TxSequence number wraparound, or set to m_unackedFrags.end() if m_unackedFrags is empty
+  /** \brief remove the fragment with the given TxSequence from the window of unacknowledged
+   *         fragments, as well as from its associated network packet
+   *
+   *  If the associated network packet has been fully transmitted, the counters are incremented.
    */
   void
-  deleteUnackedFrag(UnackedFrags::iterator fragIt);
+  onLpPacketAcknowledged(lp::Sequence txSeq);
 
 NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /**
@@ -178,8 +244,8 @@ NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 
   public:
     lp::Packet pkt;
-    scheduler::ScopedEventId rtoTimer;
     time::steady_clock::TimePoint sendTime;
+    time::steady_clock::TimePoint rtoDeadline;
     size_t retxCount;
     size_t nGreaterSeqAcks; //!< number of Acks received for sequences greater than this fragment
     shared_ptr<NetPkt> netPkt;
@@ -194,27 +260,198 @@ NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
     NetPkt(lp::Packet&& pkt, bool isInterest);
 
   public:
-    std::vector<UnackedFrags::iterator> unackedFrags;
+    std::vector<lp::Sequence> unackedFrags; //!< TxSequences of unacknowledged fragments
     lp::Packet pkt;
     bool isInterest;
     bool didRetx;
   };
 
+  /**
+   * \brief Sliding window of unacknowledged fragments, indexed by TxSequence
+   *
+   * TxSequences are assigned consecutively, so the fragments in flight occupy a contiguous range
+   * of TxSequence numbers that begins at the first unacknowledged one. They are kept in a circular
+   * buffer where the slot of a TxSequence is its value modulo the capacity, which also accounts for
+   * TxSequence wraparound. Acknowledged and retransmitted fragments leave empty slots behind; the
+   * window begin skips over them, and the buffer doubles when the range outgrows it.
+   */
+  class UnackedFrags
+  {
+  public:
+    bool
+    empty() const
+    {
+      return m_size == 0;
+    }
+
+    size_t
+    size() const
+    {
+      return m_size;
+    }
+
+    size_t
+    count(lp::Sequence txSeq) const
+    {
+      return txSeq - m_first < m_span && m_slots[txSeq & (capacity() - 1)].has_value();
+    }
+
+    /** \return the fragment with \p txSeq, or nullptr if it is not in the window
+     */
+    UnackedFrag*
+    find(lp::Sequence txSeq);
+
+    /** \throw std::out_of_range \p txSeq is not in the window
+     */
+    UnackedFrag&
+    at(lp::Sequence txSeq);
+
+    /** \brief TxSequence of the first unacknowledged fragment
+     *  \pre !empty()
+     */
+    lp::Sequence
+    getFirstTxSeq() const
+    {
+      BOOST_ASSERT(!empty());
+      return m_first;
+    }
+
+    /** \brief TxSequence following the last fragment in the window
+     */
+    lp::Sequence
+    getEndTxSeq() const
+    {
+      return m_first + m_span;
+    }
+
+    /** \brief insert a fragment at the end of the window
+     *  \pre \p txSeq follows every TxSequence in the window
+     */
+    UnackedFrag&
+    emplace(lp::Sequence txSeq, lp::Packet pkt);
+
+    /** \brief remove a fragment, advancing the window begin past empty slots
+     *
+     *  Removing a fragment that is not in the window has no effect.
+     */
+    void
+    erase(lp::Sequence txSeq);
+
+  private:
+    size_t
+    capacity() const
+    {
+      return m_slots.size();
+    }
+
+    std::optional<UnackedFrag>&
+    slot(lp::Sequence txSeq)
+    {
+      return m_slots[txSeq & (capacity() - 1)];
+    }
+
+    void
+    grow(size_t minCapacity);
+
+  private:
+    static constexpr size_t INITIAL_CAPACITY = 64;
+
+    std::vector<std::optional<UnackedFrag>> m_slots;
+    lp::Sequence m_first = 0; ///< TxSequence of the first slot in the window
+    size_t m_span = 0; ///< number of slots from the first to the last fragment, inclusive
+    size_t m_size = 0; ///< number of fragments in the window
+  };
+
+  /**
+   * \brief Bitmap of recently received Sequence numbers, for duplicate detection
+   *
+   * The bitmap covers a window of consecutive Sequence numbers; the bit of a Sequence is its value
+   * modulo the capacity. The bitmap doubles as needed up to MAX_CAPACITY bits. Beyond that, the
+   * window slides forward and forgets the oldest Sequences, so that a duplicate arriving after
+   * MAX_CAPACITY newer fragments is no longer recognized.
+   */
+  class RecvSeqWindow
+  {
+  public:
+    size_t
+    size() const
+    {
+      return m_size;
+    }
+
+    size_t
+    count(lp::Sequence seq) const
+    {
+      return m_size > 0 && seq - m_first < m_span && test(seq);
+    }
+
+    /** \brief record \p seq as received
+     *  \retval false \p seq was already recorded, or is too old to be tracked
+     */
+    bool
+    insert(lp::Sequence seq);
+
+    void
+    erase(lp::Sequence seq);
+
+  private:
+    size_t
+    capacity() const
+    {
+      return m_words.size() * 64;
+    }
+
+    bool
+    test(lp::Sequence seq) const
+    {
+      size_t bit = seq & (capacity() - 1);
+      return (m_words[bit / 64] >> (bit % 64)) & 1;
+    }
+
+    void
+    flip(lp::Sequence seq)
+    {
+      size_t bit = seq & (capacity() - 1);
+      m_words[bit / 64] ^= uint64_t(1) << (bit % 64);
+    }
+
+    void
+    grow(size_t minCapacity);
+
+    /** \brief forget every Sequence before \p newFirst
+     */
+    void
+    advance(lp::Sequence newFirst);
+
+  public:
+    static constexpr size_t INITIAL_CAPACITY = 1024;
+    static constexpr size_t MAX_CAPACITY = 1 << 20;
+
+  private:
+    std::vector<uint64_t> m_words;
+    lp::Sequence m_first = 0; ///< lowest Sequence covered by the window
+    size_t m_span = 0; ///< number of Sequences covered, up to the highest one recorded
+    size_t m_size = 0; ///< number of recorded Sequences
+  };
+
   Options m_options;
   GenericLinkService* m_linkService;
   UnackedFrags m_unackedFrags;
-  /** An iterator that points to the first unacknowledged fragment in the current window. The window
-   *  can wrap around so that the beginning of the window is at a TxSequence greater than other
-   *  fragments in the window. When the window is moved past the last item in the iterator, the
-   *  first fragment in the map will become the start of the window.
-   */
-  UnackedFrags::iterator m_firstUnackedFrag;
   std::queue<lp::Sequence> m_ackQueue;
-  std::map<lp::Sequence, time::steady_clock::TimePoint> m_recentRecvSeqs;
-  std::queue<lp::Sequence> m_recentRecvSeqsQueue;
+  RecvSeqWindow m_recentRecvSeqs;
+  /// received Sequences in arrival order, with their arrival time, for expiry after one RTO
+  std::queue<std::pair<lp::Sequence, time::steady_clock::TimePoint>> m_recentRecvSeqsQueue;
   lp::Sequence m_lastTxSeqNo;
+  /// single retransmission timer for all fragments, armed for the first fragment's deadline
+  TimerWheel::Timer m_rtoTimer;
+  time::steady_clock::TimePoint m_lastRtoDeadline;
   scheduler::ScopedEventId m_idleAckTimer;
   ndn::util::RttEstimator m_rttEst;
+  /// whether the last received fragment advertised support for AckRanges
+  bool m_isPeerAckRangesCapable = false;
+  time::steady_clock::TimePoint m_lastRecvTime;
+  /// moving average of the interval between received fragments
+  time::nanoseconds m_recvInterval = 0_ns;
 };
 
 std::ostream&
@@ -49,8 +49,9 @@ NFD_LOG_INIT(MulticastEthernetTransport);
 
 MulticastEthernetTransport::MulticastEthernetTransport(const ndn::net::NetworkInterface& localEndpoint,
                                                        const ethernet::Address& mcastAddress,
-                                                       ndn::nfd::LinkType linkType)
-  : EthernetTransport(localEndpoint, mcastAddress)
+                                                       ndn::nfd::LinkType linkType,
+                                                       EthernetBackend backend)
+  : EthernetTransport(localEndpoint, mcastAddress, backend)
 #if defined(__linux__)
   , m_interfaceIndex(localEndpoint.getIndex())
 #endif
@@ -60,7 +61,7 @@ MulticastEthernetTransport::MulticastEthernetTransport(const ndn::net::NetworkIn
   this->setScope(ndn::nfd::FACE_SCOPE_NON_LOCAL);
   this->setPersistency(ndn::nfd::FACE_PERSISTENCY_PERMANENT);
   this->setLinkType(linkType);
-  this->setMtu(localEndpoint.getMtu());
+  this->setMtu(computeMtu(localEndpoint.getMtu()));
 
   NFD_LOG_FACE_DEBUG("Creating transport");
 
@@ -72,7 +73,7 @@ MulticastEthernetTransport::MulticastEthernetTransport(const ndn::net::NetworkIn
                 ethernet::ETHERTYPE_NDN,
                 m_destAddress.toString().data(),
                 m_srcAddress.toString().data());
-  m_pcap.setPacketFilter(filter);
+  this->setPacketFilter(filter);
 
   BOOST_ASSERT(m_destAddress.isMulticast());
   if (!m_destAddress.isBroadcast()) {
@@ -84,17 +85,20 @@ void
 MulticastEthernetTransport::joinMulticastGroup()
 {
 #if defined(__linux__)
-  packet_mreq mr{};
-  mr.mr_ifindex = m_interfaceIndex;
-  mr.mr_type = PACKET_MR_MULTICAST;
-  mr.mr_alen = m_destAddress.size();
-  std::memcpy(mr.mr_address, m_destAddress.data(), m_destAddress.size());
-
-  if (::setsockopt(m_socket.native_handle(), SOL_PACKET,
-                   PACKET_ADD_MEMBERSHIP, &mr, sizeof(mr)) == 0)
-    return; // success
-
-  NFD_LOG_FACE_WARN("setsockopt(PACKET_ADD_MEMBERSHIP) failed: " << std::strerror(errno));
+  // an AF_XDP socket is not a packet socket
+  if (m_backend != EthernetBackend::XDP) {
+    packet_mreq mr{};
+    mr.mr_ifindex = m_interfaceIndex;
+    mr.mr_type = PACKET_MR_MULTICAST;
+    mr.mr_alen = m_destAddress.size();
+    std::memcpy(mr.mr_address, m_destAddress.data(), m_destAddress.size());
+
+    if (::setsockopt(m_socket.native_handle(), SOL_PACKET,
+                     PACKET_ADD_MEMBERSHIP, &mr, sizeof(mr)) == 0)
+      return; // success
+
+    NFD_LOG_FACE_WARN("setsockopt(PACKET_ADD_MEMBERSHIP) failed: " << std::strerror(errno));
+  }
 #endif
 
 #if defined(SIOCADDMULTI)
@@ -127,7 +131,13 @@ MulticastEthernetTransport::joinMulticastGroup()
   static_assert(sizeof(ifr.ifr_addr) >= offsetof(sockaddr_dl, sdl_data) + ethernet::ADDR_LEN,
                 "ifr_addr in struct ifreq is too small on this platform");
 #else
+  // an AF_XDP socket does not support interface ioctls, use a UDP socket instead
+  boost::asio::ip::udp::socket sock(getGlobalIoService());
   int fd = m_socket.native_handle();
+  if (m_backend == EthernetBackend::XDP) {
+    sock.open(boost::asio::ip::udp::v4());
+    fd = sock.native_handle();
+  }
 
   ifr.ifr_hwaddr.sa_family = AF_UNSPEC;
   std::memcpy(ifr.ifr_hwaddr.sa_data, m_destAddress.data(), m_destAddress.size());
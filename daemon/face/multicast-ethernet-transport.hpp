@@ -38,10 +38,12 @@ class MulticastEthernetTransport final : public EthernetTransport
 public:
   /**
    * @brief Creates an Ethernet-based transport for multicast communication
+   * @throw EthernetTransport::Error the backend cannot be initialized
    */
   MulticastEthernetTransport(const ndn::net::NetworkInterface& localEndpoint,
                              const ethernet::Address& mcastAddress,
-                             ndn::nfd::LinkType linkType);
+                             ndn::nfd::LinkType linkType,
+                             EthernetBackend backend = EthernetBackend::PCAP);
 
 private:
   /**
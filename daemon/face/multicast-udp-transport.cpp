@@ -46,8 +46,10 @@ NFD_LOG_MEMBER_INIT_SPECIALIZED((DatagramTransport<boost::asio::ip::udp, Multica
 MulticastUdpTransport::MulticastUdpTransport(const protocol::endpoint& multicastGroup,
                                              protocol::socket&& recvSocket,
                                              protocol::socket&& sendSocket,
-                                             ndn::nfd::LinkType linkType)
-  : DatagramTransport(std::move(recvSocket))
+                                             ndn::nfd::LinkType linkType,
+                                             size_t batchSize,
+                                             bool wantSegmentationOffload)
+  : DatagramTransport(std::move(recvSocket), batchSize, wantSegmentationOffload)
   , m_multicastGroup(multicastGroup)
   , m_sendSocket(std::move(sendSocket))
 {
@@ -69,6 +71,8 @@ MulticastUdpTransport::MulticastUdpTransport(const protocol::endpoint& multicast
     this->setSendQueueCapacity(sendBufferSizeOption.value());
   }
 
+  this->setSendDestination(m_sendSocket, m_multicastGroup);
+
   NFD_LOG_FACE_DEBUG("Creating transport");
 }
 
@@ -82,18 +86,6 @@ MulticastUdpTransport::getSendQueueLength()
   return queueLength;
 }
 
-void
-MulticastUdpTransport::doSend(const Block& packet)
-{
-  NFD_LOG_FACE_TRACE(__func__);
-
-  m_sendSocket.async_send_to(boost::asio::buffer(packet), m_multicastGroup,
-                             // 'packet' is copied into the lambda to retain the underlying Buffer
-                             [this, packet] (auto&&... args) {
-                               this->handleSend(std::forward<decltype(args)>(args)...);
-                             });
-}
-
 void
 MulticastUdpTransport::doClose()
 {
@@ -61,11 +61,15 @@ public:
    * \param recvSocket socket used to receive multicast packets
    * \param sendSocket socket used to send to the multicast group
    * \param linkType either `ndn::nfd::LINK_TYPE_MULTI_ACCESS` or `ndn::nfd::LINK_TYPE_AD_HOC`
+   * \param batchSize maximum number of datagrams received or sent per system call
+   * \param wantSegmentationOffload whether to enable UDP GSO/GRO where supported
    */
   MulticastUdpTransport(const protocol::endpoint& multicastGroup,
                         protocol::socket&& recvSocket,
                         protocol::socket&& sendSocket,
-                        ndn::nfd::LinkType linkType);
+                        ndn::nfd::LinkType linkType,
+                        size_t batchSize = 1,
+                        bool wantSegmentationOffload = false);
 
   ssize_t
   getSendQueueLength() final;
@@ -83,9 +87,6 @@ public:
                bool enableLoopback = false);
 
 private:
-  void
-  doSend(const Block& packet) final;
-
   void
   doClose() final;
 
@@ -30,28 +30,81 @@
 #include "socket-utils.hpp"
 #include "common/global.hpp"
 
-#include <queue>
+#include <deque>
 
 #include <boost/asio/write.hpp>
+#include <ndn-cxx/encoding/tlv.hpp>
 
 namespace nfd::face {
 
+/** \brief counters provided by StreamTransport
+ *  \note The type name 'StreamTransportCounters' is implementation detail.
+ *        Use 'StreamTransport::Counters' in public API.
+ */
+class StreamTransportCounters : public virtual Transport::Counters
+{
+public:
+  /** \brief count of write operations on the socket
+   */
+  PacketCounter nOutWrites;
+
+  /** \brief count of packets written by those write operations
+   *
+   *  The average number of packets per write is nOutWritePackets / nOutWrites.
+   */
+  PacketCounter nOutWritePackets;
+
+  /** \brief count of received octets that have been copied before delivery
+   *
+   *  In the default receive mode, every packet is copied out of the receive buffer.
+   *  In zero-copy mode, only partial packets at the end of a full chunk are copied.
+   */
+  ByteCounter nInCopiedBytes;
+};
+
 /** \brief Implements Transport for stream-based protocols.
+ *
+ *  Packets that are queued while a write is in progress are written together by the next write,
+ *  as one scatter/gather operation of up to MAX_WRITE_PACKETS packets and MAX_WRITE_BYTES octets.
+ *
+ *  By default, data is received into a fixed buffer, and each packet is copied out of it.
+ *  In zero-copy receive mode, data is received into reference-counted chunks of
+ *  RECEIVE_CHUNK_SIZE octets, and each packet is a Block that refers to a slice of a chunk.
+ *  A chunk is released once all packets in it are released, so a packet retained for a long
+ *  time (e.g., in the Content Store) can keep a whole chunk in memory.
  *
  *  \tparam Protocol a stream-based protocol in Boost.Asio
  */
 template<class Protocol>
 class StreamTransport : public Transport
+                      , protected virtual StreamTransportCounters
 {
 public:
   using protocol = Protocol;
 
+  /** \brief counters provided by StreamTransport
+   */
+  using Counters = StreamTransportCounters;
+
+  /// maximum number of packets gathered into one write
+  static constexpr size_t MAX_WRITE_PACKETS = 64;
+
+  /// maximum number of octets gathered into one write, unless the first packet is larger
+  static constexpr size_t MAX_WRITE_BYTES = 65536;
+
+  /// size of each receive chunk in zero-copy receive mode
+  static constexpr size_t RECEIVE_CHUNK_SIZE = 4 * ndn::MAX_NDN_PACKET_SIZE;
+
   /** \brief Construct stream transport.
    *
    *  \param socket Protocol-specific socket for the created transport
+   *  \param wantZeroCopyReceive whether to use zero-copy receive mode
    */
   explicit
-  StreamTransport(typename protocol::socket&& socket);
+  StreamTransport(typename protocol::socket&& socket, bool wantZeroCopyReceive = false);
+
+  const Counters&
+  getCounters() const final;
 
   ssize_t
   getSendQueueLength() override;
@@ -80,6 +133,17 @@ protected:
   handleReceive(const boost::system::error_code& error,
                 size_t nBytesReceived);
 
+  /** \brief deliver complete packets received into m_receiveChunk
+   *  \return false if the transport has failed
+   */
+  bool
+  processReceiveChunk();
+
+  /** \brief make room in m_receiveChunk for the next receive
+   */
+  void
+  prepareReceiveChunk();
+
   void
   processErrorCode(const boost::system::error_code& error);
 
@@ -103,15 +167,23 @@ protected:
 private:
   uint8_t m_receiveBuffer[ndn::MAX_NDN_PACKET_SIZE];
   size_t m_receiveBufferSize;
-  std::queue<Block> m_sendQueue;
+  const bool m_wantZeroCopyReceive;
+  shared_ptr<ndn::Buffer> m_receiveChunk; ///< used in zero-copy receive mode
+  size_t m_chunkBegin = 0; ///< offset of the first octet in m_receiveChunk not yet delivered
+  size_t m_chunkEnd = 0; ///< offset past the last octet received into m_receiveChunk
+  std::deque<Block> m_sendQueue; ///< the first m_nWritingPackets packets are being written
   size_t m_sendQueueBytes;
+  size_t m_nWritingPackets = 0;
+  std::vector<boost::asio::const_buffer> m_writeBuffers;
 };
 
 
 template<class T>
-StreamTransport<T>::StreamTransport(typename StreamTransport::protocol::socket&& socket)
+StreamTransport<T>::StreamTransport(typename StreamTransport::protocol::socket&& socket,
+                                    bool wantZeroCopyReceive)
   : m_socket(std::move(socket))
   , m_receiveBufferSize(0)
+  , m_wantZeroCopyReceive(wantZeroCopyReceive)
   , m_sendQueueBytes(0)
 {
   // No queue capacity is set because there is no theoretical limit to the size of m_sendQueue.
@@ -121,6 +193,13 @@ StreamTransport<T>::StreamTransport(typename StreamTransport::protocol::socket&&
   startReceive();
 }
 
+template<class T>
+const typename StreamTransport<T>::Counters&
+StreamTransport<T>::getCounters() const
+{
+  return *this;
+}
+
 template<class T>
 ssize_t
 StreamTransport<T>::getSendQueueLength()
@@ -189,7 +268,7 @@ StreamTransport<T>::doSend(const Block& packet)
     return;
 
   bool wasQueueEmpty = m_sendQueue.empty();
-  m_sendQueue.push(packet);
+  m_sendQueue.push_back(packet);
   m_sendQueueBytes += packet.size();
 
   if (wasQueueEmpty)
@@ -200,7 +279,24 @@ template<class T>
 void
 StreamTransport<T>::sendFromQueue()
 {
-  boost::asio::async_write(m_socket, boost::asio::buffer(m_sendQueue.front()),
+  BOOST_ASSERT(!m_sendQueue.empty() && m_nWritingPackets == 0);
+
+  m_writeBuffers.clear();
+  size_t nBytes = 0;
+  for (const Block& packet : m_sendQueue) {
+    if (m_writeBuffers.size() == MAX_WRITE_PACKETS ||
+        (!m_writeBuffers.empty() && nBytes + packet.size() > MAX_WRITE_BYTES)) {
+      break;
+    }
+    m_writeBuffers.push_back(boost::asio::buffer(packet));
+    nBytes += packet.size();
+    ++this->nOutWritePackets;
+  }
+  m_nWritingPackets = m_writeBuffers.size();
+  ++this->nOutWrites;
+
+  // the buffers remain valid because the packets stay in the queue until the write completes
+  boost::asio::async_write(m_socket, m_writeBuffers,
                            [this] (auto&&... args) { this->handleSend(std::forward<decltype(args)>(args)...); });
 }
 
@@ -214,10 +310,11 @@ StreamTransport<T>::handleSend(const boost::system::error_code& error,
 
   NFD_LOG_FACE_TRACE("Successfully sent: " << nBytesSent << " bytes");
 
-  BOOST_ASSERT(!m_sendQueue.empty());
-  BOOST_ASSERT(m_sendQueue.front().size() == nBytesSent);
+  BOOST_ASSERT(m_sendQueue.size() >= m_nWritingPackets);
+  m_sendQueue.erase(m_sendQueue.begin(), m_sendQueue.begin() + m_nWritingPackets);
+  m_nWritingPackets = 0;
+  BOOST_ASSERT(m_sendQueueBytes >= nBytesSent);
   m_sendQueueBytes -= nBytesSent;
-  m_sendQueue.pop();
 
   if (!m_sendQueue.empty())
     sendFromQueue();
@@ -229,6 +326,14 @@ StreamTransport<T>::startReceive()
 {
   BOOST_ASSERT(getState() == TransportState::UP);
 
+  if (m_wantZeroCopyReceive) {
+    prepareReceiveChunk();
+    m_socket.async_receive(boost::asio::buffer(m_receiveChunk->data() + m_chunkEnd,
+                                               m_receiveChunk->size() - m_chunkEnd),
+                           [this] (auto&&... args) { this->handleReceive(std::forward<decltype(args)>(args)...); });
+    return;
+  }
+
   m_socket.async_receive(boost::asio::buffer(m_receiveBuffer + m_receiveBufferSize,
                                              ndn::MAX_NDN_PACKET_SIZE - m_receiveBufferSize),
                          [this] (auto&&... args) { this->handleReceive(std::forward<decltype(args)>(args)...); });
@@ -244,6 +349,14 @@ StreamTransport<T>::handleReceive(const boost::system::error_code& error,
 
   NFD_LOG_FACE_TRACE("Received: " << nBytesReceived << " bytes");
 
+  if (m_wantZeroCopyReceive) {
+    m_chunkEnd += nBytesReceived;
+    if (processReceiveChunk()) {
+      startReceive();
+    }
+    return;
+  }
+
   m_receiveBufferSize += nBytesReceived;
   auto bufferView = ndn::make_span(m_receiveBuffer, m_receiveBufferSize);
   size_t offset = 0;
@@ -256,6 +369,7 @@ StreamTransport<T>::handleReceive(const boost::system::error_code& error,
 
     offset += element.size();
     BOOST_ASSERT(offset <= bufferView.size());
+    this->nInCopiedBytes += element.size();
 
     this->receive(element);
   }
@@ -271,6 +385,7 @@ StreamTransport<T>::handleReceive(const boost::system::error_code& error,
     if (offset != m_receiveBufferSize) {
       std::copy(m_receiveBuffer + offset, m_receiveBuffer + m_receiveBufferSize, m_receiveBuffer);
       m_receiveBufferSize -= offset;
+      this->nInCopiedBytes += m_receiveBufferSize;
     }
     else {
       m_receiveBufferSize = 0;
@@ -280,6 +395,83 @@ StreamTransport<T>::handleReceive(const boost::system::error_code& error,
   startReceive();
 }
 
+template<class T>
+bool
+StreamTransport<T>::processReceiveChunk()
+{
+  const auto chunkBegin = m_receiveChunk->cbegin();
+  bool isTooLarge = false;
+  while (m_chunkBegin < m_chunkEnd) {
+    // determine the element size from its TLV header, because the chunk may extend beyond
+    // the received octets, which Block::fromBuffer would consider
+    auto elementBegin = chunkBegin + m_chunkBegin;
+    auto pos = elementBegin;
+    auto end = chunkBegin + m_chunkEnd;
+    uint32_t type = 0;
+    uint64_t length = 0;
+    if (!ndn::tlv::readType(pos, end, type) || !ndn::tlv::readVarNumber(pos, end, length)) {
+      break;
+    }
+    if (length > ndn::MAX_NDN_PACKET_SIZE - static_cast<size_t>(pos - elementBegin)) {
+      isTooLarge = true;
+      break;
+    }
+    if (length > static_cast<uint64_t>(end - pos)) {
+      break;
+    }
+
+    auto elementEnd = pos + length;
+    Block element(m_receiveChunk, elementBegin, elementEnd, false);
+    m_chunkBegin = elementEnd - chunkBegin;
+
+    this->receive(element);
+  }
+
+  if (isTooLarge || m_chunkEnd - m_chunkBegin >= ndn::MAX_NDN_PACKET_SIZE) {
+    NFD_LOG_FACE_ERROR("Failed to parse incoming packet or packet too large to process");
+    this->setState(TransportState::FAILED);
+    doClose();
+    return false;
+  }
+
+  if (m_chunkBegin == m_chunkEnd && m_receiveChunk.use_count() == 1) {
+    // no packet refers to the chunk anymore, so it can be filled again from the start
+    m_chunkBegin = m_chunkEnd = 0;
+  }
+  return true;
+}
+
+template<class T>
+void
+StreamTransport<T>::prepareReceiveChunk()
+{
+  if (m_receiveChunk == nullptr) {
+    m_receiveChunk = make_shared<ndn::Buffer>(RECEIVE_CHUNK_SIZE);
+    m_chunkBegin = m_chunkEnd = 0;
+    return;
+  }
+
+  if (m_chunkEnd < m_receiveChunk->size()) {
+    return;
+  }
+
+  // the chunk is full: a partial packet at its end, if any, moves to the front of a chunk,
+  // which is a new one unless no delivered packet refers to the current one
+  size_t nPartial = m_chunkEnd - m_chunkBegin;
+  auto partial = m_receiveChunk->begin() + m_chunkBegin;
+  if (m_receiveChunk.use_count() == 1) {
+    std::copy(partial, partial + nPartial, m_receiveChunk->begin());
+  }
+  else {
+    auto chunk = make_shared<ndn::Buffer>(RECEIVE_CHUNK_SIZE);
+    std::copy(partial, partial + nPartial, chunk->begin());
+    m_receiveChunk = std::move(chunk);
+  }
+  this->nInCopiedBytes += nPartial;
+  m_chunkBegin = 0;
+  m_chunkEnd = nPartial;
+}
+
 template<class T>
 void
 StreamTransport<T>::processErrorCode(const boost::system::error_code& error)
@@ -316,15 +508,21 @@ void
 StreamTransport<T>::resetReceiveBuffer()
 {
   m_receiveBufferSize = 0;
+  m_chunkBegin = m_chunkEnd = 0;
+  if (m_receiveChunk.use_count() > 1) {
+    // packets still refer to the chunk
+    m_receiveChunk.reset();
+  }
 }
 
 template<class T>
 void
 StreamTransport<T>::resetSendQueue()
 {
-  std::queue<Block> emptyQueue;
+  std::deque<Block> emptyQueue;
   std::swap(emptyQueue, m_sendQueue);
   m_sendQueueBytes = 0;
+  m_nWritingPackets = 0;
 }
 
 template<class T>
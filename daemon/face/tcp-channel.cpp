@@ -38,12 +38,13 @@ NFD_LOG_INIT(TcpChannel);
 namespace ip = boost::asio::ip;
 
 TcpChannel::TcpChannel(const tcp::Endpoint& localEndpoint, bool wantCongestionMarking,
-                       DetermineFaceScopeFromAddress determineFaceScope)
+                       DetermineFaceScopeFromAddress determineFaceScope, bool wantZeroCopyReceive)
   : m_localEndpoint(localEndpoint)
   , m_acceptor(getGlobalIoService())
   , m_socket(getGlobalIoService())
   , m_wantCongestionMarking(wantCongestionMarking)
   , m_determineFaceScope(std::move(determineFaceScope))
+  , m_wantZeroCopyReceive(wantZeroCopyReceive)
 {
   setUri(FaceUri(m_localEndpoint));
   NFD_LOG_CHAN_INFO("Creating channel");
@@ -134,10 +135,20 @@ TcpChannel::createFace(ip::tcp::socket&& socket,
       options.defaultCongestionThreshold = *params.defaultCongestionThreshold;
     }
 
+    options.aqmName = params.aqmName.value_or(Aqm::getDefaultAqmName());
+    options.aqmOptions = Aqm::getDefaultOptions();
+    if (params.aqmTarget) {
+      options.aqmOptions.target = *params.aqmTarget;
+    }
+    if (params.aqmInterval) {
+      options.aqmOptions.interval = *params.aqmInterval;
+    }
+
     auto linkService = make_unique<GenericLinkService>(options);
     auto faceScope = m_determineFaceScope(socket.local_endpoint().address(),
                                           socket.remote_endpoint().address());
-    auto transport = make_unique<TcpTransport>(std::move(socket), params.persistency, faceScope);
+    auto transport = make_unique<TcpTransport>(std::move(socket), params.persistency, faceScope,
+                                              m_wantZeroCopyReceive);
     face = make_shared<Face>(std::move(linkService), std::move(transport));
     face->setChannel(weak_from_this());
 
@@ -54,9 +54,11 @@ public:
    *
    * To enable creation faces upon incoming connections,
    * one needs to explicitly call TcpChannel::listen method.
+   *
+   * \param wantZeroCopyReceive whether created transports use zero-copy receive mode
    */
   TcpChannel(const tcp::Endpoint& localEndpoint, bool wantCongestionMarking,
-             DetermineFaceScopeFromAddress determineFaceScope);
+             DetermineFaceScopeFromAddress determineFaceScope, bool wantZeroCopyReceive = false);
 
   bool
   isListening() const final
@@ -131,6 +133,7 @@ private:
   std::map<tcp::Endpoint, shared_ptr<Face>> m_channelFaces;
   bool m_wantCongestionMarking;
   DetermineFaceScopeFromAddress m_determineFaceScope;
+  bool m_wantZeroCopyReceive;
 };
 
 } // namespace nfd::face
@@ -54,6 +54,7 @@ TcpFactory::doProcessConfig(OptionalConfigSection configSection,
   // }
 
   m_wantCongestionMarking = context.generalConfig.wantCongestionMarking;
+  m_wantZeroCopyReceive = context.generalConfig.wantZeroCopyReceive;
 
   if (!configSection) {
     if (!context.isDryRun && !m_channels.empty()) {
@@ -203,7 +204,7 @@ TcpFactory::createChannel(const tcp::Endpoint& endpoint)
 
   auto channel = make_shared<TcpChannel>(endpoint, m_wantCongestionMarking, [this] (auto&&... args) {
     return determineFaceScopeFromAddresses(std::forward<decltype(args)>(args)...);
-  });
+  }, m_wantZeroCopyReceive);
   m_channels[endpoint] = channel;
   return channel;
 }
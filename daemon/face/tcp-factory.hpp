@@ -76,6 +76,7 @@ private:
 
 private:
   bool m_wantCongestionMarking = false;
+  bool m_wantZeroCopyReceive = false;
   std::map<tcp::Endpoint, shared_ptr<TcpChannel>> m_channels;
 
 NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
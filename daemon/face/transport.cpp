@@ -108,6 +108,35 @@ Transport::send(const Block& packet)
   this->doSend(packet);
 }
 
+void
+Transport::send(const GatheredPacket& packet)
+{
+  BOOST_ASSERT(this->getMtu() == MTU_UNLIMITED ||
+               packet.size() <= static_cast<size_t>(this->getMtu()));
+
+  TransportState state = this->getState();
+  if (state != TransportState::UP && state != TransportState::DOWN) {
+    NFD_LOG_FACE_TRACE("send ignored in " << state << " state");
+    return;
+  }
+
+  if (state == TransportState::UP) {
+    ++this->nOutPackets;
+    this->nOutBytes += packet.size();
+  }
+
+  this->doSendGathered(packet);
+}
+
+void
+Transport::doSendGathered(const GatheredPacket& packet)
+{
+  auto buffer = make_shared<ndn::Buffer>(packet.size());
+  auto it = std::copy(packet.header.begin(), packet.header.end(), buffer->begin());
+  std::copy(packet.payload.begin(), packet.payload.end(), it);
+  this->doSend(Block(buffer));
+}
+
 void
 Transport::receive(const Block& packet, const EndpointId& endpoint)
 {
@@ -83,6 +83,38 @@ public:
    *  This counter is increased only if transport is UP.
    */
   ByteCounter nOutBytes;
+
+  /** \brief count of incoming packets dropped because the receive ring was full
+   *
+   *  This counter is used only when packets are received on an I/O thread.
+   */
+  PacketCounter nInRingDrops;
+
+  /** \brief count of outgoing packets dropped because the send ring was full
+   *
+   *  This counter is used only when packets are sent on an I/O thread.
+   */
+  PacketCounter nOutRingDrops;
+
+  /** \brief number of packets in the receive ring, as last observed by the forwarding thread
+   */
+  SimpleCounter nInRingDepth;
+
+  /** \brief number of packets in the send ring, as last observed by the forwarding thread
+   */
+  SimpleCounter nOutRingDepth;
+
+  /** \brief count of receive buffers recycled from the receive buffer pool
+   *
+   *  This counter is used only when datagrams are received into a DatagramBufferPool.
+   */
+  PacketCounter nInPoolHits;
+
+  /** \brief count of receive buffers allocated because the receive buffer pool was exhausted
+   *
+   *  This counter is used only when datagrams are received into a DatagramBufferPool.
+   */
+  PacketCounter nInPoolMisses;
 };
 
 /**
@@ -175,6 +207,15 @@ public: // upper interface
   void
   send(const Block& packet);
 
+  /** \brief Send a link-layer packet gathered from a header and a payload
+   *  \param packet the packet to be sent; the concatenation of its parts must be a valid and
+   *                well-formed TLV block
+   *  \note This operation has no effect if getState() is neither UP nor DOWN
+   *  \warning Behavior is undefined if packet size exceeds the MTU limit
+   */
+  void
+  send(const GatheredPacket& packet);
+
 public: // static properties
   /** \return a FaceUri representing local endpoint
    */
@@ -333,6 +374,15 @@ protected: // to be overridden by subclass
   virtual void
   doClose() = 0;
 
+  /** \brief performs Transport specific operations to send a packet gathered from two parts
+   *  \pre transport state is either UP or DOWN
+   *
+   *  The default implementation copies both parts into one Block and invokes doSend().
+   *  Transports that can write both parts with scatter/gather I/O should override it.
+   */
+  virtual void
+  doSendGathered(const GatheredPacket& packet);
+
 private: // to be overridden by subclass
   /** \brief performs Transport specific operations to send a packet
    *  \param packet the packet to be sent, can be assumed to be valid and well-formed
@@ -26,6 +26,7 @@
 #include "udp-channel.hpp"
 #include "face.hpp"
 #include "generic-link-service.hpp"
+#include "udp-peer-transport.hpp"
 #include "unicast-udp-transport.hpp"
 #include "common/global.hpp"
 
@@ -40,15 +41,33 @@ namespace ip = boost::asio::ip;
 UdpChannel::UdpChannel(const udp::Endpoint& localEndpoint,
                        time::nanoseconds idleTimeout,
                        bool wantCongestionMarking,
-                       size_t defaultMtu)
+                       size_t defaultMtu,
+                       size_t batchSize,
+                       size_t nSharedSockets,
+                       bool wantSegmentationOffload)
   : m_localEndpoint(localEndpoint)
   , m_socket(getGlobalIoService())
   , m_idleFaceTimeout(idleTimeout)
   , m_wantCongestionMarking(wantCongestionMarking)
+  , m_batchSize(batchSize)
+  , m_nSharedSockets(UdpSharedSocket::canReusePort() ? nSharedSockets
+                                                     : std::min<size_t>(nSharedSockets, 1))
+  , m_wantSegmentationOffload(wantSegmentationOffload)
 {
   setUri(FaceUri(m_localEndpoint));
   setDefaultMtu(defaultMtu);
   NFD_LOG_CHAN_INFO("Creating channel");
+  if (m_nSharedSockets != nSharedSockets) {
+    NFD_LOG_CHAN_WARN("SO_REUSEPORT is not supported, using one shared socket");
+  }
+}
+
+UdpChannel::~UdpChannel()
+{
+  // the shared sockets keep themselves alive while receiving, and their callbacks refer to this
+  for (const auto& socket : m_sharedSockets) {
+    socket->close();
+  }
 }
 
 void
@@ -82,6 +101,13 @@ UdpChannel::listen(const FaceCreatedCallback& onFaceCreated,
     return;
   }
 
+  if (m_nSharedSockets > 0) {
+    openSharedSockets();
+    m_onFaceCreated = onFaceCreated;
+    NFD_LOG_CHAN_DEBUG("Started listening on " << m_sharedSockets.size() << " shared sockets");
+    return;
+  }
+
   m_socket.open(m_localEndpoint.protocol());
   m_socket.set_option(ip::udp::socket::reuse_address(true));
   if (m_localEndpoint.address().is_v6()) {
@@ -147,6 +173,53 @@ UdpChannel::handleNewPeer(const boost::system::error_code& error,
   waitForNewPeer(onFaceCreated, onReceiveFailed);
 }
 
+void
+UdpChannel::openSharedSockets()
+{
+  if (!m_sharedSockets.empty()) {
+    return;
+  }
+
+  std::vector<shared_ptr<UdpSharedSocket>> sockets;
+  sockets.reserve(m_nSharedSockets);
+  for (size_t i = 0; i < m_nSharedSockets; ++i) {
+    sockets.push_back(make_shared<UdpSharedSocket>(m_localEndpoint, m_nSharedSockets > 1, m_batchSize,
+                                                   m_wantSegmentationOffload));
+  }
+
+  m_sharedSockets = std::move(sockets);
+  for (const auto& socket : m_sharedSockets) {
+    socket->start([this] (auto datagram, const auto& sender) { handleSharedDatagram(datagram, sender); });
+  }
+}
+
+void
+UdpChannel::handleSharedDatagram(span<const uint8_t> datagram, const udp::Endpoint& sender)
+{
+  shared_ptr<Face> face;
+  auto it = m_channelFaces.find(sender);
+  if (it != m_channelFaces.end()) {
+    face = it->second;
+  }
+  else if (m_onFaceCreated) {
+    NFD_LOG_CHAN_TRACE("New peer " << sender);
+
+    FaceParams params;
+    params.persistency = ndn::nfd::FACE_PERSISTENCY_ON_DEMAND;
+    params.mtu = getDefaultMtu();
+    face = createFace(sender, params).second;
+    m_onFaceCreated(face);
+  }
+  else {
+    NFD_LOG_CHAN_TRACE("Dropping datagram from unknown peer " << sender);
+    return;
+  }
+
+  // dispatch the datagram to the face for processing
+  auto* transport = static_cast<UdpPeerTransport*>(face->getTransport());
+  transport->receiveDatagram(datagram);
+}
+
 std::pair<bool, shared_ptr<Face>>
 UdpChannel::createFace(const udp::Endpoint& remoteEndpoint,
                        const FaceParams& params)
@@ -159,11 +232,6 @@ UdpChannel::createFace(const udp::Endpoint& remoteEndpoint,
   }
 
   // else, create a new face
-  ip::udp::socket socket(getGlobalIoService(), m_localEndpoint.protocol());
-  socket.set_option(ip::udp::socket::reuse_address(true));
-  socket.bind(m_localEndpoint);
-  socket.connect(remoteEndpoint);
-
   GenericLinkService::Options options;
   options.allowFragmentation = true;
   options.allowReassembly = true;
@@ -184,11 +252,34 @@ UdpChannel::createFace(const udp::Endpoint& remoteEndpoint,
     options.defaultCongestionThreshold = *params.defaultCongestionThreshold;
   }
 
+  options.aqmName = params.aqmName.value_or(Aqm::getDefaultAqmName());
+  options.aqmOptions = Aqm::getDefaultOptions();
+  if (params.aqmTarget) {
+    options.aqmOptions.target = *params.aqmTarget;
+  }
+  if (params.aqmInterval) {
+    options.aqmOptions.interval = *params.aqmInterval;
+  }
+
   options.overrideMtu = params.mtu.value_or(getDefaultMtu());
 
   auto linkService = make_unique<GenericLinkService>(options);
-  auto transport = make_unique<UnicastUdpTransport>(std::move(socket), params.persistency,
-                                                    m_idleFaceTimeout);
+  unique_ptr<Transport> transport;
+  if (m_nSharedSockets > 0) {
+    openSharedSockets();
+    auto& socket = m_sharedSockets[udp::EndpointHash{}(remoteEndpoint) % m_sharedSockets.size()];
+    transport = make_unique<UdpPeerTransport>(socket, remoteEndpoint, params.persistency,
+                                              m_idleFaceTimeout);
+  }
+  else {
+    ip::udp::socket socket(getGlobalIoService(), m_localEndpoint.protocol());
+    socket.set_option(ip::udp::socket::reuse_address(true));
+    socket.bind(m_localEndpoint);
+    socket.connect(remoteEndpoint);
+    transport = make_unique<UnicastUdpTransport>(std::move(socket), params.persistency,
+                                                 m_idleFaceTimeout, m_batchSize,
+                                                 m_wantSegmentationOffload);
+  }
   auto face = make_shared<Face>(std::move(linkService), std::move(transport));
   face->setChannel(weak_from_this());
 
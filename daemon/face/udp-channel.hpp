@@ -30,9 +30,12 @@
 #include "udp-protocol.hpp"
 
 #include <array>
+#include <unordered_map>
 
 namespace nfd::face {
 
+class UdpSharedSocket;
+
 /**
  * \brief Class implementing UDP-based channel to create faces
  */
@@ -45,16 +48,28 @@ public:
    * To enable creation of faces upon incoming connections,
    * one needs to explicitly call UdpChannel::listen method.
    * The created socket is bound to \p localEndpoint.
+   * Faces created by the channel receive and send up to \p batchSize datagrams per system call,
+   * and use UDP segmentation offload where supported if \p wantSegmentationOffload is true.
+   *
+   * If \p nSharedSockets is zero, each face has its own socket connected to the remote endpoint.
+   * Otherwise, all faces share \p nSharedSockets unconnected sockets bound to \p localEndpoint
+   * with SO_REUSEPORT, and the channel dispatches incoming datagrams to faces by source endpoint.
+   * Only one shared socket is used on platforms without SO_REUSEPORT.
    */
   UdpChannel(const udp::Endpoint& localEndpoint,
              time::nanoseconds idleTimeout,
              bool wantCongestionMarking,
-             size_t defaultMtu);
+             size_t defaultMtu,
+             size_t batchSize = 1,
+             size_t nSharedSockets = 0,
+             bool wantSegmentationOffload = false);
+
+  ~UdpChannel() final;
 
   bool
   isListening() const final
   {
-    return m_socket.is_open();
+    return m_socket.is_open() || m_onFaceCreated != nullptr;
   }
 
   size_t
@@ -102,6 +117,19 @@ private:
                 const FaceCreatedCallback& onFaceCreated,
                 const FaceCreationFailedCallback& onReceiveFailed);
 
+  /**
+   * \brief Open the shared sockets, if not already open
+   * \throw boost::system::system_error
+   */
+  void
+  openSharedSockets();
+
+  /**
+   * \brief Dispatch a datagram received on a shared socket
+   */
+  void
+  handleSharedDatagram(span<const uint8_t> datagram, const udp::Endpoint& sender);
+
   std::pair<bool, shared_ptr<Face>>
   createFace(const udp::Endpoint& remoteEndpoint,
              const FaceParams& params);
@@ -111,9 +139,14 @@ private:
   udp::Endpoint m_remoteEndpoint; ///< The latest peer that started communicating with us
   boost::asio::ip::udp::socket m_socket; ///< Socket used to "accept" new peers
   std::array<uint8_t, ndn::MAX_NDN_PACKET_SIZE> m_receiveBuffer;
-  std::map<udp::Endpoint, shared_ptr<Face>> m_channelFaces;
+  std::unordered_map<udp::Endpoint, shared_ptr<Face>, udp::EndpointHash> m_channelFaces;
   const time::nanoseconds m_idleFaceTimeout; ///< Timeout for automatic closure of idle on-demand faces
   bool m_wantCongestionMarking;
+  const size_t m_batchSize;
+  const size_t m_nSharedSockets;
+  const bool m_wantSegmentationOffload;
+  std::vector<shared_ptr<UdpSharedSocket>> m_sharedSockets;
+  FaceCreatedCallback m_onFaceCreated; ///< set while listening on shared sockets
 };
 
 } // namespace nfd::face
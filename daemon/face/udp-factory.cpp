@@ -67,6 +67,9 @@ UdpFactory::doProcessConfig(OptionalConfigSection configSection,
   //   enable_v6 yes
   //   idle_timeout 600
   //   unicast_mtu 8800
+  //   batch_size 1
+  //   shared_sockets 0
+  //   segmentation_offload no
   //   mcast yes
   //   mcast_group 224.0.23.170
   //   mcast_port 56363
@@ -90,6 +93,9 @@ UdpFactory::doProcessConfig(OptionalConfigSection configSection,
   bool enableV6 = false;
   uint32_t idleTimeout = 600;
   size_t unicastMtu = ndn::MAX_NDN_PACKET_SIZE;
+  size_t batchSize = 1;
+  size_t nSharedSockets = 0;
+  bool wantSegmentationOffload = false;
   MulticastConfig mcastConfig;
 
   if (configSection) {
@@ -120,6 +126,18 @@ UdpFactory::doProcessConfig(OptionalConfigSection configSection,
         ConfigFile::checkRange(unicastMtu, static_cast<size_t>(MIN_MTU), ndn::MAX_NDN_PACKET_SIZE,
                                "unicast_mtu", "face_system.udp");
       }
+      else if (key == "batch_size") {
+        batchSize = ConfigFile::parseNumber<size_t>(pair, "face_system.udp");
+        ConfigFile::checkRange(batchSize, size_t{1}, DatagramBatchIo<ip::udp>::MAX_BATCH_SIZE,
+                               "batch_size", "face_system.udp");
+      }
+      else if (key == "shared_sockets") {
+        nSharedSockets = ConfigFile::parseNumber<size_t>(pair, "face_system.udp");
+        ConfigFile::checkRange(nSharedSockets, size_t{0}, size_t{64}, "shared_sockets", "face_system.udp");
+      }
+      else if (key == "segmentation_offload") {
+        wantSegmentationOffload = ConfigFile::parseYesNo(pair, "face_system.udp");
+      }
       else if (key == "keep_alive_interval") {
         // ignored
       }
@@ -185,6 +203,9 @@ UdpFactory::doProcessConfig(OptionalConfigSection configSection,
   }
 
   m_defaultUnicastMtu = unicastMtu;
+  m_batchSize = batchSize;
+  m_nSharedSockets = nSharedSockets;
+  m_wantSegmentationOffload = wantSegmentationOffload;
 
   if (enableV4) {
     udp::Endpoint endpoint(ip::udp::v4(), port);
@@ -312,7 +333,8 @@ UdpFactory::createChannel(const udp::Endpoint& localEndpoint,
   }
 
   auto channel = std::make_shared<UdpChannel>(localEndpoint, idleTimeout,
-                                              m_wantCongestionMarking, m_defaultUnicastMtu);
+                                              m_wantCongestionMarking, m_defaultUnicastMtu, m_batchSize,
+                                              m_nSharedSockets, m_wantSegmentationOffload);
   m_channels[localEndpoint] = channel;
   return channel;
 }
@@ -364,9 +386,12 @@ UdpFactory::createMulticastFace(const shared_ptr<const net::NetworkInterface>& n
 
   GenericLinkService::Options options;
   options.allowCongestionMarking = m_wantCongestionMarking;
+  options.aqmName = Aqm::getDefaultAqmName();
+  options.aqmOptions = Aqm::getDefaultOptions();
   auto linkService = make_unique<GenericLinkService>(options);
   auto transport = make_unique<MulticastUdpTransport>(mcastEp, std::move(rxSock), std::move(txSock),
-                                                      m_mcastConfig.linkType);
+                                                      m_mcastConfig.linkType, m_batchSize,
+                                                      m_wantSegmentationOffload);
   auto face = make_shared<Face>(std::move(linkService), std::move(transport));
 
   m_mcastFaces[localEp] = face;
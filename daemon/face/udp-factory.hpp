@@ -123,6 +123,9 @@ private:
 private:
   bool m_wantCongestionMarking = false;
   size_t m_defaultUnicastMtu = ndn::MAX_NDN_PACKET_SIZE;
+  size_t m_batchSize = 1;
+  size_t m_nSharedSockets = 0; ///< number of shared sockets per channel, 0 means per-face sockets
+  bool m_wantSegmentationOffload = false;
   std::map<udp::Endpoint, shared_ptr<UdpChannel>> m_channels;
 
   struct MulticastConfig
@@ -0,0 +1,259 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "udp-peer-transport.hpp"
+#include "common/global.hpp"
+
+#include <boost/asio/ip/v6_only.hpp>
+
+namespace nfd::face {
+
+NFD_LOG_INIT(UdpPeerTransport);
+
+namespace ip = boost::asio::ip;
+
+#ifdef SO_REUSEPORT
+using ReusePortOption = boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>;
+#endif
+
+UdpSharedSocket::UdpSharedSocket(const udp::Endpoint& localEndpoint, bool wantReusePort,
+                                 size_t batchSize, bool wantSegmentationOffload)
+  : m_localEndpoint(localEndpoint)
+  , m_socket(getGlobalIoService(), localEndpoint.protocol())
+  , m_batchIo(batchSize)
+{
+  m_socket.set_option(ip::udp::socket::reuse_address(true));
+#ifdef SO_REUSEPORT
+  if (wantReusePort) {
+    m_socket.set_option(ReusePortOption(true));
+  }
+#endif
+  if (localEndpoint.address().is_v6()) {
+    m_socket.set_option(ip::v6_only(true));
+  }
+  m_socket.bind(localEndpoint);
+
+  if (wantSegmentationOffload && m_batchIo.enableSegmentationOffload(m_socket)) {
+    NFD_LOG_DEBUG("[" << m_localEndpoint << "] Segmentation offload: GSO=" << m_batchIo.isGsoEnabled() <<
+                  " GRO=" << m_batchIo.isGroEnabled());
+  }
+}
+
+void
+UdpSharedSocket::start(ReceiveCallback onReceive)
+{
+  m_onReceive = std::move(onReceive);
+  asyncReceive();
+}
+
+void
+UdpSharedSocket::asyncReceive()
+{
+  m_socket.async_receive(boost::asio::null_buffers(),
+                         [self = shared_from_this()] (const auto& error, size_t) {
+                           self->handleReadable(error);
+                         });
+}
+
+void
+UdpSharedSocket::handleReadable(const boost::system::error_code& error)
+{
+  if (error == boost::asio::error::operation_aborted || !m_socket.is_open()) {
+    return;
+  }
+
+  if (error) {
+    NFD_LOG_DEBUG("[" << m_localEndpoint << "] Receive failed: " << error.message());
+  }
+  else {
+    auto recvError = m_batchIo.receive(m_socket, m_onReceive);
+    if (recvError && recvError != boost::asio::error::would_block &&
+        recvError != boost::asio::error::try_again) {
+      // unconnected sockets can report errors caused by earlier datagrams sent to any peer,
+      // which are no reason to stop receiving
+      NFD_LOG_DEBUG("[" << m_localEndpoint << "] Receive failed: " << recvError.message());
+    }
+  }
+
+  if (m_socket.is_open()) {
+    asyncReceive();
+  }
+}
+
+void
+UdpSharedSocket::send(const Block& packet, const udp::Endpoint& destination)
+{
+  m_sendQueue.push_back(packet);
+  m_sendDestinations.push_back(destination);
+  if (!m_isFlushPending && !m_isWaitingWritable) {
+    m_isFlushPending = true;
+    getGlobalIoService().post([self = shared_from_this()] { self->flush(); });
+  }
+}
+
+void
+UdpSharedSocket::flush()
+{
+  m_isFlushPending = false;
+
+  size_t nDone = 0;
+  while (nDone < m_sendQueue.size() && m_socket.is_open()) {
+    boost::system::error_code error;
+    nDone += m_batchIo.send(m_socket, ndn::make_span(m_sendQueue).subspan(nDone),
+                            ndn::make_span(m_sendDestinations).subspan(nDone), error);
+    if (!error) {
+      continue;
+    }
+
+    if (error == boost::asio::error::would_block || error == boost::asio::error::try_again) {
+      m_isWaitingWritable = true;
+      m_socket.async_send(boost::asio::null_buffers(),
+                          [self = shared_from_this()] (const auto& error, size_t) {
+                            self->m_isWaitingWritable = false;
+                            if (!error) {
+                              self->flush();
+                            }
+                          });
+      break;
+    }
+
+    // the first unsent packet caused the error, which only affects its destination
+    NFD_LOG_DEBUG("[" << m_localEndpoint << "] Send to " << m_sendDestinations[nDone] <<
+                  " failed: " << error.message());
+    ++nDone;
+  }
+
+  if (m_socket.is_open()) {
+    m_sendQueue.erase(m_sendQueue.begin(), m_sendQueue.begin() + nDone);
+    m_sendDestinations.erase(m_sendDestinations.begin(), m_sendDestinations.begin() + nDone);
+  }
+  else {
+    m_sendQueue.clear();
+    m_sendDestinations.clear();
+  }
+}
+
+void
+UdpSharedSocket::close()
+{
+  boost::system::error_code error;
+  m_socket.cancel(error);
+  m_socket.close(error);
+}
+
+UdpPeerTransport::UdpPeerTransport(shared_ptr<UdpSharedSocket> socket,
+                                   const udp::Endpoint& remoteEndpoint,
+                                   ndn::nfd::FacePersistency persistency,
+                                   time::nanoseconds idleTimeout)
+  : m_socket(std::move(socket))
+  , m_remoteEndpoint(remoteEndpoint)
+  , m_idleTimeout(idleTimeout)
+{
+  this->setLocalUri(FaceUri(m_socket->getLocalEndpoint()));
+  this->setRemoteUri(FaceUri(remoteEndpoint));
+  this->setScope(ndn::nfd::FACE_SCOPE_NON_LOCAL);
+  this->setPersistency(persistency);
+  this->setLinkType(ndn::nfd::LINK_TYPE_POINT_TO_POINT);
+  this->setMtu(udp::computeMtu(m_socket->getLocalEndpoint()));
+
+  NFD_LOG_FACE_DEBUG("Creating transport");
+
+  if (getPersistency() == ndn::nfd::FACE_PERSISTENCY_ON_DEMAND &&
+      m_idleTimeout > time::nanoseconds::zero()) {
+    scheduleClosureWhenIdle();
+  }
+}
+
+void
+UdpPeerTransport::receiveDatagram(span<const uint8_t> datagram)
+{
+  NFD_LOG_FACE_TRACE("Received: " << datagram.size() << " bytes");
+
+  auto [isOk, element] = Block::fromBuffer(datagram);
+  if (!isOk || element.size() != datagram.size()) {
+    NFD_LOG_FACE_WARN("Failed to parse incoming packet");
+    // This packet won't extend the face lifetime
+    return;
+  }
+  m_hasRecentlyReceived = true;
+
+  this->receive(element);
+}
+
+bool
+UdpPeerTransport::canChangePersistencyToImpl(ndn::nfd::FacePersistency) const
+{
+  return true;
+}
+
+void
+UdpPeerTransport::afterChangePersistency(ndn::nfd::FacePersistency)
+{
+  if (getPersistency() == ndn::nfd::FACE_PERSISTENCY_ON_DEMAND &&
+      m_idleTimeout > time::nanoseconds::zero()) {
+    scheduleClosureWhenIdle();
+  }
+  else {
+    m_closeIfIdleEvent.cancel();
+    setExpirationTime(time::steady_clock::TimePoint::max());
+  }
+}
+
+void
+UdpPeerTransport::doClose()
+{
+  NFD_LOG_FACE_TRACE(__func__);
+
+  m_closeIfIdleEvent.cancel();
+  getGlobalIoService().post([this] {
+    this->setState(TransportState::CLOSED);
+  });
+}
+
+void
+UdpPeerTransport::doSend(const Block& packet)
+{
+  NFD_LOG_FACE_TRACE(__func__);
+
+  m_socket->send(packet, m_remoteEndpoint);
+}
+
+void
+UdpPeerTransport::scheduleClosureWhenIdle()
+{
+  m_closeIfIdleEvent = getScheduler().schedule(m_idleTimeout, [this] {
+    if (!m_hasRecentlyReceived) {
+      NFD_LOG_FACE_INFO("Closing due to inactivity");
+      this->close();
+    }
+    else {
+      m_hasRecentlyReceived = false;
+      scheduleClosureWhenIdle();
+    }
+  });
+  setExpirationTime(time::steady_clock::now() + m_idleTimeout);
+}
+
+} // namespace nfd::face
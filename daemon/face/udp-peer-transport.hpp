@@ -0,0 +1,161 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_UDP_PEER_TRANSPORT_HPP
+#define NFD_DAEMON_FACE_UDP_PEER_TRANSPORT_HPP
+
+#include "datagram-batch-io.hpp"
+#include "transport.hpp"
+#include "udp-protocol.hpp"
+
+#include <sys/socket.h>
+
+namespace nfd::face {
+
+/** \brief an unconnected UDP socket shared by the faces of many peers
+ *
+ *  Several shared sockets can be bound to the same endpoint with SO_REUSEPORT, in which case
+ *  the kernel distributes incoming datagrams among them by hashing the source endpoint,
+ *  so that datagrams from a given peer always arrive on the same socket.
+ *
+ *  Datagrams are received in batches and handed to a callback along with their source endpoint.
+ *  Datagrams sent in one io_service round are queued and sent in batches.
+ */
+class UdpSharedSocket : public std::enable_shared_from_this<UdpSharedSocket>, noncopyable
+{
+public:
+  using ReceiveCallback = std::function<void(span<const uint8_t> datagram, const udp::Endpoint& sender)>;
+
+  /** \brief open a socket bound to \p localEndpoint
+   *  \param wantReusePort whether to set SO_REUSEPORT, so that other shared sockets can be bound
+   *                       to the same endpoint
+   *  \param batchSize maximum number of datagrams received or sent per system call
+   *  \param wantSegmentationOffload whether to enable UDP GSO/GRO where supported
+   *  \throw boost::system::system_error the socket cannot be opened or bound
+   */
+  UdpSharedSocket(const udp::Endpoint& localEndpoint, bool wantReusePort, size_t batchSize,
+                  bool wantSegmentationOffload = false);
+
+  /** \return whether SO_REUSEPORT is supported on this platform
+   */
+  static constexpr bool
+  canReusePort() noexcept
+  {
+#ifdef SO_REUSEPORT
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  const udp::Endpoint&
+  getLocalEndpoint() const noexcept
+  {
+    return m_localEndpoint;
+  }
+
+  /** \brief start receiving
+   *
+   *  The socket keeps itself alive while receiving, until close() is invoked.
+   */
+  void
+  start(ReceiveCallback onReceive);
+
+  /** \brief enqueue \p packet to be sent to \p destination
+   */
+  void
+  send(const Block& packet, const udp::Endpoint& destination);
+
+  void
+  close();
+
+private:
+  void
+  asyncReceive();
+
+  void
+  handleReadable(const boost::system::error_code& error);
+
+  void
+  flush();
+
+private:
+  udp::Endpoint m_localEndpoint;
+  boost::asio::ip::udp::socket m_socket;
+  DatagramBatchIo<boost::asio::ip::udp> m_batchIo;
+  ReceiveCallback m_onReceive;
+
+  std::vector<Block> m_sendQueue;
+  std::vector<udp::Endpoint> m_sendDestinations;
+  bool m_isFlushPending = false;
+  bool m_isWaitingWritable = false;
+};
+
+/** \brief a Transport toward one remote endpoint through a UdpSharedSocket
+ *
+ *  Unlike UnicastUdpTransport, this transport does not own a socket. The channel delivers
+ *  datagrams received from the remote endpoint via receiveDatagram().
+ */
+class UdpPeerTransport final : public Transport
+{
+public:
+  UdpPeerTransport(shared_ptr<UdpSharedSocket> socket,
+                   const udp::Endpoint& remoteEndpoint,
+                   ndn::nfd::FacePersistency persistency,
+                   time::nanoseconds idleTimeout);
+
+  /** \brief deliver a datagram received from the remote endpoint
+   */
+  void
+  receiveDatagram(span<const uint8_t> datagram);
+
+protected:
+  bool
+  canChangePersistencyToImpl(ndn::nfd::FacePersistency newPersistency) const final;
+
+  void
+  afterChangePersistency(ndn::nfd::FacePersistency oldPersistency) final;
+
+private:
+  void
+  doClose() final;
+
+  void
+  doSend(const Block& packet) final;
+
+  void
+  scheduleClosureWhenIdle();
+
+private:
+  shared_ptr<UdpSharedSocket> m_socket;
+  const udp::Endpoint m_remoteEndpoint;
+  const time::nanoseconds m_idleTimeout;
+  scheduler::ScopedEventId m_closeIfIdleEvent;
+  bool m_hasRecentlyReceived = false;
+};
+
+} // namespace nfd::face
+
+#endif // NFD_DAEMON_FACE_UDP_PEER_TRANSPORT_HPP
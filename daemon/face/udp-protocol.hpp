@@ -27,6 +27,7 @@
 #define NFD_DAEMON_FACE_UDP_PROTOCOL_HPP
 
 #include "core/common.hpp"
+#include "common/wyhash.hpp"
 
 #include <boost/asio/ip/udp.hpp>
 
@@ -55,6 +56,24 @@ getDefaultMulticastGroupV6()
   return {boost::asio::ip::address_v6::from_string("FF02::1234"), 56363};
 }
 
+/** \brief hash function of UDP endpoints, for use in unordered containers
+ */
+struct EndpointHash
+{
+  size_t
+  operator()(const Endpoint& ep) const noexcept
+  {
+    uint16_t port = ep.port();
+    if (ep.address().is_v4()) {
+      auto bytes = ep.address().to_v4().to_bytes();
+      return wyhash::hash64(bytes.data(), bytes.size(), port);
+    }
+    auto addr = ep.address().to_v6();
+    auto bytes = addr.to_bytes();
+    return wyhash::hash64(bytes.data(), bytes.size(), port ^ (uint64_t{addr.scope_id()} << 16));
+  }
+};
+
 } // namespace nfd::udp
 
 #endif // NFD_DAEMON_FACE_UDP_PROTOCOL_HPP
@@ -38,11 +38,13 @@ class UnicastEthernetTransport final : public EthernetTransport
 public:
   /**
    * @brief Creates an Ethernet-based transport for unicast communication
+   * @throw EthernetTransport::Error the backend cannot be initialized
    */
   UnicastEthernetTransport(const ndn::net::NetworkInterface& localEndpoint,
                            const ethernet::Address& remoteEndpoint,
                            ndn::nfd::FacePersistency persistency,
-                           time::nanoseconds idleTimeout);
+                           time::nanoseconds idleTimeout,
+                           EthernetBackend backend = EthernetBackend::PCAP);
 
 protected:
   bool
@@ -40,8 +40,10 @@ NFD_LOG_MEMBER_INIT_SPECIALIZED((DatagramTransport<boost::asio::ip::udp, Unicast
 
 UnicastUdpTransport::UnicastUdpTransport(protocol::socket&& socket,
                                          ndn::nfd::FacePersistency persistency,
-                                         time::nanoseconds idleTimeout)
-  : DatagramTransport(std::move(socket))
+                                         time::nanoseconds idleTimeout,
+                                         size_t batchSize,
+                                         bool wantSegmentationOffload)
+  : DatagramTransport(std::move(socket), batchSize, wantSegmentationOffload)
   , m_idleTimeout(idleTimeout)
 {
   this->setLocalUri(FaceUri(m_socket.local_endpoint()));
@@ -40,9 +40,15 @@ NFD_LOG_MEMBER_DECL_SPECIALIZED((DatagramTransport<boost::asio::ip::udp, Unicast
 class UnicastUdpTransport final : public DatagramTransport<boost::asio::ip::udp, Unicast>
 {
 public:
+  /**
+   * \param batchSize maximum number of datagrams received or sent per system call
+   * \param wantSegmentationOffload whether to enable UDP GSO/GRO where supported
+   */
   UnicastUdpTransport(protocol::socket&& socket,
                       ndn::nfd::FacePersistency persistency,
-                      time::nanoseconds idleTimeout);
+                      time::nanoseconds idleTimeout,
+                      size_t batchSize = 1,
+                      bool wantSegmentationOffload = false);
 
 protected:
   bool
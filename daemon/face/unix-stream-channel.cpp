@@ -37,12 +37,14 @@ namespace nfd::face {
 NFD_LOG_INIT(UnixStreamChannel);
 
 UnixStreamChannel::UnixStreamChannel(const unix_stream::Endpoint& endpoint,
-                                     bool wantCongestionMarking)
+                                     bool wantCongestionMarking,
+                                     bool wantZeroCopyReceive)
   : m_endpoint(endpoint)
   , m_acceptor(getGlobalIoService())
   , m_socket(getGlobalIoService())
   , m_size(0)
   , m_wantCongestionMarking(wantCongestionMarking)
+  , m_wantZeroCopyReceive(wantZeroCopyReceive)
 {
   setUri(FaceUri(m_endpoint));
   NFD_LOG_CHAN_INFO("Creating channel");
@@ -133,8 +135,10 @@ UnixStreamChannel::handleAccept(const boost::system::error_code& error,
 
   GenericLinkService::Options options;
   options.allowCongestionMarking = m_wantCongestionMarking;
+  options.aqmName = Aqm::getDefaultAqmName();
+  options.aqmOptions = Aqm::getDefaultOptions();
   auto linkService = make_unique<GenericLinkService>(options);
-  auto transport = make_unique<UnixStreamTransport>(std::move(m_socket));
+  auto transport = make_unique<UnixStreamTransport>(std::move(m_socket), m_wantZeroCopyReceive);
   auto face = make_shared<Face>(std::move(linkService), std::move(transport));
   face->setChannel(weak_from_this());
 
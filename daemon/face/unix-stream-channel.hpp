@@ -59,8 +59,11 @@ public:
    *
    * To enable creation of faces upon incoming connections, one
    * needs to explicitly call UnixStreamChannel::listen method.
+   *
+   * \param wantZeroCopyReceive whether created transports use zero-copy receive mode
    */
-  UnixStreamChannel(const unix_stream::Endpoint& endpoint, bool wantCongestionMarking);
+  UnixStreamChannel(const unix_stream::Endpoint& endpoint, bool wantCongestionMarking,
+                    bool wantZeroCopyReceive = false);
 
   ~UnixStreamChannel() final;
 
@@ -112,6 +115,7 @@ private:
   boost::asio::local::stream_protocol::socket m_socket;
   size_t m_size;
   bool m_wantCongestionMarking;
+  bool m_wantZeroCopyReceive;
 };
 
 } // namespace nfd::face
@@ -50,6 +50,7 @@ UnixStreamFactory::doProcessConfig(OptionalConfigSection configSection,
   // }
 
   m_wantCongestionMarking = context.generalConfig.wantCongestionMarking;
+  m_wantZeroCopyReceive = context.generalConfig.wantZeroCopyReceive;
 
   if (!configSection) {
     if (!context.isDryRun && !m_channels.empty()) {
@@ -97,7 +98,8 @@ UnixStreamFactory::createChannel(const std::string& unixSocketPath)
   if (it != m_channels.end())
     return it->second;
 
-  auto channel = make_shared<UnixStreamChannel>(endpoint, m_wantCongestionMarking);
+  auto channel = make_shared<UnixStreamChannel>(endpoint, m_wantCongestionMarking,
+                                                     m_wantZeroCopyReceive);
   m_channels[endpoint] = channel;
   return channel;
 }
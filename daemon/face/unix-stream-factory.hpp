@@ -66,6 +66,7 @@ private:
 
 private:
   bool m_wantCongestionMarking = false;
+  bool m_wantZeroCopyReceive = false;
   std::map<unix_stream::Endpoint, shared_ptr<UnixStreamChannel>> m_channels;
 };
 
@@ -29,8 +29,8 @@ namespace nfd::face {
 
 NFD_LOG_MEMBER_INIT_SPECIALIZED(StreamTransport<boost::asio::local::stream_protocol>, UnixStreamTransport);
 
-UnixStreamTransport::UnixStreamTransport(protocol::socket&& socket)
-  : StreamTransport(std::move(socket))
+UnixStreamTransport::UnixStreamTransport(protocol::socket&& socket, bool wantZeroCopyReceive)
+  : StreamTransport(std::move(socket), wantZeroCopyReceive)
 {
   static_assert(
     std::is_same_v<std::remove_cv_t<protocol::socket::native_handle_type>, int>,
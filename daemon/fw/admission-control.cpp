@@ -0,0 +1,141 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "admission-control.hpp"
+
+namespace nfd::fw {
+
+void
+AdmissionControl::setConfig(const Config& config)
+{
+  std::vector<PrefixState> prefixes;
+  for (const auto& pq : config.prefixQuotas) {
+    auto old = std::find_if(m_prefixes.begin(), m_prefixes.end(),
+                            [&] (const auto& ps) { return ps.prefix == pq.prefix; });
+    prefixes.push_back({pq.prefix, pq.pitQuota,
+                        old == m_prefixes.end() ? make_shared<size_t>(0) : old->nPitEntries});
+  }
+
+  m_config = config;
+  m_prefixes = std::move(prefixes);
+  for (auto& [faceId, state] : m_faces) {
+    state.tokens = std::min(state.tokens, static_cast<double>(m_config.faceInterestBurst));
+  }
+}
+
+AdmissionControl::FaceState&
+AdmissionControl::getFaceState(FaceId faceId)
+{
+  auto [it, isNew] = m_faces.try_emplace(faceId);
+  if (isNew) {
+    it->second.tokens = static_cast<double>(m_config.faceInterestBurst);
+    it->second.lastRefill = time::steady_clock::now();
+  }
+  return it->second;
+}
+
+bool
+AdmissionControl::consumeToken(FaceId faceId)
+{
+  auto& state = getFaceState(faceId);
+  auto now = time::steady_clock::now();
+  auto elapsed = time::duration_cast<time::duration<double>>(now - state.lastRefill);
+  state.tokens = std::min(state.tokens + elapsed.count() * m_config.faceInterestRate,
+                          static_cast<double>(m_config.faceInterestBurst));
+  state.lastRefill = now;
+
+  if (state.tokens < 1.0) {
+    return false;
+  }
+  state.tokens -= 1.0;
+  return true;
+}
+
+const AdmissionControl::PrefixState*
+AdmissionControl::findPrefix(const Name& name) const
+{
+  const PrefixState* match = nullptr;
+  for (const auto& ps : m_prefixes) {
+    if ((match == nullptr || ps.prefix.size() > match->prefix.size()) && ps.prefix.isPrefixOf(name)) {
+      match = &ps;
+    }
+  }
+  return match;
+}
+
+bool
+AdmissionControl::canCreatePitEntry(FaceId faceId, const Name& name) const
+{
+  if (m_config.facePitQuota > 0 && getFacePitUsage(faceId) >= m_config.facePitQuota) {
+    return false;
+  }
+
+  const PrefixState* ps = findPrefix(name);
+  return ps == nullptr || *ps->nPitEntries < ps->pitQuota;
+}
+
+shared_ptr<void>
+AdmissionControl::chargePitEntry(FaceId faceId, const Name& name)
+{
+  auto faceUsage = getFaceState(faceId).nPitEntries;
+  ++*faceUsage;
+
+  shared_ptr<size_t> prefixUsage;
+  if (const PrefixState* ps = findPrefix(name); ps != nullptr) {
+    prefixUsage = ps->nPitEntries;
+    ++*prefixUsage;
+  }
+
+  return shared_ptr<void>(nullptr, [faceUsage = std::move(faceUsage),
+                                    prefixUsage = std::move(prefixUsage)] (void*) {
+    --*faceUsage;
+    if (prefixUsage != nullptr) {
+      --*prefixUsage;
+    }
+  });
+}
+
+void
+AdmissionControl::removeFace(FaceId faceId)
+{
+  m_faces.erase(faceId);
+}
+
+size_t
+AdmissionControl::getFacePitUsage(FaceId faceId) const
+{
+  auto it = m_faces.find(faceId);
+  return it == m_faces.end() ? 0 : *it->second.nPitEntries;
+}
+
+size_t
+AdmissionControl::getPrefixPitUsage(const Name& prefix) const
+{
+  auto it = std::find_if(m_prefixes.begin(), m_prefixes.end(),
+                         [&] (const auto& ps) { return ps.prefix == prefix; });
+  return it == m_prefixes.end() ? 0 : *it->nPitEntries;
+}
+
+} // namespace nfd::fw
@@ -0,0 +1,157 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_ADMISSION_CONTROL_HPP
+#define NFD_DAEMON_FW_ADMISSION_CONTROL_HPP
+
+#include "face/face-common.hpp"
+
+#include <unordered_map>
+
+namespace nfd::fw {
+
+/**
+ * \brief Decides whether incoming Interests may enter the PIT
+ *
+ * A token bucket limits the rate of Interests accepted from each face. PIT quotas limit the
+ * number of PIT entries that each face may create, and the number of PIT entries under each
+ * configured prefix; the longest configured prefix of an entry's name is the one charged.
+ * A quota only prevents the creation of new entries: an Interest that joins an existing entry
+ * is always admitted.
+ */
+class AdmissionControl : noncopyable
+{
+public:
+  struct PrefixQuota
+  {
+    Name prefix;
+    size_t pitQuota = 0;
+  };
+
+  struct Config
+  {
+    /// Number of PIT entries that each face may create. A value of zero means unlimited.
+    size_t facePitQuota = 0;
+
+    /// Interests per second accepted from each face. A value of zero means unlimited.
+    double faceInterestRate = 0;
+
+    /// Depth of the per-face token bucket, in Interests.
+    size_t faceInterestBurst = 100;
+
+    std::vector<PrefixQuota> prefixQuotas;
+
+    /// Whether rejected Interests are answered with a Nack~Congestion instead of being dropped.
+    bool wantNack = true;
+  };
+
+  const Config&
+  getConfig() const
+  {
+    return m_config;
+  }
+
+  /** \brief changes the configuration
+   *
+   *  The usage of a prefix quota that remains configured is preserved.
+   */
+  void
+  setConfig(const Config& config);
+
+  bool
+  hasRateLimit() const
+  {
+    return m_config.faceInterestRate > 0;
+  }
+
+  bool
+  hasPitQuotas() const
+  {
+    return m_config.facePitQuota > 0 || !m_prefixes.empty();
+  }
+
+  /** \brief takes a token from the bucket of \p faceId
+   *  \retval false the face has exceeded its Interest rate
+   */
+  bool
+  consumeToken(FaceId faceId);
+
+  /** \return whether a new PIT entry for \p name may be created on behalf of \p faceId
+   */
+  bool
+  canCreatePitEntry(FaceId faceId, const Name& name) const;
+
+  /** \brief charges a new PIT entry for \p name to the quotas of \p faceId and of \p name
+   *  \return a handle that releases the charge when the last copy of it is destroyed
+   */
+  shared_ptr<void>
+  chargePitEntry(FaceId faceId, const Name& name);
+
+  /** \brief forgets the state of a face that is being removed
+   *
+   *  PIT entries created by the face remain charged to their prefix quotas until they are erased.
+   */
+  void
+  removeFace(FaceId faceId);
+
+NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  size_t
+  getFacePitUsage(FaceId faceId) const;
+
+  size_t
+  getPrefixPitUsage(const Name& prefix) const;
+
+private:
+  struct FaceState
+  {
+    double tokens;
+    time::steady_clock::TimePoint lastRefill;
+    shared_ptr<size_t> nPitEntries = make_shared<size_t>(0);
+  };
+
+  struct PrefixState
+  {
+    Name prefix;
+    size_t pitQuota;
+    shared_ptr<size_t> nPitEntries;
+  };
+
+  FaceState&
+  getFaceState(FaceId faceId);
+
+  /** \return the state of the longest configured prefix of \p name, or nullptr if none
+   */
+  const PrefixState*
+  findPrefix(const Name& name) const;
+
+private:
+  Config m_config;
+  std::unordered_map<FaceId, FaceState> m_faces;
+  std::vector<PrefixState> m_prefixes;
+};
+
+} // namespace nfd::fw
+
+#endif // NFD_DAEMON_FW_ADMISSION_CONTROL_HPP
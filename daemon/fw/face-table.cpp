@@ -75,6 +75,15 @@ FaceTable::addReserved(shared_ptr<Face> face, FaceId faceId)
   this->addImpl(std::move(face), faceId);
 }
 
+void
+FaceTable::addMirror(shared_ptr<Face> face, FaceId faceId)
+{
+  BOOST_ASSERT(face->getId() == face::INVALID_FACEID);
+  BOOST_ASSERT(faceId != face::INVALID_FACEID);
+  BOOST_ASSERT(m_faces.count(faceId) == 0);
+  this->addImpl(std::move(face), faceId);
+}
+
 void
 FaceTable::addImpl(shared_ptr<Face> facePtr, FaceId faceId)
 {
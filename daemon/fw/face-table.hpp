@@ -53,6 +53,15 @@ public:
   void
   addReserved(shared_ptr<Face> face, FaceId faceId);
 
+  /** \brief add a face with the same FaceId as a face in another FaceTable
+   *  \pre no face with \p faceId exists in this FaceTable
+   *
+   *  This is used by forwarding threads to mirror the faces owned by the main thread.
+   *  A FaceTable should not mix this method with add().
+   */
+  void
+  addMirror(shared_ptr<Face> face, FaceId faceId);
+
   /** \brief get face by FaceId
    *  \return a face if found, nullptr if not found;
    *          face->shared_from_this() can be used if shared_ptr<Face> is desired
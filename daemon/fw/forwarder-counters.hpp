@@ -27,6 +27,7 @@
 #define NFD_DAEMON_FW_FORWARDER_COUNTERS_HPP
 
 #include "common/counter.hpp"
+#include "common/slab-pool.hpp"
 
 namespace nfd {
 
@@ -48,6 +49,13 @@ public:
 
   PacketCounter nCsHits;
   PacketCounter nCsMisses;
+
+  /** \brief number of name tree nodes and PIT entries allocated from their memory pools
+   *  \note Pool capacity is available from SlabPool::capacity() of the observed pool.
+   *  \note In-records and out-records are stored inline in their PIT entries.
+   */
+  SizeCounter<SlabPool> nNameTreeNodesAllocated;
+  SizeCounter<SlabPool> nPitEntriesAllocated;
 };
 
 } // namespace nfd
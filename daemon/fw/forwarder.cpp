@@ -28,19 +28,24 @@
 #include "algorithm.hpp"
 #include "best-route-strategy.hpp"
 #include "scope-prefix.hpp"
+#include "sharded-forwarder.hpp"
 #include "strategy.hpp"
 #include "common/global.hpp"
 #include "common/logger.hpp"
+#include "common/timer-wheel.hpp"
 #include "table/cleanup.hpp"
 
 #include <ndn-cxx/lp/pit-token.hpp>
 #include <ndn-cxx/lp/tags.hpp>
 
+#include <boost/container/small_vector.hpp>
+
 namespace nfd {
 
 NFD_LOG_INIT(Forwarder);
 
 const std::string CFG_FORWARDER = "forwarder";
+const size_t MAX_BATCH_SIZE = 256;
 
 static Name
 getDefaultStrategyName()
@@ -56,17 +61,25 @@ Forwarder::Forwarder(FaceTable& faceTable)
   , m_measurements(m_nameTree)
   , m_strategyChoice(*this)
 {
+  m_counters.nNameTreeNodesAllocated.observe(&getSlabPool<name_tree::Node>());
+  m_counters.nPitEntriesAllocated.observe(&getSlabPool<pit::Entry>());
+
   m_faceTable.afterAdd.connect([this] (const Face& face) {
     face.afterReceiveInterest.connect(
       [this, &face] (const Interest& interest, const EndpointId& endpointId) {
-        this->onIncomingInterest(interest, FaceEndpoint(const_cast<Face&>(face), endpointId));
+        this->enqueueIncomingInterest(interest, FaceEndpoint(const_cast<Face&>(face), endpointId));
       });
     face.afterReceiveData.connect(
       [this, &face] (const Data& data, const EndpointId& endpointId) {
-        this->onIncomingData(data, FaceEndpoint(const_cast<Face&>(face), endpointId));
+        this->enqueueIncomingData(data, FaceEndpoint(const_cast<Face&>(face), endpointId));
       });
     face.afterReceiveNack.connect(
       [this, &face] (const lp::Nack& nack, const EndpointId& endpointId) {
+        if (m_shardedForwarder != nullptr) {
+          m_shardedForwarder->dispatchNack(nack, FaceEndpoint(const_cast<Face&>(face), endpointId));
+          return;
+        }
+        this->flushIncomingBatches();
         this->onIncomingNack(nack, FaceEndpoint(const_cast<Face&>(face), endpointId));
       });
     face.onDroppedInterest.connect(
@@ -76,7 +89,10 @@ Forwarder::Forwarder(FaceTable& faceTable)
   });
 
   m_faceTable.beforeRemove.connect([this] (const Face& face) {
+    // packets received on the face must not outlive it
+    this->flushIncomingBatches();
     cleanupOnFaceRemoval(m_nameTree, m_fib, m_pit, face);
+    m_admissionControl.removeFace(face.getId());
   });
 
   m_fib.afterNewNextHop.connect([this] (const Name& prefix, const fib::NextHop& nextHop) {
@@ -90,6 +106,14 @@ Forwarder::~Forwarder() = default;
 
 void
 Forwarder::onIncomingInterest(const Interest& interest, const FaceEndpoint& ingress)
+{
+  if (this->preprocessIncomingInterest(interest, ingress)) {
+    this->processIncomingInterest(interest, ingress);
+  }
+}
+
+bool
+Forwarder::preprocessIncomingInterest(const Interest& interest, const FaceEndpoint& ingress)
 {
   // receive Interest
   NFD_LOG_DEBUG("onIncomingInterest in=" << ingress << " interest=" << interest.getName());
@@ -103,7 +127,7 @@ Forwarder::onIncomingInterest(const Interest& interest, const FaceEndpoint& ingr
                     << " hop-limit=0");
       ++ingress.face.getCounters().nInHopLimitZero;
       // drop
-      return;
+      return false;
     }
     const_cast<Interest&>(interest).setHopLimit(*interest.getHopLimit() - 1);
   }
@@ -115,7 +139,16 @@ Forwarder::onIncomingInterest(const Interest& interest, const FaceEndpoint& ingr
     NFD_LOG_DEBUG("onIncomingInterest in=" << ingress
                   << " interest=" << interest.getName() << " violates /localhost");
     // drop
-    return;
+    return false;
+  }
+
+  // per-face Interest rate limit
+  if (m_admissionControl.hasRateLimit() && !m_admissionControl.consumeToken(ingress.face.getId())) {
+    NFD_LOG_DEBUG("onIncomingInterest in=" << ingress
+                  << " interest=" << interest.getName() << " rate-limited");
+    ++ingress.face.getCounters().nInInterestsRateLimited;
+    this->rejectInterest(interest, ingress);
+    return false;
   }
 
   // detect duplicate Nonce with Dead Nonce List
@@ -123,7 +156,7 @@ Forwarder::onIncomingInterest(const Interest& interest, const FaceEndpoint& ingr
   if (hasDuplicateNonceInDnl) {
     // goto Interest loop pipeline
     this->onInterestLoop(interest, ingress);
-    return;
+    return false;
   }
 
   // strip forwarding hint if Interest has reached producer region
@@ -134,8 +167,34 @@ Forwarder::onIncomingInterest(const Interest& interest, const FaceEndpoint& ingr
     const_cast<Interest&>(interest).setForwardingHint({});
   }
 
-  // PIT insert
-  shared_ptr<pit::Entry> pitEntry = m_pit.insert(interest).first;
+  return true;
+}
+
+void
+Forwarder::processIncomingInterest(const Interest& interest, const FaceEndpoint& ingress)
+{
+  // PIT insert, subject to PIT quotas
+  shared_ptr<pit::Entry> pitEntry;
+  if (m_admissionControl.hasPitQuotas() &&
+      !m_admissionControl.canCreatePitEntry(ingress.face.getId(), interest.getName())) {
+    // a quota only prevents new entries, the Interest may still join an existing one
+    pitEntry = m_pit.find(interest);
+    if (pitEntry == nullptr) {
+      NFD_LOG_DEBUG("onIncomingInterest in=" << ingress
+                    << " interest=" << interest.getName() << " over-pit-quota");
+      ++ingress.face.getCounters().nInInterestsOverQuota;
+      this->rejectInterest(interest, ingress);
+      return;
+    }
+  }
+  else {
+    bool isNew = false;
+    std::tie(pitEntry, isNew) = m_pit.insert(interest);
+    if (isNew && m_admissionControl.hasPitQuotas()) {
+      pitEntry->quotaCharge = m_admissionControl.chargePitEntry(ingress.face.getId(),
+                                                                interest.getName());
+    }
+  }
 
   // detect duplicate Nonce in PIT entry
   int dnw = fw::findDuplicateNonce(*pitEntry, interest.getNonce(), ingress.face);
@@ -161,6 +220,21 @@ Forwarder::onIncomingInterest(const Interest& interest, const FaceEndpoint& ingr
   }
 }
 
+void
+Forwarder::rejectInterest(const Interest& interest, const FaceEndpoint& ingress)
+{
+  // a Nack on a multi-access or ad hoc face would reach every node on the link
+  if (!m_admissionControl.getConfig().wantNack ||
+      ingress.face.getLinkType() != ndn::nfd::LINK_TYPE_POINT_TO_POINT) {
+    return;
+  }
+
+  // note: Don't enter outgoing Nack pipeline because it needs an in-record.
+  lp::Nack nack(interest);
+  nack.setReason(lp::NackReason::CONGESTION);
+  ingress.face.sendNack(nack);
+}
+
 void
 Forwarder::onInterestLoop(const Interest& interest, const FaceEndpoint& ingress)
 {
@@ -270,16 +344,16 @@ Forwarder::onOutgoingInterest(const Interest& interest, Face& egress,
 }
 
 void
-Forwarder::onInterestFinalize(const shared_ptr<pit::Entry>& pitEntry)
+Forwarder::onInterestFinalize(pit::Entry& pitEntry)
 {
-  NFD_LOG_DEBUG("onInterestFinalize interest=" << pitEntry->getName()
-                << (pitEntry->isSatisfied ? " satisfied" : " unsatisfied"));
+  NFD_LOG_DEBUG("onInterestFinalize interest=" << pitEntry.getName()
+                << (pitEntry.isSatisfied ? " satisfied" : " unsatisfied"));
 
   // Dead Nonce List insert if necessary
-  this->insertDeadNonceList(*pitEntry, nullptr);
+  this->insertDeadNonceList(pitEntry, nullptr);
 
   // Increment satisfied/unsatisfied Interests counter
-  if (pitEntry->isSatisfied) {
+  if (pitEntry.isSatisfied) {
     ++m_counters.nSatisfiedInterests;
   }
   else {
@@ -287,12 +361,20 @@ Forwarder::onInterestFinalize(const shared_ptr<pit::Entry>& pitEntry)
   }
 
   // PIT delete
-  pitEntry->expiryTimer.cancel();
-  m_pit.erase(pitEntry.get());
+  pitEntry.expiryTimer.cancel();
+  m_pit.erase(&pitEntry);
 }
 
 void
 Forwarder::onIncomingData(const Data& data, const FaceEndpoint& ingress)
+{
+  if (this->preprocessIncomingData(data, ingress)) {
+    this->processIncomingData(data, ingress);
+  }
+}
+
+bool
+Forwarder::preprocessIncomingData(const Data& data, const FaceEndpoint& ingress)
 {
   // receive Data
   NFD_LOG_DEBUG("onIncomingData in=" << ingress << " data=" << data.getName());
@@ -305,9 +387,15 @@ Forwarder::onIncomingData(const Data& data, const FaceEndpoint& ingress)
   if (isViolatingLocalhost) {
     NFD_LOG_DEBUG("onIncomingData in=" << ingress << " data=" << data.getName() << " violates /localhost");
     // drop
-    return;
+    return false;
   }
 
+  return true;
+}
+
+void
+Forwarder::processIncomingData(const Data& data, const FaceEndpoint& ingress)
+{
   // PIT match
   pit::DataMatchResult pitMatches = m_pit.findAllDataMatches(data);
   if (pitMatches.size() == 0) {
@@ -387,6 +475,127 @@ Forwarder::onIncomingData(const Data& data, const FaceEndpoint& ingress)
   }
 }
 
+void
+Forwarder::onIncomingInterestBatch(const std::vector<IncomingPacket<Interest>>& batch)
+{
+  // checks that depend on each Interest alone
+  boost::container::small_vector<const IncomingPacket<Interest>*, 64> accepted;
+  for (const auto& in : batch) {
+    if (this->preprocessIncomingInterest(*in.packet, in.ingress)) {
+      accepted.push_back(&in);
+    }
+  }
+
+  // compute name hashes and start loading the buckets that PIT insert will visit
+  for (const auto* in : accepted) {
+    m_nameTree.prefetch(m_nameTree.computeHashes(*in->packet));
+  }
+
+  // PIT insert, CS lookup and strategy dispatch must see the effects of earlier Interests
+  // (in-records, Nonces), therefore they run in arrival order
+  for (const auto* in : accepted) {
+    this->processIncomingInterest(*in->packet, in->ingress);
+  }
+}
+
+void
+Forwarder::onIncomingDataBatch(const std::vector<IncomingPacket<Data>>& batch)
+{
+  boost::container::small_vector<const IncomingPacket<Data>*, 64> accepted;
+  for (const auto& in : batch) {
+    if (this->preprocessIncomingData(*in.packet, in.ingress)) {
+      accepted.push_back(&in);
+    }
+  }
+
+  for (const auto* in : accepted) {
+    m_nameTree.prefetch(m_nameTree.computeHashes(*in->packet));
+  }
+
+  for (const auto* in : accepted) {
+    this->processIncomingData(*in->packet, in->ingress);
+  }
+}
+
+void
+Forwarder::enqueueIncomingInterest(const Interest& interest, const FaceEndpoint& ingress)
+{
+  if (m_shardedForwarder != nullptr) {
+    m_shardedForwarder->dispatchInterest(interest, ingress);
+    return;
+  }
+
+  if (m_config.batchSize <= 1 && m_interestBatch.empty() && m_dataBatch.empty()) {
+    this->onIncomingInterest(interest, ingress);
+    return;
+  }
+
+  // preserve arrival order between Interests and Data
+  if (!m_dataBatch.empty()) {
+    this->onIncomingDataBatch(std::exchange(m_dataBatch, {}));
+  }
+
+  if (m_interestBatch.empty()) {
+    m_interestBatch.reserve(m_config.batchSize);
+    this->scheduleBatchFlush();
+  }
+  m_interestBatch.push_back({sharePacket(interest), ingress});
+
+  if (m_interestBatch.size() >= m_config.batchSize) {
+    this->onIncomingInterestBatch(std::exchange(m_interestBatch, {}));
+  }
+}
+
+void
+Forwarder::enqueueIncomingData(const Data& data, const FaceEndpoint& ingress)
+{
+  if (m_shardedForwarder != nullptr) {
+    m_shardedForwarder->dispatchData(data, ingress);
+    return;
+  }
+
+  if (m_config.batchSize <= 1 && m_interestBatch.empty() && m_dataBatch.empty()) {
+    this->onIncomingData(data, ingress);
+    return;
+  }
+
+  if (!m_interestBatch.empty()) {
+    this->onIncomingInterestBatch(std::exchange(m_interestBatch, {}));
+  }
+
+  if (m_dataBatch.empty()) {
+    m_dataBatch.reserve(m_config.batchSize);
+    this->scheduleBatchFlush();
+  }
+  m_dataBatch.push_back({sharePacket(data), ingress});
+
+  if (m_dataBatch.size() >= m_config.batchSize) {
+    this->onIncomingDataBatch(std::exchange(m_dataBatch, {}));
+  }
+}
+
+void
+Forwarder::scheduleBatchFlush()
+{
+  // a zero delay lets the I/O events that are already pending, which usually carry more
+  // packets, be handled before the batch is processed
+  m_flushBatchEvent = getScheduler().schedule(0_ms, [this] { flushIncomingBatches(); });
+}
+
+void
+Forwarder::flushIncomingBatches()
+{
+  m_flushBatchEvent.cancel();
+
+  // at most one of the batches is non-empty
+  if (!m_interestBatch.empty()) {
+    this->onIncomingInterestBatch(std::exchange(m_interestBatch, {}));
+  }
+  if (!m_dataBatch.empty()) {
+    this->onIncomingDataBatch(std::exchange(m_dataBatch, {}));
+  }
+}
+
 void
 Forwarder::onDataUnsolicited(const Data& data, const FaceEndpoint& ingress)
 {
@@ -421,9 +630,7 @@ Forwarder::onOutgoingData(const Data& data, Face& egress)
     return false;
   }
 
-  // TODO traffic manager
-
-  // send Data
+  // send Data; its rate and queueing on the face are managed by the face's EgressScheduler
   egress.sendData(data);
   ++m_counters.nOutData;
 
@@ -568,8 +775,8 @@ Forwarder::setExpiryTimer(const shared_ptr<pit::Entry>& pitEntry, time::millisec
   BOOST_ASSERT(pitEntry);
   duration = std::max(duration, 0_ms);
 
-  pitEntry->expiryTimer.cancel();
-  pitEntry->expiryTimer = getScheduler().schedule(duration, [=] { onInterestFinalize(pitEntry); });
+  getTimerWheel().schedule(pitEntry->expiryTimer, duration,
+                           [this, entry = pitEntry.get()] { onInterestFinalize(*entry); });
 }
 
 void
@@ -616,20 +823,92 @@ void
 Forwarder::processConfig(const ConfigSection& configSection, bool isDryRun, const std::string&)
 {
   Config config;
+  fw::AdmissionControl::Config admission;
 
   for (const auto& pair : configSection) {
     const std::string& key = pair.first;
-    if (key == "default_hop_limit") {
+    if (key == "admission") {
+      admission = parseAdmissionConfig(pair.second);
+    }
+    else if (key == "default_hop_limit") {
       config.defaultHopLimit = ConfigFile::parseNumber<uint8_t>(pair, CFG_FORWARDER);
     }
+    else if (key == "batch_size") {
+      config.batchSize = ConfigFile::parseNumber<size_t>(pair, CFG_FORWARDER);
+      ConfigFile::checkRange(config.batchSize, size_t{1}, MAX_BATCH_SIZE, key, CFG_FORWARDER);
+    }
     else {
       NDN_THROW(ConfigFile::Error("Unrecognized option " + CFG_FORWARDER + "." + key));
     }
   }
 
   if (!isDryRun) {
+    // packets already queued are processed under the old batch size
+    this->flushIncomingBatches();
     m_config = config;
+    m_admissionControl.setConfig(admission);
+  }
+}
+
+fw::AdmissionControl::Config
+Forwarder::parseAdmissionConfig(const ConfigSection& configSection)
+{
+  const std::string sectionName = CFG_FORWARDER + ".admission";
+  fw::AdmissionControl::Config config;
+
+  for (const auto& pair : configSection) {
+    const std::string& key = pair.first;
+    if (key == "face_pit_quota") {
+      config.facePitQuota = ConfigFile::parseNumber<size_t>(pair, sectionName);
+    }
+    else if (key == "face_interest_rate") {
+      config.faceInterestRate = ConfigFile::parseNumber<uint32_t>(pair, sectionName);
+    }
+    else if (key == "face_interest_burst") {
+      config.faceInterestBurst = ConfigFile::parseNumber<size_t>(pair, sectionName);
+      ConfigFile::checkRange(config.faceInterestBurst, size_t{1}, size_t{1} << 20, key, sectionName);
+    }
+    else if (key == "reject") {
+      const auto& value = pair.second.get_value<std::string>();
+      if (value == "nack") {
+        config.wantNack = true;
+      }
+      else if (value == "drop") {
+        config.wantNack = false;
+      }
+      else {
+        NDN_THROW(ConfigFile::Error("Invalid value for option " + sectionName + ".reject"));
+      }
+    }
+    else if (key == "prefix") {
+      fw::AdmissionControl::PrefixQuota pq;
+      try {
+        pq.prefix = Name(pair.second.get_value<std::string>());
+      }
+      catch (const tlv::Error&) {
+        NDN_THROW_NESTED(ConfigFile::Error("Invalid value for option " + sectionName + ".prefix"));
+      }
+      const std::string prefixSectionName = sectionName + ".prefix " + pq.prefix.toUri();
+      for (const auto& prefixPair : pair.second) {
+        if (prefixPair.first == "pit_quota") {
+          pq.pitQuota = ConfigFile::parseNumber<size_t>(prefixPair, prefixSectionName);
+        }
+        else {
+          NDN_THROW(ConfigFile::Error("Unrecognized option " + prefixSectionName + "." +
+                                      prefixPair.first));
+        }
+      }
+      if (pq.pitQuota == 0) {
+        NDN_THROW(ConfigFile::Error(prefixSectionName + " must have a positive pit_quota"));
+      }
+      config.prefixQuotas.push_back(std::move(pq));
+    }
+    else {
+      NDN_THROW(ConfigFile::Error("Unrecognized option " + sectionName + "." + key));
+    }
   }
+
+  return config;
 }
 
 } // namespace nfd
@@ -26,6 +26,7 @@
 #ifndef NFD_DAEMON_FW_FORWARDER_HPP
 #define NFD_DAEMON_FW_FORWARDER_HPP
 
+#include "admission-control.hpp"
 #include "face-table.hpp"
 #include "forwarder-counters.hpp"
 #include "unsolicited-data-policy.hpp"
@@ -41,6 +42,8 @@
 
 namespace nfd {
 
+class ShardedForwarder;
+
 namespace fw {
 class Strategy;
 } // namespace fw
@@ -126,6 +129,12 @@ public:
     return m_networkRegionTable;
   }
 
+  fw::AdmissionControl&
+  getAdmissionControl()
+  {
+    return m_admissionControl;
+  }
+
   /** \brief register handler for forwarder section of NFD configuration file
    */
   void
@@ -166,7 +175,7 @@ NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE: // pipelines
   /** \brief Interest finalize pipeline
    */
   NFD_VIRTUAL_WITH_TESTS void
-  onInterestFinalize(const shared_ptr<pit::Entry>& pitEntry);
+  onInterestFinalize(pit::Entry& pitEntry);
 
   /** \brief incoming Data pipeline
    *  \param data the incoming Data, must be well-formed and created with make_shared
@@ -206,7 +215,94 @@ NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE: // pipelines
   NFD_VIRTUAL_WITH_TESTS void
   onNewNextHop(const Name& prefix, const fib::NextHop& nextHop);
 
+NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE: // batched pipelines
+  /** \brief a packet waiting in an incoming batch
+   */
+  template<typename Packet>
+  struct IncomingPacket
+  {
+    shared_ptr<const Packet> packet;
+    FaceEndpoint ingress;
+  };
+
+  /** \return a shared_ptr to \p pkt, or to a copy of \p pkt if it is not owned by a shared_ptr
+   *
+   *  Packets that outlive the call into the Forwarder, such as those in an incoming batch,
+   *  are held this way.
+   */
+  template<typename Packet>
+  static shared_ptr<const Packet>
+  sharePacket(const Packet& pkt)
+  {
+    if (pkt.weak_from_this().expired()) {
+      return make_shared<Packet>(pkt);
+    }
+    return pkt.shared_from_this();
+  }
+
+  /** \brief incoming Interest pipeline, applied to a batch of Interests
+   *
+   *  The per-packet checks are performed on the whole batch first, then the name tree buckets
+   *  of all remaining Interests are prefetched, before the Interests are processed against the
+   *  tables in arrival order. The outcome is the same as invoking onIncomingInterest() on each
+   *  Interest in turn.
+   */
+  void
+  onIncomingInterestBatch(const std::vector<IncomingPacket<Interest>>& batch);
+
+  /** \brief incoming Data pipeline, applied to a batch of Data
+   *  \sa onIncomingInterestBatch
+   */
+  void
+  onIncomingDataBatch(const std::vector<IncomingPacket<Data>>& batch);
+
+  /** \brief process all packets waiting in incoming batches
+   */
+  void
+  flushIncomingBatches();
+
 private:
+  /** \brief first stage of incoming Interest pipeline, which depends on the Interest alone
+   *  \return whether the Interest should continue to processIncomingInterest()
+   */
+  bool
+  preprocessIncomingInterest(const Interest& interest, const FaceEndpoint& ingress);
+
+  /** \brief second stage of incoming Interest pipeline, from PIT insert onwards
+   */
+  void
+  processIncomingInterest(const Interest& interest, const FaceEndpoint& ingress);
+
+  /** \brief answer or drop an Interest refused by admission control
+   */
+  void
+  rejectInterest(const Interest& interest, const FaceEndpoint& ingress);
+
+  /** \brief first stage of incoming Data pipeline, which depends on the Data alone
+   *  \return whether the Data should continue to processIncomingData()
+   */
+  bool
+  preprocessIncomingData(const Data& data, const FaceEndpoint& ingress);
+
+  /** \brief second stage of incoming Data pipeline, from PIT match onwards
+   */
+  void
+  processIncomingData(const Data& data, const FaceEndpoint& ingress);
+
+  /** \brief append a packet received from a face to its incoming batch
+   *
+   *  The batch is processed when it is full, before a packet of another type is processed,
+   *  or once the current round of I/O events has been handled, whichever comes first.
+   */
+  void
+  enqueueIncomingInterest(const Interest& interest, const FaceEndpoint& ingress);
+
+  void
+  enqueueIncomingData(const Data& data, const FaceEndpoint& ingress);
+
+  void
+  scheduleBatchFlush();
+
   /** \brief set a new expiry timer (now + \p duration) on a PIT entry
    */
   void
@@ -223,6 +319,9 @@ private:
   processConfig(const ConfigSection& configSection, bool isDryRun,
                 const std::string& filename);
 
+  static fw::AdmissionControl::Config
+  parseAdmissionConfig(const ConfigSection& configSection);
+
 NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /**
    * \brief Configuration options from "forwarder" section
@@ -232,6 +331,10 @@ NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
     /// Initial value of HopLimit that should be added to Interests that don't have one.
     /// A value of zero disables the feature.
     uint8_t defaultHopLimit = 0;
+
+    /// Maximum number of incoming packets of the same type that are processed together.
+    /// A value of one processes every packet as soon as it is received.
+    size_t batchSize = 1;
   };
   Config m_config;
 
@@ -249,9 +352,19 @@ private:
   StrategyChoice     m_strategyChoice;
   DeadNonceList      m_deadNonceList;
   NetworkRegionTable m_networkRegionTable;
+  fw::AdmissionControl m_admissionControl;
+
+  std::vector<IncomingPacket<Interest>> m_interestBatch;
+  std::vector<IncomingPacket<Data>> m_dataBatch;
+  scheduler::ScopedEventId m_flushBatchEvent;
+
+  /// if not null, packets received by faces are dispatched to forwarding threads
+  ShardedForwarder* m_shardedForwarder = nullptr;
 
   // allow Strategy (base class) to enter pipelines
   friend ::nfd::fw::Strategy;
+  // allow ShardedForwarder to intercept received packets and replicate the configuration
+  friend ShardedForwarder;
 };
 
 } // namespace nfd
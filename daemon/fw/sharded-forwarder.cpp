@@ -0,0 +1,806 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sharded-forwarder.hpp"
+#include "face-table.hpp"
+#include "forwarder.hpp"
+#include "common/global.hpp"
+#include "common/logger.hpp"
+#include "common/spsc-channel.hpp"
+#include "common/timer-wheel.hpp"
+#include "face/link-service.hpp"
+#include "face/transport.hpp"
+
+#include <boost/exception/diagnostic_information.hpp>
+
+#include <future>
+#include <thread>
+#include <typeinfo>
+#include <variant>
+
+namespace nfd {
+
+NFD_LOG_INIT(ShardedForwarder);
+
+/// maximum number of messages taken from a ring by one handler, so that other I/O events can run
+const size_t DRAIN_LIMIT = 64;
+
+namespace {
+
+/** \brief properties of a face of the main thread that are copied to its mirrors
+ */
+struct FaceProperties
+{
+  explicit
+  FaceProperties(const Face& face)
+    : localUri(face.getLocalUri())
+    , remoteUri(face.getRemoteUri())
+    , scope(face.getScope())
+    , persistency(face.getPersistency())
+    , linkType(face.getLinkType())
+    , mtu(face.getMtu())
+  {
+  }
+
+  FaceUri localUri;
+  FaceUri remoteUri;
+  ndn::nfd::FaceScope scope;
+  ndn::nfd::FacePersistency persistency;
+  ndn::nfd::LinkType linkType;
+  ssize_t mtu;
+};
+
+/** \brief transport of a face mirror in a forwarding thread
+ *
+ *  It has the same properties as the real face, but never sends anything: MirrorLinkService
+ *  hands packets to the main thread before they reach the transport.
+ */
+class ShardTransport final : public face::Transport
+{
+public:
+  explicit
+  ShardTransport(const FaceProperties& props)
+  {
+    this->setLocalUri(props.localUri);
+    this->setRemoteUri(props.remoteUri);
+    this->setScope(props.scope);
+    this->setPersistency(props.persistency);
+    this->setLinkType(props.linkType);
+    this->setMtu(props.mtu);
+  }
+
+private:
+  void
+  doClose() final
+  {
+    this->setState(face::TransportState::CLOSED);
+  }
+
+  void
+  doSend(const Block&) final
+  {
+  }
+};
+
+} // namespace
+
+/** \brief a forwarding thread and the rings that connect it to the main thread
+ */
+class ShardedForwarder::Shard : noncopyable, public std::enable_shared_from_this<Shard>
+{
+public:
+  using Control = std::function<void(Shard&)>;
+
+  struct Message
+  {
+    std::variant<Control, shared_ptr<const Interest>, shared_ptr<const Data>,
+                 shared_ptr<const lp::Nack>> packet;
+    FaceId faceId = face::INVALID_FACEID;
+    EndpointId endpoint = 0;
+    /// whether this is a copy of Data dispatched to another shard, see dispatchData()
+    bool isCopy = false;
+  };
+
+  Shard(size_t index, size_t ringCapacity, FaceTable& mainFaceTable)
+    : m_index(index)
+    , m_mainIo(getGlobalIoService())
+    , m_mainFaceTable(mainFaceTable)
+    , m_inbound(ringCapacity)
+    , m_outbound(ringCapacity)
+  {
+  }
+
+  void
+  start()
+  {
+    std::promise<boost::asio::io_service*> ready;
+    auto io = ready.get_future();
+    m_thread = std::thread([this, &ready] { run(ready); });
+    m_io = io.get();
+  }
+
+  void
+  stop()
+  {
+    m_io->stop();
+    m_thread.join();
+  }
+
+  size_t
+  getIndex() const
+  {
+    return m_index;
+  }
+
+  Forwarder&
+  getForwarder()
+  {
+    return *m_forwarder;
+  }
+
+  FaceTable&
+  getFaceTable()
+  {
+    return *m_faceTable;
+  }
+
+  /** \brief add a mirror of a face of the main thread
+   */
+  void
+  addFace(FaceId faceId, const FaceProperties& props);
+
+public: // invoked on the main thread
+  /** \brief pass a packet received by a face to this shard
+   *  \return false if the packet is dropped because the ring is full
+   */
+  bool
+  receive(Message&& msg)
+  {
+    if (!m_inbound.push(std::move(msg))) {
+      return false;
+    }
+    m_inbound.notify(*m_io, [this] { drainInbound(); });
+    return true;
+  }
+
+  /** \brief execute \p f on this shard's thread, after all previously passed messages
+   */
+  void
+  control(Control f)
+  {
+    Message msg{std::move(f)};
+    while (!m_inbound.push(std::move(msg))) {
+      std::this_thread::yield();
+    }
+    m_inbound.notify(*m_io, [this] { drainInbound(); });
+  }
+
+public: // invoked on the shard's thread
+  /** \brief pass a packet to be sent to the main thread
+   */
+  void
+  send(Message&& msg)
+  {
+    if (!m_outbound.push(std::move(msg))) {
+      NFD_LOG_DEBUG("shard=" << m_index << " outbound ring full, dropping packet");
+      return;
+    }
+    m_outbound.notify(m_mainIo, [self = weak_from_this()] {
+      if (auto shard = self.lock(); shard != nullptr) {
+        shard->drainOutbound();
+      }
+    });
+  }
+
+private:
+  void
+  run(std::promise<boost::asio::io_service*>& ready)
+  {
+    auto& io = getGlobalIoService();
+    boost::asio::io_service::work work(io);
+    m_faceTable = make_unique<FaceTable>();
+    m_forwarder = make_unique<Forwarder>(*m_faceTable);
+    ready.set_value(&io);
+
+    try {
+      io.run();
+    }
+    catch (const std::exception& e) {
+      NFD_LOG_FATAL("shard=" << m_index << " " << boost::diagnostic_information(e));
+      m_mainIo.stop();
+    }
+
+    // tables must be destroyed on the thread that allocated their entries
+    m_forwarder.reset();
+    m_faceTable.reset();
+  }
+
+  void
+  drainInbound();
+
+  void
+  drainOutbound();
+
+  class MirrorLinkService;
+
+private:
+  const size_t m_index;
+  boost::asio::io_service& m_mainIo;
+  FaceTable& m_mainFaceTable;
+  boost::asio::io_service* m_io = nullptr;
+  std::thread m_thread;
+
+  SpscChannel<Message> m_inbound;
+  SpscChannel<Message> m_outbound;
+
+  // accessed only on the shard's thread
+  unique_ptr<FaceTable> m_faceTable;
+  unique_ptr<Forwarder> m_forwarder;
+};
+
+/** \brief link service of a face mirror in a forwarding thread
+ *
+ *  Received packets are delivered to the shard's Forwarder, and packets to be sent are handed
+ *  to the main thread, which sends them on the real face.
+ */
+class ShardedForwarder::Shard::MirrorLinkService final : public face::LinkService
+{
+public:
+  explicit
+  MirrorLinkService(Shard& shard)
+    : m_shard(shard)
+  {
+  }
+
+  void
+  deliver(const Message& msg)
+  {
+    std::visit([&] (const auto& pkt) {
+      using T = std::decay_t<decltype(pkt)>;
+      if constexpr (std::is_same_v<T, shared_ptr<const Interest>>) {
+        this->receiveInterest(*pkt, msg.endpoint);
+      }
+      else if constexpr (std::is_same_v<T, shared_ptr<const Data>>) {
+        Forwarder& forwarder = m_shard.getForwarder();
+        if (msg.isCopy && forwarder.getPit().findAllDataMatches(*pkt).empty()) {
+          // unsolicited in this shard: cache it as onDataUnsolicited would,
+          // but leave the counters to the shard that received the original
+          auto decision = forwarder.getUnsolicitedDataPolicy().decide(*this->getFace(), *pkt);
+          if (decision == fw::UnsolicitedDataDecision::CACHE) {
+            forwarder.getCs().insert(*pkt, true);
+          }
+          return;
+        }
+        this->receiveData(*pkt, msg.endpoint);
+      }
+      else if constexpr (std::is_same_v<T, shared_ptr<const lp::Nack>>) {
+        this->receiveNack(*pkt, msg.endpoint);
+      }
+    }, msg.packet);
+  }
+
+private:
+  // The Forwarder may send the same packet on several faces, and keeps Interests in the PIT
+  // and Data in the CS, so each outgoing packet is copied before it leaves this thread.
+
+  void
+  doSendInterest(const Interest& interest) final
+  {
+    m_shard.send({make_shared<Interest>(interest), this->getFace()->getId()});
+  }
+
+  void
+  doSendData(const Data& data) final
+  {
+    m_shard.send({make_shared<Data>(data), this->getFace()->getId()});
+  }
+
+  void
+  doSendNack(const lp::Nack& nack) final
+  {
+    m_shard.send({make_shared<lp::Nack>(nack), this->getFace()->getId()});
+  }
+
+  void
+  doReceivePacket(const Block&, const EndpointId&) final
+  {
+  }
+
+private:
+  Shard& m_shard;
+};
+
+void
+ShardedForwarder::Shard::addFace(FaceId faceId, const FaceProperties& props)
+{
+  auto face = make_shared<Face>(make_unique<MirrorLinkService>(*this),
+                                make_unique<ShardTransport>(props));
+  m_faceTable->addMirror(std::move(face), faceId);
+}
+
+void
+ShardedForwarder::Shard::drainInbound()
+{
+  bool hasMore = m_inbound.drain(DRAIN_LIMIT, [this] (Message& msg) {
+    if (auto control = std::get_if<Control>(&msg.packet); control != nullptr) {
+      (*control)(*this);
+      return;
+    }
+
+    Face* face = m_faceTable->get(msg.faceId);
+    if (face == nullptr) {
+      NFD_LOG_DEBUG("shard=" << m_index << " face=" << msg.faceId << " not found, dropping packet");
+      return;
+    }
+    static_cast<MirrorLinkService*>(face->getLinkService())->deliver(msg);
+  });
+
+  if (hasMore) {
+    m_io->post([this] { drainInbound(); });
+  }
+}
+
+void
+ShardedForwarder::Shard::drainOutbound()
+{
+  bool hasMore = m_outbound.drain(DRAIN_LIMIT, [this] (Message& msg) {
+    Face* face = m_mainFaceTable.get(msg.faceId);
+    if (face == nullptr) {
+      return;
+    }
+    std::visit([face] (const auto& pkt) {
+      using T = std::decay_t<decltype(pkt)>;
+      if constexpr (std::is_same_v<T, shared_ptr<const Interest>>) {
+        face->sendInterest(*pkt);
+      }
+      else if constexpr (std::is_same_v<T, shared_ptr<const Data>>) {
+        face->sendData(*pkt);
+      }
+      else if constexpr (std::is_same_v<T, shared_ptr<const lp::Nack>>) {
+        face->sendNack(*pkt);
+      }
+    }, msg.packet);
+  });
+
+  if (hasMore) {
+    m_mainIo.post([self = weak_from_this()] {
+      if (auto shard = self.lock(); shard != nullptr) {
+        shard->drainOutbound();
+      }
+    });
+  }
+}
+
+ShardedForwarder::ShardedForwarder(FaceTable& faceTable, Forwarder& forwarder, const Options& options)
+  : m_faceTable(faceTable)
+  , m_forwarder(forwarder)
+  , m_options(options)
+{
+  if (m_options.nShards == 0) {
+    NDN_THROW(std::invalid_argument("ShardedForwarder needs at least one shard"));
+  }
+
+  for (size_t i = 0; i < m_options.nShards; ++i) {
+    auto shard = make_shared<Shard>(i, m_options.ringCapacity, m_faceTable);
+    shard->start();
+    m_shards.push_back(std::move(shard));
+  }
+  NFD_LOG_INFO("Started " << m_shards.size() << " forwarding threads");
+
+  // settings first, as they may affect how table entries are stored
+  this->synchronizeSettings();
+
+  for (const Face& face : m_faceTable) {
+    this->addFace(face);
+  }
+
+  for (const fib::Entry& entry : m_forwarder.getFib()) {
+    for (const fib::NextHop& nh : entry.getNextHops()) {
+      this->replicateNextHop(entry.getPrefix(), nh.getFace().getId(), nh.getCost());
+    }
+  }
+
+  for (const strategy_choice::Entry& entry : m_forwarder.getStrategyChoice()) {
+    this->replicateStrategy(entry.getPrefix(), entry.getStrategyInstanceName());
+  }
+
+  m_connections.emplace_back(m_faceTable.afterAdd.connect([this] (const Face& face) {
+    this->addFace(face);
+  }));
+  m_connections.emplace_back(m_faceTable.beforeRemove.connect([this] (const Face& face) {
+    this->replicate([faceId = face.getId()] (Shard& shard) {
+      Face* mirror = shard.getFaceTable().get(faceId);
+      if (mirror != nullptr) {
+        mirror->close();
+      }
+    });
+  }));
+
+  auto onNextHop = [this] (const Name& prefix, const fib::NextHop& nh) {
+    this->replicateNextHop(prefix, nh.getFace().getId(), nh.getCost());
+  };
+  m_connections.emplace_back(m_forwarder.getFib().afterNewNextHop.connect(onNextHop));
+  m_connections.emplace_back(m_forwarder.getFib().afterUpdateNextHop.connect(onNextHop));
+  m_connections.emplace_back(m_forwarder.getFib().afterRemoveNextHop.connect(
+    [this] (const Name& prefix, const Face& face) {
+      this->replicate([prefix, faceId = face.getId()] (Shard& shard) {
+        Fib& fib = shard.getForwarder().getFib();
+        fib::Entry* entry = fib.findExactMatch(prefix);
+        Face* mirror = shard.getFaceTable().get(faceId);
+        if (entry != nullptr && mirror != nullptr) {
+          fib.removeNextHop(*entry, *mirror);
+        }
+      });
+    }));
+
+  m_connections.emplace_back(m_forwarder.getStrategyChoice().afterInsert.connect(
+    [this] (const Name& prefix, const Name& strategyName) {
+      this->replicateStrategy(prefix, strategyName);
+    }));
+  m_connections.emplace_back(m_forwarder.getStrategyChoice().afterErase.connect(
+    [this] (const Name& prefix) {
+      this->replicate([prefix] (Shard& shard) {
+        shard.getForwarder().getStrategyChoice().erase(prefix);
+      });
+    }));
+
+  m_forwarder.m_shardedForwarder = this;
+}
+
+ShardedForwarder::~ShardedForwarder()
+{
+  m_forwarder.m_shardedForwarder = nullptr;
+  m_connections.clear();
+
+  for (const auto& shard : m_shards) {
+    shard->stop();
+  }
+  NFD_LOG_INFO("Stopped " << m_shards.size() << " forwarding threads");
+}
+
+size_t
+ShardedForwarder::getShardIndex(const Name& name) const
+{
+  return this->getShardIndex(m_forwarder.getNameTree().computeHashes(name, m_options.prefixLength));
+}
+
+size_t
+ShardedForwarder::getShardIndex(const name_tree::HashSequence& hashes) const
+{
+  BOOST_ASSERT(!hashes.empty());
+  // hashes[i] is the hash of the prefix with i components
+  return this->getShardIndexOfHash(hashes[std::min(m_options.prefixLength, hashes.size() - 1)]);
+}
+
+size_t
+ShardedForwarder::getShardIndexOfHash(name_tree::HashValue hash) const
+{
+  // name tree hash values are not uniform in their low bits with every algorithm
+  auto h = static_cast<uint64_t>(hash);
+  return static_cast<size_t>((h * 0x9E3779B97F4A7C15ULL) >> 32) % m_shards.size();
+}
+
+void
+ShardedForwarder::synchronizeSettings()
+{
+  NameTree& nameTree = m_forwarder.getNameTree();
+  Cs& cs = m_forwarder.getCs();
+
+  std::string unsolicitedPolicyName;
+  for (const auto& policyName : fw::UnsolicitedDataPolicy::getPolicyNames()) {
+    auto policy = fw::UnsolicitedDataPolicy::create(policyName);
+    if (typeid(*policy) == typeid(m_forwarder.getUnsolicitedDataPolicy())) {
+      unsolicitedPolicyName = policyName;
+      break;
+    }
+  }
+
+  // the capacity of the content store is shared among the shards
+  size_t csLimit = (cs.getLimit() + m_shards.size() - 1) / m_shards.size();
+
+  // so are PIT quotas and Interest rate limits, as each face's Interests are spread over the shards
+  auto shareAmongShards = [n = m_shards.size()] (size_t quota) {
+    return (quota + n - 1) / n;
+  };
+  auto admission = m_forwarder.m_admissionControl.getConfig();
+  admission.facePitQuota = shareAmongShards(admission.facePitQuota);
+  admission.faceInterestRate /= m_shards.size();
+  admission.faceInterestBurst = shareAmongShards(admission.faceInterestBurst);
+  for (auto& pq : admission.prefixQuotas) {
+    pq.pitQuota = shareAmongShards(pq.pitQuota);
+  }
+
+  this->replicate([granularity = getTimerWheel().getGranularity(),
+                   layout = nameTree.getHashtableLayout(),
+                   algo = nameTree.getHashAlgorithm(),
+                   csLimit,
+                   csPolicyName = cs.getPolicy()->getName(),
+                   csAdmit = cs.shouldAdmit(),
+                   csServe = cs.shouldServe(),
+                   unsolicitedPolicyName,
+                   config = m_forwarder.m_config,
+                   admission,
+                   regions = m_forwarder.getNetworkRegionTable()] (Shard& shard) {
+    getTimerWheel().setGranularity(granularity);
+
+    Forwarder& forwarder = shard.getForwarder();
+    forwarder.getNameTree().setHashtableLayout(layout);
+    forwarder.getNameTree().setHashAlgorithm(algo);
+
+    Cs& cs = forwarder.getCs();
+    if (cs.getPolicy()->getName() != csPolicyName) {
+      cs.setPolicy(cs::Policy::create(csPolicyName));
+    }
+    cs.setLimit(csLimit);
+    cs.enableAdmit(csAdmit);
+    cs.enableServe(csServe);
+
+    if (!unsolicitedPolicyName.empty()) {
+      forwarder.setUnsolicitedDataPolicy(fw::UnsolicitedDataPolicy::create(unsolicitedPolicyName));
+    }
+
+    forwarder.m_config = config;
+    forwarder.m_admissionControl.setConfig(admission);
+    static_cast<std::set<Name>&>(forwarder.getNetworkRegionTable()) = regions;
+  });
+}
+
+ShardedForwarder::Status
+ShardedForwarder::collectStatus()
+{
+  std::vector<Status> statuses(m_shards.size());
+  this->collect([&statuses] (Shard& shard) {
+    Status& status = statuses[shard.getIndex()];
+    Forwarder& forwarder = shard.getForwarder();
+    const auto& counters = forwarder.getCounters();
+    status.nInInterests = counters.nInInterests;
+    status.nOutInterests = counters.nOutInterests;
+    status.nInData = counters.nInData;
+    status.nOutData = counters.nOutData;
+    status.nInNacks = counters.nInNacks;
+    status.nOutNacks = counters.nOutNacks;
+    status.nSatisfiedInterests = counters.nSatisfiedInterests;
+    status.nUnsatisfiedInterests = counters.nUnsatisfiedInterests;
+    status.nUnsolicitedData = counters.nUnsolicitedData;
+    status.nCsHits = counters.nCsHits;
+    status.nCsMisses = counters.nCsMisses;
+    status.nNameTreeEntries = forwarder.getNameTree().size();
+    status.nPitEntries = forwarder.getPit().size();
+    status.nMeasurementsEntries = forwarder.getMeasurements().size();
+    status.nCsEntries = forwarder.getCs().size();
+  });
+
+  Status total;
+  for (const Status& status : statuses) {
+    total.nInInterests += status.nInInterests;
+    total.nOutInterests += status.nOutInterests;
+    total.nInData += status.nInData;
+    total.nOutData += status.nOutData;
+    total.nInNacks += status.nInNacks;
+    total.nOutNacks += status.nOutNacks;
+    total.nSatisfiedInterests += status.nSatisfiedInterests;
+    total.nUnsatisfiedInterests += status.nUnsatisfiedInterests;
+    total.nUnsolicitedData += status.nUnsolicitedData;
+    total.nCsHits += status.nCsHits;
+    total.nCsMisses += status.nCsMisses;
+    total.nNameTreeEntries += status.nNameTreeEntries;
+    total.nPitEntries += status.nPitEntries;
+    total.nMeasurementsEntries += status.nMeasurementsEntries;
+    total.nCsEntries += status.nCsEntries;
+  }
+  return total;
+}
+
+void
+ShardedForwarder::collectFaceCounters()
+{
+  struct MirrorCounters
+  {
+    uint64_t nInHopLimitZero = 0;
+    uint64_t nOutHopLimitZero = 0;
+    uint64_t nInInterestsRateLimited = 0;
+    uint64_t nInInterestsOverQuota = 0;
+  };
+
+  std::vector<std::map<FaceId, MirrorCounters>> mirrorCounters(m_shards.size());
+  this->collect([&mirrorCounters] (Shard& shard) {
+    auto& counters = mirrorCounters[shard.getIndex()];
+    for (const Face& mirror : shard.getFaceTable()) {
+      const auto& c = mirror.getCounters();
+      counters[mirror.getId()] = {c.nInHopLimitZero, c.nOutHopLimitZero,
+                                  c.nInInterestsRateLimited, c.nInInterestsOverQuota};
+    }
+  });
+
+  for (const Face& face : m_faceTable) {
+    MirrorCounters total;
+    for (const auto& counters : mirrorCounters) {
+      auto it = counters.find(face.getId());
+      if (it != counters.end()) {
+        total.nInHopLimitZero += it->second.nInHopLimitZero;
+        total.nOutHopLimitZero += it->second.nOutHopLimitZero;
+        total.nInInterestsRateLimited += it->second.nInInterestsRateLimited;
+        total.nInInterestsOverQuota += it->second.nInInterestsOverQuota;
+      }
+    }
+    auto& counters = const_cast<Face&>(face).getCounters();
+    counters.nInHopLimitZero.set(total.nInHopLimitZero);
+    counters.nOutHopLimitZero.set(total.nOutHopLimitZero);
+    counters.nInInterestsRateLimited.set(total.nInInterestsRateLimited);
+    counters.nInInterestsOverQuota.set(total.nInInterestsOverQuota);
+  }
+}
+
+std::pair<size_t, bool>
+ShardedForwarder::eraseCs(const Name& prefix, size_t limit)
+{
+  size_t nErased = 0;
+  bool hasMore = false;
+  for (const auto& shard : m_shards) {
+    std::promise<void> promise;
+    auto done = promise.get_future();
+    // Cs::erase and Cs::find invoke their callbacks before returning
+    shard->control([&] (Shard& s) {
+      Cs& cs = s.getForwarder().getCs();
+      if (nErased < limit) {
+        cs.erase(prefix, limit - nErased, [&] (size_t n) { nErased += n; });
+      }
+      if (limit > 0 && nErased == limit) {
+        cs.find(Interest(prefix).setCanBePrefix(true),
+                [&] (const Interest&, const Data&) { hasMore = true; },
+                [] (const Interest&) {});
+      }
+      promise.set_value();
+    });
+    done.wait();
+
+    if (hasMore) {
+      break;
+    }
+  }
+  return {nErased, hasMore};
+}
+
+void
+ShardedForwarder::dispatchInterest(const Interest& interest, const FaceEndpoint& ingress)
+{
+  const auto& hashes = m_forwarder.getNameTree().computeHashes(interest);
+  size_t index = this->getShardIndex(hashes);
+  if (!m_shards[index]->receive({Forwarder::sharePacket(interest), ingress.face.getId(),
+                                 ingress.endpoint})) {
+    NFD_LOG_DEBUG("dispatchInterest in=" << ingress << " interest=" << interest.getName()
+                  << " shard=" << index << " ring full, dropping");
+  }
+}
+
+void
+ShardedForwarder::dispatchData(const Data& data, const FaceEndpoint& ingress)
+{
+  const auto& hashes = m_forwarder.getNameTree().computeHashes(data);
+  size_t index = this->getShardIndex(hashes);
+
+  // An Interest whose name is shorter than the shard prefix length is dispatched by its full
+  // name. If it has CanBePrefix, it can be satisfied by this Data, so the shard of each shorter
+  // prefix of the Data name receives a copy too. The packet is copied because the shards
+  // would otherwise share its lazily computed fields. All copies are made before the original
+  // is handed to its shard, which may then modify it (e.g., its tags) concurrently.
+  size_t nShortPrefixes = std::min(m_options.prefixLength, hashes.size() - 1);
+  std::vector<std::pair<size_t, shared_ptr<Data>>> copies;
+  for (size_t len = 1; len < nShortPrefixes; ++len) {
+    size_t copyIndex = this->getShardIndexOfHash(hashes[len]);
+    if (copyIndex == index ||
+        std::any_of(copies.begin(), copies.end(),
+                    [copyIndex] (const auto& copy) { return copy.first == copyIndex; })) {
+      continue;
+    }
+    copies.emplace_back(copyIndex, make_shared<Data>(data));
+  }
+
+  if (!m_shards[index]->receive({Forwarder::sharePacket(data), ingress.face.getId(),
+                                 ingress.endpoint})) {
+    NFD_LOG_DEBUG("dispatchData in=" << ingress << " data=" << data.getName()
+                  << " shard=" << index << " ring full, dropping");
+  }
+
+  for (auto& [copyIndex, copy] : copies) {
+    if (!m_shards[copyIndex]->receive({std::move(copy), ingress.face.getId(),
+                                       ingress.endpoint, true})) {
+      NFD_LOG_DEBUG("dispatchData in=" << ingress << " data=" << data.getName()
+                    << " shard=" << copyIndex << " ring full, dropping copy");
+    }
+  }
+}
+
+void
+ShardedForwarder::dispatchNack(const lp::Nack& nack, const FaceEndpoint& ingress)
+{
+  const auto& hashes = m_forwarder.getNameTree().computeHashes(nack.getInterest());
+  size_t index = this->getShardIndex(hashes);
+  // lp::Nack cannot be shared, so it is copied; the copy keeps the cached hash values
+  if (!m_shards[index]->receive({make_shared<lp::Nack>(nack), ingress.face.getId(), ingress.endpoint})) {
+    NFD_LOG_DEBUG("dispatchNack in=" << ingress << " nack=" << nack.getInterest().getName()
+                  << " shard=" << index << " ring full, dropping");
+  }
+}
+
+void
+ShardedForwarder::replicate(const std::function<void(Shard&)>& f)
+{
+  for (const auto& shard : m_shards) {
+    shard->control(f);
+  }
+}
+
+void
+ShardedForwarder::collect(const std::function<void(Shard&)>& f)
+{
+  std::vector<std::future<void>> done;
+  for (const auto& shard : m_shards) {
+    auto promise = make_shared<std::promise<void>>();
+    done.push_back(promise->get_future());
+    shard->control([&f, promise] (Shard& s) {
+      f(s);
+      promise->set_value();
+    });
+  }
+  for (auto& d : done) {
+    d.wait();
+  }
+}
+
+void
+ShardedForwarder::addFace(const Face& face)
+{
+  this->replicate([faceId = face.getId(), props = FaceProperties(face)] (Shard& shard) {
+    shard.addFace(faceId, props);
+  });
+}
+
+void
+ShardedForwarder::replicateNextHop(const Name& prefix, FaceId faceId, uint64_t cost)
+{
+  this->replicate([prefix, faceId, cost] (Shard& shard) {
+    Face* mirror = shard.getFaceTable().get(faceId);
+    if (mirror == nullptr) {
+      return;
+    }
+    Fib& fib = shard.getForwarder().getFib();
+    fib::Entry* entry = fib.insert(prefix).first;
+    fib.addOrUpdateNextHop(*entry, *mirror, cost);
+  });
+}
+
+void
+ShardedForwarder::replicateStrategy(const Name& prefix, const Name& strategyName)
+{
+  this->replicate([prefix, strategyName] (Shard& shard) {
+    auto res = shard.getForwarder().getStrategyChoice().insert(prefix, strategyName);
+    if (!res) {
+      NFD_LOG_WARN("cannot replicate strategy " << strategyName << " for " << prefix << ": " << res);
+    }
+  });
+}
+
+} // namespace nfd
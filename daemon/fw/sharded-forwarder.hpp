@@ -0,0 +1,205 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_SHARDED_FORWARDER_HPP
+#define NFD_DAEMON_FW_SHARDED_FORWARDER_HPP
+
+#include "face/face-endpoint.hpp"
+#include "table/name-tree-hashtable.hpp"
+
+namespace nfd {
+
+class FaceTable;
+class Forwarder;
+
+/** \brief runs the forwarding pipelines on several threads, each owning a shard of the tables
+ *
+ *  Every packet received by a face is dispatched to a shard according to the hash of the first
+ *  few components of its name, so that an Interest and the Data that satisfies it are normally
+ *  processed by the same shard. Each shard runs in its own thread with its own io_service and
+ *  Forwarder, and therefore has its own NameTree, PIT, CS, Measurements, and Dead Nonce List.
+ *
+ *  The main Forwarder remains the one visible to management. Its FIB and StrategyChoice are
+ *  replicated to every shard, along with the other forwarding settings when synchronizeSettings()
+ *  is called. Faces stay on the main thread: each shard has a mirror of every face, which hands
+ *  packets to be sent back to the main thread.
+ *
+ *  Packets are passed between the main thread and the shards through lock-free single-producer
+ *  single-consumer rings. A packet is dropped if the ring toward its destination is full.
+ *
+ *  An Interest whose name has fewer components than the shard prefix length is dispatched by its
+ *  full name. As it may have CanBePrefix, Data is also copied to the shard of each prefix of its
+ *  name that is shorter than the shard prefix length, where the copy satisfies pending Interests,
+ *  or is cached if the unsolicited Data policy allows it.
+ *
+ *  \note Packet counters of the main Forwarder do not reflect the packets processed by the shards.
+ *        They are summed over the shards by collectStatus(), and the face counters maintained
+ *        by the shards' Forwarders are copied to the real faces by collectFaceCounters().
+ */
+class ShardedForwarder : noncopyable
+{
+public:
+  struct Options
+  {
+    /// number of forwarding threads
+    size_t nShards = 2;
+    /// number of leading name components that determine the shard of a packet
+    size_t prefixLength = 2;
+    /// capacity of each ring between the main thread and a shard
+    size_t ringCapacity = 4096;
+  };
+
+  /** \brief counters and table sizes of the shards' Forwarders, summed over all shards
+   */
+  struct Status
+  {
+    uint64_t nInInterests = 0;
+    uint64_t nOutInterests = 0;
+    uint64_t nInData = 0;
+    uint64_t nOutData = 0;
+    uint64_t nInNacks = 0;
+    uint64_t nOutNacks = 0;
+    uint64_t nSatisfiedInterests = 0;
+    uint64_t nUnsatisfiedInterests = 0;
+    uint64_t nUnsolicitedData = 0;
+    uint64_t nCsHits = 0;
+    uint64_t nCsMisses = 0;
+
+    size_t nNameTreeEntries = 0;
+    size_t nPitEntries = 0;
+    size_t nMeasurementsEntries = 0;
+    size_t nCsEntries = 0;
+  };
+
+  /** \brief start forwarding threads
+   *
+   *  The faces, FIB, and StrategyChoice of \p forwarder are copied to every shard. From then on,
+   *  packets received by the faces in \p faceTable are no longer processed by \p forwarder.
+   */
+  ShardedForwarder(FaceTable& faceTable, Forwarder& forwarder, const Options& options);
+
+  /** \brief stop forwarding threads
+   *
+   *  Packets in flight are dropped. \p forwarder resumes processing received packets.
+   */
+  ~ShardedForwarder();
+
+  size_t
+  getNShards() const
+  {
+    return m_shards.size();
+  }
+
+  /** \return index of the shard that processes packets with \p name
+   */
+  size_t
+  getShardIndex(const Name& name) const;
+
+  /** \brief copy the settings of the main Forwarder that are not replicated automatically,
+   *         such as CS capacity and policy, to every shard
+   */
+  void
+  synchronizeSettings();
+
+  /** \brief sum the counters and table sizes of every shard
+   *
+   *  This blocks until every shard has processed the packets already dispatched to it.
+   */
+  Status
+  collectStatus();
+
+  /** \brief set the counters of each face that are maintained by the Forwarder, such as
+   *         FaceCounters::nInHopLimitZero, to their sum over the mirrors of the face
+   *
+   *  This blocks until every shard has processed the packets already dispatched to it.
+   */
+  void
+  collectFaceCounters();
+
+  /** \brief erase up to \p limit CS entries under \p prefix from the shards' content stores,
+   *         one shard after another
+   *  \return number of erased entries, and whether an entry under \p prefix remains
+   *          after \p limit entries have been erased
+   *
+   *  This blocks until every shard has processed the packets already dispatched to it.
+   */
+  std::pair<size_t, bool>
+  eraseCs(const Name& prefix, size_t limit);
+
+private: // invoked by Forwarder on the main thread
+  void
+  dispatchInterest(const Interest& interest, const FaceEndpoint& ingress);
+
+  void
+  dispatchData(const Data& data, const FaceEndpoint& ingress);
+
+  void
+  dispatchNack(const lp::Nack& nack, const FaceEndpoint& ingress);
+
+  friend Forwarder;
+
+private:
+  size_t
+  getShardIndex(const name_tree::HashSequence& hashes) const;
+
+  size_t
+  getShardIndexOfHash(name_tree::HashValue hash) const;
+
+  class Shard;
+
+  /** \brief invoke \p f on every shard, in the shard's thread
+   *
+   *  Unlike packets, these invocations are never dropped: this function blocks if a ring is full.
+   */
+  void
+  replicate(const std::function<void(Shard&)>& f);
+
+  /** \brief invoke \p f on every shard, in the shard's thread, and wait until all have returned
+   *
+   *  \p f may be invoked on several shards concurrently.
+   */
+  void
+  collect(const std::function<void(Shard&)>& f);
+
+  void
+  addFace(const Face& face);
+
+  void
+  replicateNextHop(const Name& prefix, FaceId faceId, uint64_t cost);
+
+  void
+  replicateStrategy(const Name& prefix, const Name& strategyName);
+
+private:
+  FaceTable& m_faceTable;
+  Forwarder& m_forwarder;
+  Options m_options;
+  std::vector<shared_ptr<Shard>> m_shards;
+  std::vector<signal::ScopedConnection> m_connections;
+};
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_SHARDED_FORWARDER_HPP
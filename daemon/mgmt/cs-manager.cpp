@@ -25,6 +25,7 @@
 
 #include "cs-manager.hpp"
 #include "fw/forwarder-counters.hpp"
+#include "fw/sharded-forwarder.hpp"
 #include "table/cs.hpp"
 
 #include <ndn-cxx/mgmt/nfd/cs-info.hpp>
@@ -63,6 +64,10 @@ CsManager::changeConfig(const ControlParameters& parameters,
     m_cs.enableServe(parameters.getFlagBit(CsFlagBit::BIT_CS_ENABLE_SERVE));
   }
 
+  if (m_shardedForwarder != nullptr) {
+    m_shardedForwarder->synchronizeSettings();
+  }
+
   ControlParameters body;
   body.setCapacity(m_cs.getLimit());
   body.setFlagBit(CsFlagBit::BIT_CS_ENABLE_ADMIT, m_cs.shouldAdmit(), false);
@@ -77,6 +82,20 @@ CsManager::erase(const ControlParameters& parameters,
   size_t count = parameters.hasCount() ?
                  parameters.getCount() :
                  std::numeric_limits<size_t>::max();
+
+  if (m_shardedForwarder != nullptr) {
+    auto [nErased, hasMore] = m_shardedForwarder->eraseCs(parameters.getName(),
+                                                          std::min(count, ERASE_LIMIT));
+    ControlParameters body;
+    body.setName(parameters.getName());
+    body.setCount(nErased);
+    if (nErased == ERASE_LIMIT && count > ERASE_LIMIT && hasMore) {
+      body.setCapacity(ERASE_LIMIT);
+    }
+    done(ControlResponse(200, "OK").setBody(body.wireEncode()));
+    return;
+  }
+
   m_cs.erase(parameters.getName(), std::min(count, ERASE_LIMIT),
     [=] (size_t nErased) {
       ControlParameters body;
@@ -105,9 +124,17 @@ CsManager::serveInfo(const Name&, const Interest&, ndn::mgmt::StatusDatasetConte
   info.setCapacity(m_cs.getLimit());
   info.setEnableAdmit(m_cs.shouldAdmit());
   info.setEnableServe(m_cs.shouldServe());
-  info.setNEntries(m_cs.size());
-  info.setNHits(m_fwCounters.nCsHits);
-  info.setNMisses(m_fwCounters.nCsMisses);
+  if (m_shardedForwarder != nullptr) {
+    auto status = m_shardedForwarder->collectStatus();
+    info.setNEntries(status.nCsEntries);
+    info.setNHits(status.nCsHits);
+    info.setNMisses(status.nCsMisses);
+  }
+  else {
+    info.setNEntries(m_cs.size());
+    info.setNHits(m_fwCounters.nCsHits);
+    info.setNMisses(m_fwCounters.nCsMisses);
+  }
 
   context.append(info.wireEncode());
   context.end();
@@ -35,6 +35,7 @@ class Cs;
 } // namespace cs
 
 class ForwarderCounters;
+class ShardedForwarder;
 
 /**
  * \brief Implements the CS Management of NFD Management Protocol.
@@ -46,6 +47,16 @@ public:
   CsManager(cs::Cs& cs, const ForwarderCounters& fwCounters,
             Dispatcher& dispatcher, CommandAuthenticator& authenticator);
 
+  /** \brief apply CS commands to the content stores of the forwarding threads of
+   *         \p shardedForwarder, and report their entries and counters in the CS dataset
+   *  \param shardedForwarder the ShardedForwarder of the Forwarder that owns the CS, or nullptr
+   */
+  void
+  setShardedForwarder(ShardedForwarder* shardedForwarder)
+  {
+    m_shardedForwarder = shardedForwarder;
+  }
+
 private:
   /** \brief Process cs/config command.
    */
@@ -71,6 +82,7 @@ public:
 private:
   cs::Cs& m_cs;
   const ForwarderCounters& m_fwCounters;
+  ShardedForwarder* m_shardedForwarder = nullptr;
 };
 
 } // namespace nfd
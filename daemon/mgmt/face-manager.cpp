@@ -29,6 +29,7 @@
 #include "face/generic-link-service.hpp"
 #include "face/protocol-factory.hpp"
 #include "fw/face-table.hpp"
+#include "fw/sharded-forwarder.hpp"
 
 #include <ndn-cxx/lp/tags.hpp>
 #include <ndn-cxx/mgmt/nfd/channel-status.hpp>
@@ -398,6 +399,10 @@ makeFaceStatus(const Face& face, const time::steady_clock::time_point& now)
 void
 FaceManager::listFaces(ndn::mgmt::StatusDatasetContext& context)
 {
+  if (m_shardedForwarder != nullptr) {
+    m_shardedForwarder->collectFaceCounters();
+  }
+
   auto now = time::steady_clock::now();
   for (const auto& face : m_faceTable) {
     ndn::nfd::FaceStatus status = makeFaceStatus(face, now);
@@ -475,6 +480,10 @@ FaceManager::queryFaces(const Interest& interest,
     return context.reject(ControlResponse(400, "Malformed filter"));
   }
 
+  if (m_shardedForwarder != nullptr) {
+    m_shardedForwarder->collectFaceCounters();
+  }
+
   auto now = time::steady_clock::now();
   for (const auto& face : m_faceTable) {
     if (matchFilter(faceFilter, face)) {
@@ -32,6 +32,8 @@
 
 namespace nfd {
 
+class ShardedForwarder;
+
 /**
  * @brief Implements the Face Management of NFD Management Protocol.
  * @sa https://redmine.named-data.net/projects/nfd/wiki/FaceMgmt
@@ -42,6 +44,16 @@ public:
   FaceManager(FaceSystem& faceSystem,
               Dispatcher& dispatcher, CommandAuthenticator& authenticator);
 
+  /** \brief collect the face counters maintained by the forwarding threads of \p shardedForwarder
+   *         before face datasets are generated
+   *  \param shardedForwarder the ShardedForwarder of the Forwarder, or nullptr
+   */
+  void
+  setShardedForwarder(ShardedForwarder* shardedForwarder)
+  {
+    m_shardedForwarder = shardedForwarder;
+  }
+
 private: // ControlCommand
   void
   createFace(const ControlParameters& parameters,
@@ -82,6 +94,7 @@ private: // NotificationStream
 private:
   FaceSystem& m_faceSystem;
   FaceTable& m_faceTable;
+  ShardedForwarder* m_shardedForwarder = nullptr;
   ndn::mgmt::PostNotification m_postNotification;
   signal::ScopedConnection m_faceAddConn;
   signal::ScopedConnection m_faceRemoveConn;
@@ -25,6 +25,7 @@
 
 #include "forwarder-status-manager.hpp"
 #include "fw/forwarder.hpp"
+#include "fw/sharded-forwarder.hpp"
 #include "core/version.hpp"
 
 namespace nfd {
@@ -63,6 +64,23 @@ ForwarderStatusManager::collectGeneralStatus()
         .setNSatisfiedInterests(counters.nSatisfiedInterests)
         .setNUnsatisfiedInterests(counters.nUnsatisfiedInterests);
 
+  if (m_shardedForwarder != nullptr) {
+    // packets are processed and the tables other than FIB are populated by the forwarding threads
+    auto shards = m_shardedForwarder->collectStatus();
+    status.setNNameTreeEntries(shards.nNameTreeEntries)
+          .setNPitEntries(shards.nPitEntries)
+          .setNMeasurementsEntries(shards.nMeasurementsEntries)
+          .setNCsEntries(shards.nCsEntries)
+          .setNInInterests(status.getNInInterests() + shards.nInInterests)
+          .setNOutInterests(status.getNOutInterests() + shards.nOutInterests)
+          .setNInData(status.getNInData() + shards.nInData)
+          .setNOutData(status.getNOutData() + shards.nOutData)
+          .setNInNacks(status.getNInNacks() + shards.nInNacks)
+          .setNOutNacks(status.getNOutNacks() + shards.nOutNacks)
+          .setNSatisfiedInterests(status.getNSatisfiedInterests() + shards.nSatisfiedInterests)
+          .setNUnsatisfiedInterests(status.getNUnsatisfiedInterests() + shards.nUnsatisfiedInterests);
+  }
+
   return status;
 }
 
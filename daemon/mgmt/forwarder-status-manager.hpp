@@ -33,6 +33,7 @@
 namespace nfd {
 
 class Forwarder;
+class ShardedForwarder;
 
 /**
  * @brief Implements the Forwarder Status of NFD Management Protocol.
@@ -43,6 +44,16 @@ class ForwarderStatusManager : noncopyable
 public:
   ForwarderStatusManager(Forwarder& forwarder, Dispatcher& dispatcher);
 
+  /** \brief report the counters and table sizes of the forwarding threads of \p shardedForwarder
+   *         instead of those of the main Forwarder
+   *  \param shardedForwarder the ShardedForwarder of the main Forwarder, or nullptr
+   */
+  void
+  setShardedForwarder(ShardedForwarder* shardedForwarder)
+  {
+    m_shardedForwarder = shardedForwarder;
+  }
+
 private:
   ndn::nfd::ForwarderStatus
   collectGeneralStatus();
@@ -55,6 +66,7 @@ private:
 
 private:
   Forwarder& m_forwarder;
+  ShardedForwarder* m_shardedForwarder = nullptr;
   Dispatcher& m_dispatcher;
   time::system_clock::TimePoint m_startTimestamp;
 };
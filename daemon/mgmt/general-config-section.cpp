@@ -24,21 +24,29 @@
  */
 
 #include "general-config-section.hpp"
+#include "common/global.hpp"
 #include "common/privilege-helper.hpp"
+#include "common/timer-wheel.hpp"
 
 namespace nfd::general {
 
 static void
-onConfig(const ConfigSection& section, bool isDryRun, const std::string&)
+onConfig(const ConfigSection& section, bool isDryRun, const std::string&,
+         StartupOptions* startupOptions)
 {
   // general
   // {
   //   user "ndn-user"
   //   group "ndn-user"
+  //   timer_granularity 1
+  //   forwarding_threads 1
+  //   shard_prefix_length 2
   // }
 
   std::string user;
   std::string group;
+  time::nanoseconds timerGranularity = TimerWheel::DEFAULT_GRANULARITY;
+  StartupOptions options;
 
   for (const auto& i : section) {
     if (i.first == "user") {
@@ -63,15 +71,38 @@ onConfig(const ConfigSection& section, bool isDryRun, const std::string&)
         NDN_THROW(ConfigFile::Error("Invalid value for 'group' in section 'general'"));
       }
     }
+    else if (i.first == "timer_granularity") {
+      auto ms = ConfigFile::parseNumber<uint32_t>(i, "general");
+      ConfigFile::checkRange(ms, 1U, 1000U, i.first, "general");
+      timerGranularity = time::milliseconds(ms);
+    }
+    else if (i.first == "forwarding_threads") {
+      options.nForwardingThreads = ConfigFile::parseNumber<size_t>(i, "general");
+      ConfigFile::checkRange(options.nForwardingThreads, size_t{1}, size_t{64}, i.first, "general");
+    }
+    else if (i.first == "shard_prefix_length") {
+      options.shardPrefixLength = ConfigFile::parseNumber<size_t>(i, "general");
+      ConfigFile::checkRange(options.shardPrefixLength, size_t{1}, size_t{8}, i.first, "general");
+    }
   }
 
   PrivilegeHelper::initialize(user, group);
+
+  if (!isDryRun) {
+    getTimerWheel().setGranularity(timerGranularity);
+    if (startupOptions != nullptr) {
+      *startupOptions = options;
+    }
+  }
 }
 
 void
-setConfigFile(ConfigFile& config)
+setConfigFile(ConfigFile& config, StartupOptions* startupOptions)
 {
-  config.addSectionHandler("general", &onConfig);
+  config.addSectionHandler("general",
+    [startupOptions] (const ConfigSection& section, bool isDryRun, const std::string& filename) {
+      onConfig(section, isDryRun, filename, startupOptions);
+    });
 }
 
 } // namespace nfd::general
@@ -30,8 +30,22 @@
 
 namespace nfd::general {
 
+/** \brief options in the general section that take effect only when NFD starts
+ */
+struct StartupOptions
+{
+  /// number of threads that run the forwarding pipelines
+  size_t nForwardingThreads = 1;
+  /// number of leading name components that determine which thread processes a packet
+  size_t shardPrefixLength = 2;
+};
+
+/** \brief register handler for the general section of NFD configuration file
+ *  \param startupOptions if not null, receives the startup options; otherwise they are
+ *                        validated but ignored, as when the configuration file is reloaded
+ */
 void
-setConfigFile(ConfigFile& config);
+setConfigFile(ConfigFile& config, StartupOptions* startupOptions = nullptr);
 
 } // namespace nfd::general
 
@@ -90,6 +90,54 @@ TablesConfigSection::processConfig(const ConfigSection& section, bool isDryRun,
     unsolicitedDataPolicy = make_unique<fw::DefaultUnsolicitedDataPolicy>();
   }
 
+  auto nameTreeLayout = name_tree::HashtableLayout::CHAINED;
+  OptionalConfigSection nameTreeLayoutNode = section.get_child_optional("name_tree_hashtable");
+  if (nameTreeLayoutNode) {
+    std::string layoutName = nameTreeLayoutNode->get_value<std::string>();
+    if (layoutName == "chained") {
+      nameTreeLayout = name_tree::HashtableLayout::CHAINED;
+    }
+    else if (layoutName == "open-addressing") {
+      nameTreeLayout = name_tree::HashtableLayout::OPEN_ADDRESSING;
+    }
+    else {
+      NDN_THROW(ConfigFile::Error("Unknown name_tree_hashtable '" + layoutName + "' in section 'tables'"));
+    }
+  }
+
+  auto nameTreeHash = name_tree::DEFAULT_HASH_ALGORITHM;
+  OptionalConfigSection nameTreeHashNode = section.get_child_optional("name_tree_hash");
+  if (nameTreeHashNode) {
+    std::string hashName = nameTreeHashNode->get_value<std::string>();
+    if (hashName == "cityhash") {
+      nameTreeHash = name_tree::HashAlgorithm::CITYHASH;
+    }
+    else if (hashName == "wyhash") {
+      nameTreeHash = name_tree::HashAlgorithm::WYHASH;
+    }
+    else {
+      NDN_THROW(ConfigFile::Error("Unknown name_tree_hash '" + hashName + "' in section 'tables'"));
+    }
+  }
+
+  size_t nameTreeResizeStep = 0;
+  OptionalConfigSection nameTreeResizeStepNode = section.get_child_optional("name_tree_resize_step");
+  if (nameTreeResizeStepNode) {
+    nameTreeResizeStep = ConfigFile::parseNumber<size_t>(*nameTreeResizeStepNode,
+                                                         "name_tree_resize_step", "tables");
+  }
+
+  float nameTreeShrinkDelay = 0.0f;
+  OptionalConfigSection nameTreeShrinkDelayNode = section.get_child_optional("name_tree_shrink_delay");
+  if (nameTreeShrinkDelayNode) {
+    nameTreeShrinkDelay = ConfigFile::parseNumber<float>(*nameTreeShrinkDelayNode,
+                                                         "name_tree_shrink_delay", "tables");
+    if (nameTreeShrinkDelay < 0.0f) {
+      NDN_THROW(ConfigFile::Error("Invalid value '" + nameTreeShrinkDelayNode->get_value<std::string>() +
+                                  "' for option 'name_tree_shrink_delay' in section 'tables'"));
+    }
+  }
+
   OptionalConfigSection strategyChoiceSection = section.get_child_optional("strategy_choice");
   if (strategyChoiceSection) {
     processStrategyChoiceSection(*strategyChoiceSection, isDryRun);
@@ -112,6 +160,11 @@ TablesConfigSection::processConfig(const ConfigSection& section, bool isDryRun,
 
   m_forwarder.setUnsolicitedDataPolicy(std::move(unsolicitedDataPolicy));
 
+  NameTree& nameTree = m_forwarder.getNameTree();
+  nameTree.setHashtableLayout(nameTreeLayout);
+  nameTree.setHashAlgorithm(nameTreeHash);
+  nameTree.setHashtableResizePolicy(nameTreeResizeStep, nameTreeShrinkDelay);
+
   m_isConfigured = true;
 }
 
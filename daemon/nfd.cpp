@@ -32,6 +32,7 @@
 #include "face/null-face.hpp"
 #include "fw/face-table.hpp"
 #include "fw/forwarder.hpp"
+#include "fw/sharded-forwarder.hpp"
 #include "mgmt/cs-manager.hpp"
 #include "mgmt/face-manager.hpp"
 #include "mgmt/fib-manager.hpp"
@@ -148,7 +149,8 @@ Nfd::initializeManagement()
                                                                *m_dispatcher, *m_authenticator);
 
   ConfigFile config(&ignoreRibAndLogSections);
-  general::setConfigFile(config);
+  general::StartupOptions startupOptions;
+  general::setConfigFile(config, &startupOptions);
 
   m_forwarder->setConfigFile(config);
 
@@ -175,6 +177,16 @@ Nfd::initializeManagement()
   fib::Entry* entry = m_forwarder->getFib().insert(topPrefix).first;
   m_forwarder->getFib().addOrUpdateNextHop(*entry, *m_internalFace, 0);
   m_dispatcher->addTopPrefix(topPrefix, false);
+
+  if (startupOptions.nForwardingThreads > 1) {
+    ShardedForwarder::Options shardOptions;
+    shardOptions.nShards = startupOptions.nForwardingThreads;
+    shardOptions.prefixLength = startupOptions.shardPrefixLength;
+    m_shardedForwarder = make_unique<ShardedForwarder>(*m_faceTable, *m_forwarder, shardOptions);
+    m_forwarderStatusManager->setShardedForwarder(m_shardedForwarder.get());
+    m_faceManager->setShardedForwarder(m_shardedForwarder.get());
+    m_csManager->setShardedForwarder(m_shardedForwarder.get());
+  }
 }
 
 void
@@ -199,6 +211,10 @@ Nfd::reloadConfigFile()
   else {
     config.parse(m_configSection, false, INTERNAL_CONFIG);
   }
+
+  if (m_shardedForwarder != nullptr) {
+    m_shardedForwarder->synchronizeSettings();
+  }
 }
 
 void
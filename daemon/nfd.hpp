@@ -37,6 +37,7 @@ namespace nfd {
 
 class FaceTable;
 class Forwarder;
+class ShardedForwarder;
 
 class CommandAuthenticator;
 class ForwarderStatusManager;
@@ -124,6 +125,7 @@ private:
   unique_ptr<FibManager> m_fibManager;
   unique_ptr<CsManager> m_csManager;
   unique_ptr<StrategyChoiceManager> m_strategyChoiceManager;
+  unique_ptr<ShardedForwarder> m_shardedForwarder;
 
   shared_ptr<ndn::net::NetworkMonitor> m_netmon;
   scheduler::ScopedEventId m_reloadConfigEvent;
@@ -137,6 +137,8 @@ Fib::addOrUpdateNextHop(Entry& entry, Face& face, uint64_t cost)
   auto [it, isNew] = entry.addOrUpdateNextHop(face, cost);
   if (isNew)
     this->afterNewNextHop(entry.getPrefix(), *it);
+  else
+    this->afterUpdateNextHop(entry.getPrefix(), *it);
 }
 
 Fib::RemoveNextHopResult
@@ -148,11 +150,14 @@ Fib::removeNextHop(Entry& entry, const Face& face)
     return RemoveNextHopResult::NO_SUCH_NEXTHOP;
   }
   else if (!entry.hasNextHops()) {
+    Name prefix = entry.getPrefix();
     name_tree::Entry* nte = m_nameTree.getEntry(entry);
     this->erase(nte, false);
+    this->afterRemoveNextHop(prefix, face);
     return RemoveNextHopResult::FIB_ENTRY_REMOVED;
   }
   else {
+    this->afterRemoveNextHop(entry.getPrefix(), face);
     return RemoveNextHopResult::NEXTHOP_REMOVED;
   }
 }
@@ -151,6 +151,16 @@ public: // signal
    */
   signal::Signal<Fib, Name, NextHop> afterNewNextHop;
 
+  /** \brief signals on cost assignment of an existing Fib entry nexthop
+   */
+  signal::Signal<Fib, Name, NextHop> afterUpdateNextHop;
+
+  /** \brief signals on Fib entry nexthop removal
+   *
+   *  When this signal is emitted, the Fib entry may have been erased.
+   */
+  signal::Signal<Fib, Name, Face> afterRemoveNextHop;
+
 private:
   /** \tparam K a parameter acceptable to NameTree::findLongestPrefixMatch
    */
@@ -26,51 +26,159 @@
 #include "name-tree-hashtable.hpp"
 #include "common/city-hash.hpp"
 #include "common/logger.hpp"
+#include "common/slab-pool.hpp"
+#include "common/wyhash.hpp"
+
+#include <ndn-cxx/tag.hpp>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#else
+#include <array>
+#endif
 
 namespace nfd::name_tree {
 
 NFD_LOG_INIT(NameTreeHashtable);
 
-class Hash32
+namespace {
+
+/** \brief hashes name components with CityHash
+ */
+class CityHashFunc
 {
 public:
   static HashValue
-  compute(const void* buffer, size_t length)
+  extend(HashValue prefixHash, const uint8_t* buffer, size_t length)
   {
-    return static_cast<HashValue>(CityHash32(reinterpret_cast<const char*>(buffer), length));
+    if constexpr (sizeof(HashValue) > 4) {
+      return static_cast<HashValue>(CityHash64WithSeed(reinterpret_cast<const char*>(buffer),
+                                                       length, prefixHash));
+    }
+    else {
+      auto h = static_cast<HashValue>(CityHash32(reinterpret_cast<const char*>(buffer), length));
+      return prefixHash ^ (h + 0x9e3779b9 + (prefixHash << 6) + (prefixHash >> 2));
+    }
   }
 };
 
-class Hash64
+/** \brief hashes name components with wyhash
+ */
+class WyHashFunc
 {
 public:
   static HashValue
-  compute(const void* buffer, size_t length)
+  extend(HashValue prefixHash, const uint8_t* buffer, size_t length)
   {
-    return static_cast<HashValue>(CityHash64(reinterpret_cast<const char*>(buffer), length));
+    uint64_t h = wyhash::hash64(buffer, length, prefixHash);
+    if constexpr (sizeof(HashValue) > 4) {
+      return static_cast<HashValue>(h);
+    }
+    else {
+      return static_cast<HashValue>(h ^ (h >> 32));
+    }
   }
 };
 
-/**
- * \brief A type with a `compute()` static method to compute the hash value from a raw buffer
+/** \brief invokes \p f with a HashFunc type that implements \p algo
+ *
+ *  HashFunc is a type with an `extend()` static method that computes the hash value of a name
+ *  from the hash value of its prefix and the TLV encoding of its last component.
+ *  The hash value of the prefix is used as a seed, which makes the combination order-sensitive.
+ */
+template<typename F>
+decltype(auto)
+dispatchHashFunc(HashAlgorithm algo, const F& f)
+{
+  switch (algo) {
+    case HashAlgorithm::WYHASH:
+      return f(WyHashFunc{});
+    case HashAlgorithm::CITYHASH:
+      break;
+  }
+  return f(CityHashFunc{});
+}
+
+/** \brief caches hash values of the name of an Interest or Data
+ *  \sa computeHashes(const Interest&, size_t, HashAlgorithm)
  */
-using HashFunc = std::conditional_t<(sizeof(HashValue) > 4), Hash64, Hash32>;
+class HashSequenceTag : public ndn::Tag
+{
+public:
+  static constexpr int
+  getTypeId() noexcept
+  {
+    // NFD-specific type IDs start at 1000, see also fw/access-strategy.hpp
+    return 1050;
+  }
+
+public:
+  HashAlgorithm algo;
+  Block nameWire; ///< encoding of the name from which hashes were computed
+  HashSequence hashes;
+};
+
+template<typename Packet>
+const HashSequence&
+computeHashesCached(const Packet& pkt, size_t prefixLen, HashAlgorithm algo)
+{
+  const Name& name = pkt.getName();
+  const Block& nameWire = name.wireEncode();
+  size_t last = std::min(prefixLen, name.size());
+
+  auto tag = pkt.template getTag<HashSequenceTag>();
+  if (tag != nullptr && tag->algo == algo && tag->hashes.size() > last &&
+      tag->nameWire == nameWire) {
+    return tag->hashes;
+  }
+
+  tag = make_shared<HashSequenceTag>();
+  tag->algo = algo;
+  tag->nameWire = nameWire;
+  tag->hashes = computeHashes(name, prefixLen, algo);
+  pkt.setTag(tag);
+  return tag->hashes;
+}
+
+} // namespace
+
+std::ostream&
+operator<<(std::ostream& os, HashAlgorithm algo)
+{
+  switch (algo) {
+    case HashAlgorithm::CITYHASH:
+      return os << "cityhash";
+    case HashAlgorithm::WYHASH:
+      return os << "wyhash";
+  }
+  return os << "unknown";
+}
+
+HashValue
+extendHash(HashValue prefixHash, const name::Component& component, HashAlgorithm algo)
+{
+  return dispatchHashFunc(algo, [&] (auto hashFunc) {
+    return hashFunc.extend(prefixHash, component.data(), component.size());
+  });
+}
 
 HashValue
-computeHash(const Name& name, size_t prefixLen)
+computeHash(const Name& name, size_t prefixLen, HashAlgorithm algo)
 {
   name.wireEncode(); // ensure wire buffer exists
 
-  HashValue h = 0;
-  for (size_t i = 0, last = std::min(prefixLen, name.size()); i < last; ++i) {
-    const name::Component& comp = name[i];
-    h ^= HashFunc::compute(comp.data(), comp.size());
-  }
-  return h;
+  return dispatchHashFunc(algo, [&] (auto hashFunc) {
+    HashValue h = 0;
+    for (size_t i = 0, last = std::min(prefixLen, name.size()); i < last; ++i) {
+      const name::Component& comp = name[i];
+      h = hashFunc.extend(h, comp.data(), comp.size());
+    }
+    return h;
+  });
 }
 
 HashSequence
-computeHashes(const Name& name, size_t prefixLen)
+computeHashes(const Name& name, size_t prefixLen, HashAlgorithm algo)
 {
   name.wireEncode(); // ensure wire buffer exists
 
@@ -81,14 +189,28 @@ computeHashes(const Name& name, size_t prefixLen)
   HashValue h = 0;
   seq.push_back(h);
 
-  for (size_t i = 0; i < last; ++i) {
-    const name::Component& comp = name[i];
-    h ^= HashFunc::compute(comp.data(), comp.size());
-    seq.push_back(h);
-  }
+  dispatchHashFunc(algo, [&] (auto hashFunc) {
+    for (size_t i = 0; i < last; ++i) {
+      const name::Component& comp = name[i];
+      h = hashFunc.extend(h, comp.data(), comp.size());
+      seq.push_back(h);
+    }
+  });
   return seq;
 }
 
+const HashSequence&
+computeHashes(const Interest& interest, size_t prefixLen, HashAlgorithm algo)
+{
+  return computeHashesCached(interest, prefixLen, algo);
+}
+
+const HashSequence&
+computeHashes(const Data& data, size_t prefixLen, HashAlgorithm algo)
+{
+  return computeHashesCached(data, prefixLen, algo);
+}
+
 Node::Node(HashValue h, const Name& name)
   : hash(h)
   , prev(nullptr)
@@ -103,12 +225,127 @@ Node::~Node()
   BOOST_ASSERT(next == nullptr);
 }
 
+void*
+Node::operator new(size_t size)
+{
+  BOOST_ASSERT(size == sizeof(Node));
+  SlabPool& pool = getSlabPool<Node>();
+  BOOST_VERIFY(pool.accommodate(sizeof(Node)));
+  return pool.allocate();
+}
+
+void
+Node::operator delete(void* ptr) noexcept
+{
+  getSlabPool<Node>().deallocate(ptr);
+}
+
 Node*
 getNode(const Entry& entry)
 {
   return entry.m_node;
 }
 
+std::ostream&
+operator<<(std::ostream& os, HashtableLayout layout)
+{
+  switch (layout) {
+    case HashtableLayout::CHAINED:
+      return os << "chained";
+    case HashtableLayout::OPEN_ADDRESSING:
+      return os << "open-addressing";
+  }
+  return os << "unknown";
+}
+
+namespace {
+
+/** \brief control byte of an empty bucket that terminates probe sequences
+ */
+constexpr int8_t CTRL_EMPTY = -128;
+
+/** \brief control byte of a bucket whose node has been erased
+ */
+constexpr int8_t CTRL_DELETED = -2;
+
+/** \brief number of control bytes scanned at a time
+ */
+constexpr size_t GROUP_WIDTH = 16;
+
+/** \brief compute the 7-bit fingerprint stored in the control byte of an occupied bucket
+ *
+ *  Most significant bits are used, because bucket index is derived from least significant bits.
+ */
+int8_t
+computeFingerprint(HashValue h)
+{
+  return static_cast<int8_t>(h >> (sizeof(HashValue) * 8 - 7));
+}
+
+size_t
+getMinBucketsForOpenAddressing(size_t nNodes)
+{
+  return nNodes + nNodes / 7 + 1;
+}
+
+/** \brief GROUP_WIDTH consecutive control bytes
+ */
+class Group
+{
+public:
+  explicit
+  Group(const int8_t* pos)
+  {
+#if defined(__SSE2__)
+    m_ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+#else
+    std::copy_n(pos, GROUP_WIDTH, m_ctrl.begin());
+#endif
+  }
+
+  /** \return bitmask of positions whose control byte equals \p ctrl
+   */
+  uint32_t
+  match(int8_t ctrl) const
+  {
+#if defined(__SSE2__)
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(m_ctrl, _mm_set1_epi8(ctrl))));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < GROUP_WIDTH; ++i) {
+      mask |= static_cast<uint32_t>(m_ctrl[i] == ctrl) << i;
+    }
+    return mask;
+#endif
+  }
+
+  /** \return bitmask of positions that are either empty or deleted
+   */
+  uint32_t
+  matchFree() const
+  {
+    // CTRL_EMPTY and CTRL_DELETED have the sign bit set, while fingerprints do not
+#if defined(__SSE2__)
+    return static_cast<uint32_t>(_mm_movemask_epi8(m_ctrl));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < GROUP_WIDTH; ++i) {
+      mask |= static_cast<uint32_t>(m_ctrl[i] < 0) << i;
+    }
+    return mask;
+#endif
+  }
+
+private:
+#if defined(__SSE2__)
+  __m128i m_ctrl;
+#else
+  std::array<int8_t, GROUP_WIDTH> m_ctrl;
+#endif
+};
+
+} // namespace
+
 HashtableOptions::HashtableOptions(size_t size)
   : initialSize(size)
   , minSize(size)
@@ -117,7 +354,6 @@ HashtableOptions::HashtableOptions(size_t size)
 
 Hashtable::Hashtable(const Options& options)
   : m_options(options)
-  , m_size(0)
 {
   BOOST_ASSERT(m_options.minSize > 0);
   BOOST_ASSERT(m_options.initialSize >= m_options.minSize);
@@ -128,45 +364,62 @@ Hashtable::Hashtable(const Options& options)
   BOOST_ASSERT(m_options.shrinkLoadFactor < 1.0);
   BOOST_ASSERT(m_options.shrinkFactor > 0.0);
   BOOST_ASSERT(m_options.shrinkFactor < 1.0);
+  BOOST_ASSERT(m_options.shrinkDelayFactor >= 0.0);
 
-  m_buckets.resize(options.initialSize);
+  this->initBuckets(m_table, options.initialSize);
   this->computeThresholds();
 }
 
 Hashtable::~Hashtable()
 {
-  for (size_t i = 0; i < m_buckets.size(); ++i) {
-    foreachNode(m_buckets[i], [] (Node* node) {
-      node->prev = node->next = nullptr;
-      delete node;
-    });
+  for (BucketArray* ba : {&m_table, &m_oldTable}) {
+    for (Node* head : ba->buckets) {
+      foreachNode(head, [] (Node* node) {
+        node->prev = node->next = nullptr;
+        delete node;
+      });
+    }
   }
 }
 
 void
-Hashtable::attach(size_t bucket, Node* node)
+Hashtable::initBuckets(BucketArray& ba, size_t nBuckets) const
+{
+  ba.buckets.assign(nBuckets, nullptr);
+  if (m_options.layout == HashtableLayout::OPEN_ADDRESSING) {
+    ba.ctrl.assign(nBuckets + GROUP_WIDTH - 1, CTRL_EMPTY);
+  }
+  else {
+    ba.ctrl.clear();
+  }
+  ba.nNodes = 0;
+  ba.nDeleted = 0;
+}
+
+void
+Hashtable::attach(BucketArray& ba, size_t bucket, Node* node)
 {
   node->prev = nullptr;
-  node->next = m_buckets[bucket];
+  node->next = ba.buckets[bucket];
 
   if (node->next != nullptr) {
     BOOST_ASSERT(node->next->prev == nullptr);
     node->next->prev = node;
   }
 
-  m_buckets[bucket] = node;
+  ba.buckets[bucket] = node;
 }
 
 void
-Hashtable::detach(size_t bucket, Node* node)
+Hashtable::detach(BucketArray& ba, size_t bucket, Node* node)
 {
   if (node->prev != nullptr) {
     BOOST_ASSERT(node->prev->next == node);
     node->prev->next = node->next;
   }
   else {
-    BOOST_ASSERT(m_buckets[bucket] == node);
-    m_buckets[bucket] = node->next;
+    BOOST_ASSERT(ba.buckets[bucket] == node);
+    ba.buckets[bucket] = node->next;
   }
 
   if (node->next != nullptr) {
@@ -177,16 +430,146 @@ Hashtable::detach(size_t bucket, Node* node)
   node->prev = node->next = nullptr;
 }
 
+void
+Hashtable::setControl(BucketArray& ba, size_t bucket, int8_t ctrl)
+{
+  size_t nBuckets = ba.buckets.size();
+  ba.ctrl[bucket] = ctrl;
+  // bucket i is cloned at every position nBuckets+k where k < GROUP_WIDTH-1 and k % nBuckets == i
+  for (size_t k = bucket; k < GROUP_WIDTH - 1; k += nBuckets) {
+    ba.ctrl[nBuckets + k] = ctrl;
+  }
+}
+
+const Node*
+Hashtable::findIn(const BucketArray& ba, const Name& name, size_t prefixLen, HashValue h) const
+{
+  size_t nBuckets = ba.buckets.size();
+  size_t bucket = h % nBuckets;
+
+  if (m_options.layout == HashtableLayout::CHAINED) {
+    for (const Node* node = ba.buckets[bucket]; node != nullptr; node = node->next) {
+      if (node->hash == h && name.compare(0, prefixLen, node->entry.getName()) == 0) {
+        return node;
+      }
+    }
+    return nullptr;
+  }
+
+  int8_t fingerprint = computeFingerprint(h);
+  size_t pos = bucket;
+  for (size_t nProbed = 0; nProbed < nBuckets; nProbed += GROUP_WIDTH) {
+    Group group(&ba.ctrl[pos]);
+    for (uint32_t mask = group.match(fingerprint); mask != 0; mask &= mask - 1) {
+      const Node* node = ba.buckets[(pos + __builtin_ctz(mask)) % nBuckets];
+      if (node->hash == h && name.compare(0, prefixLen, node->entry.getName()) == 0) {
+        return node;
+      }
+    }
+    if (group.match(CTRL_EMPTY) != 0) {
+      break;
+    }
+    pos = (pos + GROUP_WIDTH) % nBuckets;
+  }
+  return nullptr;
+}
+
+size_t
+Hashtable::findBucketIn(const BucketArray& ba, const Node& node) const
+{
+  size_t nBuckets = ba.buckets.size();
+  size_t bucket = node.hash % nBuckets;
+
+  if (m_options.layout == HashtableLayout::CHAINED) {
+    for (const Node* n = ba.buckets[bucket]; n != nullptr; n = n->next) {
+      if (n == &node) {
+        return bucket;
+      }
+    }
+    return NOT_FOUND;
+  }
+
+  int8_t fingerprint = computeFingerprint(node.hash);
+  size_t pos = bucket;
+  for (size_t nProbed = 0; nProbed < nBuckets; nProbed += GROUP_WIDTH) {
+    Group group(&ba.ctrl[pos]);
+    for (uint32_t mask = group.match(fingerprint); mask != 0; mask &= mask - 1) {
+      bucket = (pos + __builtin_ctz(mask)) % nBuckets;
+      if (ba.buckets[bucket] == &node) {
+        return bucket;
+      }
+    }
+    if (group.match(CTRL_EMPTY) != 0) {
+      break;
+    }
+    pos = (pos + GROUP_WIDTH) % nBuckets;
+  }
+  return NOT_FOUND;
+}
+
+size_t
+Hashtable::addTo(BucketArray& ba, Node* node)
+{
+  size_t nBuckets = ba.buckets.size();
+  size_t bucket = node->hash % nBuckets;
+  ++ba.nNodes;
+
+  if (m_options.layout == HashtableLayout::CHAINED) {
+    attach(ba, bucket, node);
+    return bucket;
+  }
+
+  // place node into the first free bucket of its probe sequence
+  BOOST_ASSERT(ba.nNodes + ba.nDeleted <= nBuckets);
+  size_t pos = bucket;
+  uint32_t mask = 0;
+  while ((mask = Group(&ba.ctrl[pos]).matchFree()) == 0) {
+    pos = (pos + GROUP_WIDTH) % nBuckets;
+  }
+
+  bucket = (pos + __builtin_ctz(mask)) % nBuckets;
+  if (ba.ctrl[bucket] == CTRL_DELETED) {
+    --ba.nDeleted;
+  }
+  ba.buckets[bucket] = node;
+  setControl(ba, bucket, computeFingerprint(node->hash));
+  return bucket;
+}
+
+void
+Hashtable::removeFrom(BucketArray& ba, size_t bucket, Node* node)
+{
+  --ba.nNodes;
+
+  if (m_options.layout == HashtableLayout::CHAINED) {
+    detach(ba, bucket, node);
+    return;
+  }
+
+  BOOST_ASSERT(ba.buckets[bucket] == node);
+  ba.buckets[bucket] = nullptr;
+  // the bucket can become empty only if it does not break any probe sequence
+  if (ba.ctrl[(bucket + 1) % ba.buckets.size()] == CTRL_EMPTY) {
+    setControl(ba, bucket, CTRL_EMPTY);
+  }
+  else {
+    setControl(ba, bucket, CTRL_DELETED);
+    ++ba.nDeleted;
+  }
+}
+
 std::pair<const Node*, bool>
 Hashtable::findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool allowInsert)
 {
   size_t bucket = this->computeBucketIndex(h);
 
-  for (const Node* node = m_buckets[bucket]; node != nullptr; node = node->next) {
-    if (node->hash == h && name.compare(0, prefixLen, node->entry.getName()) == 0) {
-      NFD_LOG_TRACE("found " << name.getPrefix(prefixLen) << " hash=" << h << " bucket=" << bucket);
-      return {node, false};
-    }
+  const Node* found = this->findIn(m_table, name, prefixLen, h);
+  if (found == nullptr && this->isResizing()) {
+    found = this->findIn(m_oldTable, name, prefixLen, h);
+  }
+  if (found != nullptr) {
+    NFD_LOG_TRACE("found " << name.getPrefix(prefixLen) << " hash=" << h << " bucket=" << bucket);
+    return {found, false};
   }
 
   if (!allowInsert) {
@@ -195,13 +578,11 @@ Hashtable::findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool al
   }
 
   Node* node = new Node(h, name.getPrefix(prefixLen));
-  this->attach(bucket, node);
+  bucket = this->addTo(m_table, node);
   NFD_LOG_TRACE("insert " << node->entry.getName() << " hash=" << h << " bucket=" << bucket);
   ++m_size;
-
-  if (m_size > m_expandThreshold) {
-    this->resize(static_cast<size_t>(m_options.expandFactor * this->getNBuckets()));
-  }
+  ++m_nOpsSinceResize;
+  this->resizeIfNeeded(false);
 
   return {node, true};
 }
@@ -209,71 +590,256 @@ Hashtable::findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool al
 const Node*
 Hashtable::find(const Name& name, size_t prefixLen) const
 {
-  HashValue h = computeHash(name, prefixLen);
+  HashValue h = computeHash(name, prefixLen, m_options.hashAlgorithm);
   return const_cast<Hashtable*>(this)->findOrInsert(name, prefixLen, h, false).first;
 }
 
 const Node*
 Hashtable::find(const Name& name, size_t prefixLen, const HashSequence& hashes) const
 {
-  BOOST_ASSERT(hashes.at(prefixLen) == computeHash(name, prefixLen));
+  BOOST_ASSERT(hashes.at(prefixLen) == computeHash(name, prefixLen, m_options.hashAlgorithm));
   return const_cast<Hashtable*>(this)->findOrInsert(name, prefixLen, hashes[prefixLen], false).first;
 }
 
 std::pair<const Node*, bool>
 Hashtable::insert(const Name& name, size_t prefixLen, const HashSequence& hashes)
 {
-  BOOST_ASSERT(hashes.at(prefixLen) == computeHash(name, prefixLen));
+  BOOST_ASSERT(hashes.at(prefixLen) == computeHash(name, prefixLen, m_options.hashAlgorithm));
   return this->findOrInsert(name, prefixLen, hashes[prefixLen], true);
 }
 
+size_t
+Hashtable::findBucket(const Node& node) const
+{
+  if (this->isResizing()) {
+    size_t bucket = this->findBucketIn(m_oldTable, node);
+    if (bucket != NOT_FOUND) {
+      return this->getNBuckets() + bucket;
+    }
+  }
+
+  size_t bucket = this->findBucketIn(m_table, node);
+  BOOST_ASSERT(bucket != NOT_FOUND);
+  return bucket;
+}
+
 void
 Hashtable::erase(Node* node)
 {
   BOOST_ASSERT(node != nullptr);
   BOOST_ASSERT(node->entry.getParent() == nullptr);
 
-  size_t bucket = this->computeBucketIndex(node->hash);
+  size_t bucket = this->findBucket(*node);
   NFD_LOG_TRACE("erase " << node->entry.getName() << " hash=" << node->hash << " bucket=" << bucket);
 
-  this->detach(bucket, node);
+  if (bucket < this->getNBuckets()) {
+    this->removeFrom(m_table, bucket, node);
+  }
+  else {
+    this->removeFrom(m_oldTable, bucket - this->getNBuckets(), node);
+  }
   delete node;
   --m_size;
+  ++m_nOpsSinceResize;
+  this->resizeIfNeeded(true);
+}
 
-  if (m_size < m_shrinkThreshold) {
-    size_t newNBuckets = std::max(m_options.minSize,
-      static_cast<size_t>(m_options.shrinkFactor * this->getNBuckets()));
-    this->resize(newNBuckets);
+void
+Hashtable::setLayout(HashtableLayout layout)
+{
+  if (m_options.layout == layout) {
+    return;
   }
+  NFD_LOG_DEBUG("layout from=" << m_options.layout << " to=" << layout);
+
+  m_options.layout = layout;
+  size_t nBuckets = this->getNBuckets();
+  if (layout == HashtableLayout::OPEN_ADDRESSING) {
+    nBuckets = std::max(nBuckets, getMinBucketsForOpenAddressing(m_size));
+  }
+  this->rehash(nBuckets);
+}
+
+void
+Hashtable::setHashAlgorithm(HashAlgorithm algo)
+{
+  if (m_options.hashAlgorithm == algo) {
+    return;
+  }
+  NFD_LOG_DEBUG("hash-algorithm from=" << m_options.hashAlgorithm << " to=" << algo);
+
+  m_options.hashAlgorithm = algo;
+  // rehash() walks the bucket arrays without probing, so node hashes can be updated in place
+  for (BucketArray* ba : {&m_table, &m_oldTable}) {
+    for (Node* head : ba->buckets) {
+      foreachNode(head, [algo] (Node* node) {
+        const Name& name = node->entry.getName();
+        node->hash = computeHash(name, name.size(), algo);
+      });
+    }
+  }
+  this->rehash(this->getNBuckets());
+}
+
+void
+Hashtable::setResizePolicy(size_t resizeStep, float shrinkDelayFactor)
+{
+  BOOST_ASSERT(shrinkDelayFactor >= 0.0);
+
+  m_options.resizeStep = resizeStep;
+  m_options.shrinkDelayFactor = shrinkDelayFactor;
+  if (resizeStep == 0 && this->isResizing()) {
+    this->migrate(this->getNOldBuckets());
+  }
+  this->computeThresholds();
 }
 
 void
 Hashtable::computeThresholds()
 {
-  m_expandThreshold = static_cast<size_t>(m_options.expandLoadFactor * this->getNBuckets());
-  m_shrinkThreshold = static_cast<size_t>(m_options.shrinkLoadFactor * this->getNBuckets());
+  size_t nBuckets = this->getNBuckets();
+  m_expandThreshold = static_cast<size_t>(m_options.expandLoadFactor * nBuckets);
+  m_shrinkThreshold = 0;
+  size_t shrunkNBuckets = std::max(m_options.minSize,
+                                   static_cast<size_t>(m_options.shrinkFactor * nBuckets));
+  if (shrunkNBuckets < nBuckets) {
+    // hysteresis: don't shrink into a table that would soon need to be expanded again
+    m_shrinkThreshold = std::min(static_cast<size_t>(m_options.shrinkLoadFactor * nBuckets),
+      static_cast<size_t>(m_options.expandLoadFactor * shrunkNBuckets) / 2 + 1);
+  }
+  m_shrinkDelay = static_cast<size_t>(m_options.shrinkDelayFactor * nBuckets);
+  m_maxOccupied = nBuckets;
+  if (m_options.layout == HashtableLayout::OPEN_ADDRESSING) {
+    // at least one empty bucket must remain to terminate probe sequences
+    m_maxOccupied = nBuckets * 7 / 8;
+    m_expandThreshold = std::min(m_expandThreshold, m_maxOccupied);
+  }
   NFD_LOG_TRACE("thresholds expand=" << m_expandThreshold << " shrink=" << m_shrinkThreshold);
 }
 
+void
+Hashtable::resizeIfNeeded(bool canShrink)
+{
+  size_t nBuckets = this->getNBuckets();
+  size_t newNBuckets = nBuckets;
+  if (m_size > m_expandThreshold) {
+    newNBuckets = static_cast<size_t>(m_options.expandFactor * nBuckets);
+  }
+  else if (m_options.layout == HashtableLayout::OPEN_ADDRESSING &&
+           m_table.nNodes + m_table.nDeleted > m_maxOccupied) {
+    // too many deleted buckets in the probe sequences, clean them up by resizing to the same size
+  }
+  else if (canShrink && m_size < m_shrinkThreshold && m_nOpsSinceResize >= m_shrinkDelay) {
+    newNBuckets = std::max(m_options.minSize, static_cast<size_t>(m_options.shrinkFactor * nBuckets));
+    if (m_options.layout == HashtableLayout::OPEN_ADDRESSING) {
+      newNBuckets = std::max(newNBuckets, getMinBucketsForOpenAddressing(m_size));
+    }
+    if (newNBuckets >= nBuckets) {
+      this->migrate(m_options.resizeStep);
+      return;
+    }
+  }
+  else {
+    this->migrate(m_options.resizeStep);
+    return;
+  }
+
+  if (this->isResizing()) {
+    // Starting over would migrate all remaining old buckets at once.
+    // Instead, the new resize is deferred: the conditions above are evaluated again
+    // after each insert or erase, and hold until the current migration has drained.
+    // With open addressing, the migration is completed right away only if the new
+    // bucket array is about to run out of empty buckets.
+    bool mustComplete = m_options.layout == HashtableLayout::OPEN_ADDRESSING &&
+                        m_size + m_table.nDeleted >= m_maxOccupied + (nBuckets - m_maxOccupied) / 2;
+    if (!mustComplete) {
+      this->migrate(m_options.resizeStep);
+      return;
+    }
+    this->migrate(this->getNOldBuckets());
+  }
+  this->resize(newNBuckets);
+}
+
 void
 Hashtable::resize(size_t newNBuckets)
 {
-  if (this->getNBuckets() == newNBuckets) {
+  BOOST_ASSERT(!this->isResizing());
+  if (this->getNBuckets() == newNBuckets && m_table.nDeleted == 0) {
     return;
   }
   NFD_LOG_DEBUG("resize from=" << this->getNBuckets() << " to=" << newNBuckets);
 
-  std::vector<Node*> oldBuckets;
-  oldBuckets.swap(m_buckets);
-  m_buckets.resize(newNBuckets);
+  if (m_options.resizeStep == 0) {
+    this->rehash(newNBuckets);
+    return;
+  }
+
+  m_oldTable = std::move(m_table);
+  this->initBuckets(m_table, newNBuckets);
+  m_migratePos = 0;
+  m_nOpsSinceResize = 0;
+  this->computeThresholds();
+  this->migrate(m_options.resizeStep);
+}
+
+void
+Hashtable::migrate(size_t nBuckets)
+{
+  if (!this->isResizing()) {
+    return;
+  }
+
+  size_t nOldBuckets = this->getNOldBuckets();
+  size_t end = std::min(m_migratePos + nBuckets, nOldBuckets);
+  for (; m_migratePos < end; ++m_migratePos) {
+    Node* head = m_oldTable.buckets[m_migratePos];
+    if (head == nullptr) {
+      continue;
+    }
+
+    m_oldTable.buckets[m_migratePos] = nullptr;
+    if (m_options.layout == HashtableLayout::OPEN_ADDRESSING) {
+      // keep probe sequences of unmigrated nodes intact
+      setControl(m_oldTable, m_migratePos, CTRL_DELETED);
+      ++m_oldTable.nDeleted;
+    }
 
-  for (Node* head : oldBuckets) {
     foreachNode(head, [this] (Node* node) {
-      size_t bucket = this->computeBucketIndex(node->hash);
-      this->attach(bucket, node);
+      node->prev = node->next = nullptr;
+      --m_oldTable.nNodes;
+      this->addTo(m_table, node);
     });
   }
 
+  if (m_migratePos == nOldBuckets) {
+    BOOST_ASSERT(m_oldTable.nNodes == 0);
+    NFD_LOG_DEBUG("resize completed nBuckets=" << this->getNBuckets());
+    m_oldTable = BucketArray();
+    m_migratePos = 0;
+  }
+}
+
+void
+Hashtable::rehash(size_t newNBuckets)
+{
+  BucketArray table = std::move(m_table);
+  BucketArray oldTable = std::move(m_oldTable);
+  m_oldTable = BucketArray();
+  m_migratePos = 0;
+  this->initBuckets(m_table, newNBuckets);
+
+  for (BucketArray* ba : {&table, &oldTable}) {
+    for (Node* head : ba->buckets) {
+      foreachNode(head, [this] (Node* node) {
+        node->prev = node->next = nullptr;
+        this->addTo(m_table, node);
+      });
+    }
+  }
+  BOOST_ASSERT(m_table.nNodes == m_size);
+
+  m_nOpsSinceResize = 0;
   this->computeThresholds();
 }
 
@@ -41,16 +41,75 @@ using HashValue = size_t;
  */
 using HashSequence = std::vector<HashValue>;
 
+/** \brief indicates which function is used to hash name components
+ */
+enum class HashAlgorithm {
+  /** \brief CityHash64, or CityHash32 on platforms with 32-bit size_t
+   */
+  CITYHASH,
+  /** \brief wyhash, which is faster than CityHash on short inputs such as name components
+   */
+  WYHASH,
+};
+
+std::ostream&
+operator<<(std::ostream& os, HashAlgorithm algo);
+
+/** \brief default hash algorithm, selected at build time with `./waf configure --with-name-tree-hash`
+ */
+inline constexpr HashAlgorithm DEFAULT_HASH_ALGORITHM =
+#ifdef NFD_NAME_TREE_HASH_WYHASH
+  HashAlgorithm::WYHASH;
+#else
+  HashAlgorithm::CITYHASH;
+#endif
+
+/** \brief computes hash value of a name from the hash value of its prefix and its last component
+ *  \param prefixHash hash value of the name without its last component
+ *  \param component last component of the name
+ *
+ *  The hash value of the empty name is zero. The combination is order-sensitive, so that
+ *  names consisting of the same components in different orders have unrelated hash values.
+ *  \post computeHash(name, i + 1, algo) == extendHash(computeHash(name, i, algo), name[i], algo)
+ */
+HashValue
+extendHash(HashValue prefixHash, const name::Component& component,
+           HashAlgorithm algo = DEFAULT_HASH_ALGORITHM);
+
 /** \brief computes hash value of \p name.getPrefix(prefixLen)
  */
 HashValue
-computeHash(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::max());
+computeHash(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::max(),
+            HashAlgorithm algo = DEFAULT_HASH_ALGORITHM);
 
 /** \brief computes hash values for each prefix of \p name.getPrefix(prefixLen)
- *  \return a hash sequence, where the i-th hash value equals computeHash(name, i)
+ *  \return a hash sequence, where the i-th hash value equals computeHash(name, i, algo)
  */
 HashSequence
-computeHashes(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::max());
+computeHashes(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::max(),
+              HashAlgorithm algo = DEFAULT_HASH_ALGORITHM);
+
+/** \brief computes hash values for each prefix of \p interest.getName().getPrefix(prefixLen),
+ *         caching them on the Interest
+ *  \return a hash sequence of at least `min(prefixLen, interest.getName().size()) + 1` elements,
+ *          where the i-th hash value equals computeHash(interest.getName(), i, algo);
+ *          it remains valid until the tags of the Interest are changed
+ *
+ *  Hash values are stored in a packet tag, so that subsequent lookups of the same packet
+ *  in PIT, FIB, StrategyChoice, and Measurements do not need to hash its name again.
+ *  Cached hash values are discarded if the name has been changed since they were computed.
+ */
+const HashSequence&
+computeHashes(const Interest& interest, size_t prefixLen = std::numeric_limits<size_t>::max(),
+              HashAlgorithm algo = DEFAULT_HASH_ALGORITHM);
+
+/** \brief computes hash values for each prefix of \p data.getName().getPrefix(prefixLen),
+ *         caching them on the Data
+ *  \sa computeHashes(const Interest&, size_t, HashAlgorithm)
+ */
+const HashSequence&
+computeHashes(const Data& data, size_t prefixLen = std::numeric_limits<size_t>::max(),
+              HashAlgorithm algo = DEFAULT_HASH_ALGORITHM);
 
 /** \brief a hashtable node
  *
@@ -70,8 +129,16 @@ public:
    */
   ~Node();
 
+  /** \brief allocates nodes from a SlabPool, getSlabPool<Node>()
+   */
+  static void*
+  operator new(size_t size);
+
+  static void
+  operator delete(void* ptr) noexcept;
+
 public:
-  const HashValue hash;
+  HashValue hash; ///< changed only by Hashtable::setHashAlgorithm
   Node* prev;
   Node* next;
   mutable Entry entry;
@@ -100,6 +167,24 @@ foreachNode(N* head, const F& func)
   }
 }
 
+/** \brief indicates how Hashtable resolves hash collisions
+ */
+enum class HashtableLayout {
+  /** \brief each bucket is a doubly linked list of nodes
+   */
+  CHAINED,
+  /** \brief each bucket holds at most one node; collisions are resolved by linear probing
+   *
+   *  A control byte per bucket keeps a 7-bit fingerprint of the hash value, so that most
+   *  mismatching buckets are rejected without dereferencing the node. Control bytes are
+   *  scanned in groups of 16, using SSE2 instructions if available.
+   */
+  OPEN_ADDRESSING,
+};
+
+std::ostream&
+operator<<(std::ostream& os, HashtableLayout layout);
+
 /** \brief provides options for Hashtable
  */
 class HashtableOptions
@@ -136,14 +221,47 @@ public:
   /** \brief when hashtable is shrunk, its new size is max(nBuckets*shrinkFactor, minSize)
    */
   float shrinkFactor = 0.5f;
+
+  /** \brief collision resolution scheme
+   *  \note With HashtableLayout::OPEN_ADDRESSING, the effective expandLoadFactor is at most 0.875.
+   */
+  HashtableLayout layout = HashtableLayout::CHAINED;
+
+  /** \brief function used to hash name components
+   */
+  HashAlgorithm hashAlgorithm = DEFAULT_HASH_ALGORITHM;
+
+  /** \brief maximum number of old buckets migrated during each insert or erase while resizing
+   *
+   *  If zero, all nodes are rehashed at once when the hashtable is resized.
+   *  Otherwise, the old and new bucket arrays coexist until all old buckets have been migrated,
+   *  which bounds the latency of each insert or erase operation.
+   */
+  size_t resizeStep = 0;
+
+  /** \brief after hashtable is resized to nBuckets, it will not be shrunk until
+   *         nBuckets*shrinkDelayFactor insert or erase operations have been performed
+   */
+  float shrinkDelayFactor = 0.0f;
 };
 
 /** \brief a hashtable for fast exact name lookup
  *
  *  The Hashtable contains a number of buckets.
  *  Each node is placed into a bucket determined by a hash value computed from its name.
- *  Hash collision is resolved through a doubly linked list in each bucket.
+ *  Hash collision is resolved according to HashtableOptions::layout.
  *  The number of buckets is adjusted according to how many nodes are stored.
+ *
+ *  Nodes are individually allocated and never move, regardless of the layout,
+ *  so that pointers to name tree entries stay valid when the table is resized.
+ *
+ *  The hashtable is not shrunk if its new load would exceed half of the expansion threshold,
+ *  so that it does not alternate between expanding and shrinking under oscillating load.
+ *  The default factors satisfy this already; the bound takes effect only when shrinkLoadFactor
+ *  is large relative to expandLoadFactor*shrinkFactor.
+ *
+ *  During an incremental resize, another resize is not started until all old buckets have
+ *  been migrated, so that no single insert or erase has to complete the migration.
  */
 class Hashtable
 {
@@ -166,13 +284,69 @@ public:
   }
 
   /** \return number of buckets
+   *
+   *  While an incremental resize is in progress, this is the size of the new bucket array.
    */
   size_t
   getNBuckets() const
   {
-    return m_buckets.size();
+    return m_table.buckets.size();
   }
 
+  /** \return number of buckets in the old bucket array while an incremental resize is
+   *          in progress, or zero otherwise
+   */
+  size_t
+  getNOldBuckets() const
+  {
+    return m_oldTable.buckets.size();
+  }
+
+  /** \return whether an incremental resize is in progress
+   */
+  bool
+  isResizing() const
+  {
+    return !m_oldTable.buckets.empty();
+  }
+
+  /** \return collision resolution scheme
+   */
+  HashtableLayout
+  getLayout() const
+  {
+    return m_options.layout;
+  }
+
+  /** \brief change collision resolution scheme
+   *
+   *  Existing nodes are reindexed under the new layout. They are not reallocated.
+   */
+  void
+  setLayout(HashtableLayout layout);
+
+  /** \return function used to hash name components
+   */
+  HashAlgorithm
+  getHashAlgorithm() const
+  {
+    return m_options.hashAlgorithm;
+  }
+
+  /** \brief change function used to hash name components
+   *
+   *  Hash values of existing nodes are recomputed and the nodes are reindexed.
+   *  They are not reallocated.
+   */
+  void
+  setHashAlgorithm(HashAlgorithm algo);
+
+  /** \brief change resizing policy
+   *  \sa HashtableOptions::resizeStep, HashtableOptions::shrinkDelayFactor
+   */
+  void
+  setResizePolicy(size_t resizeStep, float shrinkDelayFactor);
+
   /** \return bucket index for hash value h
    */
   size_t
@@ -182,15 +356,42 @@ public:
   }
 
   /** \return i-th bucket
-   *  \pre bucket < getNBuckets()
+   *  \pre bucket < getNBuckets() + getNOldBuckets()
+   *
+   *  Buckets with index getNBuckets() and above belong to the old bucket array.
+   *  With HashtableLayout::OPEN_ADDRESSING, the returned node (if any) has no \c next node.
    */
   const Node*
   getBucket(size_t bucket) const
   {
-    BOOST_ASSERT(bucket < this->getNBuckets());
-    return m_buckets[bucket]; // don't use m_bucket.at() for better performance
+    if (bucket < this->getNBuckets()) {
+      return m_table.buckets[bucket]; // don't use m_bucket.at() for better performance
+    }
+    BOOST_ASSERT(bucket - this->getNBuckets() < this->getNOldBuckets());
+    return m_oldTable.buckets[bucket - this->getNBuckets()];
   }
 
+  /** \brief hint the CPU to load the bucket for hash value \p h into cache
+   *
+   *  This has no observable effect. Calling it for several packets before looking them up
+   *  lets the memory accesses of the lookups overlap.
+   */
+  void
+  prefetch(HashValue h) const noexcept
+  {
+    size_t bucket = this->computeBucketIndex(h);
+    __builtin_prefetch(&m_table.buckets[bucket]);
+    if (m_options.layout == HashtableLayout::OPEN_ADDRESSING) {
+      __builtin_prefetch(&m_table.ctrl[bucket]);
+    }
+  }
+
+  /** \return index of the bucket that contains \p node, as accepted by getBucket()
+   *  \pre node exists in this hashtable
+   */
+  size_t
+  findBucket(const Node& node) const;
+
   /** \brief find node for name.getPrefix(prefixLen)
    *  \pre name.size() > prefixLen
    */
@@ -199,14 +400,14 @@ public:
 
   /** \brief find node for name.getPrefix(prefixLen)
    *  \pre name.size() > prefixLen
-   *  \pre hashes == computeHashes(name)
+   *  \pre hashes[i] == computeHash(name, i, getHashAlgorithm()) for every i <= prefixLen
    */
   const Node*
   find(const Name& name, size_t prefixLen, const HashSequence& hashes) const;
 
   /** \brief find or insert node for name.getPrefix(prefixLen)
    *  \pre name.size() > prefixLen
-   *  \pre hashes == computeHashes(name)
+   *  \pre hashes[i] == computeHash(name, i, getHashAlgorithm()) for every i <= prefixLen
    */
   std::pair<const Node*, bool>
   insert(const Name& name, size_t prefixLen, const HashSequence& hashes);
@@ -218,15 +419,57 @@ public:
   erase(Node* node);
 
 private:
-  /** \brief attach node to bucket
+  /** \brief an array of buckets
    */
+  struct BucketArray
+  {
+    std::vector<Node*> buckets;
+    /** \brief control bytes for HashtableLayout::OPEN_ADDRESSING
+     *
+     *  Element i describes buckets[i]. It is followed by clones of the first
+     *  elements, so that a group of control bytes can be loaded at any bucket index.
+     */
+    std::vector<int8_t> ctrl;
+    size_t nNodes = 0;
+    size_t nDeleted = 0;
+  };
+
   void
-  attach(size_t bucket, Node* node);
+  initBuckets(BucketArray& ba, size_t nBuckets) const;
+
+  /** \brief attach node to bucket
+   */
+  static void
+  attach(BucketArray& ba, size_t bucket, Node* node);
 
   /** \brief detach node from bucket
    */
+  static void
+  detach(BucketArray& ba, size_t bucket, Node* node);
+
+  /** \brief set the control byte of a bucket, including its cloned copies
+   */
+  static void
+  setControl(BucketArray& ba, size_t bucket, int8_t ctrl);
+
+  const Node*
+  findIn(const BucketArray& ba, const Name& name, size_t prefixLen, HashValue h) const;
+
+  /** \return index of the bucket in \p ba that contains \p node, or NOT_FOUND
+   */
+  size_t
+  findBucketIn(const BucketArray& ba, const Node& node) const;
+
+  /** \brief add node to \p ba
+   *  \return index of the bucket that contains \p node
+   */
+  size_t
+  addTo(BucketArray& ba, Node* node);
+
+  /** \brief remove node from \p ba
+   */
   void
-  detach(size_t bucket, Node* node);
+  removeFrom(BucketArray& ba, size_t bucket, Node* node);
 
   std::pair<const Node*, bool>
   findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool allowInsert);
@@ -234,15 +477,42 @@ private:
   void
   computeThresholds();
 
+  /** \brief expand, shrink, or clean up the hashtable if its load calls for it,
+   *         otherwise continue the incremental resize in progress, if any
+   *  \param canShrink whether shrinking is considered; true only after an erase
+   */
+  void
+  resizeIfNeeded(bool canShrink);
+
+  /** \pre !isResizing()
+   */
   void
   resize(size_t newNBuckets);
 
+  /** \brief migrate up to \p nBuckets old buckets into the new bucket array
+   */
+  void
+  migrate(size_t nBuckets);
+
+  /** \brief reindex all nodes into \p newNBuckets buckets under the current layout
+   *  \post !isResizing()
+   */
+  void
+  rehash(size_t newNBuckets);
+
 private:
-  std::vector<Node*> m_buckets;
+  static constexpr size_t NOT_FOUND = std::numeric_limits<size_t>::max();
+
+  BucketArray m_table;
+  BucketArray m_oldTable; ///< non-empty only during incremental resizing
+  size_t m_migratePos = 0; ///< index of the next old bucket to be migrated
   Options m_options;
-  size_t m_size;
+  size_t m_size = 0;
   size_t m_expandThreshold;
   size_t m_shrinkThreshold;
+  size_t m_maxOccupied;
+  size_t m_shrinkDelay;
+  size_t m_nOpsSinceResize = 0;
 };
 
 } // namespace nfd::name_tree
@@ -115,7 +115,7 @@ FullEnumerationImpl::advance(Iterator& i)
 {
   // find first entry
   if (i.m_entry == nullptr) {
-    for (size_t bucket = 0; bucket < ht.getNBuckets(); ++bucket) {
+    for (size_t bucket = 0; bucket < ht.getNBuckets() + ht.getNOldBuckets(); ++bucket) {
       const Node* node = ht.getBucket(bucket);
       if (node != nullptr) {
         i.m_entry = &node->entry;
@@ -140,8 +140,8 @@ FullEnumerationImpl::advance(Iterator& i)
   }
 
   // process other buckets
-  size_t currentBucket = ht.computeBucketIndex(getNode(*i.m_entry)->hash);
-  for (size_t bucket = currentBucket + 1; bucket < ht.getNBuckets(); ++bucket) {
+  size_t currentBucket = ht.findBucket(*getNode(*i.m_entry));
+  for (size_t bucket = currentBucket + 1; bucket < ht.getNBuckets() + ht.getNOldBuckets(); ++bucket) {
     for (const Node* node = ht.getBucket(bucket); node != nullptr; node = node->next) {
       if (m_pred(node->entry)) {
         i.m_entry = &node->entry;
@@ -69,6 +69,88 @@ public: // information
     return m_ht.getNBuckets();
   }
 
+  /** \return collision resolution scheme of the hashtable
+   */
+  HashtableLayout
+  getHashtableLayout() const
+  {
+    return m_ht.getLayout();
+  }
+
+  /** \brief Change collision resolution scheme of the hashtable
+   *
+   *  Existing entries are reindexed; references and pointers to them remain valid.
+   *  Existing iterators may skip entries or visit some entries twice.
+   */
+  void
+  setHashtableLayout(HashtableLayout layout)
+  {
+    m_ht.setLayout(layout);
+  }
+
+  /** \return function used to hash name components
+   */
+  HashAlgorithm
+  getHashAlgorithm() const
+  {
+    return m_ht.getHashAlgorithm();
+  }
+
+  /** \brief Change function used to hash name components
+   *
+   *  Existing entries are reindexed; references and pointers to them remain valid.
+   *  Existing iterators may skip entries or visit some entries twice.
+   */
+  void
+  setHashAlgorithm(HashAlgorithm algo)
+  {
+    m_ht.setHashAlgorithm(algo);
+  }
+
+  /** \brief Compute hash values for each prefix of a name, as used by this name tree
+   *  \return hash sequence that can be passed to lookup and matching methods
+   */
+  HashSequence
+  computeHashes(const Name& name, size_t prefixLen = getMaxDepth()) const
+  {
+    return name_tree::computeHashes(name, std::min(prefixLen, getMaxDepth()), getHashAlgorithm());
+  }
+
+  /** \brief Compute hash values for each prefix of the name of an Interest or Data,
+   *         caching them on the packet
+   *  \tparam Packet Interest or Data
+   *  \return hash sequence that can be passed to lookup and matching methods;
+   *          it remains valid until the tags of the packet are changed
+   */
+  template<typename Packet>
+  const HashSequence&
+  computeHashes(const Packet& pkt) const
+  {
+    return name_tree::computeHashes(pkt, getMaxDepth(), getHashAlgorithm());
+  }
+
+  /** \brief Hint the CPU to load the hashtable buckets of every prefix into cache
+   *  \param hashes hash values returned by computeHashes()
+   *
+   *  This is used by batched pipelines to overlap the cache misses of several lookups.
+   */
+  void
+  prefetch(const HashSequence& hashes) const noexcept
+  {
+    for (HashValue h : hashes) {
+      m_ht.prefetch(h);
+    }
+  }
+
+  /** \brief Change resizing policy of the hashtable
+   *  \sa HashtableOptions::resizeStep, HashtableOptions::shrinkDelayFactor
+   */
+  void
+  setHashtableResizePolicy(size_t resizeStep, float shrinkDelayFactor)
+  {
+    m_ht.setResizePolicy(resizeStep, shrinkDelayFactor);
+  }
+
   /** \return name tree entry on which a table entry is attached,
    *          or nullptr if the table entry is detached
    */
@@ -92,6 +174,12 @@ public: // mutation
   Entry&
   lookup(const Name& name, size_t prefixLen);
 
+  /** \brief Equivalent to `lookup(name, prefixLen)`, using precomputed hash values
+   *  \param hashes hash values returned by computeHashes(), with at least prefixLen+1 elements
+   */
+  Entry&
+  lookup(const Name& name, size_t prefixLen, const HashSequence& hashes);
+
   /** \brief Equivalent to `lookup(name, name.size())`
    */
   Entry&
@@ -148,6 +236,14 @@ public: // matching
   Entry*
   findExactMatch(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::max()) const;
 
+  /** \brief Exact match lookup, using precomputed hash values
+   *  \param hashes hash values returned by computeHashes(),
+   *                with at least `min(prefixLen, name.size()) + 1` elements
+   *  \return entry with \c name.getPrefix(prefixLen), or nullptr if it does not exist
+   */
+  Entry*
+  findExactMatch(const Name& name, size_t prefixLen, const HashSequence& hashes) const;
+
   /** \brief Longest prefix matching
    *  \return entry whose name is a prefix of \p name and passes \p entrySelector,
    *          where no other entry with a longer name satisfies those requirements;
@@ -157,6 +253,14 @@ public: // matching
   findLongestPrefixMatch(const Name& name,
                          const EntrySelector& entrySelector = AnyEntry()) const;
 
+  /** \brief Longest prefix matching, using precomputed hash values
+   *  \param hashes hash values returned by computeHashes(),
+   *                with at least `min(name.size(), getMaxDepth()) + 1` elements
+   */
+  Entry*
+  findLongestPrefixMatch(const Name& name, const HashSequence& hashes,
+                         const EntrySelector& entrySelector = AnyEntry()) const;
+
   /** \brief Equivalent to `findLongestPrefixMatch(entry.getName(), entrySelector)`
    *  \note This overload is more efficient than
    *        `findLongestPrefixMatch(const Name&, const EntrySelector&)` in common cases.
@@ -213,6 +317,14 @@ public: // matching
   findAllMatches(const Name& name,
                  const EntrySelector& entrySelector = AnyEntry()) const;
 
+  /** \brief All-prefixes match lookup, using precomputed hash values
+   *  \param hashes hash values returned by computeHashes(),
+   *                with at least `min(name.size(), getMaxDepth()) + 1` elements
+   */
+  Range
+  findAllMatches(const Name& name, const HashSequence& hashes,
+                 const EntrySelector& entrySelector = AnyEntry()) const;
+
 public: // enumeration
   using const_iterator = Iterator;
 
@@ -28,8 +28,9 @@
 
 #include "pit-in-record.hpp"
 #include "pit-out-record.hpp"
+#include "common/timer-wheel.hpp"
 
-#include <list>
+#include <boost/container/small_vector.hpp>
 
 namespace nfd::name_tree {
 class Entry;
@@ -39,13 +40,23 @@ namespace nfd::pit {
 
 /**
  * \brief An unordered collection of in-records
+ *
+ * Up to two records are stored inline in the PIT entry, so that most lookups are a short
+ * contiguous scan without following pointers.
+ * Inserting or deleting an in-record may invalidate iterators, pointers, and references
+ * to other in-records of the same entry.
  */
-using InRecordCollection = std::list<InRecord>;
+using InRecordCollection = boost::container::small_vector<InRecord, 2>;
 
 /**
  * \brief An unordered collection of out-records
+ *
+ * Up to three records are stored inline in the PIT entry, so that most lookups are a short
+ * contiguous scan without following pointers.
+ * Inserting or deleting an out-record may invalidate iterators, pointers, and references
+ * to other out-records of the same entry.
  */
-using OutRecordCollection = std::list<OutRecord>;
+using OutRecordCollection = boost::container::small_vector<OutRecord, 3>;
 
 /**
  * \brief Represents an entry in the %Interest table (PIT).
@@ -221,9 +232,10 @@ public: // out-record
 public:
   /** \brief Expiry timer
    *
-   *  This timer is used in forwarding pipelines to delete the entry
+   *  This timer is used in forwarding pipelines to delete the entry.
+   *  It is armed on the global TimerWheel, because it is re-armed for almost every packet.
    */
-  scheduler::EventId expiryTimer;
+  TimerWheel::Timer expiryTimer;
 
   /** \brief Indicates whether this PIT entry is satisfied
    */
@@ -234,6 +246,11 @@ public:
    */
   time::milliseconds dataFreshnessPeriod = 0_ms;
 
+  /** \brief Charge of this entry to PIT quotas, released when the entry is destroyed
+   *  \sa fw::AdmissionControl
+   */
+  shared_ptr<void> quotaCharge;
+
 private:
   shared_ptr<const Interest> m_interest;
   InRecordCollection m_inRecords;
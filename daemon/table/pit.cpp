@@ -24,6 +24,7 @@
  */
 
 #include "pit.hpp"
+#include "common/slab-pool.hpp"
 
 namespace nfd::pit {
 
@@ -47,13 +48,16 @@ Pit::findOrInsert(const Interest& interest, bool allowInsert)
   size_t nteDepth = name.size() - static_cast<int>(hasDigest);
   nteDepth = std::min(nteDepth, NameTree::getMaxDepth());
 
+  // hash values are cached on the Interest, to be reused by subsequent table lookups
+  const auto& hashes = m_nameTree.computeHashes(interest);
+
   // ensure NameTree entry exists
   name_tree::Entry* nte = nullptr;
   if (allowInsert) {
-    nte = &m_nameTree.lookup(name, nteDepth);
+    nte = &m_nameTree.lookup(name, nteDepth, hashes);
   }
   else {
-    nte = m_nameTree.findExactMatch(name, nteDepth);
+    nte = m_nameTree.findExactMatch(name, nteDepth, hashes);
     if (nte == nullptr) {
       return {nullptr, true};
     }
@@ -75,7 +79,8 @@ Pit::findOrInsert(const Interest& interest, bool allowInsert)
     return {nullptr, true};
   }
 
-  auto entry = make_shared<Entry>(interest);
+  // the entry and its shared_ptr control block are allocated from getSlabPool<Entry>()
+  auto entry = std::allocate_shared<Entry>(SlabAllocator<Entry>(), interest);
   nte->insertPitEntry(entry);
   ++m_nItems;
   return {entry, true};
@@ -84,7 +89,8 @@ Pit::findOrInsert(const Interest& interest, bool allowInsert)
 DataMatchResult
 Pit::findAllDataMatches(const Data& data) const
 {
-  auto&& ntMatches = m_nameTree.findAllMatches(data.getName(), &nteHasPitEntries);
+  auto&& ntMatches = m_nameTree.findAllMatches(data.getName(), m_nameTree.computeHashes(data),
+                                               &nteHasPitEntries);
 
   DataMatchResult matches;
   for (const auto& nte : ntMatches) {
@@ -110,6 +110,7 @@ StrategyChoice::insert(const Name& prefix, const Name& strategyName)
 
   this->changeStrategy(*entry, *oldStrategy, *strategy);
   entry->setStrategy(std::move(strategy));
+  this->afterInsert(prefix, entry->getStrategyInstanceName());
   return InsertResult::OK;
 }
 
@@ -159,6 +160,7 @@ StrategyChoice::erase(const Name& prefix)
   nte->setStrategyChoiceEntry(nullptr);
   m_nameTree.eraseIfEmpty(nte);
   --m_nItems;
+  this->afterErase(prefix);
 }
 
 std::pair<bool, Name>
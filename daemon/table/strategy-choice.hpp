@@ -175,6 +175,17 @@ public: // enumeration
     return this->getRange().end();
   }
 
+public: // signal
+  /** \brief signals after the strategy of a prefix is changed by insert()
+   *
+   *  The second argument is the strategy instance name.
+   */
+  signal::Signal<StrategyChoice, Name, Name> afterInsert;
+
+  /** \brief signals after the strategy choice of a prefix is erased
+   */
+  signal::Signal<StrategyChoice, Name> afterErase;
+
 private:
   void
   changeStrategy(Entry& entry,
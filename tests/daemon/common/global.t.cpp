@@ -24,6 +24,7 @@
  */
 
 #include "common/global.hpp"
+#include "common/timer-wheel.hpp"
 
 #include "tests/test-common.hpp"
 #include "tests/daemon/global-io-fixture.hpp"
@@ -61,6 +62,20 @@ BOOST_AUTO_TEST_CASE(ThreadLocalScheduler)
   BOOST_CHECK(s1 != s2);
 }
 
+BOOST_AUTO_TEST_CASE(ThreadLocalTimerWheel)
+{
+  TimerWheel* w1 = &getTimerWheel();
+  TimerWheel* w2 = nullptr;
+
+  std::thread t([&w2] { w2 = &getTimerWheel(); });
+  t.join();
+
+  BOOST_CHECK(w1 != nullptr);
+  BOOST_CHECK(w2 != nullptr);
+  BOOST_CHECK(w1 != w2);
+  BOOST_CHECK(w1 == &getTimerWheel());
+}
+
 BOOST_FIXTURE_TEST_CASE(MainRibIoService, RibIoFixture)
 {
   boost::asio::io_service* mainIo = &g_io;
@@ -0,0 +1,141 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/slab-pool.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <array>
+#include <cstring>
+#include <list>
+#include <set>
+#include <thread>
+
+namespace nfd::tests {
+
+BOOST_AUTO_TEST_SUITE(TestSlabPool)
+
+BOOST_AUTO_TEST_CASE(AllocateDeallocate)
+{
+  SlabPool pool(24, 4);
+  BOOST_CHECK_GE(pool.getBlockSize(), 24);
+  BOOST_CHECK_EQUAL(pool.getBlockSize() % alignof(std::max_align_t), 0);
+  BOOST_CHECK_EQUAL(pool.size(), 0);
+
+  std::set<void*> blocks;
+  for (int i = 0; i < 10; ++i) {
+    void* block = pool.allocate();
+    BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(block) % alignof(std::max_align_t), 0);
+    std::memset(block, 0xBB, 24);
+    blocks.insert(block);
+  }
+  BOOST_CHECK_EQUAL(blocks.size(), 10);
+  BOOST_CHECK_EQUAL(pool.size(), 10);
+  BOOST_CHECK_GE(pool.capacity(), 10);
+
+  size_t capacity = pool.capacity();
+  for (void* block : blocks) {
+    pool.deallocate(block);
+  }
+  BOOST_CHECK_EQUAL(pool.size(), 0);
+  BOOST_CHECK_LE(pool.capacity(), capacity);
+}
+
+BOOST_AUTO_TEST_CASE(Accommodate)
+{
+  SlabPool pool(8);
+  BOOST_CHECK(pool.accommodate(8));
+  BOOST_CHECK(pool.accommodate(100));
+  BOOST_CHECK_GE(pool.getBlockSize(), 100);
+
+  void* block = pool.allocate();
+  BOOST_CHECK(pool.accommodate(100));
+  pool.deallocate(block);
+}
+
+struct AllocatorTestTag;
+struct SharedTestTag;
+
+BOOST_AUTO_TEST_CASE(Allocator)
+{
+  SlabPool& pool = getSlabPool<AllocatorTestTag>();
+  BOOST_CHECK_EQUAL(&pool, &getSlabPool<AllocatorTestTag>());
+
+  {
+    std::list<int, SlabAllocator<int, AllocatorTestTag>> list;
+    for (int i = 0; i < 1000; ++i) {
+      list.push_back(i);
+    }
+    // list nodes are allocated from the pool of the tag
+    BOOST_CHECK_EQUAL(pool.size(), 1000);
+    BOOST_CHECK_GE(pool.capacity(), 1000);
+
+    list.erase(list.begin());
+    BOOST_CHECK_EQUAL(pool.size(), 999);
+    list.push_front(-1);
+    BOOST_CHECK_EQUAL(pool.size(), 1000);
+    BOOST_CHECK_EQUAL(list.front(), -1);
+    BOOST_CHECK_EQUAL(list.back(), 999);
+  }
+  BOOST_CHECK_EQUAL(pool.size(), 0);
+
+  // a larger type is not allocated from the pool after its block size has been fixed
+  std::list<std::array<char, 256>, SlabAllocator<std::array<char, 256>, AllocatorTestTag>> list2(1);
+  BOOST_CHECK_EQUAL(pool.size(), 0);
+
+  // arrays are not allocated from the pool
+  SlabAllocator<int, AllocatorTestTag> alloc;
+  int* array = alloc.allocate(3);
+  BOOST_CHECK_EQUAL(pool.size(), 0);
+  alloc.deallocate(array, 3);
+}
+
+BOOST_AUTO_TEST_CASE(AllocateShared)
+{
+  SlabPool& pool = getSlabPool<SharedTestTag>();
+  {
+    // object and control block share one block
+    auto ptr = std::allocate_shared<std::string>(SlabAllocator<std::string, SharedTestTag>(), "shared");
+    BOOST_CHECK_EQUAL(*ptr, "shared");
+    BOOST_CHECK_EQUAL(pool.size(), 1);
+  }
+  BOOST_CHECK_EQUAL(pool.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ThreadLocal)
+{
+  SlabPool* mainPool = &getSlabPool<AllocatorTestTag>();
+  SlabPool* otherPool = nullptr;
+  std::thread thread([&otherPool] { otherPool = &getSlabPool<AllocatorTestTag>(); });
+  thread.join();
+
+  BOOST_CHECK(otherPool != nullptr);
+  BOOST_CHECK(otherPool != mainPool);
+  BOOST_CHECK_EQUAL(mainPool, &getSlabPool<AllocatorTestTag>());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestSlabPool
+
+} // namespace nfd::tests
@@ -0,0 +1,106 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/spsc-channel.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd::tests {
+
+BOOST_AUTO_TEST_SUITE(TestSpscChannel)
+
+BOOST_AUTO_TEST_CASE(NotifyCoalescing)
+{
+  boost::asio::io_service io;
+  SpscChannel<int> channel(16);
+  std::vector<int> received;
+  int nDrains = 0;
+
+  std::function<void()> drain = [&] {
+    ++nDrains;
+    bool hasMore = channel.drain(4, [&] (int& item) { received.push_back(item); });
+    if (hasMore) {
+      io.post(drain);
+    }
+  };
+
+  for (int i = 0; i < 3; ++i) {
+    BOOST_CHECK(channel.push(int(i)));
+    channel.notify(io, drain);
+  }
+  BOOST_CHECK_EQUAL(channel.size(), 3);
+  io.poll();
+  BOOST_CHECK_EQUAL(nDrains, 1);
+  BOOST_CHECK_EQUAL(received.size(), 3);
+  BOOST_CHECK(channel.size() == 0);
+
+  // a notification after draining posts another handler
+  BOOST_CHECK(channel.push(3));
+  channel.notify(io, drain);
+#if BOOST_VERSION >= 106600
+  io.restart();
+#else
+  io.reset();
+#endif
+  io.poll();
+  BOOST_CHECK_EQUAL(nDrains, 2);
+  BOOST_CHECK_EQUAL(received.size(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(DrainLimit)
+{
+  boost::asio::io_service io;
+  SpscChannel<int> channel(16);
+  std::vector<int> received;
+  int nDrains = 0;
+
+  std::function<void()> drain = [&] {
+    ++nDrains;
+    bool hasMore = channel.drain(4, [&] (int& item) { received.push_back(item); });
+    if (hasMore) {
+      io.post(drain);
+    }
+  };
+
+  for (int i = 0; i < 10; ++i) {
+    BOOST_CHECK(channel.push(int(i)));
+  }
+  channel.notify(io, drain);
+  io.poll_one();
+  BOOST_CHECK_EQUAL(received.size(), 4);
+
+  // further notifications do not post handlers while one is pending
+  channel.notify(io, drain);
+  io.poll();
+  BOOST_CHECK_EQUAL(nDrains, 3);
+  BOOST_REQUIRE_EQUAL(received.size(), 10);
+  for (int i = 0; i < 10; ++i) {
+    BOOST_CHECK_EQUAL(received[i], i);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestSpscChannel
+
+} // namespace nfd::tests
@@ -0,0 +1,132 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/spsc-ring.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <thread>
+
+namespace nfd::tests {
+
+BOOST_AUTO_TEST_SUITE(TestSpscRing)
+
+BOOST_AUTO_TEST_CASE(Capacity)
+{
+  BOOST_CHECK_EQUAL(SpscRing<int>(1).capacity(), 1);
+  BOOST_CHECK_EQUAL(SpscRing<int>(5).capacity(), 8);
+  BOOST_CHECK_EQUAL(SpscRing<int>(64).capacity(), 64);
+  BOOST_CHECK_THROW(SpscRing<int>(0), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(PushPop)
+{
+  SpscRing<int> ring(4);
+  BOOST_CHECK(ring.empty());
+
+  int item = 0;
+  BOOST_CHECK(!ring.pop(item));
+
+  // wrap around several times
+  int next = 0;
+  int expected = 0;
+  for (int round = 0; round < 5; ++round) {
+    while (ring.push(int(next))) {
+      ++next;
+    }
+    BOOST_CHECK_EQUAL(ring.size(), 4);
+
+    int n = 0;
+    while (n < 3 && ring.pop(item)) {
+      BOOST_CHECK_EQUAL(item, expected++);
+      ++n;
+    }
+    BOOST_CHECK_EQUAL(ring.size(), 1);
+  }
+
+  while (ring.pop(item)) {
+    BOOST_CHECK_EQUAL(item, expected++);
+  }
+  BOOST_CHECK_EQUAL(expected, next);
+  BOOST_CHECK(ring.empty());
+}
+
+BOOST_AUTO_TEST_CASE(Ownership)
+{
+  SpscRing<shared_ptr<int>> ring(2);
+  auto p1 = make_shared<int>(1);
+  auto p2 = make_shared<int>(2);
+  auto p3 = make_shared<int>(3);
+
+  BOOST_CHECK(ring.push(shared_ptr<int>(p1)));
+  BOOST_CHECK(ring.push(shared_ptr<int>(p2)));
+  BOOST_CHECK_EQUAL(p1.use_count(), 2);
+
+  // a rejected item is not moved from
+  auto item = p3;
+  BOOST_CHECK(!ring.push(std::move(item)));
+  BOOST_CHECK(item == p3);
+
+  // a popped element is not retained by the ring
+  BOOST_CHECK(ring.pop(item));
+  BOOST_CHECK(item == p1);
+  item.reset();
+  BOOST_CHECK_EQUAL(p1.use_count(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(TwoThreads)
+{
+  const uint64_t nItems = 200000;
+  SpscRing<uint64_t> ring(64);
+
+  std::thread producer([&ring, nItems] {
+    for (uint64_t i = 1; i <= nItems; ++i) {
+      while (!ring.push(uint64_t(i))) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  uint64_t expected = 1;
+  uint64_t item = 0;
+  bool isOrdered = true;
+  while (expected <= nItems) {
+    if (ring.pop(item)) {
+      isOrdered = isOrdered && item == expected;
+      ++expected;
+    }
+    else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+
+  BOOST_CHECK(isOrdered);
+  BOOST_CHECK(ring.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestSpscRing
+
+} // namespace nfd::tests
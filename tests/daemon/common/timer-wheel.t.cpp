@@ -0,0 +1,183 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/timer-wheel.hpp"
+#include "common/global.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+
+namespace nfd::tests {
+
+BOOST_FIXTURE_TEST_SUITE(TestTimerWheel, GlobalIoTimeFixture)
+
+BOOST_AUTO_TEST_CASE(Fire)
+{
+  TimerWheel wheel(getScheduler());
+  TimerWheel::Timer t1, t2, t3;
+  std::vector<int> fired;
+
+  wheel.schedule(t1, 10_ms, [&] { fired.push_back(1); });
+  wheel.schedule(t2, 300_ms, [&] { fired.push_back(2); }); // beyond the first level
+  wheel.schedule(t3, 90_s, [&] { fired.push_back(3); });
+  BOOST_CHECK(t1.isPending());
+  BOOST_CHECK_EQUAL(wheel.size(), 3);
+
+  advanceClocks(1_ms, 9);
+  BOOST_CHECK(fired.empty());
+  advanceClocks(1_ms);
+  BOOST_CHECK(fired == std::vector<int>({1}));
+  BOOST_CHECK(!t1.isPending());
+  BOOST_CHECK_EQUAL(wheel.size(), 2);
+
+  advanceClocks(1_ms, 289);
+  BOOST_CHECK_EQUAL(fired.size(), 1);
+  advanceClocks(1_ms);
+  BOOST_CHECK(fired == std::vector<int>({1, 2}));
+
+  advanceClocks(1_s, 89);
+  BOOST_CHECK_EQUAL(fired.size(), 2);
+  BOOST_CHECK(t3.isPending());
+  advanceClocks(1_ms, 1000);
+  BOOST_CHECK(fired == std::vector<int>({1, 2, 3}));
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ZeroDelay)
+{
+  TimerWheel wheel(getScheduler());
+  TimerWheel::Timer t1, t2;
+  int nFired = 0;
+
+  wheel.schedule(t1, 5_s, [] {});
+  advanceClocks(1_ms, 3);
+
+  wheel.schedule(t2, 0_ms, [&] { ++nFired; });
+  BOOST_CHECK_EQUAL(nFired, 0); // never invoked synchronously
+  pollIo();
+  BOOST_CHECK_EQUAL(nFired, 1);
+
+  // a zero-delay timer armed by a callback fires without advancing the clock
+  std::function<void()> rearm = [&] {
+    if (++nFired < 5) {
+      wheel.schedule(t2, 0_ms, rearm);
+    }
+  };
+  wheel.schedule(t2, 0_ms, rearm);
+  pollIo();
+  BOOST_CHECK_EQUAL(nFired, 5);
+}
+
+BOOST_AUTO_TEST_CASE(CancelAndRearm)
+{
+  TimerWheel wheel(getScheduler());
+  TimerWheel::Timer t1;
+  int nFired1 = 0, nFired2 = 0;
+
+  wheel.schedule(t1, 10_ms, [&] { ++nFired1; });
+  t1.cancel();
+  BOOST_CHECK(!t1.isPending());
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+  t1.cancel(); // no effect
+
+  wheel.schedule(t1, 10_ms, [&] { ++nFired1; });
+  advanceClocks(1_ms, 5);
+  wheel.schedule(t1, 10_ms, [&] { ++nFired2; }); // replaces the pending callback
+  BOOST_CHECK_EQUAL(wheel.size(), 1);
+  advanceClocks(1_ms, 9);
+  BOOST_CHECK_EQUAL(nFired1, 0);
+  BOOST_CHECK_EQUAL(nFired2, 0);
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(nFired1, 0);
+  BOOST_CHECK_EQUAL(nFired2, 1);
+  t1.cancel(); // no effect after firing
+
+  {
+    TimerWheel::Timer t2;
+    wheel.schedule(t2, 10_ms, [&] { ++nFired1; });
+    BOOST_CHECK_EQUAL(wheel.size(), 1);
+  }
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+  advanceClocks(1_ms, 20);
+  BOOST_CHECK_EQUAL(nFired1, 0);
+}
+
+BOOST_AUTO_TEST_CASE(DestroyOwnerInCallback)
+{
+  struct Owner
+  {
+    TimerWheel::Timer timer;
+  };
+
+  TimerWheel wheel(getScheduler());
+  auto owner = make_unique<Owner>();
+  Owner other;
+  int nFired = 0;
+
+  wheel.schedule(owner->timer, 10_ms, [&] { owner.reset(); });
+  wheel.schedule(other.timer, 10_ms, [&] { ++nFired; });
+  advanceClocks(1_ms, 10);
+  BOOST_CHECK(owner == nullptr);
+  BOOST_CHECK_EQUAL(nFired, 1);
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(SetGranularity)
+{
+  TimerWheel wheel(getScheduler(), 1_ms);
+  BOOST_CHECK_EQUAL(wheel.getGranularity(), 1_ms);
+  BOOST_CHECK_THROW(wheel.setGranularity(0_ms), std::invalid_argument);
+
+  TimerWheel::Timer t1;
+  bool hasFired = false;
+  wheel.schedule(t1, 200_ms, [&] { hasFired = true; });
+  advanceClocks(1_ms, 50);
+
+  wheel.setGranularity(10_ms);
+  BOOST_CHECK_EQUAL(wheel.getGranularity(), 10_ms);
+  BOOST_CHECK_EQUAL(wheel.size(), 1);
+  advanceClocks(1_ms, 149);
+  BOOST_CHECK_EQUAL(hasFired, false);
+  advanceClocks(1_ms, 10);
+  BOOST_CHECK_EQUAL(hasFired, true);
+}
+
+BOOST_AUTO_TEST_CASE(Destroy)
+{
+  TimerWheel::Timer t1;
+  bool hasFired = false;
+  {
+    TimerWheel wheel(getScheduler());
+    wheel.schedule(t1, 10_ms, [&] { hasFired = true; });
+  }
+  BOOST_CHECK(!t1.isPending());
+  advanceClocks(1_ms, 20);
+  BOOST_CHECK_EQUAL(hasFired, false);
+  t1.cancel();
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestTimerWheel
+
+} // namespace nfd::tests
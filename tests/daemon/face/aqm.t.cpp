@@ -0,0 +1,159 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "face/aqm-codel.hpp"
+#include "face/aqm-pie.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd::tests {
+
+using namespace nfd::face;
+using Verdict = Aqm::Verdict;
+
+BOOST_AUTO_TEST_SUITE(Face)
+BOOST_AUTO_TEST_SUITE(TestAqm)
+
+BOOST_AUTO_TEST_CASE(Registry)
+{
+  std::set<std::string> expected{"codel", "pie"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(Aqm::getAqmNames().begin(), Aqm::getAqmNames().end(),
+                                expected.begin(), expected.end());
+
+  BOOST_CHECK(dynamic_cast<CoDelAqm*>(Aqm::create("codel", {}).get()) != nullptr);
+  BOOST_CHECK(dynamic_cast<PieAqm*>(Aqm::create("pie", {}).get()) != nullptr);
+  BOOST_CHECK(Aqm::create("red", {}) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(CoDel)
+{
+  CoDelAqm codel({});
+  auto now = time::steady_clock::now();
+  const size_t queueSize = 10000;
+
+  // below target
+  BOOST_CHECK(codel.afterDequeue(4_ms, queueSize, now) == Verdict::PASS);
+  BOOST_CHECK_EQUAL(codel.m_firstAboveTime, time::steady_clock::TimePoint());
+
+  // above target, but not yet for one interval
+  BOOST_CHECK(codel.afterDequeue(6_ms, queueSize, now) == Verdict::PASS);
+  BOOST_CHECK_EQUAL(codel.m_firstAboveTime, now + 100_ms);
+  BOOST_CHECK(codel.afterDequeue(6_ms, queueSize, now + 99_ms) == Verdict::PASS);
+  BOOST_CHECK(!codel.m_isSignaling);
+
+  // above target for one interval: signal congestion, then again after 100ms / sqrt(2)
+  BOOST_CHECK(codel.afterDequeue(6_ms, queueSize, now + 100_ms) == Verdict::CONGESTED);
+  BOOST_CHECK(codel.m_isSignaling);
+  BOOST_CHECK_EQUAL(codel.m_count, 1);
+  BOOST_CHECK_EQUAL(codel.m_signalNext, now + 200_ms);
+  BOOST_CHECK(codel.afterDequeue(6_ms, queueSize, now + 199_ms) == Verdict::PASS);
+  BOOST_CHECK(codel.afterDequeue(6_ms, queueSize, now + 200_ms) == Verdict::CONGESTED);
+  BOOST_CHECK_EQUAL(codel.m_count, 2);
+  BOOST_CHECK_EQUAL(codel.m_signalNext, now + 200_ms + 70710678_ns);
+
+  // an empty queue ends the signaling state
+  BOOST_CHECK(codel.afterDequeue(6_ms, 0, now + 300_ms) == Verdict::PASS);
+  BOOST_CHECK(!codel.m_isSignaling);
+
+  // above target for another interval: signaling starts over
+  BOOST_CHECK(codel.afterDequeue(6_ms, queueSize, now + 310_ms) == Verdict::PASS);
+  BOOST_CHECK(codel.afterDequeue(6_ms, queueSize, now + 410_ms) == Verdict::CONGESTED);
+  BOOST_CHECK_EQUAL(codel.m_count, 1);
+
+  // CoDel never acts on enqueue
+  BOOST_CHECK(codel.beforeEnqueue(1000000, now) == Verdict::PASS);
+}
+
+BOOST_AUTO_TEST_CASE(Pie)
+{
+  Aqm::Options options;
+  options.target = 15_ms;
+  PieAqm pie(options);
+  auto now = time::steady_clock::now();
+  const size_t queueSize = 100000;
+
+  // the first update period starts with the first packet
+  BOOST_CHECK(pie.beforeEnqueue(0, now) == Verdict::PASS);
+  BOOST_CHECK_EQUAL(pie.m_probability, 0.0);
+
+  // a persistent queueing delay above target raises the probability, once the burst allowance
+  // has been used up
+  for (int i = 1; i <= 20; ++i) {
+    pie.afterDequeue(100_ms, queueSize, now + i * PieAqm::UPDATE_PERIOD);
+    pie.beforeEnqueue(queueSize, now + i * PieAqm::UPDATE_PERIOD);
+  }
+  BOOST_CHECK_GT(pie.m_probability, 0.0);
+  BOOST_CHECK_EQUAL(pie.m_burstAllowance, 0_ns);
+  double probability = pie.m_probability;
+
+  // a growing delay raises it faster than a stable one
+  for (int i = 21; i <= 40; ++i) {
+    pie.afterDequeue(100_ms + (i - 20) * 10_ms, queueSize, now + i * PieAqm::UPDATE_PERIOD);
+    pie.beforeEnqueue(queueSize, now + i * PieAqm::UPDATE_PERIOD);
+  }
+  BOOST_CHECK_GT(pie.m_probability, probability);
+
+  // while the queue stays empty, the probability decays
+  probability = pie.m_probability;
+  for (int i = 41; i <= 200; ++i) {
+    pie.beforeEnqueue(0, now + i * PieAqm::UPDATE_PERIOD);
+  }
+  BOOST_CHECK_LT(pie.m_probability, probability / 2);
+
+  // a small queue is never subject to congestion signals
+  pie.m_probability = 1.0;
+  pie.m_burstAllowance = 0_ns;
+  BOOST_CHECK(pie.beforeEnqueue(PieAqm::MIN_QUEUE_SIZE, now + 201 * PieAqm::UPDATE_PERIOD) ==
+              Verdict::PASS);
+}
+
+BOOST_AUTO_TEST_CASE(PieDropAboveMarkingThreshold)
+{
+  PieAqm pie({});
+  auto now = time::steady_clock::now();
+  pie.beforeEnqueue(0, now);
+  pie.m_burstAllowance = 0_ns;
+  pie.m_qdelay = pie.m_qdelayOld = 1_s;
+
+  // no probability update is due before UPDATE_PERIOD has elapsed
+  pie.m_probability = 1.0;
+  BOOST_CHECK(pie.beforeEnqueue(100000, now + 1_ms) == Verdict::DROP);
+
+  pie.m_probability = 0.05;
+  pie.m_qdelay = pie.m_qdelayOld = 20_ms;
+  size_t nCongested = 0;
+  for (int i = 0; i < 1000; ++i) {
+    auto verdict = pie.beforeEnqueue(100000, now + 2_ms);
+    BOOST_CHECK(verdict != Verdict::DROP);
+    nCongested += verdict == Verdict::CONGESTED;
+  }
+  BOOST_CHECK_GT(nCongested, 10);
+  BOOST_CHECK_LT(nCongested, 150);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestAqm
+BOOST_AUTO_TEST_SUITE_END() // Face
+
+} // namespace nfd::tests
@@ -0,0 +1,91 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "face/datagram-buffer-pool.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd::tests {
+
+using face::DatagramBufferPool;
+
+BOOST_AUTO_TEST_SUITE(Face)
+BOOST_AUTO_TEST_SUITE(TestDatagramBufferPool)
+
+BOOST_AUTO_TEST_CASE(Recycle)
+{
+  DatagramBufferPool pool(2, 100);
+  BOOST_CHECK_EQUAL(pool.getCapacity(), 2);
+  BOOST_CHECK_EQUAL(pool.getBufferSize(), 100);
+
+  auto b1 = pool.acquire();
+  auto b2 = pool.acquire();
+  BOOST_REQUIRE(b1 != nullptr);
+  BOOST_CHECK_EQUAL(b1->size(), 100);
+  BOOST_CHECK(b1 != b2);
+
+  // a buffer is recycled once it is released
+  const ndn::Buffer* b1Ptr = b1.get();
+  b1.reset();
+  auto b3 = pool.acquire();
+  BOOST_CHECK_EQUAL(b3.get(), b1Ptr);
+  BOOST_CHECK_EQUAL(pool.getNHits(), 3);
+  BOOST_CHECK_EQUAL(pool.getNMisses(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Exhausted)
+{
+  DatagramBufferPool pool(2, 100);
+  auto b1 = pool.acquire();
+  auto b2 = pool.acquire();
+  b1->front() = 0xB1;
+
+  // every buffer is in use, so a new one is allocated and replaces the least recently used one
+  auto b3 = pool.acquire();
+  BOOST_CHECK(b3 != b1);
+  BOOST_CHECK(b3 != b2);
+  BOOST_CHECK_EQUAL(b3->size(), 100);
+  BOOST_CHECK_EQUAL(pool.getNHits(), 2);
+  BOOST_CHECK_EQUAL(pool.getNMisses(), 1);
+  BOOST_CHECK_EQUAL(pool.getCapacity(), 2);
+  BOOST_CHECK_EQUAL(b1->front(), 0xB1);
+
+  // the replaced buffer has left the pool, the others are recycled
+  const ndn::Buffer* b1Ptr = b1.get();
+  b1.reset();
+  b2.reset();
+  b3.reset();
+  auto b4 = pool.acquire();
+  auto b5 = pool.acquire();
+  BOOST_CHECK(b4.get() != b1Ptr);
+  BOOST_CHECK(b5.get() != b1Ptr);
+  BOOST_CHECK_EQUAL(pool.getNHits(), 4);
+  BOOST_CHECK_EQUAL(pool.getNMisses(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestDatagramBufferPool
+BOOST_AUTO_TEST_SUITE_END() // Face
+
+} // namespace nfd::tests
@@ -0,0 +1,216 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "face/egress-scheduler.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+#include "dummy-face.hpp"
+
+namespace nfd::tests {
+
+using namespace nfd::face;
+using Verdict = EgressScheduler::Verdict;
+
+class EgressSchedulerFixture : public GlobalIoTimeFixture
+{
+protected:
+  EgressSchedulerFixture()
+  {
+    data = makeSizedData("/z/0");
+    dataSize = data.wireEncode().size();
+  }
+
+  static Data
+  makeSizedData(const Name& name)
+  {
+    Data data(name);
+    data.setContent(std::vector<uint8_t>(1200, 0xBB));
+    return signData(data);
+  }
+
+  EgressScheduler
+  makeScheduler(EgressScheduler::Options options)
+  {
+    return EgressScheduler(options, [this] (const EgressScheduler::Packet& packet) {
+      std::visit([this] (const auto& pkt) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(pkt)>, lp::Nack>) {
+          sent.push_back(pkt.getInterest().getName());
+        }
+        else {
+          sent.push_back(pkt.getName());
+        }
+      }, packet);
+    });
+  }
+
+protected:
+  Data data;
+  size_t dataSize;
+  std::vector<Name> sent;
+};
+
+BOOST_AUTO_TEST_SUITE(Face)
+BOOST_FIXTURE_TEST_SUITE(TestEgressScheduler, EgressSchedulerFixture)
+
+BOOST_AUTO_TEST_CASE(Classify)
+{
+  EgressScheduler::Options options;
+  options.rate = 1000;
+  options.classes = {{"a", {"/a", "/c"}, 1}, {"ab", {"/a/b"}, 1}};
+  EgressScheduler scheduler(options, nullptr);
+
+  BOOST_CHECK_EQUAL(scheduler.classify("/localhost/nfd"), 0);
+  BOOST_CHECK_EQUAL(scheduler.classify("/localhop/nfd/rib"), 0);
+  BOOST_CHECK_EQUAL(scheduler.classify("/a/c"), 1);
+  BOOST_CHECK_EQUAL(scheduler.classify("/c"), 1);
+  BOOST_CHECK_EQUAL(scheduler.classify("/a/b/c"), 2);
+  BOOST_CHECK_EQUAL(scheduler.classify("/b"), 3);
+  BOOST_CHECK_EQUAL(scheduler.classify("/"), 3);
+}
+
+BOOST_AUTO_TEST_CASE(TokenBucket)
+{
+  EgressScheduler::Options options;
+  options.rate = 10 * dataSize; // 100ms per packet
+  options.burst = 3 * dataSize;
+  auto scheduler = makeScheduler(options);
+
+  // the burst is sent right away, the rest waits for tokens
+  for (int i = 0; i < 3; ++i) {
+    BOOST_CHECK(scheduler.schedule(data) == Verdict::SEND);
+  }
+  for (int i = 0; i < 7; ++i) {
+    BOOST_CHECK(scheduler.schedule(data) == Verdict::QUEUED);
+  }
+  BOOST_CHECK_EQUAL(scheduler.size(), 7);
+  BOOST_CHECK_EQUAL(sent.size(), 0);
+
+  advanceClocks(10_ms, 350_ms);
+  BOOST_CHECK_EQUAL(sent.size(), 3);
+  advanceClocks(10_ms, 400_ms);
+  BOOST_CHECK_EQUAL(sent.size(), 7);
+  BOOST_CHECK_EQUAL(scheduler.size(), 0);
+
+  // the bucket refills up to the burst size
+  advanceClocks(100_ms, 1_s);
+  for (int i = 0; i < 3; ++i) {
+    BOOST_CHECK(scheduler.schedule(data) == Verdict::SEND);
+  }
+  BOOST_CHECK(scheduler.schedule(data) == Verdict::QUEUED);
+}
+
+BOOST_AUTO_TEST_CASE(ManagementPriority)
+{
+  EgressScheduler::Options options;
+  options.rate = 10 * dataSize;
+  options.burst = dataSize;
+  auto scheduler = makeScheduler(options);
+
+  BOOST_CHECK(scheduler.schedule(data) == Verdict::SEND);
+  BOOST_CHECK(scheduler.schedule(makeSizedData("/z/1")) == Verdict::QUEUED);
+  BOOST_CHECK(scheduler.schedule(makeSizedData("/z/2")) == Verdict::QUEUED);
+  BOOST_CHECK(scheduler.schedule(*makeInterest("/localhop/nfd/rib")) == Verdict::QUEUED);
+  BOOST_CHECK(scheduler.schedule(makeNack(*makeInterest("/localhop/nfd/x"), lp::NackReason::CONGESTION)) ==
+              Verdict::QUEUED);
+
+  advanceClocks(10_ms, 1_s);
+  BOOST_REQUIRE_EQUAL(sent.size(), 4);
+  // management packets overtake the Data queued before them
+  BOOST_CHECK_EQUAL(sent[0], "/localhop/nfd/rib");
+  BOOST_CHECK_EQUAL(sent[1], "/localhop/nfd/x");
+  BOOST_CHECK_EQUAL(sent[2], "/z/1");
+  BOOST_CHECK_EQUAL(sent[3], "/z/2");
+}
+
+BOOST_AUTO_TEST_CASE(WeightedFairness)
+{
+  EgressScheduler::Options options;
+  options.rate = 100 * dataSize;
+  options.burst = dataSize;
+  options.queueLimit = 100;
+  options.classes = {{"a", {"/a"}, 1}, {"b", {"/b"}, 3}};
+  auto scheduler = makeScheduler(options);
+
+  BOOST_CHECK(scheduler.schedule(data) == Verdict::SEND);
+  auto dataA = makeSizedData("/a/0");
+  auto dataB = makeSizedData("/b/0");
+  for (int i = 0; i < 100; ++i) {
+    BOOST_CHECK(scheduler.schedule(dataA) == Verdict::QUEUED);
+    BOOST_CHECK(scheduler.schedule(dataB) == Verdict::QUEUED);
+  }
+  BOOST_CHECK_EQUAL(scheduler.getQueueLength(1), 100);
+  BOOST_CHECK_EQUAL(scheduler.getQueueLength(2), 100);
+  BOOST_CHECK(scheduler.schedule(dataA) == Verdict::DROPPED);
+
+  advanceClocks(5_ms, 400_ms);
+  auto nA = std::count(sent.begin(), sent.end(), dataA.getName());
+  auto nB = std::count(sent.begin(), sent.end(), dataB.getName());
+  BOOST_CHECK_GE(nA + nB, 38);
+  BOOST_CHECK_GE(nA, 8);
+  BOOST_CHECK_LE(nA, 12);
+
+  sent.clear();
+  scheduler.flush();
+  BOOST_CHECK_EQUAL(sent.size(), 200 - nA - nB);
+  BOOST_CHECK_EQUAL(scheduler.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(WithLinkService)
+{
+  DummyFace face;
+  auto service = face.getLinkService();
+  EgressScheduler::Options options;
+  options.rate = 10 * dataSize;
+  options.burst = dataSize;
+  options.queueLimit = 2;
+  service->setEgressScheduler(options);
+  BOOST_REQUIRE(service->getEgressScheduler() != nullptr);
+
+  for (int i = 0; i < 4; ++i) {
+    face.sendData(data);
+  }
+  BOOST_CHECK_EQUAL(face.getCounters().nOutData, 1);
+  BOOST_CHECK_EQUAL(face.getCounters().nEgressQueued, 2);
+  BOOST_CHECK_EQUAL(face.getCounters().nEgressDropped, 1);
+  BOOST_CHECK_EQUAL(face.sentData.size(), 1);
+
+  advanceClocks(10_ms, 150_ms);
+  BOOST_CHECK_EQUAL(face.getCounters().nOutData, 2);
+  BOOST_CHECK_EQUAL(face.sentData.size(), 2);
+
+  // disabling the scheduler sends the waiting packets
+  service->setEgressScheduler(std::nullopt);
+  BOOST_CHECK(service->getEgressScheduler() == nullptr);
+  BOOST_CHECK_EQUAL(face.getCounters().nOutData, 3);
+  face.sendData(data);
+  BOOST_CHECK_EQUAL(face.getCounters().nOutData, 4);
+  BOOST_CHECK_EQUAL(face.sentData.size(), 4);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestEgressScheduler
+BOOST_AUTO_TEST_SUITE_END() // Face
+
+} // namespace nfd::tests
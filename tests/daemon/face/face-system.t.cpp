@@ -24,7 +24,10 @@
  */
 
 #include "face/face-system.hpp"
+#include "face/datagram-buffer-pool.hpp"
+#include "face/io-thread.hpp"
 #include "face-system-fixture.hpp"
+#include "dummy-face.hpp"
 
 #include "tests/test-common.hpp"
 
@@ -159,6 +162,226 @@ BOOST_AUTO_TEST_CASE(ChangeProvidedSchemes)
   BOOST_CHECK_EQUAL(faceSystem.getFactoryByScheme("s3"), f1);
 }
 
+BOOST_AUTO_TEST_CASE(IoThreads)
+{
+  const std::string CONFIG1 = R"CONFIG(
+    face_system
+    {
+      general
+      {
+        io_threads 2
+        io_ring_capacity 64
+      }
+    }
+  )CONFIG";
+
+  parseConfig(CONFIG1, true);
+  BOOST_CHECK(IoThreadPool::get() == nullptr);
+
+  parseConfig(CONFIG1, false);
+  BOOST_REQUIRE(IoThreadPool::get() != nullptr);
+  BOOST_CHECK_EQUAL(IoThreadPool::get()->size(), 2);
+  BOOST_CHECK_EQUAL(IoThreadPool::get()->getRingCapacity(), 64);
+
+  const std::string CONFIG2 = R"CONFIG(
+    face_system
+    {
+      general
+      {
+        io_threads 4
+      }
+    }
+  )CONFIG";
+
+  // the pool is not recreated on reload
+  auto pool = IoThreadPool::get();
+  parseConfig(CONFIG2, false);
+  BOOST_CHECK_EQUAL(IoThreadPool::get(), pool);
+  BOOST_CHECK_EQUAL(IoThreadPool::get()->size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidIoThreads)
+{
+  const std::string CONFIG1 = R"CONFIG(
+    face_system
+    {
+      general
+      {
+        io_threads 65
+      }
+    }
+  )CONFIG";
+  BOOST_CHECK_THROW(parseConfig(CONFIG1, true), ConfigFile::Error);
+
+  const std::string CONFIG2 = R"CONFIG(
+    face_system
+    {
+      general
+      {
+        io_ring_capacity 8
+      }
+    }
+  )CONFIG";
+  BOOST_CHECK_THROW(parseConfig(CONFIG2, true), ConfigFile::Error);
+  BOOST_CHECK(IoThreadPool::get() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(BufferPool)
+{
+  const std::string CONFIG1 = R"CONFIG(
+    face_system
+    {
+      general
+      {
+        datagram_buffer_pool 16
+      }
+    }
+  )CONFIG";
+
+  parseConfig(CONFIG1, true);
+  BOOST_CHECK_EQUAL(face::DatagramBufferPool::getTransportPoolCapacity(), 0);
+  parseConfig(CONFIG1, false);
+  BOOST_CHECK_EQUAL(face::DatagramBufferPool::getTransportPoolCapacity(), 16);
+
+  const std::string CONFIG2 = R"CONFIG(
+    face_system
+    {
+      general
+      {
+        datagram_buffer_pool 65537
+      }
+    }
+  )CONFIG";
+  BOOST_CHECK_THROW(parseConfig(CONFIG2, true), ConfigFile::Error);
+
+  parseConfig("face_system\n{\n}\n", false);
+  BOOST_CHECK_EQUAL(face::DatagramBufferPool::getTransportPoolCapacity(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(AqmDefaults)
+{
+  const std::string CONFIG1 = R"CONFIG(
+    face_system
+    {
+      general
+      {
+        aqm pie
+        aqm_target 15
+        aqm_interval 50
+        aqm_queue_capacity 100000
+      }
+    }
+  )CONFIG";
+
+  parseConfig(CONFIG1, true);
+  BOOST_CHECK_EQUAL(face::Aqm::getDefaultAqmName(), "");
+  parseConfig(CONFIG1, false);
+  BOOST_CHECK_EQUAL(face::Aqm::getDefaultAqmName(), "pie");
+  BOOST_CHECK_EQUAL(face::Aqm::getDefaultOptions().target, 15_ms);
+  BOOST_CHECK_EQUAL(face::Aqm::getDefaultOptions().interval, 50_ms);
+  BOOST_CHECK_EQUAL(face::Aqm::getDefaultOptions().capacity, 100000);
+
+  const std::string CONFIG2 = R"CONFIG(
+    face_system
+    {
+      general
+      {
+        aqm red
+      }
+    }
+  )CONFIG";
+  BOOST_CHECK_THROW(parseConfig(CONFIG2, true), ConfigFile::Error);
+
+  const std::string CONFIG3 = R"CONFIG(
+    face_system
+    {
+      general
+      {
+        aqm_target 0
+      }
+    }
+  )CONFIG";
+  BOOST_CHECK_THROW(parseConfig(CONFIG3, true), ConfigFile::Error);
+
+  parseConfig("face_system\n{\n}\n", false);
+  BOOST_CHECK_EQUAL(face::Aqm::getDefaultAqmName(), "");
+  BOOST_CHECK_EQUAL(face::Aqm::getDefaultOptions().target, 5_ms);
+}
+
+BOOST_AUTO_TEST_CASE(Egress)
+{
+  const std::string CONFIG1 = R"CONFIG(
+    face_system
+    {
+      egress
+      {
+        rate 125000
+        burst 30000
+        queue_limit 500
+        default_weight 2
+        class interactive
+        {
+          prefix /example/interactive
+          prefix /example/voice
+          weight 4
+        }
+      }
+    }
+  )CONFIG";
+
+  parseConfig(CONFIG1, true);
+  BOOST_CHECK(!faceSystem.getEgressSchedulerOptions());
+  parseConfig(CONFIG1, false);
+  BOOST_REQUIRE(faceSystem.getEgressSchedulerOptions());
+  const auto& options = *faceSystem.getEgressSchedulerOptions();
+  BOOST_CHECK_EQUAL(options.rate, 125000);
+  BOOST_CHECK_EQUAL(options.burst, 30000);
+  BOOST_CHECK_EQUAL(options.queueLimit, 500);
+  BOOST_CHECK_EQUAL(options.defaultWeight, 2);
+  BOOST_REQUIRE_EQUAL(options.classes.size(), 1);
+  BOOST_CHECK_EQUAL(options.classes[0].name, "interactive");
+  BOOST_REQUIRE_EQUAL(options.classes[0].prefixes.size(), 2);
+  BOOST_CHECK_EQUAL(options.classes[0].prefixes[1], "/example/voice");
+  BOOST_CHECK_EQUAL(options.classes[0].weight, 4);
+
+  // the scheduler is installed on non-local faces only
+  auto nonLocalFace = make_shared<DummyFace>();
+  auto localFace = make_shared<DummyFace>("dummy://", "dummy://", ndn::nfd::FACE_SCOPE_LOCAL);
+  faceTable.add(nonLocalFace);
+  faceTable.add(localFace);
+  BOOST_CHECK(nonLocalFace->getLinkService()->getEgressScheduler() != nullptr);
+  BOOST_CHECK(localFace->getLinkService()->getEgressScheduler() == nullptr);
+
+  const std::string CONFIG2 = R"CONFIG(
+    face_system
+    {
+      egress
+      {
+        class empty
+        {
+          weight 2
+        }
+      }
+    }
+  )CONFIG";
+  BOOST_CHECK_THROW(parseConfig(CONFIG2, true), ConfigFile::Error);
+
+  const std::string CONFIG3 = R"CONFIG(
+    face_system
+    {
+      egress
+      {
+        rate 125000
+        burst 100
+      }
+    }
+  )CONFIG";
+  BOOST_CHECK_THROW(parseConfig(CONFIG3, true), ConfigFile::Error);
+
+  parseConfig("face_system\n{\n}\n", false);
+  BOOST_CHECK(!faceSystem.getEgressSchedulerOptions());
+}
+
 BOOST_AUTO_TEST_SUITE_END() // ProcessConfig
 
 BOOST_AUTO_TEST_SUITE_END() // TestFaceSystem
@@ -332,6 +332,31 @@ BOOST_AUTO_TEST_CASE(FragmentationDisabledExceedMtuDrop)
   BOOST_CHECK_EQUAL(service->getCounters().nOutOverMtu, 1);
 }
 
+BOOST_AUTO_TEST_CASE(FragmentationOverMtuRoundTrip)
+{
+  // without reliability, fragments refer to the Data wire encoding and are gathered by the transport
+  GenericLinkService::Options options;
+  options.allowFragmentation = true;
+  options.allowReassembly = true;
+  initialize(options);
+
+  transport->setMtu(100);
+
+  auto data = makeData("/test/data/123456789/987654321/123456789");
+  data->setContent(std::vector<uint8_t>(500, 0xBB));
+  signData(data);
+  face->sendData(*data);
+
+  BOOST_CHECK_GT(transport->sentPackets.size(), 1);
+  BOOST_CHECK_EQUAL(transport->getCounters().nOutPackets, transport->sentPackets.size());
+  for (const auto& frag : transport->sentPackets) {
+    BOOST_CHECK_LE(frag.size(), 100);
+    transport->receivePacket(frag);
+  }
+  BOOST_REQUIRE_EQUAL(receivedData.size(), 1);
+  BOOST_CHECK_EQUAL(receivedData.back().wireEncode(), data->wireEncode());
+}
+
 // It is possible for some interfaces (e.g., virtual Ethernet) to have their MTU set to zero
 // This test case ensures that packets are dropped if the MTU is zero
 BOOST_AUTO_TEST_CASE(FragmentationDisabledZeroMtuDrop)
@@ -901,6 +926,149 @@ BOOST_AUTO_TEST_CASE(DefaultThreshold)
 
 BOOST_AUTO_TEST_SUITE_END() // CongestionMark
 
+BOOST_AUTO_TEST_SUITE(SendQueue)
+
+BOOST_AUTO_TEST_CASE(HoldWhileTransportBusy)
+{
+  GenericLinkService::Options options;
+  options.aqmName = "codel";
+  initialize(options, MTU_UNLIMITED, 65536);
+  auto interest = makeInterest("/12345678");
+
+  // transport queue below the limit: packets pass through the send queue right away
+  transport->setSendQueueLength(0);
+  face->sendInterest(*interest);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 1);
+  BOOST_CHECK(service->m_sendQueue.empty());
+
+  // transport queue at the limit: packets wait in the send queue
+  transport->setSendQueueLength(options.aqmOptions.transportQueueLimit);
+  face->sendInterest(*interest);
+  face->sendInterest(*interest);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 1);
+  BOOST_CHECK_EQUAL(service->m_sendQueue.size(), 2);
+  advanceClocks(1_ms, 10);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 1);
+
+  // once the transport drains, the send queue is polled and drained as well
+  transport->setSendQueueLength(0);
+  advanceClocks(1_ms, 2);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 3);
+  BOOST_CHECK(service->m_sendQueue.empty());
+  BOOST_CHECK_EQUAL(service->m_sendQueueSize, 0);
+
+  // disabling the send queue passes waiting packets to the transport
+  transport->setSendQueueLength(options.aqmOptions.transportQueueLimit);
+  face->sendInterest(*interest);
+  BOOST_CHECK_EQUAL(service->m_sendQueue.size(), 1);
+  options.aqmName.clear();
+  service->setOptions(options);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 4);
+  BOOST_CHECK(service->m_sendQueue.empty());
+}
+
+BOOST_AUTO_TEST_CASE(Overflow)
+{
+  GenericLinkService::Options options;
+  options.aqmName = "codel";
+  initialize(options, MTU_UNLIMITED, 65536);
+  auto interest = makeInterest("/12345678");
+  size_t packetSize = interest->wireEncode().size();
+
+  options.aqmOptions.capacity = 3 * packetSize;
+  service->setOptions(options);
+  transport->setSendQueueLength(options.aqmOptions.transportQueueLimit);
+  for (int i = 0; i < 5; ++i) {
+    face->sendInterest(*interest);
+  }
+  BOOST_CHECK_EQUAL(service->m_sendQueue.size(), 3);
+  BOOST_CHECK_EQUAL(service->getCounters().nSendQueueOverflows, 2);
+}
+
+BOOST_AUTO_TEST_CASE(KeepAqmState)
+{
+  GenericLinkService::Options options;
+  options.aqmName = "codel";
+  initialize(options, MTU_UNLIMITED, 65536);
+  const Aqm* aqm = service->m_aqm.get();
+  BOOST_REQUIRE(aqm != nullptr);
+
+  // other options, or options of the same algorithm, do not restart the algorithm
+  options.allowCongestionMarking = false;
+  options.aqmOptions.target = 10_ms;
+  service->setOptions(options);
+  BOOST_CHECK_EQUAL(service->m_aqm.get(), aqm);
+  BOOST_CHECK_EQUAL(service->m_aqm->getOptions().target, 10_ms);
+
+  options.aqmName = "pie";
+  service->setOptions(options);
+  BOOST_REQUIRE(service->m_aqm != nullptr);
+  BOOST_CHECK_NE(service->m_aqm.get(), aqm);
+  BOOST_CHECK_EQUAL(service->m_aqm->getOptions().target, 10_ms);
+}
+
+class StandingQueueFixture : public GenericLinkServiceFixture
+{
+protected:
+  /** \brief enqueue \p nPackets at once, then release one packet per millisecond
+   */
+  void
+  runStandingQueue(bool allowCongestionMarking, size_t nPackets)
+  {
+    GenericLinkService::Options options;
+    options.allowCongestionMarking = allowCongestionMarking;
+    options.aqmName = "codel";
+    initialize(options, MTU_UNLIMITED, 65536);
+    auto interest = makeInterest("/12345678");
+
+    transport->setSendQueueLength(options.aqmOptions.transportQueueLimit);
+    for (size_t i = 0; i < nPackets; ++i) {
+      face->sendInterest(*interest);
+    }
+    BOOST_REQUIRE_EQUAL(service->m_sendQueue.size(), nPackets);
+
+    // any packet brings the estimated transport queue length to the limit
+    transport->setSendQueueLength(options.aqmOptions.transportQueueLimit - 1);
+    for (size_t i = 0; i < 2 * nPackets && !service->m_sendQueue.empty(); ++i) {
+      advanceClocks(1_ms);
+    }
+    BOOST_CHECK(service->m_sendQueue.empty());
+  }
+};
+
+BOOST_FIXTURE_TEST_CASE(CoDelMark, StandingQueueFixture)
+{
+  runStandingQueue(true, 300);
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 300);
+
+  // the sojourn time exceeds the 5ms target within a few packets, and CoDel reacts only after it
+  // has stayed above the target for 100ms
+  for (size_t i = 0; i < 50; ++i) {
+    BOOST_CHECK_EQUAL(lp::Packet(transport->sentPackets[i]).count<lp::CongestionMarkField>(), 0);
+  }
+  size_t nMarked = std::count_if(transport->sentPackets.begin(), transport->sentPackets.end(),
+                                 [] (const Block& pkt) {
+                                   return lp::Packet(pkt).has<lp::CongestionMarkField>();
+                                 });
+  BOOST_CHECK_GE(nMarked, 2);
+  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, nMarked);
+  BOOST_CHECK_EQUAL(service->getCounters().nCongestionDropped, 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(CoDelDrop, StandingQueueFixture)
+{
+  runStandingQueue(false, 300);
+
+  BOOST_CHECK_GE(service->getCounters().nCongestionDropped, 2);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size() + service->getCounters().nCongestionDropped, 300);
+  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 0);
+  for (const auto& pkt : transport->sentPackets) {
+    BOOST_CHECK(!lp::Packet(pkt).has<lp::CongestionMarkField>());
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END() // SendQueue
+
 BOOST_AUTO_TEST_SUITE(LpFields)
 
 BOOST_AUTO_TEST_CASE(ReceiveNextHopFaceId)
@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "face/lp-ack-ranges.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <ndn-cxx/lp/packet.hpp>
+
+namespace nfd::tests {
+
+using namespace nfd::face;
+
+BOOST_AUTO_TEST_SUITE(Face)
+BOOST_AUTO_TEST_SUITE(TestLpAckRanges)
+
+BOOST_AUTO_TEST_CASE(EncodeDecode)
+{
+  AckRanges ackRanges;
+  BOOST_CHECK(ackRanges.empty());
+  BOOST_CHECK(ackRanges.append(5, 3));
+  BOOST_CHECK(ackRanges.append(10, 1));
+  BOOST_CHECK(ackRanges.append(300, 2));
+  BOOST_CHECK(!ackRanges.empty());
+
+  ndn::EncodingBuffer encoder;
+  ackRanges.wireEncode(encoder);
+  Block wire = encoder.block();
+
+  // ranges [5,8) [10,11) [300,302): gaps 5, 2, 289
+  static const uint8_t expected[] = {
+    0xfd, 0x03, 0x54, 0x08,
+      0x05, 0x03,
+      0x02, 0x01,
+      0xfd, 0x01, 0x21, 0x02,
+  };
+  BOOST_TEST(wire == expected, boost::test_tools::per_element());
+  BOOST_CHECK_EQUAL(ackRanges.size(), sizeof(expected));
+
+  AckRanges decoded(wire);
+  const auto& ranges = decoded.getRanges();
+  BOOST_REQUIRE_EQUAL(ranges.size(), 3);
+  BOOST_CHECK_EQUAL(ranges[0].first, 5);
+  BOOST_CHECK_EQUAL(ranges[0].count, 3);
+  BOOST_CHECK_EQUAL(ranges[1].first, 10);
+  BOOST_CHECK_EQUAL(ranges[1].count, 1);
+  BOOST_CHECK_EQUAL(ranges[2].first, 300);
+  BOOST_CHECK_EQUAL(ranges[2].count, 2);
+  BOOST_CHECK_EQUAL(decoded.size(), sizeof(expected));
+}
+
+BOOST_AUTO_TEST_CASE(Empty)
+{
+  lp::Packet pkt;
+  pkt.add<AckRangesField>(AckRanges());
+  BOOST_CHECK_EQUAL(pkt.wireEncode().size(), 2 + 4);
+
+  lp::Packet decoded(pkt.wireEncode());
+  BOOST_REQUIRE(decoded.has<AckRangesField>());
+  BOOST_CHECK(decoded.get<AckRangesField>().empty());
+}
+
+BOOST_AUTO_TEST_CASE(DecodeMalformed)
+{
+  // wrong TLV-TYPE
+  static const uint8_t wrongType[] = {0xfd, 0x03, 0x50, 0x02, 0x01, 0x01};
+  BOOST_CHECK_THROW(AckRanges().wireDecode(Block(wrongType)), tlv::Error);
+
+  // Gap without Count
+  static const uint8_t truncated[] = {0xfd, 0x03, 0x54, 0x03, 0x01, 0x01, 0x05};
+  BOOST_CHECK_THROW(AckRanges().wireDecode(Block(truncated)), tlv::Error);
+
+  // zero Count
+  static const uint8_t zeroCount[] = {0xfd, 0x03, 0x54, 0x02, 0x01, 0x00};
+  BOOST_CHECK_THROW(AckRanges().wireDecode(Block(zeroCount)), tlv::Error);
+}
+
+BOOST_AUTO_TEST_CASE(AppendMaxSize)
+{
+  AckRanges ackRanges;
+  // TLV-TYPE 3 octets, TLV-LENGTH 1 octet, each range 2 octets
+  BOOST_CHECK(ackRanges.append(1, 1, 8));
+  BOOST_CHECK(ackRanges.append(3, 1, 8));
+  BOOST_CHECK(!ackRanges.append(5, 1, 9));
+  BOOST_CHECK_EQUAL(ackRanges.getRanges().size(), 2);
+  BOOST_CHECK_EQUAL(ackRanges.size(), 8);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestLpAckRanges
+BOOST_AUTO_TEST_SUITE_END() // Face
+
+} // namespace nfd::tests
@@ -133,6 +133,49 @@ BOOST_AUTO_TEST_CASE(MultipleFragments)
   BOOST_TEST(data->wireEncode() == reassembledPayload, boost::test_tools::per_element());
 }
 
+BOOST_AUTO_TEST_CASE(ZeroCopy)
+{
+  const size_t mtu = MIN_MTU;
+
+  lp::Packet packet;
+  packet.add<lp::IncomingFaceIdField>(123);
+
+  auto data = makeData("/test/data123/123456789/987654321/123456789");
+  packet.add<lp::FragmentField>({data->wireEncode().begin(), data->wireEncode().end()});
+
+  auto [isOk, frags] = fragmenter.fragmentPacket(packet, mtu);
+  BOOST_REQUIRE(isOk);
+  BOOST_REQUIRE_EQUAL(frags.size(), 5);
+
+  auto [isSliceOk, slices] = fragmenter.fragmentPacketZeroCopy(packet, mtu);
+  BOOST_REQUIRE(isSliceOk);
+  BOOST_REQUIRE_EQUAL(slices.size(), frags.size());
+
+  const Block& packetWire = packet.wireEncode();
+  for (size_t i = 0; i < slices.size(); ++i) {
+    BOOST_TEST_CONTEXT("fragment " << i) {
+      // the payload refers to the input packet
+      BOOST_CHECK(!slices[i].header.has<lp::FragmentField>());
+      BOOST_CHECK(slices[i].payload.data() >= packetWire.data() &&
+                  slices[i].payload.data() + slices[i].payload.size() <= packetWire.data() + packetWire.size());
+
+      // the gathered encoding is the same as the encoding of the copying fragmenter
+      frags[i].set<lp::SequenceField>(1000 + i);
+      slices[i].header.set<lp::SequenceField>(1000 + i);
+      auto gathered = slices[i].encode();
+      BOOST_CHECK_LE(gathered.size(), mtu);
+      std::vector<uint8_t> wire(gathered.header.begin(), gathered.header.end());
+      wire.insert(wire.end(), gathered.payload.begin(), gathered.payload.end());
+      BOOST_TEST(frags[i].wireEncode() == wire, boost::test_tools::per_element());
+    }
+  }
+
+  // no fragment if the packet fits in the MTU
+  std::tie(isSliceOk, slices) = fragmenter.fragmentPacketZeroCopy(packet, 2000);
+  BOOST_CHECK(isSliceOk);
+  BOOST_CHECK(slices.empty());
+}
+
 BOOST_AUTO_TEST_CASE(MtuTooSmall)
 {
   const size_t mtu = 20;
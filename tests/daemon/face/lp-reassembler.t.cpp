@@ -28,6 +28,8 @@
 #include "tests/test-common.hpp"
 #include "tests/daemon/global-io-fixture.hpp"
 
+#include <numeric>
+
 namespace nfd::tests {
 
 using namespace nfd::face;
@@ -264,6 +266,47 @@ BOOST_AUTO_TEST_CASE(OutOfOrder)
   BOOST_REQUIRE(isComplete);
 }
 
+BOOST_AUTO_TEST_CASE(UnequalSizes)
+{
+  // the second fragment does not fit in the slots sized after the first,
+  // and the first is smaller than the slots afterwards
+  ndn::Buffer data0Buffer(data, 3);
+  ndn::Buffer data1Buffer(data + 3, 5);
+  ndn::Buffer data2Buffer(data + 8, 2);
+
+  lp::Packet frag0;
+  frag0.add<lp::FragmentField>(std::make_pair(data0Buffer.begin(), data0Buffer.end()));
+  frag0.add<lp::FragIndexField>(0);
+  frag0.add<lp::FragCountField>(3);
+  frag0.add<lp::SequenceField>(1000);
+
+  lp::Packet frag1;
+  frag1.add<lp::FragmentField>(std::make_pair(data1Buffer.begin(), data1Buffer.end()));
+  frag1.add<lp::FragIndexField>(1);
+  frag1.add<lp::FragCountField>(3);
+  frag1.add<lp::SequenceField>(1001);
+
+  lp::Packet frag2;
+  frag2.add<lp::FragmentField>(std::make_pair(data2Buffer.begin(), data2Buffer.end()));
+  frag2.add<lp::FragIndexField>(2);
+  frag2.add<lp::FragCountField>(3);
+  frag2.add<lp::SequenceField>(1002);
+
+  bool isComplete = false;
+  Block netPacket;
+
+  std::tie(isComplete, std::ignore, std::ignore) = reassembler.receiveFragment(0, frag0);
+  BOOST_REQUIRE(!isComplete);
+
+  std::tie(isComplete, std::ignore, std::ignore) = reassembler.receiveFragment(0, frag2);
+  BOOST_REQUIRE(!isComplete);
+
+  std::tie(isComplete, netPacket, std::ignore) = reassembler.receiveFragment(0, frag1);
+  BOOST_REQUIRE(isComplete);
+  BOOST_CHECK_EQUAL_COLLECTIONS(data, data + sizeof(data), netPacket.begin(), netPacket.end());
+  BOOST_CHECK_EQUAL(reassembler.size(), 0);
+}
+
 BOOST_AUTO_TEST_CASE(Duplicate)
 {
   ndn::Buffer data0Buffer(data, 5);
@@ -376,6 +419,84 @@ BOOST_AUTO_TEST_CASE(FragCountOverLimit)
   BOOST_REQUIRE(!isComplete);
 }
 
+BOOST_AUTO_TEST_CASE(OverSizeLimit)
+{
+  // the last fragment arrives first; FragCount slots as large as it would not fit
+  ndn::Buffer data1Buffer(8000);
+  lp::Packet received1;
+  received1.add<lp::FragmentField>(std::make_pair(data1Buffer.begin(), data1Buffer.end()));
+  received1.add<lp::FragIndexField>(399);
+  received1.add<lp::FragCountField>(400);
+  received1.add<lp::SequenceField>(1399);
+
+  bool isComplete = false;
+
+  std::tie(isComplete, std::ignore, std::ignore) = reassembler.receiveFragment(0, received1);
+  BOOST_REQUIRE(!isComplete);
+  BOOST_CHECK_EQUAL(reassembler.size(), 1);
+  BOOST_CHECK_LE(reassembler.getBufferCapacity(), ndn::MAX_NDN_PACKET_SIZE);
+
+  // 399 fragments of this size cannot form a packet within MAX_NDN_PACKET_SIZE
+  ndn::Buffer data2Buffer(8000);
+  lp::Packet received2;
+  received2.add<lp::FragmentField>(std::make_pair(data2Buffer.begin(), data2Buffer.end()));
+  received2.add<lp::FragIndexField>(0);
+  received2.add<lp::FragCountField>(400);
+  received2.add<lp::SequenceField>(1000);
+
+  std::tie(isComplete, std::ignore, std::ignore) = reassembler.receiveFragment(0, received2);
+  BOOST_REQUIRE(!isComplete);
+  BOOST_CHECK_EQUAL(reassembler.size(), 0);
+  BOOST_CHECK_EQUAL(reassembler.getBufferCapacity(), 0);
+
+  // same for a new packet starting with a large first fragment
+  received2.set<lp::SequenceField>(2000);
+  std::tie(isComplete, std::ignore, std::ignore) = reassembler.receiveFragment(0, received2);
+  BOOST_REQUIRE(!isComplete);
+  BOOST_CHECK_EQUAL(reassembler.size(), 0);
+  BOOST_CHECK_EQUAL(reassembler.getBufferCapacity(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(SlotsOverSizeLimit)
+{
+  // Data of 8000 octets, split into fragments of 3500, 3500, and 1000 octets
+  ndn::Buffer wire(8000);
+  wire[0] = 0x06;
+  wire[1] = 0xFD;
+  wire[2] = (8000 - 4) >> 8;
+  wire[3] = (8000 - 4) & 0xFF;
+  std::iota(wire.begin() + 4, wire.end(), uint8_t{0});
+
+  auto makeFragment = [&wire] (size_t begin, size_t end, uint64_t index) {
+    lp::Packet frag;
+    frag.add<lp::FragmentField>(std::make_pair(wire.begin() + begin, wire.begin() + end));
+    frag.add<lp::FragIndexField>(index);
+    frag.add<lp::FragCountField>(3);
+    frag.add<lp::SequenceField>(1000 + index);
+    return frag;
+  };
+
+  bool isComplete = false;
+  Block netPacket;
+
+  std::tie(isComplete, std::ignore, std::ignore) =
+    reassembler.receiveFragment(0, makeFragment(7000, 8000, 2));
+  BOOST_REQUIRE(!isComplete);
+  BOOST_CHECK_LE(reassembler.getBufferCapacity(), ndn::MAX_NDN_PACKET_SIZE);
+
+  // three slots of 3500 octets would not fit
+  std::tie(isComplete, std::ignore, std::ignore) =
+    reassembler.receiveFragment(0, makeFragment(3500, 7000, 1));
+  BOOST_REQUIRE(!isComplete);
+  BOOST_CHECK_LE(reassembler.getBufferCapacity(), ndn::MAX_NDN_PACKET_SIZE);
+
+  std::tie(isComplete, netPacket, std::ignore) =
+    reassembler.receiveFragment(0, makeFragment(0, 3500, 0));
+  BOOST_REQUIRE(isComplete);
+  BOOST_CHECK_EQUAL_COLLECTIONS(wire.begin(), wire.end(), netPacket.begin(), netPacket.end());
+  BOOST_CHECK_EQUAL(reassembler.size(), 0);
+}
+
 BOOST_AUTO_TEST_CASE(MissingFragCount)
 {
   ndn::Buffer data1Buffer(data, 4);
@@ -112,8 +112,8 @@ public:
   static bool
   netPktHasUnackedFrag(const shared_ptr<LpReliability::NetPkt>& netPkt, lp::Sequence txSeq)
   {
-    return std::any_of(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(),
-                       [txSeq] (auto fragIt) { return fragIt->first == txSeq; });
+    return std::find(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(), txSeq) !=
+           netPkt->unackedFrags.end();
   }
 
   /** \brief make an LpPacket with fragment of specified size
@@ -204,7 +204,7 @@ BOOST_AUTO_TEST_CASE(SendUnfragmentedRetx)
                  reliability->m_unackedFrags.at(firstTxSeq + 1).netPkt);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq).retxCount, 0);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 1).retxCount, 0);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, firstTxSeq);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), firstTxSeq);
   BOOST_CHECK_EQUAL(reliability->m_ackQueue.size(), 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -222,7 +222,7 @@ BOOST_AUTO_TEST_CASE(SendUnfragmentedRetx)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 2).retxCount, 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(firstTxSeq + 1), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 1).retxCount, 0);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, firstTxSeq + 1);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), firstTxSeq + 1);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 3);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -241,7 +241,7 @@ BOOST_AUTO_TEST_CASE(SendUnfragmentedRetx)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 4).retxCount, 2);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(firstTxSeq + 3), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 3).retxCount, 1);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, firstTxSeq + 3);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), firstTxSeq + 3);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 5);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -260,7 +260,7 @@ BOOST_AUTO_TEST_CASE(SendUnfragmentedRetx)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 6).retxCount, 3);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(firstTxSeq + 5), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 5).retxCount, 2);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, firstTxSeq + 5);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), firstTxSeq + 5);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 7);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -277,7 +277,7 @@ BOOST_AUTO_TEST_CASE(SendUnfragmentedRetx)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(firstTxSeq + 6), 0);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(firstTxSeq + 7), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 7).retxCount, 3);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, firstTxSeq + 7);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), firstTxSeq + 7);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 8);
 
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
@@ -351,7 +351,7 @@ BOOST_AUTO_TEST_CASE(SendFragmentedRetx)
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 2));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 3));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 4));
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 2);
   BOOST_CHECK_EQUAL(reliability->m_ackQueue.size(), 0);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 3);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
@@ -386,7 +386,7 @@ BOOST_AUTO_TEST_CASE(SendFragmentedRetx)
   BOOST_CHECK(!netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 3));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 5));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 4));
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 2);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 4);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -420,7 +420,7 @@ BOOST_AUTO_TEST_CASE(SendFragmentedRetx)
   BOOST_CHECK(!netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 5));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 6));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 4));
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 2);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 5);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -454,7 +454,7 @@ BOOST_AUTO_TEST_CASE(SendFragmentedRetx)
   BOOST_CHECK(!netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 6));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 7));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 4));
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 2);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 6);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -483,7 +483,7 @@ BOOST_AUTO_TEST_CASE(AckUnknownTxSeq)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(2), 1);
   BOOST_CHECK(reliability->m_unackedFrags.at(2).netPkt);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 2);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 1);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -497,7 +497,7 @@ BOOST_AUTO_TEST_CASE(AckUnknownTxSeq)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(2), 1);
   BOOST_CHECK(reliability->m_unackedFrags.at(2).netPkt);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 2);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 1);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -530,7 +530,7 @@ BOOST_AUTO_TEST_CASE(LossByGreaterAcks)
   BOOST_CHECK(reliability->m_unackedFrags.at(2).netPkt);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(3), 1); // pkt5
   BOOST_CHECK(reliability->m_unackedFrags.at(3).netPkt);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 0xFFFFFFFFFFFFFFFF);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 0xFFFFFFFFFFFFFFFF);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetxExhausted, 0);
@@ -557,7 +557,7 @@ BOOST_AUTO_TEST_CASE(LossByGreaterAcks)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(3), 1); // pkt5
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(3).retxCount, 0);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(3).nGreaterSeqAcks, 0);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 0xFFFFFFFFFFFFFFFF);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 0xFFFFFFFFFFFFFFFF);
   BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 5);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 1);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -585,7 +585,7 @@ BOOST_AUTO_TEST_CASE(LossByGreaterAcks)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(3).retxCount, 0);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(3).nGreaterSeqAcks, 0);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(101010), 0);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 0xFFFFFFFFFFFFFFFF);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 0xFFFFFFFFFFFFFFFF);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 5);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 2);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -610,7 +610,7 @@ BOOST_AUTO_TEST_CASE(LossByGreaterAcks)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(4), 1); // pkt1 new TxSeq
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(4).retxCount, 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(4).nGreaterSeqAcks, 0);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 3);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 3);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 6);
   lp::Packet sentRetxPkt(transport->sentPackets.back());
   BOOST_REQUIRE(sentRetxPkt.has<lp::TxSequenceField>());
@@ -637,7 +637,7 @@ BOOST_AUTO_TEST_CASE(LossByGreaterAcks)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(3).retxCount, 0);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(3).nGreaterSeqAcks, 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(4), 0); // pkt1 new TxSeq
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 3);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 3);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 6);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 3);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 1);
@@ -662,7 +662,7 @@ BOOST_AUTO_TEST_CASE(SkipFragmentsRemovedInRtt)
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 5);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 5);
 
-  lp::Sequence firstTxSeq = reliability->m_firstUnackedFrag->first;
+  lp::Sequence firstTxSeq = reliability->m_unackedFrags.getFirstTxSeq();
 
   // Ack the last 2 packets
   lp::Packet ackPkt1;
@@ -941,7 +941,7 @@ BOOST_AUTO_TEST_CASE(TrackRecentReceivedLpPackets)
   pkt1.add<lp::TxSequenceField>(12);
   BOOST_CHECK(reliability->processIncomingPacket({pkt1}));
   BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqsQueue.size(), 1);
-  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqsQueue.front(), 7);
+  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqsQueue.front().first, 7);
   BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.size(), 1);
   BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.count(7), 1);
 
@@ -956,7 +956,7 @@ BOOST_AUTO_TEST_CASE(TrackRecentReceivedLpPackets)
   pkt2.add<lp::TxSequenceField>(13);
   BOOST_CHECK(reliability->processIncomingPacket({pkt2}));
   BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqsQueue.size(), 2);
-  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqsQueue.front(), 7);
+  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqsQueue.front().first, 7);
   BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.size(), 2);
   BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.count(7), 1);
   BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.count(23), 1);
@@ -969,7 +969,7 @@ BOOST_AUTO_TEST_CASE(TrackRecentReceivedLpPackets)
   pkt3.add<lp::TxSequenceField>(14);
   BOOST_CHECK(reliability->processIncomingPacket({pkt3}));
   BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqsQueue.size(), 2);
-  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqsQueue.front(), 23);
+  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqsQueue.front().first, 23);
   BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.size(), 2);
   BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.count(23), 1);
   BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.count(24), 1);
@@ -982,7 +982,7 @@ BOOST_AUTO_TEST_CASE(TrackRecentReceivedLpPackets)
   pkt4.add<lp::TxSequenceField>(15);
   BOOST_CHECK(reliability->processIncomingPacket({pkt4}));
   BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqsQueue.size(), 2);
-  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqsQueue.front(), 24);
+  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqsQueue.front().first, 24);
   BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.size(), 2);
   BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.count(24), 1);
   BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.count(25), 1);
@@ -1016,7 +1016,7 @@ BOOST_AUTO_TEST_CASE(DropDuplicateAckForRetx)
   // Will send out a single fragment
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 1);
-  lp::Sequence firstTxSeq = reliability->m_firstUnackedFrag->first;
+  lp::Sequence firstTxSeq = reliability->m_unackedFrags.getFirstTxSeq();
 
   // RTO is initially 1 second, so will time out and retx
   advanceClocks(1250_ms, 1);
@@ -1033,11 +1033,230 @@ BOOST_AUTO_TEST_CASE(DropDuplicateAckForRetx)
   // Acknowledge second transmission
   // Ack will acknowledge retx and remove unacked frag
   lp::Packet ackPkt2;
-  ackPkt2.add<lp::AckField>(reliability->m_firstUnackedFrag->first);
+  ackPkt2.add<lp::AckField>(reliability->m_unackedFrags.getFirstTxSeq());
   reliability->processIncomingPacket(ackPkt2);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(WindowGrowth)
+{
+  // 200 unacknowledged fragments do not fit in the initial window, which must grow while keeping
+  // TxSequences that wrap around
+  reliability->m_lastTxSeqNo = 0xFFFFFFFFFFFFFFFF - 100;
+  lp::Sequence firstTxSeq = reliability->m_lastTxSeqNo + 1;
+  for (uint32_t i = 0; i < 200; ++i) {
+    linkService->sendLpPackets({makeFrag(i, 50)});
+  }
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 200);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), firstTxSeq);
+  for (uint32_t i = 0; i < 200; ++i) {
+    BOOST_REQUIRE_EQUAL(reliability->m_unackedFrags.count(firstTxSeq + i), 1);
+    BOOST_CHECK_EQUAL(getPktNum(reliability->m_unackedFrags.at(firstTxSeq + i).pkt), i);
+  }
+  BOOST_CHECK_THROW(reliability->m_unackedFrags.at(firstTxSeq + 200), std::out_of_range);
+
+  // Acknowledge the first fragment and every fragment after the 150th, in reverse order
+  lp::Packet ackPkt;
+  ackPkt.add<lp::AckField>(firstTxSeq);
+  for (uint32_t i = 199; i >= 150; --i) {
+    ackPkt.add<lp::AckField>(firstTxSeq + i);
+  }
+  auto opts = linkService->getOptions();
+  opts.reliabilityOptions.seqNumLossThreshold = 1000; // no loss detection in this test case
+  linkService->setOptions(opts);
+  BOOST_CHECK(reliability->processIncomingPacket(ackPkt));
+
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 149);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), firstTxSeq + 1);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getEndTxSeq(), firstTxSeq + 150);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 1).nGreaterSeqAcks, 50);
+  BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 51);
+}
+
+BOOST_AUTO_TEST_CASE(AckBatch)
+{
+  // MTU is 1500. LpPacket TL occupies 4 octets. Each Ack header is 12 octets. Once 124 Acks are
+  // pending, they are sent in an IDLE packet without waiting for the idle Ack timer.
+  transport->setMtu(1500);
+  BOOST_CHECK_EQUAL(reliability->getAckBatchSize(), 124);
+
+  for (lp::Sequence i = 0; i < 124; ++i) {
+    BOOST_CHECK_EQUAL(transport->sentPackets.size(), 0);
+    lp::Packet pkt = makeFrag(1, 100);
+    pkt.add<lp::SequenceField>(100 + i);
+    pkt.add<lp::TxSequenceField>(1000 + i);
+    BOOST_CHECK(reliability->processIncomingPacket(pkt));
+  }
+
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 1);
+  lp::Packet sentPkt(transport->sentPackets.back());
+  BOOST_CHECK(!sentPkt.has<lp::FragmentField>());
+  BOOST_CHECK_EQUAL(sentPkt.count<lp::AckField>(), 124);
+  BOOST_CHECK_EQUAL(sentPkt.get<lp::AckField>(0), 1000);
+  BOOST_CHECK_EQUAL(reliability->m_ackQueue.size(), 0);
+
+  // the idle Ack timer has nothing left to send
+  advanceClocks(1_ms, 5);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(RecentReceivedSeqsWindowSlides)
+{
+  constexpr lp::Sequence maxCapacity = LpReliability::RecvSeqWindow::MAX_CAPACITY;
+
+  lp::Packet pkt1 = makeFrag(1, 100);
+  pkt1.add<lp::SequenceField>(7);
+  pkt1.add<lp::TxSequenceField>(12);
+  BOOST_CHECK(reliability->processIncomingPacket(pkt1));
+
+  // within the window: both are tracked
+  lp::Packet pkt2 = makeFrag(1, 100);
+  pkt2.add<lp::SequenceField>(7 + maxCapacity - 1);
+  pkt2.add<lp::TxSequenceField>(13);
+  BOOST_CHECK(reliability->processIncomingPacket(pkt2));
+  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.size(), 2);
+  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.count(7), 1);
+
+  // the window slides forward and forgets the oldest Sequence
+  lp::Packet pkt3 = makeFrag(1, 100);
+  pkt3.add<lp::SequenceField>(7 + maxCapacity);
+  pkt3.add<lp::TxSequenceField>(14);
+  BOOST_CHECK(reliability->processIncomingPacket(pkt3));
+  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.size(), 2);
+  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.count(7), 0);
+  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.count(7 + maxCapacity - 1), 1);
+  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.count(7 + maxCapacity), 1);
+
+  // a forgotten Sequence is no longer recognized as a duplicate
+  BOOST_CHECK(reliability->processIncomingPacket(pkt1));
+  BOOST_CHECK(!reliability->processIncomingPacket(pkt3));
+}
+
+BOOST_AUTO_TEST_CASE(AckRangesNegotiation)
+{
+  GenericLinkService::Options opts = linkService->getOptions();
+  opts.reliabilityOptions.allowAckRanges = true;
+  linkService->setOptions(opts);
+
+  // every fragment advertises support for AckRanges with an empty field
+  linkService->sendLpPackets({makeFrag(1, 50)});
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 1);
+  lp::Packet sentPkt1(transport->sentPackets.back());
+  BOOST_CHECK(sentPkt1.has<lp::TxSequenceField>());
+  BOOST_REQUIRE(sentPkt1.has<AckRangesField>());
+  BOOST_CHECK(sentPkt1.get<AckRangesField>().empty());
+
+  // peer does not advertise AckRanges: acknowledge with individual Acks
+  for (lp::Sequence txSeq : {20, 21, 22}) {
+    lp::Packet pkt = makeFrag(2, 50);
+    pkt.add<lp::SequenceField>(txSeq + 100);
+    pkt.add<lp::TxSequenceField>(txSeq);
+    BOOST_CHECK(reliability->processIncomingPacket(pkt));
+  }
+  BOOST_CHECK(!reliability->m_isPeerAckRangesCapable);
+  linkService->sendLpPackets({lp::Packet()});
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 2);
+  lp::Packet sentPkt2(transport->sentPackets.back());
+  BOOST_CHECK_EQUAL(sentPkt2.count<lp::AckField>(), 3);
+  BOOST_CHECK(!sentPkt2.has<AckRangesField>());
+
+  // peer advertises AckRanges: consecutive TxSequences are coalesced into ranges
+  for (lp::Sequence txSeq : {30, 32, 31, 35}) {
+    lp::Packet pkt = makeFrag(2, 50);
+    pkt.add<lp::SequenceField>(txSeq + 100);
+    pkt.add<lp::TxSequenceField>(txSeq);
+    pkt.add<AckRangesField>(AckRanges());
+    BOOST_CHECK(reliability->processIncomingPacket(pkt));
+  }
+  BOOST_CHECK(reliability->m_isPeerAckRangesCapable);
+  linkService->sendLpPackets({lp::Packet()});
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 3);
+  lp::Packet sentPkt3(transport->sentPackets.back());
+  BOOST_CHECK(!sentPkt3.has<lp::AckField>());
+  BOOST_REQUIRE(sentPkt3.has<AckRangesField>());
+  const auto& ranges = sentPkt3.get<AckRangesField>().getRanges();
+  BOOST_REQUIRE_EQUAL(ranges.size(), 2);
+  BOOST_CHECK_EQUAL(ranges[0].first, 30);
+  BOOST_CHECK_EQUAL(ranges[0].count, 3);
+  BOOST_CHECK_EQUAL(ranges[1].first, 35);
+  BOOST_CHECK_EQUAL(ranges[1].count, 1);
+  BOOST_CHECK_EQUAL(reliability->m_ackQueue.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ReceiveAckRanges)
+{
+  GenericLinkService::Options opts = linkService->getOptions();
+  opts.reliabilityOptions.allowAckRanges = true;
+  opts.reliabilityOptions.seqNumLossThreshold = 1000; // no loss detection in this test case
+  linkService->setOptions(opts);
+
+  for (uint32_t i = 1; i <= 6; ++i) {
+    linkService->sendLpPackets({makeFrag(i, 50)});
+  }
+  BOOST_REQUIRE_EQUAL(reliability->m_unackedFrags.size(), 6);
+  lp::Sequence firstTxSeq = reliability->m_unackedFrags.getFirstTxSeq();
+
+  // ranges that extend beyond the window acknowledge only the fragments within it
+  AckRanges ackRanges;
+  BOOST_REQUIRE(ackRanges.append(0, firstTxSeq + 3));
+  BOOST_REQUIRE(ackRanges.append(firstTxSeq + 4, 100));
+  lp::Packet pkt;
+  pkt.add<AckRangesField>(ackRanges);
+  BOOST_CHECK(reliability->processIncomingPacket(pkt));
+
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 1);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(firstTxSeq + 3), 1);
+  BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 5);
+
+  // AckRanges is ignored unless enabled locally
+  opts.reliabilityOptions.allowAckRanges = false;
+  linkService->setOptions(opts);
+  AckRanges ackRanges2;
+  BOOST_REQUIRE(ackRanges2.append(firstTxSeq + 3, 1));
+  lp::Packet pkt2;
+  pkt2.add<AckRangesField>(ackRanges2);
+  BOOST_CHECK(reliability->processIncomingPacket(pkt2));
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(AckFrequency)
+{
+  GenericLinkService::Options opts = linkService->getOptions();
+  opts.reliabilityOptions.ackFrequency = 4;
+  linkService->setOptions(opts);
+  BOOST_CHECK_EQUAL(reliability->getAckBatchSize(), 4);
+
+  // without a receive interval estimate, the configured period is used
+  BOOST_CHECK_EQUAL(reliability->getIdleAckTimerPeriod(), opts.reliabilityOptions.idleAckTimerPeriod);
+
+  // fragments arriving 1ms apart: the idle Ack timer waits for about four of them
+  for (lp::Sequence i = 0; i < 3; ++i) {
+    lp::Packet pkt = makeFrag(1, 50);
+    pkt.add<lp::SequenceField>(100 + i);
+    pkt.add<lp::TxSequenceField>(1000 + i);
+    BOOST_CHECK(reliability->processIncomingPacket(pkt));
+    advanceClocks(1_ms);
+  }
+  BOOST_CHECK_EQUAL(reliability->m_recvInterval, 1_ms);
+  BOOST_CHECK_EQUAL(reliability->getIdleAckTimerPeriod(), 4_ms);
+
+  // the fourth fragment completes a batch, which is sent right away
+  lp::Packet pkt = makeFrag(1, 50);
+  pkt.add<lp::SequenceField>(103);
+  pkt.add<lp::TxSequenceField>(1003);
+  BOOST_CHECK(reliability->processIncomingPacket(pkt));
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 1);
+  BOOST_CHECK_EQUAL(lp::Packet(transport->sentPackets.back()).count<lp::AckField>(), 4);
+
+  // a slow link never waits longer than the configured period
+  advanceClocks(1_s);
+  lp::Packet pkt2 = makeFrag(1, 50);
+  pkt2.add<lp::SequenceField>(104);
+  pkt2.add<lp::TxSequenceField>(1004);
+  BOOST_CHECK(reliability->processIncomingPacket(pkt2));
+  BOOST_CHECK_EQUAL(reliability->getIdleAckTimerPeriod(), opts.reliabilityOptions.idleAckTimerPeriod);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestLpReliability
 BOOST_AUTO_TEST_SUITE_END() // Face
 
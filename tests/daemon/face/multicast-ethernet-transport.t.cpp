@@ -129,6 +129,95 @@ BOOST_AUTO_TEST_CASE(Close)
   BOOST_REQUIRE_EQUAL(limitedIo.run(1, 1_s), LimitedIo::EXCEED_OPS);
 }
 
+BOOST_AUTO_TEST_CASE(SendBatch)
+{
+  SKIP_IF_NO_RUNNING_ETHERNET_NETIF();
+  initializeMulticast(getRunningNetif());
+  BOOST_CHECK_EQUAL(transport->getState(), TransportState::UP);
+
+  // more frames than a batch holds: the full batch is flushed early, the rest at the end of
+  // the current io_service round, and no frame is dropped
+  auto pkt = ndn::encoding::makeStringBlock(300, "payload");
+  for (size_t i = 0; i < EthernetTxBatch::MAX_BATCH_SIZE + 5; ++i) {
+    transport->send(pkt);
+  }
+  limitedIo.defer(10_ms);
+  BOOST_CHECK_EQUAL(transport->getState(), TransportState::UP);
+
+  const auto& counters = transport->getCounters();
+  BOOST_CHECK_EQUAL(counters.nOutPackets, EthernetTxBatch::MAX_BATCH_SIZE + 5);
+  BOOST_CHECK_EQUAL(counters.nOutDrops, 0);
+}
+
+#ifdef __linux__
+BOOST_AUTO_TEST_CASE(PacketRingBackend)
+{
+  SKIP_IF_NO_RUNNING_ETHERNET_NETIF();
+  auto netif = getRunningNetif();
+  localEp = netif->getName();
+  remoteEp = {0x01, 0x00, 0x5e, 0x90, 0x10, 0x5e};
+  BOOST_REQUIRE_NO_THROW(transport = make_unique<MulticastEthernetTransport>(*netif, remoteEp,
+                                                                            ndn::nfd::LINK_TYPE_MULTI_ACCESS,
+                                                                            EthernetBackend::PACKET_RING));
+  checkStaticPropertiesInitialized(*transport);
+  BOOST_CHECK_EQUAL(transport->getLocalUri(), FaceUri("dev://" + localEp));
+  BOOST_CHECK_EQUAL(transport->getState(), TransportState::UP);
+
+  // frames are written into the TX ring and flushed at the end of the current io_service round
+  auto pkt = ndn::encoding::makeStringBlock(300, "payload");
+  transport->send(pkt);
+  transport->send(pkt);
+  BOOST_CHECK_EQUAL(transport->getCounters().nOutPackets, 2);
+  limitedIo.defer(10_ms);
+  BOOST_CHECK_EQUAL(transport->getState(), TransportState::UP);
+
+  transport->close();
+  transport->afterStateChange.connectSingleShot([this] (auto, auto newState) {
+    BOOST_CHECK_EQUAL(newState, TransportState::CLOSED);
+    this->limitedIo.afterOp();
+  });
+  BOOST_REQUIRE_EQUAL(limitedIo.run(1, 1_s), LimitedIo::EXCEED_OPS);
+}
+#endif // __linux__
+
+#ifdef NFD_HAVE_AF_XDP
+BOOST_AUTO_TEST_CASE(XdpBackend)
+{
+  SKIP_IF_NO_RUNNING_ETHERNET_NETIF();
+  auto netif = getRunningNetif();
+  localEp = netif->getName();
+  remoteEp = {0x01, 0x00, 0x5e, 0x90, 0x10, 0x5e};
+  try {
+    transport = make_unique<MulticastEthernetTransport>(*netif, remoteEp, ndn::nfd::LINK_TYPE_MULTI_ACCESS,
+                                                        EthernetBackend::XDP);
+  }
+  catch (const EthernetTransport::Error& e) {
+    // e.g., the kernel is too old, or another XDP program is attached to the interface
+    BOOST_WARN_MESSAGE(false, "skipping assertions that require an AF_XDP socket: "s + e.what());
+    return;
+  }
+  checkStaticPropertiesInitialized(*transport);
+  BOOST_CHECK_EQUAL(transport->getLocalUri(), FaceUri("dev://" + localEp));
+  BOOST_CHECK_EQUAL(transport->getState(), TransportState::UP);
+  // a frame must fit in a UMEM frame
+  BOOST_CHECK_LE(transport->getMtu(), XdpSocket::FRAME_SIZE - ethernet::HDR_LEN);
+
+  auto pkt = ndn::encoding::makeStringBlock(300, "payload");
+  transport->send(pkt);
+  transport->send(pkt);
+  BOOST_CHECK_EQUAL(transport->getCounters().nOutPackets, 2);
+  limitedIo.defer(10_ms);
+  BOOST_CHECK_EQUAL(transport->getState(), TransportState::UP);
+
+  transport->close();
+  transport->afterStateChange.connectSingleShot([this] (auto, auto newState) {
+    BOOST_CHECK_EQUAL(newState, TransportState::CLOSED);
+    this->limitedIo.afterOp();
+  });
+  BOOST_REQUIRE_EQUAL(limitedIo.run(1, 1_s), LimitedIo::EXCEED_OPS);
+}
+#endif // NFD_HAVE_AF_XDP
+
 BOOST_AUTO_TEST_CASE(SendQueueLength)
 {
   SKIP_IF_ETHERNET_NETIF_COUNT_LT(1);
@@ -71,6 +71,39 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(Send, T, StreamTransportFixtures, T)
   BOOST_CHECK_EQUAL(this->transport->getState(), TransportState::UP);
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(SendGathered, T, StreamTransportFixtures, T)
+{
+  TRANSPORT_TEST_INIT();
+
+  // the first packet is written alone, and the packets queued meanwhile are written together
+  std::vector<Block> blocks;
+  size_t totalSize = 0;
+  for (int i = 0; i < 10; ++i) {
+    blocks.push_back(ndn::encoding::makeNonNegativeIntegerBlock(300, i));
+    totalSize += blocks.back().size();
+    this->transport->send(blocks.back());
+  }
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nOutPackets, 10);
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nOutWrites, 1);
+
+  std::vector<uint8_t> readBuf(totalSize);
+  boost::asio::async_read(this->remoteSocket, boost::asio::buffer(readBuf),
+    [this] (const boost::system::error_code& error, size_t) {
+      BOOST_REQUIRE_EQUAL(error, boost::system::errc::success);
+      this->limitedIo.afterOp();
+    });
+  BOOST_REQUIRE_EQUAL(this->limitedIo.run(1, 1_s), LimitedIo::EXCEED_OPS);
+
+  auto it = readBuf.begin();
+  for (const auto& block : blocks) {
+    BOOST_CHECK_EQUAL_COLLECTIONS(it, it + block.size(), block.begin(), block.end());
+    it += block.size();
+  }
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nOutWrites, 2);
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nOutWritePackets, 10);
+  BOOST_CHECK_EQUAL(this->transport->getState(), TransportState::UP);
+}
+
 BOOST_FIXTURE_TEST_CASE_TEMPLATE(ReceiveNormal, T, StreamTransportFixtures, T)
 {
   TRANSPORT_TEST_INIT();
@@ -138,6 +171,38 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(ReceiveMultipleBlocks, T, StreamTransportFixtur
   BOOST_CHECK_EQUAL(this->transport->getState(), TransportState::UP);
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(ReceiveZeroCopy, T, StreamTransportFixtures, T)
+{
+  this->wantZeroCopyReceive = true;
+  TRANSPORT_TEST_INIT();
+
+  auto pkt1 = ndn::encoding::makeStringBlock(300, "hello");
+  auto pkt2 = ndn::encoding::makeStringBlock(301, "world");
+  auto pkt3 = ndn::encoding::makeStringBlock(302, "again");
+  ndn::Buffer buf1(pkt1.size() + pkt2.size() + pkt3.size() - 2);
+  auto it = std::copy(pkt1.begin(), pkt1.end(), buf1.begin());
+  it = std::copy(pkt2.begin(), pkt2.end(), it);
+  std::copy(pkt3.begin(), pkt3.end() - 2, it);
+  ndn::Buffer buf2(pkt3.end() - 2, pkt3.end());
+
+  this->remoteWrite(buf1);
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nInPackets, 2);
+  this->remoteWrite(buf2);
+
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nInPackets, 3);
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nInBytes, pkt1.size() + pkt2.size() + pkt3.size());
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nInCopiedBytes, 0);
+  BOOST_CHECK_EQUAL(this->transport->getState(), TransportState::UP);
+
+  BOOST_REQUIRE_EQUAL(this->receivedPackets->size(), 3);
+  BOOST_CHECK(this->receivedPackets->at(0).packet == pkt1);
+  BOOST_CHECK(this->receivedPackets->at(1).packet == pkt2);
+  BOOST_CHECK(this->receivedPackets->at(2).packet == pkt3);
+  // all packets are slices of the same receive chunk
+  BOOST_CHECK(this->receivedPackets->at(0).packet.getBuffer() ==
+              this->receivedPackets->at(2).packet.getBuffer());
+}
+
 BOOST_FIXTURE_TEST_CASE_TEMPLATE(ReceiveTooLarge, T, StreamTransportFixtures, T)
 {
   TRANSPORT_TEST_INIT();
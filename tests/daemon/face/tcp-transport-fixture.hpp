@@ -89,7 +89,8 @@ protected:
     }
 
     face = make_unique<Face>(make_unique<DummyLinkService>(),
-                             make_unique<TcpTransport>(std::move(sock), persistency, scope));
+                             make_unique<TcpTransport>(std::move(sock), persistency, scope,
+                                                                     wantZeroCopyReceive));
     transport = static_cast<TcpTransport*>(face->getTransport());
     receivedPackets = &static_cast<DummyLinkService*>(face->getLinkService())->receivedPackets;
 
@@ -114,6 +115,7 @@ protected:
   tcp::endpoint localEp;
   tcp::socket remoteSocket{g_io};
   std::vector<RxPacket>* receivedPackets = nullptr;
+  bool wantZeroCopyReceive = false;
 
 private:
   tcp::acceptor acceptor{g_io};
@@ -60,6 +60,55 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(DefaultMtu, F, AddressFamilies)
   }
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(SharedSockets, F, AddressFamilies)
+{
+  auto address = getTestIp(F::value, AddressScope::Loopback);
+  SKIP_IF_IP_UNAVAILABLE(address);
+
+  this->listenerEp = udp::Endpoint(address, 7030);
+  this->listenerChannel = std::make_shared<UdpChannel>(this->listenerEp, 2_s, false,
+                                                       ndn::MAX_NDN_PACKET_SIZE, 4, 2);
+  this->listenerChannel->listen(
+    [this] (const shared_ptr<Face>& newFace) {
+      BOOST_REQUIRE(newFace != nullptr);
+      BOOST_CHECK_EQUAL(newFace->getLocalUri(), FaceUri(this->listenerEp));
+      this->listenerFaces.push_back(newFace);
+      this->limitedIo.afterOp();
+    },
+    &UdpChannelFixture::unexpectedFailure);
+  BOOST_CHECK_EQUAL(this->listenerChannel->isListening(), true);
+
+  auto ch1 = this->makeChannel(typename IpAddressFromFamily<F::value>::type());
+  auto ch2 = this->makeChannel(typename IpAddressFromFamily<F::value>::type());
+  this->connect(*ch1);
+  this->connect(*ch2);
+
+  // two client faces created, and two listener faces created by their first datagrams
+  BOOST_CHECK_EQUAL(this->limitedIo.run(4, 2_s), LimitedIo::EXCEED_OPS);
+  BOOST_CHECK_EQUAL(this->listenerChannel->size(), 2);
+  BOOST_REQUIRE_EQUAL(this->listenerFaces.size(), 2);
+  BOOST_REQUIRE_EQUAL(this->clientFaces.size(), 2);
+
+  // further datagrams from the same peers are dispatched to the existing faces
+  for (const auto& face : this->clientFaces) {
+    face->getTransport()->send(ndn::encoding::makeStringBlock(300, "again"));
+  }
+  this->limitedIo.defer(200_ms);
+  BOOST_CHECK_EQUAL(this->listenerChannel->size(), 2);
+  for (const auto& face : this->listenerFaces) {
+    BOOST_CHECK_EQUAL(face->getTransport()->getCounters().nInPackets, 2);
+  }
+
+  // replies reach the peer of each face
+  for (const auto& face : this->listenerFaces) {
+    face->getTransport()->send(ndn::encoding::makeStringBlock(300, "world"));
+  }
+  this->limitedIo.defer(200_ms);
+  for (const auto& face : this->clientFaces) {
+    BOOST_CHECK_EQUAL(face->getTransport()->getCounters().nInPackets, 1);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestUdpChannel
 BOOST_AUTO_TEST_SUITE_END() // Face
 
@@ -44,7 +44,9 @@ class UnicastUdpTransportFixture : public GlobalIoFixture
 protected:
   void
   initialize(ip::address address,
-             ndn::nfd::FacePersistency persistency = ndn::nfd::FACE_PERSISTENCY_PERSISTENT)
+             ndn::nfd::FacePersistency persistency = ndn::nfd::FACE_PERSISTENCY_PERSISTENT,
+             size_t batchSize = 1,
+             bool wantSegmentationOffload = false)
   {
     udp::socket sock(g_io);
     sock.connect(udp::endpoint(address, 7070));
@@ -53,7 +55,9 @@ protected:
     remoteConnect(address);
 
     face = make_unique<Face>(make_unique<DummyLinkService>(),
-                             make_unique<UnicastUdpTransport>(std::move(sock), persistency, 3_s));
+                             make_unique<UnicastUdpTransport>(std::move(sock), persistency,
+                                                              3_s, batchSize,
+                                                              wantSegmentationOffload));
     transport = static_cast<UnicastUdpTransport*>(face->getTransport());
     receivedPackets = &static_cast<DummyLinkService*>(face->getLinkService())->receivedPackets;
 
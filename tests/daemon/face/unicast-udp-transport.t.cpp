@@ -27,6 +27,9 @@
 
 #include "unicast-udp-transport-fixture.hpp"
 
+#include "face/datagram-buffer-pool.hpp"
+#include "face/io-thread.hpp"
+
 #include <boost/mpl/vector.hpp>
 #include <boost/mpl/vector_c.hpp>
 
@@ -174,6 +177,166 @@ BOOST_FIXTURE_TEST_CASE(RemoteClosePermanent, RemoteCloseFixture)
   BOOST_CHECK_EQUAL(transport->getState(), TransportState::UP);
 }
 
+BOOST_FIXTURE_TEST_CASE(BatchIo, RemoteCloseFixture)
+{
+  TRANSPORT_TEST_INIT(ndn::nfd::FACE_PERSISTENCY_PERSISTENT, 8);
+
+  // packets sent in the same round are sent together
+  std::vector<Block> sent;
+  for (int i = 0; i < 20; ++i) {
+    sent.push_back(ndn::encoding::makeNonNegativeIntegerBlock(300, i));
+    transport->send(sent.back());
+  }
+  BOOST_CHECK_EQUAL(transport->getCounters().nOutPackets, 20);
+
+  for (const auto& block : sent) {
+    std::vector<uint8_t> readBuf(block.size());
+    remoteRead(readBuf);
+    BOOST_TEST(readBuf == block, boost::test_tools::per_element());
+  }
+
+  // datagrams that arrive together are received in batches
+  for (int i = 0; i < 20; ++i) {
+    Block block = ndn::encoding::makeNonNegativeIntegerBlock(301, i);
+    remoteSocket.send(boost::asio::buffer(block));
+  }
+  limitedIo.defer(1_s);
+  BOOST_CHECK_EQUAL(transport->getCounters().nInPackets, 20);
+  BOOST_REQUIRE_EQUAL(receivedPackets->size(), 20);
+  for (int i = 0; i < 20; ++i) {
+    BOOST_CHECK_EQUAL(receivedPackets->at(i).packet, ndn::encoding::makeNonNegativeIntegerBlock(301, i));
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(SegmentationOffload, RemoteCloseFixture)
+{
+  TRANSPORT_TEST_INIT(ndn::nfd::FACE_PERSISTENCY_PERSISTENT, 1, true);
+
+  // packets of equal size are split back into separate datagrams, whether or not GSO is supported
+  std::vector<Block> sent;
+  for (int i = 0; i < 20; ++i) {
+    sent.push_back(ndn::encoding::makeStringBlock(300, "packet-" + to_string(10 + i)));
+    transport->send(sent.back());
+  }
+  sent.push_back(ndn::encoding::makeStringBlock(300, "last"));
+  transport->send(sent.back());
+  BOOST_CHECK_EQUAL(transport->getCounters().nOutPackets, 21);
+
+  for (const auto& block : sent) {
+    std::vector<uint8_t> readBuf(block.size());
+    remoteRead(readBuf);
+    BOOST_TEST(readBuf == block, boost::test_tools::per_element());
+  }
+
+  // datagrams coalesced by the remote sender are received as separate packets
+  face::DatagramBatchIo<udp> remoteIo(1);
+  remoteIo.enableSegmentationOffload(remoteSocket);
+  std::vector<Block> incoming;
+  for (int i = 0; i < 20; ++i) {
+    incoming.push_back(ndn::encoding::makeStringBlock(301, "packet-" + to_string(10 + i)));
+  }
+  boost::system::error_code error;
+  BOOST_CHECK_EQUAL(remoteIo.send(remoteSocket, incoming, nullptr, error), incoming.size());
+  BOOST_CHECK(!error);
+
+  limitedIo.defer(1_s);
+  BOOST_CHECK_EQUAL(transport->getCounters().nInPackets, 20);
+  BOOST_REQUIRE_EQUAL(receivedPackets->size(), 20);
+  for (int i = 0; i < 20; ++i) {
+    BOOST_CHECK_EQUAL(receivedPackets->at(i).packet, incoming[i]);
+  }
+}
+
+class BufferPoolFixture : public RemoteCloseFixture
+{
+protected:
+  BufferPoolFixture()
+  {
+    DatagramBufferPool::setTransportPoolCapacity(2);
+  }
+
+  ~BufferPoolFixture()
+  {
+    DatagramBufferPool::setTransportPoolCapacity(0);
+  }
+
+  void
+  checkReceivePooled()
+  {
+    std::vector<Block> incoming;
+    for (int i = 0; i < 4; ++i) {
+      incoming.push_back(ndn::encoding::makeStringBlock(300, "packet-" + to_string(i)));
+      remoteWrite(ndn::Buffer(incoming.back().begin(), incoming.back().end()));
+    }
+
+    BOOST_CHECK_EQUAL(transport->getCounters().nInPackets, 4);
+    BOOST_REQUIRE_EQUAL(receivedPackets->size(), 4);
+    for (int i = 0; i < 4; ++i) {
+      const Block& packet = receivedPackets->at(i).packet;
+      BOOST_CHECK_EQUAL(packet, incoming[i]);
+      // the packet refers to the buffer it was received into
+      BOOST_CHECK_EQUAL(packet.getBuffer()->size(), ndn::MAX_NDN_PACKET_SIZE);
+    }
+    // the received packets hold more buffers than the pool has
+    BOOST_CHECK_GT(transport->getCounters().nInPoolHits, 0);
+    BOOST_CHECK_GT(transport->getCounters().nInPoolMisses, 0);
+
+    // a datagram that is not a TLV element is dropped, even if the buffer extends beyond it
+    remoteWrite({0x06, 0x05, 0x01});
+    BOOST_CHECK_EQUAL(transport->getCounters().nInPackets, 4);
+    BOOST_CHECK_EQUAL(transport->getState(), TransportState::UP);
+  }
+};
+
+BOOST_FIXTURE_TEST_CASE(BufferPool, BufferPoolFixture)
+{
+  TRANSPORT_TEST_INIT();
+  checkReceivePooled();
+}
+
+BOOST_FIXTURE_TEST_CASE(BufferPoolBatchIo, BufferPoolFixture)
+{
+  TRANSPORT_TEST_INIT(ndn::nfd::FACE_PERSISTENCY_PERSISTENT, 8);
+  checkReceivePooled();
+}
+
+BOOST_FIXTURE_TEST_CASE(IoThread, RemoteCloseFixture)
+{
+  IoThreadPool pool(1, 16);
+  TRANSPORT_TEST_INIT();
+
+  Block block1 = ndn::encoding::makeStringBlock(300, "hello");
+  transport->send(block1);
+  BOOST_CHECK_EQUAL(transport->getCounters().nOutPackets, 1);
+  BOOST_CHECK_EQUAL(transport->getCounters().nOutRingDrops, 0);
+
+  std::vector<uint8_t> readBuf(block1.size());
+  remoteRead(readBuf);
+  BOOST_TEST(readBuf == block1, boost::test_tools::per_element());
+
+  Block block2 = ndn::encoding::makeStringBlock(301, "world");
+  remoteWrite(ndn::Buffer(block2.begin(), block2.end()));
+  BOOST_CHECK_EQUAL(transport->getCounters().nInPackets, 1);
+  BOOST_CHECK_EQUAL(transport->getCounters().nInBytes, block2.size());
+  BOOST_CHECK_EQUAL(transport->getCounters().nInRingDrops, 0);
+  BOOST_CHECK_EQUAL(transport->getCounters().nInRingDepth, 0);
+  BOOST_REQUIRE_EQUAL(receivedPackets->size(), 1);
+  BOOST_CHECK_EQUAL(receivedPackets->back().packet, block2);
+
+  // a datagram that is not a TLV element is dropped
+  remoteWrite({0x06, 0x05, 0x01});
+  BOOST_CHECK_EQUAL(transport->getCounters().nInPackets, 1);
+  BOOST_CHECK_EQUAL(transport->getState(), TransportState::UP);
+
+  transport->afterStateChange.connect([this] (auto, auto newState) {
+    if (newState == TransportState::CLOSED) {
+      limitedIo.afterOp();
+    }
+  });
+  transport->close();
+  BOOST_REQUIRE_EQUAL(limitedIo.run(1, 1_s), LimitedIo::EXCEED_OPS);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestUnicastUdpTransport
 BOOST_AUTO_TEST_SUITE_END() // Face
 
@@ -112,7 +112,7 @@ protected:
 
     localEp = sock.local_endpoint();
     face = make_unique<Face>(make_unique<DummyLinkService>(),
-                             make_unique<UnixStreamTransport>(std::move(sock)));
+                             make_unique<UnixStreamTransport>(std::move(sock), wantZeroCopyReceive));
     transport = static_cast<UnixStreamTransport*>(face->getTransport());
     receivedPackets = &static_cast<DummyLinkService*>(face->getLinkService())->receivedPackets;
 
@@ -137,6 +137,7 @@ protected:
   unix_stream::endpoint localEp;
   unix_stream::socket remoteSocket;
   std::vector<RxPacket>* receivedPackets;
+  bool wantZeroCopyReceive = false;
 
 private:
   AcceptorWithCleanup acceptor;
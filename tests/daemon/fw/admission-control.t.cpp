@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/admission-control.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+
+namespace nfd::tests {
+
+using namespace nfd::fw;
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_FIXTURE_TEST_SUITE(TestAdmissionControl, GlobalIoTimeFixture)
+
+BOOST_AUTO_TEST_CASE(Disabled)
+{
+  AdmissionControl admission;
+  BOOST_CHECK(!admission.hasRateLimit());
+  BOOST_CHECK(!admission.hasPitQuotas());
+}
+
+BOOST_AUTO_TEST_CASE(TokenBucket)
+{
+  AdmissionControl admission;
+  AdmissionControl::Config config;
+  config.faceInterestRate = 100;
+  config.faceInterestBurst = 5;
+  admission.setConfig(config);
+  BOOST_CHECK(admission.hasRateLimit());
+
+  for (int i = 0; i < 5; ++i) {
+    BOOST_CHECK(admission.consumeToken(300));
+  }
+  BOOST_CHECK(!admission.consumeToken(300));
+  BOOST_CHECK(admission.consumeToken(301));
+
+  advanceClocks(5_ms, 25_ms);
+  BOOST_CHECK(admission.consumeToken(300));
+  BOOST_CHECK(admission.consumeToken(300));
+  BOOST_CHECK(!admission.consumeToken(300));
+
+  // the bucket does not fill beyond the burst size
+  advanceClocks(1_s);
+  for (int i = 0; i < 5; ++i) {
+    BOOST_CHECK(admission.consumeToken(300));
+  }
+  BOOST_CHECK(!admission.consumeToken(300));
+}
+
+BOOST_AUTO_TEST_CASE(PitQuotas)
+{
+  AdmissionControl admission;
+  AdmissionControl::Config config;
+  config.facePitQuota = 3;
+  config.prefixQuotas = {{"/A", 2}, {"/A/B", 1}};
+  admission.setConfig(config);
+  BOOST_CHECK(admission.hasPitQuotas());
+
+  // the longest configured prefix is charged
+  auto c1 = admission.chargePitEntry(300, "/A/B/1");
+  BOOST_CHECK_EQUAL(admission.getPrefixPitUsage("/A/B"), 1);
+  BOOST_CHECK_EQUAL(admission.getPrefixPitUsage("/A"), 0);
+  BOOST_CHECK(!admission.canCreatePitEntry(300, "/A/B/2"));
+  BOOST_CHECK(admission.canCreatePitEntry(300, "/A/C"));
+
+  auto c2 = admission.chargePitEntry(300, "/A/C");
+  auto c3 = admission.chargePitEntry(300, "/Z");
+  BOOST_CHECK_EQUAL(admission.getFacePitUsage(300), 3);
+  BOOST_CHECK(!admission.canCreatePitEntry(300, "/Z"));
+  BOOST_CHECK(admission.canCreatePitEntry(301, "/Z"));
+
+  // usage of a prefix that remains configured is preserved
+  config.prefixQuotas = {{"/A", 5}};
+  admission.setConfig(config);
+  BOOST_CHECK_EQUAL(admission.getPrefixPitUsage("/A"), 1);
+  BOOST_CHECK_EQUAL(admission.getPrefixPitUsage("/A/B"), 0);
+
+  // charges are released when their handles are destroyed, even after the face is gone
+  c2.reset();
+  BOOST_CHECK_EQUAL(admission.getFacePitUsage(300), 2);
+  BOOST_CHECK_EQUAL(admission.getPrefixPitUsage("/A"), 0);
+  admission.removeFace(300);
+  BOOST_CHECK_EQUAL(admission.getFacePitUsage(300), 0);
+  c1.reset();
+  c3.reset();
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestAdmissionControl
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace nfd::tests
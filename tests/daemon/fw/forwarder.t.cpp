@@ -698,6 +698,97 @@ BOOST_AUTO_TEST_CASE(PitLeak) // Bug 3484
   BOOST_CHECK_EQUAL(pit.size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(AdmissionRateLimit)
+{
+  auto face1 = addFace();
+  auto face2 = addFace();
+  auto face3 = addFace();
+  Fib& fib = forwarder.getFib();
+  fib.addOrUpdateNextHop(*fib.insert("/").first, *face3, 0);
+
+  fw::AdmissionControl::Config config;
+  config.faceInterestRate = 10;
+  config.faceInterestBurst = 2;
+  forwarder.getAdmissionControl().setConfig(config);
+
+  for (int i = 0; i < 3; ++i) {
+    face1->receiveInterest(*makeInterest(Name("/A").appendNumber(i)), 0);
+  }
+  BOOST_CHECK_EQUAL(forwarder.getPit().size(), 2);
+  BOOST_CHECK_EQUAL(face1->getCounters().nInInterestsRateLimited, 1);
+  BOOST_REQUIRE_EQUAL(face1->sentNacks.size(), 1);
+  BOOST_CHECK_EQUAL(face1->sentNacks.back().getReason(), lp::NackReason::CONGESTION);
+  BOOST_CHECK_EQUAL(face1->sentNacks.back().getInterest().getName(), Name("/A").appendNumber(2));
+
+  // each face has its own token bucket
+  face2->receiveInterest(*makeInterest("/B"), 0);
+  BOOST_CHECK_EQUAL(forwarder.getPit().size(), 3);
+  BOOST_CHECK_EQUAL(face2->getCounters().nInInterestsRateLimited, 0);
+
+  // the bucket refills at the configured rate
+  this->advanceClocks(10_ms, 150_ms);
+  face1->receiveInterest(*makeInterest("/A/3"), 0);
+  BOOST_CHECK_EQUAL(forwarder.getPit().size(), 4);
+  BOOST_CHECK_EQUAL(face1->getCounters().nInInterestsRateLimited, 1);
+
+  // rejected Interests can be dropped silently
+  config.wantNack = false;
+  forwarder.getAdmissionControl().setConfig(config);
+  face1->receiveInterest(*makeInterest("/A/4"), 0);
+  BOOST_CHECK_EQUAL(face1->getCounters().nInInterestsRateLimited, 2);
+  BOOST_CHECK_EQUAL(face1->sentNacks.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(AdmissionPitQuota)
+{
+  auto face1 = addFace();
+  auto face2 = addFace();
+  auto face3 = addFace();
+  Fib& fib = forwarder.getFib();
+  fib.addOrUpdateNextHop(*fib.insert("/").first, *face3, 0);
+
+  fw::AdmissionControl::Config config;
+  config.facePitQuota = 2;
+  config.prefixQuotas = {{"/P", 1}};
+  auto& admission = forwarder.getAdmissionControl();
+  admission.setConfig(config);
+
+  face1->receiveInterest(*makeInterest("/A/1", false, std::nullopt, 1), 0);
+  face1->receiveInterest(*makeInterest("/A/2"), 0);
+  face1->receiveInterest(*makeInterest("/A/3"), 0);
+  BOOST_CHECK_EQUAL(forwarder.getPit().size(), 2);
+  BOOST_CHECK_EQUAL(admission.getFacePitUsage(face1->getId()), 2);
+  BOOST_CHECK_EQUAL(face1->getCounters().nInInterestsOverQuota, 1);
+  BOOST_REQUIRE_EQUAL(face1->sentNacks.size(), 1);
+  BOOST_CHECK_EQUAL(face1->sentNacks.back().getReason(), lp::NackReason::CONGESTION);
+
+  // an Interest joining an existing PIT entry is admitted
+  face2->receiveInterest(*makeInterest("/A/1", false, std::nullopt, 2), 0);
+  BOOST_CHECK_EQUAL(forwarder.getPit().size(), 2);
+  BOOST_CHECK_EQUAL(face2->getCounters().nInInterestsOverQuota, 0);
+  BOOST_CHECK_EQUAL(admission.getFacePitUsage(face2->getId()), 0);
+
+  // faces have their own quotas, but share prefix quotas
+  face2->receiveInterest(*makeInterest("/P/1"), 0);
+  face1->receiveInterest(*makeInterest("/P/2"), 0);
+  face2->receiveInterest(*makeInterest("/P/3"), 0);
+  BOOST_CHECK_EQUAL(forwarder.getPit().size(), 3);
+  BOOST_CHECK_EQUAL(admission.getPrefixPitUsage("/P"), 1);
+  BOOST_CHECK_EQUAL(face1->getCounters().nInInterestsOverQuota, 2);
+  BOOST_CHECK_EQUAL(face2->getCounters().nInInterestsOverQuota, 1);
+
+  // the charge is released when the PIT entry is erased
+  face3->receiveData(*makeData("/A/1"), 0);
+  face3->receiveData(*makeData("/P/1"), 0);
+  this->advanceClocks(10_ms, 100_ms);
+  BOOST_CHECK_EQUAL(forwarder.getPit().size(), 1);
+  BOOST_CHECK_EQUAL(admission.getFacePitUsage(face1->getId()), 1);
+  BOOST_CHECK_EQUAL(admission.getPrefixPitUsage("/P"), 0);
+  face1->receiveInterest(*makeInterest("/A/3"), 0);
+  BOOST_CHECK_EQUAL(forwarder.getPit().size(), 2);
+  BOOST_CHECK_EQUAL(face1->getCounters().nInInterestsOverQuota, 2);
+}
+
 BOOST_AUTO_TEST_CASE(UnsolicitedData)
 {
   auto face1 = addFace();
@@ -799,6 +890,128 @@ BOOST_AUTO_TEST_CASE(NewNextHop)
   BOOST_TEST(strategy.afterNewNextHopCalls[1] == "/A");
 }
 
+BOOST_AUTO_TEST_SUITE(Batching)
+
+BOOST_AUTO_TEST_CASE(InterestAndData)
+{
+  forwarder.m_config.batchSize = 4;
+  auto face1 = addFace();
+  auto face2 = addFace();
+
+  Fib& fib = forwarder.getFib();
+  fib::Entry* entry = fib.insert("/A").first;
+  fib.addOrUpdateNextHop(*entry, *face2, 0);
+
+  // partial batch is processed after pending I/O events
+  face1->receiveInterest(*makeInterest("/A/1"), 0);
+  face1->receiveInterest(*makeInterest("/A/2"), 0);
+  face1->receiveInterest(*makeInterest("/A/3"), 0);
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nInInterests, 0);
+  BOOST_CHECK_EQUAL(face2->sentInterests.size(), 0);
+  this->advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nInInterests, 3);
+  BOOST_REQUIRE_EQUAL(face2->sentInterests.size(), 3);
+  BOOST_CHECK_EQUAL(face2->sentInterests[0].getName(), "/A/1");
+  BOOST_CHECK_EQUAL(face2->sentInterests[1].getName(), "/A/2");
+  BOOST_CHECK_EQUAL(face2->sentInterests[2].getName(), "/A/3");
+
+  // full batch is processed immediately
+  for (int i = 4; i <= 7; ++i) {
+    face1->receiveInterest(*makeInterest("/A/" + to_string(i)), 0);
+  }
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nInInterests, 7);
+  BOOST_REQUIRE_EQUAL(face2->sentInterests.size(), 7);
+  BOOST_CHECK_EQUAL(face2->sentInterests[6].getName(), "/A/7");
+
+  // Data flushes queued Interests, so that it can satisfy them
+  face1->receiveInterest(*makeInterest("/A/8"), 0);
+  face2->receiveData(*makeData("/A/8"), 0);
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nInInterests, 8);
+  BOOST_CHECK_EQUAL(face2->sentInterests.size(), 8);
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nInData, 0);
+  this->advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nInData, 1);
+  BOOST_REQUIRE_EQUAL(face1->sentData.size(), 1);
+  BOOST_CHECK_EQUAL(face1->sentData[0].getName(), "/A/8");
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nUnsolicitedData, 0);
+}
+
+BOOST_AUTO_TEST_CASE(DropInBatch)
+{
+  forwarder.m_config.batchSize = 8;
+  auto face1 = addFace("dummy://", "dummy://", ndn::nfd::FACE_SCOPE_NON_LOCAL);
+  auto face2 = addFace();
+
+  Fib& fib = forwarder.getFib();
+  fib::Entry* entry = fib.insert("/").first;
+  fib.addOrUpdateNextHop(*entry, *face2, 0);
+
+  auto hopLimitZero = makeInterest("/A/1");
+  hopLimitZero->setHopLimit(0);
+  face1->receiveInterest(*hopLimitZero, 0);
+  face1->receiveInterest(*makeInterest("/localhost/A/2"), 0);
+  face1->receiveInterest(*makeInterest("/A/3"), 0);
+  this->advanceClocks(1_ms);
+
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nInInterests, 3);
+  BOOST_CHECK_EQUAL(face1->getCounters().nInHopLimitZero, 1);
+  BOOST_REQUIRE_EQUAL(face2->sentInterests.size(), 1);
+  BOOST_CHECK_EQUAL(face2->sentInterests[0].getName(), "/A/3");
+}
+
+BOOST_AUTO_TEST_CASE(FlushOnFaceRemoval)
+{
+  forwarder.m_config.batchSize = 8;
+  auto face1 = addFace();
+  auto face2 = addFace();
+
+  Fib& fib = forwarder.getFib();
+  fib::Entry* entry = fib.insert("/A").first;
+  fib.addOrUpdateNextHop(*entry, *face2, 0);
+
+  auto interest = makeInterest("/A/1");
+  face1->receiveInterest(*interest, 0);
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nInInterests, 0);
+
+  // queued Interest is processed before PIT entries are cleaned up, so that no in-record
+  // refers to the removed face
+  face1->close();
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nInInterests, 1);
+  BOOST_CHECK_EQUAL(face2->sentInterests.size(), 1);
+  auto pitEntry = forwarder.getPit().find(*interest);
+  BOOST_REQUIRE(pitEntry != nullptr);
+  BOOST_CHECK(!pitEntry->hasInRecords());
+
+  this->advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nInInterests, 1);
+}
+
+BOOST_AUTO_TEST_CASE(UnsharedPackets)
+{
+  forwarder.m_config.batchSize = 4;
+  auto face1 = addFace();
+  auto face2 = addFace();
+
+  Fib& fib = forwarder.getFib();
+  fib::Entry* entry = fib.insert("/A").first;
+  fib.addOrUpdateNextHop(*entry, *face2, 0);
+
+  // packets not owned by a shared_ptr are copied into the batch
+  Interest interest(*makeInterest("/A/1"));
+  face1->receiveInterest(interest, 0);
+  this->advanceClocks(1_ms);
+  BOOST_REQUIRE_EQUAL(face2->sentInterests.size(), 1);
+
+  Data data(*makeData("/A/1"));
+  face2->receiveData(data, 0);
+  this->advanceClocks(1_ms);
+  BOOST_REQUIRE_EQUAL(face1->sentData.size(), 1);
+  BOOST_CHECK_EQUAL(face1->sentData[0].getName(), "/A/1");
+  BOOST_CHECK_EQUAL(forwarder.getCs().size(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // Batching
+
 BOOST_AUTO_TEST_SUITE(ProcessConfig)
 
 BOOST_AUTO_TEST_CASE(DefaultHopLimit)
@@ -875,6 +1088,99 @@ BOOST_AUTO_TEST_CASE(BadDefaultHopLimit)
   BOOST_CHECK_THROW(cf.parse(config, false, "dummy-config"), ConfigFile::Error);
 }
 
+BOOST_AUTO_TEST_CASE(BatchSize)
+{
+  ConfigFile cf;
+  forwarder.setConfigFile(cf);
+
+  std::string config = R"CONFIG(
+    forwarder
+    {
+      batch_size 32
+    }
+  )CONFIG";
+
+  BOOST_TEST(forwarder.m_config.batchSize == 1);
+
+  cf.parse(config, true, "dummy-config");
+  BOOST_TEST(forwarder.m_config.batchSize == 1);
+
+  cf.parse(config, false, "dummy-config");
+  BOOST_TEST(forwarder.m_config.batchSize == 32);
+
+  config = R"CONFIG(
+    forwarder
+    {
+    }
+  )CONFIG";
+
+  cf.parse(config, false, "dummy-config");
+  BOOST_TEST(forwarder.m_config.batchSize == 1);
+}
+
+BOOST_AUTO_TEST_CASE(BadBatchSize)
+{
+  ConfigFile cf;
+  forwarder.setConfigFile(cf);
+
+  for (const auto& value : {"hello", "-1", "0", "257"}) {
+    BOOST_TEST_CONTEXT(value) {
+      std::string config = "forwarder\n{\n  batch_size "s + value + "\n}\n";
+      BOOST_CHECK_THROW(cf.parse(config, true, "dummy-config"), ConfigFile::Error);
+      BOOST_CHECK_THROW(cf.parse(config, false, "dummy-config"), ConfigFile::Error);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Admission)
+{
+  ConfigFile cf;
+  forwarder.setConfigFile(cf);
+
+  std::string config = R"CONFIG(
+    forwarder
+    {
+      admission
+      {
+        face_pit_quota 1000
+        face_interest_rate 500
+        face_interest_burst 50
+        reject drop
+        prefix /example
+        {
+          pit_quota 200
+        }
+      }
+    }
+  )CONFIG";
+
+  const auto& admission = forwarder.getAdmissionControl().getConfig();
+  cf.parse(config, true, "dummy-config");
+  BOOST_TEST(admission.facePitQuota == 0);
+
+  cf.parse(config, false, "dummy-config");
+  BOOST_TEST(admission.facePitQuota == 1000);
+  BOOST_TEST(admission.faceInterestRate == 500);
+  BOOST_TEST(admission.faceInterestBurst == 50);
+  BOOST_TEST(admission.wantNack == false);
+  BOOST_TEST_REQUIRE(admission.prefixQuotas.size() == 1);
+  BOOST_TEST(admission.prefixQuotas[0].prefix == "/example");
+  BOOST_TEST(admission.prefixQuotas[0].pitQuota == 200);
+
+  cf.parse("forwarder\n{\n}\n", false, "dummy-config");
+  BOOST_TEST(admission.facePitQuota == 0);
+  BOOST_TEST(admission.wantNack == true);
+  BOOST_TEST(admission.prefixQuotas.empty());
+
+  for (const auto& section : {"reject maybe", "face_pit_quota -1", "face_interest_burst 0",
+                              "prefix /example", "prefix /example\n{\n  weight 1\n}"}) {
+    BOOST_TEST_CONTEXT(section) {
+      config = "forwarder\n{\n  admission\n  {\n  "s + section + "\n  }\n}\n";
+      BOOST_CHECK_THROW(cf.parse(config, true, "dummy-config"), ConfigFile::Error);
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END() // ProcessConfig
 
 BOOST_AUTO_TEST_SUITE_END() // TestForwarder
@@ -0,0 +1,292 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/sharded-forwarder.hpp"
+#include "fw/forwarder.hpp"
+#include "fw/multicast-strategy.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+
+#include <chrono>
+#include <set>
+#include <thread>
+
+namespace nfd::tests {
+
+class ShardedForwarderFixture : public GlobalIoFixture
+{
+protected:
+  shared_ptr<DummyFace>
+  addFace()
+  {
+    auto face = make_shared<DummyFace>();
+    faceTable.add(face);
+    return face;
+  }
+
+  /** \brief poll the main thread until \p predicate holds, while forwarding threads run
+   *  \return whether \p predicate holds before the timeout
+   */
+  template<typename Predicate>
+  bool
+  waitUntil(const Predicate& predicate)
+  {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!predicate()) {
+      if (std::chrono::steady_clock::now() > deadline) {
+        return false;
+      }
+      pollIo();
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+  }
+
+protected:
+  FaceTable faceTable;
+  Forwarder forwarder{faceTable};
+  ShardedForwarder::Options options;
+};
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_FIXTURE_TEST_SUITE(TestShardedForwarder, ShardedForwarderFixture)
+
+BOOST_AUTO_TEST_CASE(SimpleExchange)
+{
+  auto face1 = addFace();
+  auto face2 = addFace();
+  fib::Entry* entry = forwarder.getFib().insert("/A").first;
+  forwarder.getFib().addOrUpdateNextHop(*entry, *face2, 0);
+
+  ShardedForwarder sharded(faceTable, forwarder, options);
+  BOOST_CHECK_EQUAL(sharded.getNShards(), 2);
+
+  face1->receiveInterest(*makeInterest("/A/B/c", false, 4_s), 0);
+  BOOST_REQUIRE(waitUntil([&] { return face2->sentInterests.size() == 1; }));
+  BOOST_CHECK_EQUAL(face2->sentInterests[0].getName(), "/A/B/c");
+
+  face2->receiveData(*makeData("/A/B/c"), 0);
+  BOOST_REQUIRE(waitUntil([&] { return face1->sentData.size() == 1; }));
+  BOOST_CHECK_EQUAL(face1->sentData[0].getName(), "/A/B/c");
+
+  // packets are not processed by the main Forwarder
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nInInterests, 0);
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nInData, 0);
+  BOOST_CHECK_EQUAL(forwarder.getPit().size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ReplicateNextHops)
+{
+  auto face1 = addFace();
+  auto face2 = addFace();
+  ShardedForwarder sharded(faceTable, forwarder, options);
+
+  // face and route added after the threads have started
+  auto face3 = addFace();
+  fib::Entry* entry = forwarder.getFib().insert("/A").first;
+  forwarder.getFib().addOrUpdateNextHop(*entry, *face3, 0);
+
+  face1->receiveInterest(*makeInterest("/A/B/c", false, 4_s), 0);
+  BOOST_REQUIRE(waitUntil([&] { return face3->sentInterests.size() == 1; }));
+
+  // lower cost nexthop
+  forwarder.getFib().addOrUpdateNextHop(*entry, *face2, 10);
+  forwarder.getFib().addOrUpdateNextHop(*entry, *face3, 20);
+  face1->receiveInterest(*makeInterest("/A/B/d", false, 4_s), 0);
+  BOOST_REQUIRE(waitUntil([&] { return face2->sentInterests.size() == 1; }));
+  BOOST_CHECK_EQUAL(face3->sentInterests.size(), 1);
+
+  // no route
+  forwarder.getFib().removeNextHop(*entry, *face2);
+  entry = forwarder.getFib().findExactMatch("/A");
+  BOOST_REQUIRE(entry != nullptr);
+  forwarder.getFib().removeNextHop(*entry, *face3);
+  face1->receiveInterest(*makeInterest("/A/B/e", false, 4_s), 0);
+  BOOST_REQUIRE(waitUntil([&] { return face1->sentNacks.size() == 1; }));
+  BOOST_CHECK_EQUAL(face1->sentNacks[0].getReason(), lp::NackReason::NO_ROUTE);
+  BOOST_CHECK_EQUAL(face2->sentInterests.size(), 1);
+  BOOST_CHECK_EQUAL(face3->sentInterests.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(ReplicateStrategyChoice)
+{
+  auto face1 = addFace();
+  auto face2 = addFace();
+  auto face3 = addFace();
+  fib::Entry* entry = forwarder.getFib().insert("/A").first;
+  forwarder.getFib().addOrUpdateNextHop(*entry, *face2, 10);
+  forwarder.getFib().addOrUpdateNextHop(*entry, *face3, 20);
+  ShardedForwarder sharded(faceTable, forwarder, options);
+
+  BOOST_REQUIRE(forwarder.getStrategyChoice().insert("/A", fw::MulticastStrategy::getStrategyName()));
+  face1->receiveInterest(*makeInterest("/A/B/c", false, 4_s), 0);
+  BOOST_REQUIRE(waitUntil([&] {
+    return face2->sentInterests.size() == 1 && face3->sentInterests.size() == 1;
+  }));
+
+  forwarder.getStrategyChoice().erase("/A");
+  face1->receiveInterest(*makeInterest("/A/B/d", false, 4_s), 0);
+  BOOST_REQUIRE(waitUntil([&] { return face2->sentInterests.size() == 2; }));
+  // give a multicast strategy the chance to send on face3 as well
+  pollIo();
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  pollIo();
+  BOOST_CHECK_EQUAL(face3->sentInterests.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(RemoveFace)
+{
+  auto face1 = addFace();
+  auto face2 = addFace();
+  fib::Entry* entry = forwarder.getFib().insert("/A").first;
+  forwarder.getFib().addOrUpdateNextHop(*entry, *face2, 0);
+  ShardedForwarder sharded(faceTable, forwarder, options);
+
+  face2->close();
+  pollIo();
+  BOOST_CHECK(faceTable.get(face2->getId()) == nullptr);
+
+  face1->receiveInterest(*makeInterest("/A/B/c", false, 4_s), 0);
+  BOOST_REQUIRE(waitUntil([&] { return face1->sentNacks.size() == 1; }));
+  BOOST_CHECK_EQUAL(face1->sentNacks[0].getReason(), lp::NackReason::NO_ROUTE);
+}
+
+BOOST_AUTO_TEST_CASE(CanBePrefixShortName)
+{
+  auto face1 = addFace();
+  auto face2 = addFace();
+  auto face3 = addFace();
+  fib::Entry* entry = forwarder.getFib().insert("/").first;
+  forwarder.getFib().addOrUpdateNextHop(*entry, *face2, 0);
+  ShardedForwarder sharded(faceTable, forwarder, options);
+
+  // an Interest name shorter than the shard prefix length, on another shard than the Data
+  Name prefix;
+  for (int i = 0; prefix.empty(); ++i) {
+    Name candidate = Name().appendNumber(i);
+    if (sharded.getShardIndex(candidate) != sharded.getShardIndex(Name(candidate).append("y"))) {
+      prefix = candidate;
+    }
+  }
+  Name dataName = Name(prefix).append("y").append("z");
+
+  face1->receiveInterest(*makeInterest(prefix, true, 4_s), 0);
+  BOOST_REQUIRE(waitUntil([&] { return face2->sentInterests.size() == 1; }));
+
+  face2->receiveData(*makeData(dataName), 0);
+  BOOST_REQUIRE(waitUntil([&] { return face1->sentData.size() == 1; }));
+  BOOST_CHECK_EQUAL(face1->sentData[0].getName(), dataName);
+
+  // satisfied from the CS of the shard of the Interest
+  face3->receiveInterest(*makeInterest(prefix, true, 4_s), 0);
+  BOOST_REQUIRE(waitUntil([&] { return face3->sentData.size() == 1; }));
+  BOOST_CHECK_EQUAL(face3->sentData[0].getName(), dataName);
+  BOOST_CHECK_EQUAL(face2->sentInterests.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(CollectCounters)
+{
+  auto face1 = addFace();
+  auto face2 = addFace();
+  fib::Entry* entry = forwarder.getFib().insert("/A").first;
+  forwarder.getFib().addOrUpdateNextHop(*entry, *face2, 0);
+  ShardedForwarder sharded(faceTable, forwarder, options);
+
+  face1->receiveInterest(*makeInterest("/A/B/c", false, 4_s), 0);
+  BOOST_REQUIRE(waitUntil([&] { return face2->sentInterests.size() == 1; }));
+  face2->receiveData(*makeData("/A/B/c"), 0);
+  BOOST_REQUIRE(waitUntil([&] { return face1->sentData.size() == 1; }));
+
+  auto interest = makeInterest("/A/D/e", false, 4_s);
+  interest->setHopLimit(0);
+  face1->receiveInterest(*interest, 0);
+
+  auto status = sharded.collectStatus();
+  BOOST_CHECK_EQUAL(status.nInInterests, 2);
+  BOOST_CHECK_EQUAL(status.nOutInterests, 1);
+  BOOST_CHECK_EQUAL(status.nInData, 1);
+  BOOST_CHECK_EQUAL(status.nOutData, 1);
+  BOOST_CHECK_EQUAL(status.nCsEntries, 1);
+
+  BOOST_CHECK_EQUAL(face1->getCounters().nInHopLimitZero, 0);
+  sharded.collectFaceCounters();
+  BOOST_CHECK_EQUAL(face1->getCounters().nInHopLimitZero, 1);
+  BOOST_CHECK_EQUAL(face2->getCounters().nInHopLimitZero, 0);
+}
+
+BOOST_AUTO_TEST_CASE(EraseCs)
+{
+  auto face1 = addFace();
+  auto face2 = addFace();
+  fib::Entry* entry = forwarder.getFib().insert("/A").first;
+  forwarder.getFib().addOrUpdateNextHop(*entry, *face2, 0);
+  ShardedForwarder sharded(faceTable, forwarder, options);
+
+  for (int i = 0; i < 8; ++i) {
+    face1->receiveInterest(*makeInterest(Name("/A").appendNumber(i).append("x"), false, 4_s), 0);
+  }
+  BOOST_REQUIRE(waitUntil([&] { return face2->sentInterests.size() == 8; }));
+  for (int i = 0; i < 8; ++i) {
+    face2->receiveData(*makeData(Name("/A").appendNumber(i).append("x")), 0);
+  }
+  BOOST_REQUIRE(waitUntil([&] { return face1->sentData.size() == 8; }));
+  BOOST_CHECK_EQUAL(sharded.collectStatus().nCsEntries, 8);
+  BOOST_CHECK_EQUAL(forwarder.getCs().size(), 0);
+
+  auto [nErased, hasMore] = sharded.eraseCs("/A", 5);
+  BOOST_CHECK_EQUAL(nErased, 5);
+  BOOST_CHECK_EQUAL(hasMore, true);
+  BOOST_CHECK_EQUAL(sharded.collectStatus().nCsEntries, 3);
+
+  std::tie(nErased, hasMore) = sharded.eraseCs("/A", 5);
+  BOOST_CHECK_EQUAL(nErased, 3);
+  BOOST_CHECK_EQUAL(hasMore, false);
+  BOOST_CHECK_EQUAL(sharded.collectStatus().nCsEntries, 0);
+}
+
+BOOST_AUTO_TEST_CASE(ShardIndex)
+{
+  options.nShards = 8;
+  ShardedForwarder sharded(faceTable, forwarder, options);
+
+  // names that share the first two components are processed by the same shard
+  BOOST_CHECK_EQUAL(sharded.getShardIndex("/A/B"), sharded.getShardIndex("/A/B/c"));
+  BOOST_CHECK_EQUAL(sharded.getShardIndex("/A/B/c"), sharded.getShardIndex("/A/B/d/e"));
+
+  std::set<size_t> indices;
+  for (int i = 0; i < 100; ++i) {
+    size_t index = sharded.getShardIndex(Name("/P").appendNumber(i).append("x"));
+    BOOST_CHECK_LT(index, 8);
+    indices.insert(index);
+  }
+  BOOST_CHECK_EQUAL(indices.size(), 8);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestShardedForwarder
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace nfd::tests
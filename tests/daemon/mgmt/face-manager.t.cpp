@@ -151,6 +151,61 @@ BOOST_AUTO_TEST_CASE(NonExisting)
 
 BOOST_AUTO_TEST_SUITE_END() // DestroyFace
 
+BOOST_AUTO_TEST_SUITE(CreateFace)
+
+/** \brief creates non-local DummyFaces for udp4 FaceUris
+ */
+class NonLocalFaceFactory : public face::ProtocolFactory
+{
+public:
+  using ProtocolFactory::ProtocolFactory;
+
+private:
+  void
+  doProcessConfig(OptionalConfigSection, FaceSystem::ConfigContext&) final
+  {
+    providedSchemes = {"udp4"};
+  }
+
+  void
+  doCreateFace(const CreateFaceRequest& req, const face::FaceCreatedCallback& onCreated,
+               const face::FaceCreationFailedCallback&) final
+  {
+    onCreated(make_shared<DummyFace>("udp4://192.0.2.1:6363", req.remoteUri.toString()));
+  }
+};
+
+BOOST_AUTO_TEST_CASE(EgressScheduler)
+{
+  m_faceSystem.m_factories["test"] = make_unique<NonLocalFaceFactory>(m_faceSystem.makePFCtorParams());
+
+  const std::string config = R"CONFIG(
+    face_system
+    {
+      egress
+      {
+        rate 125000
+      }
+    }
+  )CONFIG";
+  ConfigFile cf;
+  m_faceSystem.setConfigFile(cf);
+  cf.parse(config, false, "dummy-config");
+
+  auto parameters = ControlParameters()
+                      .setUri("udp4://192.0.2.2:6363")
+                      .setFacePersistency(ndn::nfd::FACE_PERSISTENCY_PERSISTENT);
+  receiveInterest(makeControlCommandRequest("/localhost/nfd/faces/create", parameters));
+
+  auto face = std::find_if(m_faceTable.begin(), m_faceTable.end(), [] (const Face& f) {
+    return f.getRemoteUri() == FaceUri("udp4://192.0.2.2:6363");
+  });
+  BOOST_REQUIRE(face != m_faceTable.end());
+  BOOST_CHECK(face->getLinkService()->getEgressScheduler() != nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // CreateFace
+
 BOOST_AUTO_TEST_SUITE(Datasets)
 
 BOOST_AUTO_TEST_CASE(FaceDataset)
@@ -67,10 +67,10 @@ BOOST_AUTO_TEST_CASE(GeneralStatusDataset)
   m_forwarder.getCs().insert(*makeData("ndn:/cs2"));
   shared_ptr<pit::Entry> pitA = m_forwarder.getPit().insert(*makeInterest("ndn:/pitA")).first;
   pitA->isSatisfied = false;
-  m_forwarder.onInterestFinalize(pitA);
+  m_forwarder.onInterestFinalize(*pitA);
   shared_ptr<pit::Entry> pitB = m_forwarder.getPit().insert(*makeInterest("ndn:/pitB")).first;
   pitB->isSatisfied = true;
-  m_forwarder.onInterestFinalize(pitB);
+  m_forwarder.onInterestFinalize(*pitB);
 
   BOOST_CHECK_GE(m_forwarder.getFib().size(), 1);
   BOOST_CHECK_GE(m_forwarder.getPit().size(), 4);
@@ -25,7 +25,9 @@
 
 #include "mgmt/general-config-section.hpp"
 #include "common/config-file.hpp"
+#include "common/global.hpp"
 #include "common/privilege-helper.hpp"
+#include "common/timer-wheel.hpp"
 
 #include "tests/test-common.hpp"
 #include "tests/daemon/global-io-fixture.hpp"
@@ -156,6 +158,96 @@ BOOST_AUTO_TEST_CASE(InvalidGroupConfig)
                         });
 }
 
+BOOST_AUTO_TEST_CASE(TimerGranularity)
+{
+  const std::string CONFIG1 = R"CONFIG(
+    general
+    {
+      timer_granularity 10
+    }
+  )CONFIG";
+
+  configFile.parse(CONFIG1, true, "test-general-config-section");
+  BOOST_CHECK_EQUAL(getTimerWheel().getGranularity(), TimerWheel::DEFAULT_GRANULARITY);
+  configFile.parse(CONFIG1, false, "test-general-config-section");
+  BOOST_CHECK_EQUAL(getTimerWheel().getGranularity(), 10_ms);
+
+  const std::string CONFIG2 = R"CONFIG(
+    general
+    {
+    }
+  )CONFIG";
+
+  configFile.parse(CONFIG2, false, "test-general-config-section");
+  BOOST_CHECK_EQUAL(getTimerWheel().getGranularity(), TimerWheel::DEFAULT_GRANULARITY);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidTimerGranularity)
+{
+  const std::string CONFIG1 = R"CONFIG(
+    general
+    {
+      timer_granularity 0
+    }
+  )CONFIG";
+  BOOST_CHECK_THROW(configFile.parse(CONFIG1, true, "test-general-config-section"), ConfigFile::Error);
+
+  const std::string CONFIG2 = R"CONFIG(
+    general
+    {
+      timer_granularity 1001
+    }
+  )CONFIG";
+  BOOST_CHECK_THROW(configFile.parse(CONFIG2, true, "test-general-config-section"), ConfigFile::Error);
+
+  const std::string CONFIG3 = R"CONFIG(
+    general
+    {
+      timer_granularity fast
+    }
+  )CONFIG";
+  BOOST_CHECK_THROW(configFile.parse(CONFIG3, true, "test-general-config-section"), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_CASE(ForwardingThreads)
+{
+  const std::string CONFIG = R"CONFIG(
+    general
+    {
+      forwarding_threads 4
+      shard_prefix_length 3
+    }
+  )CONFIG";
+
+  ConfigFile config;
+  general::StartupOptions options;
+  general::setConfigFile(config, &options);
+
+  config.parse(CONFIG, true, "test-general-config-section");
+  BOOST_CHECK_EQUAL(options.nForwardingThreads, 1);
+  BOOST_CHECK_EQUAL(options.shardPrefixLength, 2);
+
+  config.parse(CONFIG, false, "test-general-config-section");
+  BOOST_CHECK_EQUAL(options.nForwardingThreads, 4);
+  BOOST_CHECK_EQUAL(options.shardPrefixLength, 3);
+
+  // without StartupOptions, the options are validated but ignored
+  BOOST_CHECK_NO_THROW(configFile.parse(CONFIG, false, "test-general-config-section"));
+}
+
+BOOST_AUTO_TEST_CASE(InvalidForwardingThreads)
+{
+  for (const std::string value : {"0", "65", "-1", "many"}) {
+    const std::string CONFIG = "general\n{\n  forwarding_threads " + value + "\n}\n";
+    BOOST_CHECK_THROW(configFile.parse(CONFIG, true, "test-general-config-section"), ConfigFile::Error);
+  }
+
+  for (const std::string value : {"0", "9", "-1"}) {
+    const std::string CONFIG = "general\n{\n  shard_prefix_length " + value + "\n}\n";
+    BOOST_CHECK_THROW(configFile.parse(CONFIG, true, "test-general-config-section"), ConfigFile::Error);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestGeneralConfigSection
 BOOST_AUTO_TEST_SUITE_END() // Mgmt
 
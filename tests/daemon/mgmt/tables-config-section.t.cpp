@@ -199,6 +199,135 @@ BOOST_AUTO_TEST_CASE(Unknown)
 
 BOOST_AUTO_TEST_SUITE_END() // CsPolicy
 
+BOOST_AUTO_TEST_SUITE(NameTreeHashtable)
+
+BOOST_AUTO_TEST_CASE(Default)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+    }
+  )CONFIG";
+
+  forwarder.getNameTree().setHashtableLayout(name_tree::HashtableLayout::OPEN_ADDRESSING);
+  runConfig(CONFIG, false);
+  BOOST_CHECK_EQUAL(forwarder.getNameTree().getHashtableLayout(), name_tree::HashtableLayout::CHAINED);
+}
+
+BOOST_AUTO_TEST_CASE(Known)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      name_tree_hashtable open-addressing
+    }
+  )CONFIG";
+
+  runConfig(CONFIG, true);
+  BOOST_CHECK_EQUAL(forwarder.getNameTree().getHashtableLayout(), name_tree::HashtableLayout::CHAINED);
+
+  runConfig(CONFIG, false);
+  BOOST_CHECK_EQUAL(forwarder.getNameTree().getHashtableLayout(),
+                    name_tree::HashtableLayout::OPEN_ADDRESSING);
+}
+
+BOOST_AUTO_TEST_CASE(Unknown)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      name_tree_hashtable unknown
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG, false), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_CASE(HashAlgorithm)
+{
+  const std::string CONFIG1 = R"CONFIG(
+    tables
+    {
+      name_tree_hash wyhash
+    }
+  )CONFIG";
+
+  runConfig(CONFIG1, true);
+  BOOST_CHECK_EQUAL(forwarder.getNameTree().getHashAlgorithm(), name_tree::DEFAULT_HASH_ALGORITHM);
+
+  runConfig(CONFIG1, false);
+  BOOST_CHECK_EQUAL(forwarder.getNameTree().getHashAlgorithm(), name_tree::HashAlgorithm::WYHASH);
+
+  const std::string CONFIG2 = R"CONFIG(
+    tables
+    {
+      name_tree_hash cityhash
+    }
+  )CONFIG";
+
+  runConfig(CONFIG2, false);
+  BOOST_CHECK_EQUAL(forwarder.getNameTree().getHashAlgorithm(), name_tree::HashAlgorithm::CITYHASH);
+
+  const std::string CONFIG3 = R"CONFIG(
+    tables
+    {
+    }
+  )CONFIG";
+
+  runConfig(CONFIG3, false);
+  BOOST_CHECK_EQUAL(forwarder.getNameTree().getHashAlgorithm(), name_tree::DEFAULT_HASH_ALGORITHM);
+
+  const std::string CONFIG4 = R"CONFIG(
+    tables
+    {
+      name_tree_hash md5
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG4, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG4, false), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_CASE(ResizePolicy)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      name_tree_resize_step 64
+      name_tree_shrink_delay 1.5
+    }
+  )CONFIG";
+
+  BOOST_CHECK_NO_THROW(runConfig(CONFIG, true));
+  BOOST_CHECK_NO_THROW(runConfig(CONFIG, false));
+}
+
+BOOST_AUTO_TEST_CASE(InvalidResizePolicy)
+{
+  const std::string CONFIG1 = R"CONFIG(
+    tables
+    {
+      name_tree_resize_step -1
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG1, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG1, false), ConfigFile::Error);
+
+  const std::string CONFIG2 = R"CONFIG(
+    tables
+    {
+      name_tree_shrink_delay -0.5
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG2, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG2, false), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // NameTreeHashtable
+
 class CsUnsolicitedPolicyFixture : public TablesConfigSectionFixture
 {
 protected:
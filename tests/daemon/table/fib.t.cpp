@@ -50,6 +50,8 @@ BOOST_AUTO_TEST_CASE(FibEntry)
   Face* expectedFace = nullptr;
   uint64_t expectedCost = 0;
   size_t nNewNextHopSignals = 0;
+  size_t nUpdateNextHopSignals = 0;
+  std::vector<const Face*> removedNextHops;
 
   fib.afterNewNextHop.connect(
     [&] (const Name& prefix1, const NextHop& nextHop) {
@@ -58,6 +60,18 @@ BOOST_AUTO_TEST_CASE(FibEntry)
       BOOST_CHECK_EQUAL(&nextHop.getFace(), expectedFace);
       BOOST_CHECK_EQUAL(nextHop.getCost(), expectedCost);
     });
+  fib.afterUpdateNextHop.connect(
+    [&] (const Name& prefix1, const NextHop& nextHop) {
+      ++nUpdateNextHopSignals;
+      BOOST_CHECK_EQUAL(prefix1, prefix);
+      BOOST_CHECK_EQUAL(&nextHop.getFace(), expectedFace);
+      BOOST_CHECK_EQUAL(nextHop.getCost(), expectedCost);
+    });
+  fib.afterRemoveNextHop.connect(
+    [&] (const Name& prefix1, const Face& face) {
+      BOOST_CHECK_EQUAL(prefix1, prefix);
+      removedNextHops.push_back(&face);
+    });
 
   Entry& entry = *fib.insert(prefix).first;
 
@@ -76,12 +90,15 @@ BOOST_AUTO_TEST_CASE(FibEntry)
   BOOST_CHECK_EQUAL(entry.getNextHops().begin()->getCost(), 20);
   BOOST_CHECK_EQUAL(nNewNextHopSignals, 1);
 
+  expectedCost = 30;
+
   fib.addOrUpdateNextHop(entry, *face1, 30);
   // [(face1,30)]
   BOOST_CHECK_EQUAL(entry.getNextHops().size(), 1);
   BOOST_CHECK_EQUAL(&entry.getNextHops().begin()->getFace(), face1.get());
   BOOST_CHECK_EQUAL(entry.getNextHops().begin()->getCost(), 30);
   BOOST_CHECK_EQUAL(nNewNextHopSignals, 1);
+  BOOST_CHECK_EQUAL(nUpdateNextHopSignals, 1);
 
   expectedFace = face2.get();
   expectedCost = 40;
@@ -106,6 +123,8 @@ BOOST_AUTO_TEST_CASE(FibEntry)
     BOOST_CHECK_EQUAL(nNewNextHopSignals, 2);
   }
 
+  expectedCost = 10;
+
   fib.addOrUpdateNextHop(entry, *face2, 10);
   // [(face2,10), (face1,30)]
   BOOST_CHECK_EQUAL(entry.getNextHops().size(), 2);
@@ -124,6 +143,7 @@ BOOST_AUTO_TEST_CASE(FibEntry)
     BOOST_CHECK(it == entry.getNextHops().end());
 
     BOOST_CHECK_EQUAL(nNewNextHopSignals, 2);
+    BOOST_CHECK_EQUAL(nUpdateNextHopSignals, 2);
   }
 
   Fib::RemoveNextHopResult status = fib.removeNextHop(entry, *face1);
@@ -144,6 +164,8 @@ BOOST_AUTO_TEST_CASE(FibEntry)
   // []
   BOOST_CHECK(status == Fib::RemoveNextHopResult::FIB_ENTRY_REMOVED);
   BOOST_CHECK(fib.findExactMatch(prefix) == nullptr);
+
+  BOOST_CHECK(removedNextHops == std::vector<const Face*>({face1.get(), face2.get()}));
 }
 
 BOOST_AUTO_TEST_CASE(Insert_LongestPrefixMatch)
@@ -30,6 +30,8 @@
 
 #include <unordered_set>
 
+#include <boost/mpl/vector.hpp>
+
 namespace nfd::tests {
 
 using namespace nfd::name_tree;
@@ -53,13 +55,71 @@ BOOST_AUTO_TEST_CASE(ComputeHash)
   BOOST_CHECK_EQUAL(hashes.size(), 3);
 }
 
+using HashAlgorithms = boost::mpl::vector<
+  std::integral_constant<HashAlgorithm, HashAlgorithm::CITYHASH>,
+  std::integral_constant<HashAlgorithm, HashAlgorithm::WYHASH>
+>;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(ComputeHashAlgorithm, Algo, HashAlgorithms)
+{
+  BOOST_CHECK_EQUAL(computeHash("/", 0, Algo::value), 0);
+
+  Name name("/nohello/world/ndn/research");
+  HashSequence hashes = computeHashes(name, name.size(), Algo::value);
+  BOOST_REQUIRE_EQUAL(hashes.size(), name.size() + 1);
+  for (size_t i = 0; i < name.size(); ++i) {
+    BOOST_CHECK_EQUAL(hashes[i], computeHash(name, i, Algo::value));
+    BOOST_CHECK_EQUAL(hashes[i + 1], extendHash(hashes[i], name[i], Algo::value));
+  }
+
+  // combination is order-sensitive
+  BOOST_CHECK_NE(computeHash("/A/B", 2, Algo::value), computeHash("/B/A", 2, Algo::value));
+  BOOST_CHECK_NE(computeHash("/A/A", 2, Algo::value), 0);
+  BOOST_CHECK_NE(computeHash("/A/B/C", 3, Algo::value), computeHash("/C/B/A", 3, Algo::value));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(ComputeHashesCached, Algo, HashAlgorithms)
+{
+  auto interest = makeInterest("/A/B/C/D");
+  const HashSequence& hashes1 = computeHashes(*interest, 32, Algo::value);
+  BOOST_CHECK(hashes1 == computeHashes(interest->getName(), 32, Algo::value));
+
+  // hash values are cached
+  const HashSequence& hashes2 = computeHashes(*interest, 2, Algo::value);
+  BOOST_CHECK_EQUAL(&hashes2, &hashes1);
+
+  // cache is discarded when the name changes
+  interest->setName("/A/B/E");
+  const HashSequence& hashes3 = computeHashes(*interest, 32, Algo::value);
+  BOOST_CHECK(hashes3 == computeHashes(Name("/A/B/E"), 32, Algo::value));
+
+  // cache is discarded when a different algorithm is requested
+  auto otherAlgo = Algo::value == HashAlgorithm::CITYHASH ? HashAlgorithm::WYHASH : HashAlgorithm::CITYHASH;
+  const HashSequence& hashes4 = computeHashes(*interest, 32, otherAlgo);
+  BOOST_CHECK(hashes4 == computeHashes(Name("/A/B/E"), 32, otherAlgo));
+
+  auto data = makeData("/A/B/C/D/E");
+  const HashSequence& hashes5 = computeHashes(*data, 3, Algo::value);
+  BOOST_CHECK(hashes5 == computeHashes(data->getName(), 3, Algo::value));
+  // a longer hash sequence is computed if the cached one is too short
+  const HashSequence& hashes6 = computeHashes(*data, 32, Algo::value);
+  BOOST_CHECK(hashes6 == computeHashes(data->getName(), 32, Algo::value));
+}
+
 BOOST_AUTO_TEST_SUITE(Hashtable)
 
 using name_tree::Hashtable;
 
-BOOST_AUTO_TEST_CASE(Modifiers)
+using HashtableLayouts = boost::mpl::vector<
+  std::integral_constant<HashtableLayout, HashtableLayout::CHAINED>,
+  std::integral_constant<HashtableLayout, HashtableLayout::OPEN_ADDRESSING>
+>;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(Modifiers, Layout, HashtableLayouts)
 {
-  Hashtable ht(HashtableOptions(16));
+  HashtableOptions options(16);
+  options.layout = Layout::value;
+  Hashtable ht(options);
 
   Name name("/A/B/C/D");
   HashSequence hashes = computeHashes(name);
@@ -104,11 +164,12 @@ BOOST_AUTO_TEST_CASE(Modifiers)
   BOOST_CHECK(ht.find(name, 4) == nullptr);
 }
 
-BOOST_AUTO_TEST_CASE(Resize)
+BOOST_AUTO_TEST_CASE_TEMPLATE(Resize, Layout, HashtableLayouts)
 {
   HashtableOptions options(9);
   BOOST_CHECK_EQUAL(options.initialSize, 9);
   BOOST_CHECK_EQUAL(options.minSize, 9);
+  options.layout = Layout::value;
   options.minSize = 6;
   options.expandLoadFactor = 0.80;
   options.expandFactor = 5.0;
@@ -184,6 +245,309 @@ BOOST_AUTO_TEST_CASE(Resize)
   BOOST_CHECK_EQUAL(ht.getNBuckets(), 6);
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(IncrementalResize, Layout, HashtableLayouts)
+{
+  HashtableOptions options(16);
+  options.layout = Layout::value;
+  options.resizeStep = 2;
+  Hashtable ht(options);
+
+  std::vector<const Node*> nodes;
+  auto addNode = [&] (int i) {
+    Name name;
+    name.appendNumber(i);
+    nodes.push_back(ht.insert(name, name.size(), computeHashes(name)).first);
+  };
+
+  for (int i = 1; i <= 8; ++i) {
+    addNode(i);
+  }
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 16);
+  BOOST_CHECK_EQUAL(ht.isResizing(), false);
+
+  addNode(9);
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 32);
+  BOOST_CHECK_EQUAL(ht.isResizing(), true);
+  BOOST_CHECK_EQUAL(ht.getNOldBuckets(), 16);
+
+  // all nodes are reachable while old and new bucket arrays coexist
+  size_t nEnumerated = 0;
+  for (size_t bucket = 0; bucket < ht.getNBuckets() + ht.getNOldBuckets(); ++bucket) {
+    for (const Node* node = ht.getBucket(bucket); node != nullptr; node = node->next) {
+      BOOST_CHECK_EQUAL(ht.findBucket(*node), bucket);
+      ++nEnumerated;
+    }
+  }
+  BOOST_CHECK_EQUAL(nEnumerated, 9);
+  for (const Node* node : nodes) {
+    BOOST_CHECK_EQUAL(ht.find(node->entry.getName(), 1), node);
+  }
+
+  // 2 of 16 old buckets are migrated during each operation
+  ht.erase(const_cast<Node*>(nodes.front()));
+  for (int i = 10; i <= 14; ++i) {
+    addNode(i);
+  }
+  BOOST_CHECK_EQUAL(ht.isResizing(), true);
+
+  addNode(15);
+  BOOST_CHECK_EQUAL(ht.isResizing(), false);
+  BOOST_CHECK_EQUAL(ht.getNOldBuckets(), 0);
+  BOOST_CHECK_EQUAL(ht.size(), 14);
+  for (size_t i = 1; i < nodes.size(); ++i) {
+    BOOST_CHECK_EQUAL(ht.find(nodes[i]->entry.getName(), 1), nodes[i]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(DeferredResize, Layout, HashtableLayouts)
+{
+  HashtableOptions options(16);
+  options.layout = Layout::value;
+  options.resizeStep = 1;
+  Hashtable ht(options);
+
+  std::vector<const Node*> nodes;
+  for (int i = 1; i <= 9; ++i) {
+    Name name;
+    name.appendNumber(i);
+    nodes.push_back(ht.insert(name, name.size(), computeHashes(name)).first);
+  }
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 32);
+  BOOST_CHECK_EQUAL(ht.isResizing(), true);
+
+  // the load falls below the shrink threshold, but the expansion is not completed at once
+  for (int i = 0; i < 7; ++i) {
+    ht.erase(const_cast<Node*>(nodes[i]));
+  }
+  BOOST_CHECK_EQUAL(ht.size(), 2);
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 32);
+  BOOST_CHECK_EQUAL(ht.isResizing(), true);
+  BOOST_CHECK_EQUAL(ht.getNOldBuckets(), 16);
+
+  // 8 of 16 old buckets have been migrated, the remaining ones are migrated one per operation
+  Name name("/A");
+  HashSequence hashes = computeHashes(name);
+  for (int i = 0; i < 4; ++i) {
+    ht.erase(const_cast<Node*>(ht.insert(name, 1, hashes).first));
+  }
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 32);
+  BOOST_CHECK_EQUAL(ht.isResizing(), false);
+
+  // the deferred shrink starts after the expansion has completed
+  ht.erase(const_cast<Node*>(nodes[7]));
+  BOOST_CHECK_EQUAL(ht.size(), 1);
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 16);
+  BOOST_CHECK_EQUAL(ht.isResizing(), true);
+  BOOST_CHECK_EQUAL(ht.getNOldBuckets(), 32);
+  BOOST_CHECK_EQUAL(ht.find(nodes[8]->entry.getName(), 1), nodes[8]);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(NoOscillation, Layout, HashtableLayouts)
+{
+  HashtableOptions options(16);
+  options.layout = Layout::value;
+  Hashtable ht(options);
+
+  std::vector<const Node*> nodes;
+  auto addNode = [&] (int i) {
+    Name name;
+    name.appendNumber(i);
+    nodes.push_back(ht.insert(name, name.size(), computeHashes(name)).first);
+  };
+  auto removeNode = [&] {
+    ht.erase(const_cast<Node*>(nodes.back()));
+    nodes.pop_back();
+  };
+
+  for (int i = 1; i <= 9; ++i) {
+    addNode(i);
+  }
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 32);
+
+  // oscillating around the expansion threshold of the old size does not shrink the hashtable
+  for (int i = 0; i < 20; ++i) {
+    removeNode();
+    BOOST_CHECK_EQUAL(ht.getNBuckets(), 32);
+    addNode(9);
+    BOOST_CHECK_EQUAL(ht.getNBuckets(), 32);
+  }
+
+  for (int i = 0; i < 7; ++i) {
+    removeNode();
+  }
+  BOOST_CHECK_EQUAL(ht.size(), 2);
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 16);
+
+  // oscillating around the shrink threshold of the old size does not expand the hashtable
+  for (int i = 0; i < 20; ++i) {
+    addNode(3);
+    BOOST_CHECK_EQUAL(ht.getNBuckets(), 16);
+    removeNode();
+    BOOST_CHECK_EQUAL(ht.getNBuckets(), 16);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ShrinkDelay)
+{
+  HashtableOptions options(16);
+  options.shrinkDelayFactor = 1.0;
+  Hashtable ht(options);
+
+  std::vector<const Node*> nodes;
+  for (int i = 1; i <= 9; ++i) {
+    Name name;
+    name.appendNumber(i);
+    nodes.push_back(ht.insert(name, name.size(), computeHashes(name)).first);
+  }
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 32);
+
+  for (const Node* node : nodes) {
+    ht.erase(const_cast<Node*>(node));
+  }
+  BOOST_CHECK_EQUAL(ht.size(), 0);
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 32);
+
+  // shrinking is allowed after 32 operations since the expansion
+  Name name("/A");
+  HashSequence hashes = computeHashes(name);
+  for (int i = 0; i < 11; ++i) {
+    ht.erase(const_cast<Node*>(ht.insert(name, 1, hashes).first));
+  }
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 32);
+  ht.erase(const_cast<Node*>(ht.insert(name, 1, hashes).first));
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 16);
+}
+
+BOOST_AUTO_TEST_CASE(ShrinkHysteresis)
+{
+  HashtableOptions options(64);
+  options.minSize = 4;
+  options.shrinkLoadFactor = 0.3f;
+  Hashtable ht(options);
+
+  std::vector<const Node*> nodes;
+  for (int i = 1; i <= 20; ++i) {
+    Name name;
+    name.appendNumber(i);
+    nodes.push_back(ht.insert(name, name.size(), computeHashes(name)).first);
+  }
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 64);
+
+  // shrinking to 32 buckets is deferred until the load stays below half of the expand threshold
+  for (int i = 0; i < 11; ++i) {
+    ht.erase(const_cast<Node*>(nodes[i]));
+  }
+  BOOST_CHECK_EQUAL(ht.size(), 9);
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 64);
+
+  ht.erase(const_cast<Node*>(nodes[11]));
+  BOOST_CHECK_EQUAL(ht.size(), 8);
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 32);
+}
+
+BOOST_AUTO_TEST_CASE(OpenAddressingCollisions)
+{
+  HashtableOptions options(32);
+  options.layout = HashtableLayout::OPEN_ADDRESSING;
+  Hashtable ht(options);
+
+  // pick names that share a bucket, so that they occupy consecutive buckets in a probe sequence
+  std::vector<Name> names;
+  size_t home = 0;
+  for (int i = 0; names.size() < 8; ++i) {
+    Name name;
+    name.appendNumber(i);
+    size_t bucket = ht.computeBucketIndex(computeHash(name));
+    if (names.empty()) {
+      home = bucket;
+    }
+    if (bucket == home) {
+      names.push_back(name);
+    }
+  }
+
+  std::vector<const Node*> nodes;
+  for (const Name& name : names) {
+    auto [node, isNew] = ht.insert(name, 1, computeHashes(name));
+    BOOST_CHECK_EQUAL(isNew, true);
+    nodes.push_back(node);
+  }
+  BOOST_CHECK_EQUAL(ht.size(), 8);
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 32);
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    BOOST_CHECK_EQUAL(ht.findBucket(*nodes[i]), (home + i) % 32);
+  }
+
+  // erasing a node in the middle of the probe sequence must not hide later nodes
+  ht.erase(const_cast<Node*>(nodes[3]));
+  BOOST_CHECK_EQUAL(ht.size(), 7);
+  BOOST_CHECK(ht.find(names[3], 1) == nullptr);
+  for (size_t i = 4; i < nodes.size(); ++i) {
+    BOOST_CHECK_EQUAL(ht.find(names[i], 1), nodes[i]);
+  }
+
+  // the freed bucket is reused
+  auto [node3, isNew3] = ht.insert(names[3], 1, computeHashes(names[3]));
+  BOOST_CHECK_EQUAL(isNew3, true);
+  BOOST_CHECK_EQUAL(ht.findBucket(*node3), (home + 3) % 32);
+  BOOST_CHECK_EQUAL(ht.getBucket((home + 3) % 32), node3);
+  BOOST_CHECK_EQUAL(ht.size(), 8);
+}
+
+BOOST_AUTO_TEST_CASE(SetLayout)
+{
+  Hashtable ht(HashtableOptions(16));
+  BOOST_CHECK_EQUAL(ht.getLayout(), HashtableLayout::CHAINED);
+
+  std::vector<const Node*> nodes;
+  for (int i = 0; i < 6; ++i) {
+    Name name;
+    name.appendNumber(i);
+    nodes.push_back(ht.insert(name, 1, computeHashes(name)).first);
+  }
+
+  ht.setLayout(HashtableLayout::OPEN_ADDRESSING);
+  BOOST_CHECK_EQUAL(ht.getLayout(), HashtableLayout::OPEN_ADDRESSING);
+  BOOST_CHECK_EQUAL(ht.size(), 6);
+  for (const Node* node : nodes) {
+    // nodes are reindexed without being reallocated
+    BOOST_CHECK_EQUAL(ht.find(node->entry.getName(), 1), node);
+  }
+
+  ht.setLayout(HashtableLayout::CHAINED);
+  BOOST_CHECK_EQUAL(ht.getLayout(), HashtableLayout::CHAINED);
+  BOOST_CHECK_EQUAL(ht.size(), 6);
+  for (const Node* node : nodes) {
+    BOOST_CHECK_EQUAL(ht.find(node->entry.getName(), 1), node);
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(SetHashAlgorithm, Layout, HashtableLayouts)
+{
+  HashtableOptions options(16);
+  options.layout = Layout::value;
+  options.hashAlgorithm = HashAlgorithm::CITYHASH;
+  Hashtable ht(options);
+
+  std::vector<const Node*> nodes;
+  for (int i = 0; i < 20; ++i) {
+    Name name("/A");
+    name.appendNumber(i);
+    nodes.push_back(ht.insert(name, 2, computeHashes(name, 2, HashAlgorithm::CITYHASH)).first);
+  }
+
+  ht.setHashAlgorithm(HashAlgorithm::WYHASH);
+  BOOST_CHECK_EQUAL(ht.getHashAlgorithm(), HashAlgorithm::WYHASH);
+  BOOST_CHECK_EQUAL(ht.size(), 20);
+  for (const Node* node : nodes) {
+    const Name& name = node->entry.getName();
+    // nodes are reindexed without being reallocated
+    BOOST_CHECK_EQUAL(node->hash, computeHash(name, 2, HashAlgorithm::WYHASH));
+    BOOST_CHECK_EQUAL(ht.find(name, 2), node);
+    BOOST_CHECK_EQUAL(ht.find(name, 2, computeHashes(name, 2, HashAlgorithm::WYHASH)), node);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END() // Hashtable
 
 BOOST_AUTO_TEST_SUITE(TestEntry)
@@ -524,6 +888,25 @@ BOOST_FIXTURE_TEST_CASE(IteratorFullEnumerate, EnumerationFixture)
     .end();
 }
 
+BOOST_FIXTURE_TEST_CASE(IteratorFullEnumerateOpenAddressing, EnumerationFixture)
+{
+  nt.setHashtableLayout(HashtableLayout::OPEN_ADDRESSING);
+  this->insertAb1Ab2Ac1Ac2();
+  nt.eraseIfEmpty(nt.findExactMatch("/a/b/1"));
+  BOOST_CHECK_EQUAL(nt.size(), 7);
+
+  auto&& enumerable = nt.fullEnumerate();
+  EnumerationVerifier(enumerable)
+    .expect("/")
+    .expect("/a")
+    .expect("/a/b")
+    .expect("/a/b/2")
+    .expect("/a/c")
+    .expect("/a/c/1")
+    .expect("/a/c/2")
+    .end();
+}
+
 BOOST_FIXTURE_TEST_SUITE(IteratorPartialEnumerate, EnumerationFixture)
 
 BOOST_AUTO_TEST_CASE(Empty)
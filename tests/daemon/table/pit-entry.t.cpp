@@ -168,6 +168,75 @@ BOOST_AUTO_TEST_CASE(InOutRecords)
   BOOST_CHECK(entry.getOutRecord(*face2) == entry.out_end());
 }
 
+class RecordStrategyInfo : public fw::StrategyInfo
+{
+public:
+  static constexpr int
+  getTypeId()
+  {
+    return 1;
+  }
+
+  explicit
+  RecordStrategyInfo(FaceId faceId)
+    : faceId(faceId)
+  {
+  }
+
+public:
+  FaceId faceId;
+};
+
+BOOST_AUTO_TEST_CASE(ManyRecords)
+{
+  // more records than can be stored inline
+  std::vector<shared_ptr<DummyFace>> faces;
+  for (int i = 0; i < 6; ++i) {
+    faces.push_back(make_shared<DummyFace>());
+    faces.back()->setId(300 + i);
+  }
+
+  auto interest = makeInterest("/DkqAwBQ3", false, std::nullopt, 1);
+  Entry entry(*interest);
+  for (const auto& face : faces) {
+    entry.insertOrUpdateInRecord(*face, *interest);
+    auto outIt = entry.insertOrUpdateOutRecord(*face, *interest);
+    outIt->insertStrategyInfo<RecordStrategyInfo>(face->getId());
+  }
+  BOOST_CHECK_EQUAL(entry.getInRecords().size(), 6);
+  BOOST_CHECK_EQUAL(entry.getOutRecords().size(), 6);
+
+  entry.deleteInRecord(*faces[0]);
+  entry.deleteInRecord(*faces[3]);
+  entry.deleteOutRecord(*faces[2]);
+  BOOST_CHECK_EQUAL(entry.getInRecords().size(), 4);
+  BOOST_CHECK_EQUAL(entry.getOutRecords().size(), 5);
+
+  for (size_t i = 0; i < faces.size(); ++i) {
+    auto inIt = entry.getInRecord(*faces[i]);
+    if (i == 0 || i == 3) {
+      BOOST_CHECK(inIt == entry.in_end());
+    }
+    else {
+      BOOST_REQUIRE(inIt != entry.in_end());
+      BOOST_CHECK_EQUAL(&inIt->getFace(), faces[i].get());
+    }
+
+    auto outIt = entry.getOutRecord(*faces[i]);
+    if (i == 2) {
+      BOOST_CHECK(outIt == entry.out_end());
+    }
+    else {
+      BOOST_REQUIRE(outIt != entry.out_end());
+      BOOST_CHECK_EQUAL(&outIt->getFace(), faces[i].get());
+      // strategy info moves along with its record
+      auto info = outIt->getStrategyInfo<RecordStrategyInfo>();
+      BOOST_REQUIRE(info != nullptr);
+      BOOST_CHECK_EQUAL(info->faceId, faces[i]->getId());
+    }
+  }
+}
+
 const time::milliseconds lifetimes[] = {
   -1_ms, // unset
   1_ms,
@@ -265,6 +265,38 @@ BOOST_AUTO_TEST_CASE(Erase)
   BOOST_CHECK_EQUAL(nameTree.size(), nNameTreeEntriesBefore);
 }
 
+BOOST_AUTO_TEST_CASE(Signals)
+{
+  std::vector<std::pair<Name, Name>> inserted;
+  std::vector<Name> erased;
+  sc.afterInsert.connect([&] (const Name& prefix, const Name& strategyName) {
+    inserted.emplace_back(prefix, strategyName);
+  });
+  sc.afterErase.connect([&] (const Name& prefix) { erased.push_back(prefix); });
+
+  Name instanceName = insertAndGet("/A", strategyNameP);
+  BOOST_REQUIRE_EQUAL(inserted.size(), 1);
+  BOOST_CHECK_EQUAL(inserted.back().first, "/A");
+  BOOST_CHECK_EQUAL(inserted.back().second, instanceName);
+
+  // no signal if the strategy is unchanged
+  insertAndGet("/A", strategyNameP);
+  BOOST_CHECK_EQUAL(inserted.size(), 1);
+
+  instanceName = insertAndGet("/A", strategyNameQ);
+  BOOST_REQUIRE_EQUAL(inserted.size(), 2);
+  BOOST_CHECK_EQUAL(inserted.back().second, instanceName);
+
+  // no signal on failure
+  BOOST_CHECK(!sc.insert("/B", "/strategy-choice-unknown"));
+  BOOST_CHECK_EQUAL(inserted.size(), 2);
+
+  sc.erase("/B");
+  BOOST_CHECK(erased.empty());
+  sc.erase("/A");
+  BOOST_CHECK(erased == std::vector<Name>({"/A"}));
+}
+
 BOOST_AUTO_TEST_CASE(Enumerate)
 {
   sc.insert("/",      strategyNameP);
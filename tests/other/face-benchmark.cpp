@@ -24,14 +24,22 @@
  */
 
 #include "common/global.hpp"
+#include "face/datagram-batch-io.hpp"
 #include "face/face.hpp"
 #include "face/tcp-channel.hpp"
 #include "face/udp-channel.hpp"
 
+#ifdef NFD_HAVE_LIBPCAP
+#include "face/ethernet-channel.hpp"
+
+#include <ndn-cxx/net/network-monitor.hpp>
+#endif
+
 #include <boost/asio/signal_set.hpp>
 #include <boost/exception/diagnostic_information.hpp>
 #include <boost/lexical_cast.hpp>
 
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 
@@ -44,18 +52,30 @@ namespace nfd::tests {
 class FaceBenchmark
 {
 public:
-  explicit
-  FaceBenchmark(const char* configFileName)
+  /** \param udpBatchSize maximum number of datagrams per system call on UDP faces
+   *  \param wantUdpOffload whether UDP faces use segmentation offload (GSO/GRO)
+   *  \param etherBackend backend of Ethernet faces
+   */
+  FaceBenchmark(const char* configFileName, size_t udpBatchSize, bool wantUdpOffload,
+                const std::string& etherBackend)
     : m_terminationSignalSet{getGlobalIoService(), SIGINT, SIGTERM}
     , m_tcpChannel{tcp::Endpoint{boost::asio::ip::tcp::v4(), 6363}, false,
                    [] (auto&&...) { return ndn::nfd::FACE_SCOPE_NON_LOCAL; }}
-    , m_udpChannel{udp::Endpoint{boost::asio::ip::udp::v4(), 6363}, 10_min, false, ndn::MAX_NDN_PACKET_SIZE}
+    , m_udpChannel{udp::Endpoint{boost::asio::ip::udp::v4(), 6363}, 10_min, false, ndn::MAX_NDN_PACKET_SIZE,
+                   udpBatchSize, 0, wantUdpOffload}
+    , m_etherBackend{etherBackend}
+    , m_startTime{time::steady_clock::now()}
   {
-    m_terminationSignalSet.async_wait([] (const auto& error, int) {
-      if (!error)
+    m_terminationSignalSet.async_wait([this] (const auto& error, int) {
+      if (!error) {
+        printCounters();
         getGlobalIoService().stop();
+      }
     });
 
+    std::clog << "UDP batch size " << udpBatchSize
+              << ", segmentation offload " << (wantUdpOffload ? "on" : "off") << std::endl;
+
     parseConfig(configFileName);
 
     m_tcpChannel.listen(std::bind(&FaceBenchmark::onLeftFaceCreated, this, _1),
@@ -65,6 +85,10 @@ public:
     m_udpChannel.listen(std::bind(&FaceBenchmark::onLeftFaceCreated, this, _1),
                         std::bind(&FaceBenchmark::onFaceCreationFailed, _1, _2));
     std::clog << "Listening on " << m_udpChannel.getUri() << std::endl;
+
+    if (!m_etherInterfaces.empty()) {
+      listenOnEthernet();
+    }
   }
 
 private:
@@ -79,14 +103,19 @@ private:
       FaceUri uriL{uriStrL};
       FaceUri uriR{uriStrR};
 
-      if (uriL.getScheme() != "tcp4" && uriL.getScheme() != "udp4") {
-        std::clog << "Unsupported protocol '" << uriL.getScheme() << "'" << std::endl;
+      if (!isSupported(uriL)) {
+        std::clog << "Unsupported FaceUri '" << uriL << "'" << std::endl;
       }
-      else if (uriR.getScheme() != "tcp4" && uriR.getScheme() != "udp4") {
-        std::clog << "Unsupported protocol '" << uriR.getScheme() << "'" << std::endl;
+      else if (!isSupported(uriR)) {
+        std::clog << "Unsupported FaceUri '" << uriR << "'" << std::endl;
       }
       else {
         m_faceUris.emplace_back(uriL, uriR);
+        for (const auto& uri : {uriL, uriR}) {
+          if (uri.getScheme() == "ether") {
+            m_etherInterfaces.insert(uri.getPath().substr(1));
+          }
+        }
       }
     }
 
@@ -95,11 +124,74 @@ private:
     }
   }
 
+  static bool
+  isSupported(const FaceUri& uri)
+  {
+    if (uri.getScheme() == "ether") {
+      // the path names the local network interface
+#ifdef NFD_HAVE_LIBPCAP
+      return uri.getPath().size() > 1;
+#else
+      return false;
+#endif
+    }
+    return uri.getScheme() == "tcp4" || uri.getScheme() == "udp4";
+  }
+
+  void
+  listenOnEthernet()
+  {
+#ifdef NFD_HAVE_LIBPCAP
+    face::EthernetBackend backend = face::EthernetBackend::PCAP;
+    if (m_etherBackend == "packet_ring") {
+      backend = face::EthernetBackend::PACKET_RING;
+    }
+    else if (m_etherBackend == "xdp") {
+      backend = face::EthernetBackend::XDP;
+    }
+
+    m_netmon = make_unique<ndn::net::NetworkMonitor>(getGlobalIoService());
+    m_netmon->onEnumerationCompleted.connect([this, backend] {
+      for (const auto& netif : m_netmon->listNetworkInterfaces()) {
+        if (m_etherInterfaces.count(netif->getName()) == 0) {
+          continue;
+        }
+        auto channel = std::make_shared<face::EthernetChannel>(netif, 10_min, backend);
+        channel->listen(std::bind(&FaceBenchmark::onLeftFaceCreated, this, _1),
+                        std::bind(&FaceBenchmark::onFaceCreationFailed, _1, _2));
+        std::clog << "Listening on " << channel->getUri() << " with " << backend << std::endl;
+        m_etherChannels[netif->getName()] = std::move(channel);
+      }
+    });
+#endif
+  }
+
+  void
+  printCounters() const
+  {
+    auto duration = time::duration<double>(time::steady_clock::now() - m_startTime).count();
+    uint64_t nInPackets = 0;
+    uint64_t nOutPackets = 0;
+    uint64_t nInBytes = 0;
+    for (const auto& face : m_faces) {
+      const auto& counters = face->getCounters();
+      std::cout << face->getRemoteUri() << " in=" << counters.nInPackets << " out=" << counters.nOutPackets
+                << std::endl;
+      nInPackets += counters.nInPackets;
+      nOutPackets += counters.nOutPackets;
+      nInBytes += counters.nInBytes;
+    }
+    std::cout << "Total in=" << nInPackets << " out=" << nOutPackets << " over " << duration << "s, "
+              << static_cast<uint64_t>(nInPackets / duration) << " packets/s, "
+              << static_cast<uint64_t>(nInBytes * 8 / duration / 1e6) << " Mbit/s received" << std::endl;
+  }
+
   void
   onLeftFaceCreated(const shared_ptr<Face>& faceL)
   {
     std::clog << "Left face created: remote=" << faceL->getRemoteUri()
               << " local=" << faceL->getLocalUri() << std::endl;
+    m_faces.push_back(faceL);
 
     // find a matching right uri
     FaceUri uriR;
@@ -121,25 +213,38 @@ private:
     }
 
     // create the right face
+#ifdef NFD_HAVE_LIBPCAP
+    if (uriR.getScheme() == "ether") {
+      auto it = m_etherChannels.find(uriR.getPath().substr(1));
+      if (it == m_etherChannels.end()) {
+        onFaceCreationFailed(504, "No channel on " + uriR.getPath().substr(1));
+      }
+      it->second->connect(ethernet::Address::fromString(uriR.getHost()), {},
+                          std::bind(&FaceBenchmark::onRightFaceCreated, this, faceL, _1),
+                          std::bind(&FaceBenchmark::onFaceCreationFailed, _1, _2));
+      return;
+    }
+#endif
     auto addr = boost::asio::ip::address::from_string(uriR.getHost());
     auto port = boost::lexical_cast<uint16_t>(uriR.getPort());
     if (uriR.getScheme() == "tcp4") {
       m_tcpChannel.connect(tcp::Endpoint(addr, port), {},
-                           std::bind(&FaceBenchmark::onRightFaceCreated, faceL, _1),
+                           std::bind(&FaceBenchmark::onRightFaceCreated, this, faceL, _1),
                            std::bind(&FaceBenchmark::onFaceCreationFailed, _1, _2));
     }
     else if (uriR.getScheme() == "udp4") {
       m_udpChannel.connect(udp::Endpoint(addr, port), {},
-                           std::bind(&FaceBenchmark::onRightFaceCreated, faceL, _1),
+                           std::bind(&FaceBenchmark::onRightFaceCreated, this, faceL, _1),
                            std::bind(&FaceBenchmark::onFaceCreationFailed, _1, _2));
     }
   }
 
-  static void
+  void
   onRightFaceCreated(const shared_ptr<Face>& faceL, const shared_ptr<Face>& faceR)
   {
     std::clog << "Right face created: remote=" << faceR->getRemoteUri()
               << " local=" << faceR->getLocalUri() << std::endl;
+    m_faces.push_back(faceR);
 
     tieFaces(faceR, faceL);
     tieFaces(faceL, faceR);
@@ -169,7 +274,15 @@ private:
   boost::asio::signal_set m_terminationSignalSet;
   face::TcpChannel m_tcpChannel;
   face::UdpChannel m_udpChannel;
+  std::string m_etherBackend;
+  std::set<std::string> m_etherInterfaces;
+#ifdef NFD_HAVE_LIBPCAP
+  unique_ptr<ndn::net::NetworkMonitor> m_netmon;
+  std::map<std::string, shared_ptr<face::EthernetChannel>> m_etherChannels;
+#endif
   std::vector<std::pair<FaceUri, FaceUri>> m_faceUris;
+  std::vector<shared_ptr<Face>> m_faces;
+  time::steady_clock::TimePoint m_startTime;
 };
 
 } // namespace nfd::tests
@@ -181,13 +294,29 @@ main(int argc, char** argv)
   std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
 #endif
 
-  if (argc != 2) {
-    std::cerr << "Usage: " << argv[0] << " <config-file>" << std::endl;
+  if (argc < 2 || argc > 5) {
+    std::cerr << "Usage: " << argv[0] << " <config-file> [udp-batch-size [udp-offload [ether-backend]]]\n"
+              << "  udp-batch-size  datagrams per system call on UDP faces, 1 to 64 (default 1)\n"
+              << "  udp-offload     'yes' to enable UDP segmentation offload (default no)\n"
+              << "  ether-backend   'pcap', 'packet_ring', or 'xdp' for Ethernet faces (default pcap)"
+              << std::endl;
+    return 2;
+  }
+
+  size_t udpBatchSize = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1;
+  if (udpBatchSize < 1 || udpBatchSize > nfd::face::DatagramBatchIo<boost::asio::ip::udp>::MAX_BATCH_SIZE) {
+    std::cerr << "ERROR: invalid udp-batch-size" << std::endl;
+    return 2;
+  }
+  bool wantUdpOffload = argc > 3 && std::string(argv[3]) == "yes";
+  std::string etherBackend = argc > 4 ? argv[4] : "pcap";
+  if (etherBackend != "pcap" && etherBackend != "packet_ring" && etherBackend != "xdp") {
+    std::cerr << "ERROR: invalid ether-backend" << std::endl;
     return 2;
   }
 
   try {
-    nfd::tests::FaceBenchmark bench{argv[1]};
+    nfd::tests::FaceBenchmark bench{argv[1], udpBatchSize, wantUdpOffload, etherBackend};
 #ifdef NFD_HAVE_VALGRIND
     CALLGRIND_START_INSTRUMENTATION;
 #endif
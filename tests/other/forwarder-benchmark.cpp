@@ -0,0 +1,244 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "benchmark-helpers.hpp"
+#include "common/global.hpp"
+#include "face/generic-link-service.hpp"
+#include "face/transport.hpp"
+#include "fw/forwarder.hpp"
+#include "fw/sharded-forwarder.hpp"
+
+#include <iostream>
+
+#ifdef NFD_HAVE_VALGRIND
+#include <valgrind/callgrind.h>
+#endif
+
+namespace nfd::tests {
+
+/** \brief a Transport that drops sent packets and lets the benchmark inject received packets
+ */
+class BenchmarkTransport final : public face::Transport
+{
+public:
+  BenchmarkTransport()
+  {
+    this->setLocalUri(FaceUri("dummy://"));
+    this->setRemoteUri(FaceUri("dummy://"));
+    this->setScope(ndn::nfd::FACE_SCOPE_NON_LOCAL);
+    this->setPersistency(ndn::nfd::FACE_PERSISTENCY_PERMANENT);
+    this->setLinkType(ndn::nfd::LINK_TYPE_POINT_TO_POINT);
+    this->setMtu(face::MTU_UNLIMITED);
+  }
+
+  void
+  receivePacket(const Block& packet)
+  {
+    this->receive(packet);
+  }
+
+private:
+  void
+  doClose() final
+  {
+    this->setState(face::TransportState::CLOSED);
+  }
+
+  void
+  doSend(const Block&) final
+  {
+  }
+};
+
+class ForwarderBenchmarkFixture
+{
+protected:
+  ForwarderBenchmarkFixture()
+  {
+#ifdef _DEBUG
+    std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
+#endif
+
+    m_inFace = addFace(m_inTransport);
+    m_outFace = addFace(m_outTransport);
+    m_forwarder.setConfigFile(m_configFile);
+  }
+
+  /** \brief Forward Interest-Data exchanges through the complete pipelines
+   *  \param batchSize value of forwarder.batch_size option
+   *  \param nThreads number of forwarding threads; if greater than one, ShardedForwarder is used
+   *
+   *  Packets arrive in bursts, each of which is received in one round of I/O events,
+   *  so that the forwarder can process up to \p batchSize packets together.
+   */
+  void
+  runExchanges(size_t batchSize, size_t nThreads = 1)
+  {
+    // number of Interest-Data exchanges
+    const size_t nRoundTrip = 500000;
+    // number of packets received in one round of I/O events
+    const size_t burstSize = 64;
+    // number of FIB entries, which the packet names are evenly distributed under
+    const size_t nFibEntries = 1000;
+
+    m_configFile.parse("forwarder\n{\n  batch_size " + to_string(batchSize) + "\n}\n",
+                       false, "benchmark");
+
+    Fib& fib = m_forwarder.getFib();
+    for (size_t i = 0; i < nFibEntries; ++i) {
+      fib::Entry* entry = fib.insert(Name("/bench").append(to_string(i))).first;
+      fib.addOrUpdateNextHop(*entry, *m_outFace, 0);
+    }
+
+    std::vector<Block> interests;
+    std::vector<Block> data;
+    interests.reserve(nRoundTrip);
+    data.reserve(nRoundTrip);
+    for (size_t i = 0; i < nRoundTrip; ++i) {
+      Name name("/bench");
+      name.append(to_string(i % nFibEntries)).append(to_string(i));
+
+      Interest interest(name);
+      interest.setNonce(static_cast<uint32_t>(i));
+      interests.push_back(interest.wireEncode());
+
+      Data d(name);
+      d.setSignatureInfo(ndn::SignatureInfo(tlv::NullSignature));
+      d.setSignatureValue(std::make_shared<ndn::Buffer>());
+      data.push_back(d.wireEncode());
+    }
+
+    unique_ptr<ShardedForwarder> sharded;
+    if (nThreads > 1) {
+      ShardedForwarder::Options options;
+      options.nShards = nThreads;
+      sharded = make_unique<ShardedForwarder>(m_faceTable, m_forwarder, options);
+    }
+
+    // a burst of replies is received only after the whole burst of requests has been forwarded,
+    // which takes more than one round of I/O events with forwarding threads
+    const auto& inCounters = m_inFace->getCounters();
+    const auto& outCounters = m_outFace->getCounters();
+    auto pollUntil = [] (const PacketCounter& counter, size_t value) {
+      auto& io = getGlobalIoService();
+      do {
+#if BOOST_VERSION >= 106600
+        io.restart();
+#else
+        io.reset();
+#endif
+        io.poll();
+      } while (counter < value);
+    };
+
+#ifdef NFD_HAVE_VALGRIND
+    CALLGRIND_START_INSTRUMENTATION;
+#endif
+
+    auto t1 = time::steady_clock::now();
+
+    for (size_t begin = 0; begin < nRoundTrip; begin += burstSize) {
+      size_t end = std::min(begin + burstSize, nRoundTrip);
+      for (size_t i = begin; i < end; ++i) {
+        m_inTransport->receivePacket(interests[i]);
+      }
+      pollUntil(outCounters.nOutInterests, end);
+
+      for (size_t i = begin; i < end; ++i) {
+        m_outTransport->receivePacket(data[i]);
+      }
+      pollUntil(inCounters.nOutData, end);
+    }
+
+    auto t2 = time::steady_clock::now();
+
+#ifdef NFD_HAVE_VALGRIND
+    CALLGRIND_STOP_INSTRUMENTATION;
+#endif
+
+    BOOST_CHECK_EQUAL(inCounters.nInInterests, nRoundTrip);
+    BOOST_CHECK_EQUAL(inCounters.nOutData, nRoundTrip);
+
+    auto duration = time::duration_cast<time::microseconds>(t2 - t1);
+    std::cout << "batch-size=" << batchSize << " threads=" << nThreads << ' ' << duration << ' '
+              << static_cast<uint64_t>(2.0 * nRoundTrip / time::duration<double>(duration).count())
+              << " packets/s" << std::endl;
+  }
+
+private:
+  shared_ptr<Face>
+  addFace(BenchmarkTransport*& transport)
+  {
+    auto t = make_unique<BenchmarkTransport>();
+    transport = t.get();
+    auto face = make_shared<Face>(make_unique<face::GenericLinkService>(), std::move(t));
+    m_faceTable.add(face);
+    return face;
+  }
+
+protected:
+  FaceTable m_faceTable;
+  Forwarder m_forwarder{m_faceTable};
+  ConfigFile m_configFile;
+  BenchmarkTransport* m_inTransport = nullptr;
+  BenchmarkTransport* m_outTransport = nullptr;
+  shared_ptr<Face> m_inFace;
+  shared_ptr<Face> m_outFace;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ForwarderBenchmark, ForwarderBenchmarkFixture)
+
+BOOST_AUTO_TEST_CASE(BatchSize1)
+{
+  runExchanges(1);
+}
+
+BOOST_AUTO_TEST_CASE(BatchSize8)
+{
+  runExchanges(8);
+}
+
+BOOST_AUTO_TEST_CASE(BatchSize32)
+{
+  runExchanges(32);
+}
+
+BOOST_AUTO_TEST_CASE(BatchSize64)
+{
+  runExchanges(64);
+}
+
+BOOST_AUTO_TEST_CASE(Threads2)
+{
+  runExchanges(32, 2);
+}
+
+BOOST_AUTO_TEST_CASE(Threads4)
+{
+  runExchanges(32, 4);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nfd::tests
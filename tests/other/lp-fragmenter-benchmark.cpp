@@ -0,0 +1,119 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmark-helpers.hpp"
+#include "face/lp-fragmenter.hpp"
+
+#include <iostream>
+
+namespace nfd::tests {
+
+/** \brief measures how fast LpFragmenter fragments and encodes an 8 KB Data packet
+ *
+ *  Each iteration wraps the Data in an LpPacket, fragments it, assigns sequence numbers, and
+ *  encodes every fragment as GenericLinkService would before handing it to the transport.
+ *  The copying mode produces complete fragments; the zero-copy mode produces encoded headers
+ *  that refer to slices of the Data wire encoding.
+ */
+class LpFragmenterBenchmarkFixture
+{
+protected:
+  LpFragmenterBenchmarkFixture()
+  {
+#ifdef _DEBUG
+    std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
+#endif
+
+    m_data.setName(Name("/bench/lp-fragmenter"));
+    m_data.setContent(std::vector<uint8_t>(8000, 0xBB));
+    m_data.setSignatureInfo(ndn::SignatureInfo(ndn::tlv::DigestSha256));
+    m_data.setSignatureValue(std::make_shared<ndn::Buffer>(32));
+    m_data.wireEncode();
+  }
+
+  template<typename F>
+  void
+  run(const char* mode, const F& fragmentAndEncode)
+  {
+    const size_t nIterations = 100000;
+
+    for (size_t mtu : {1280, 1500, 4000, 8000}) {
+      size_t nFragments = 0;
+      size_t nBytes = 0;
+      auto t1 = time::steady_clock::now();
+      for (size_t i = 0; i < nIterations; ++i) {
+        lp::Packet packet(m_data.wireEncode());
+        fragmentAndEncode(packet, mtu, nFragments, nBytes);
+      }
+      auto t2 = time::steady_clock::now();
+
+      auto duration = time::duration_cast<time::nanoseconds>(t2 - t1);
+      std::cout << mode << " mtu=" << mtu << " fragments/packet=" << nFragments / nIterations
+                << ' ' << duration.count() / nIterations << " ns/packet, "
+                << static_cast<uint64_t>(nBytes / time::duration<double>(duration).count() / 1e6)
+                << " MB/s" << std::endl;
+    }
+  }
+
+protected:
+  LpFragmenter m_fragmenter{{}};
+  lp::Sequence m_lastSeqNo = 0;
+
+private:
+  Data m_data;
+};
+
+BOOST_FIXTURE_TEST_SUITE(LpFragmenterBenchmark, LpFragmenterBenchmarkFixture)
+
+BOOST_AUTO_TEST_CASE(Copying)
+{
+  run("copying", [this] (const lp::Packet& packet, size_t mtu, size_t& nFragments, size_t& nBytes) {
+    auto [isOk, frags] = m_fragmenter.fragmentPacket(packet, mtu);
+    BOOST_REQUIRE(isOk);
+    for (auto& frag : frags) {
+      frag.set<lp::SequenceField>(++m_lastSeqNo);
+      nBytes += frag.wireEncode().size();
+    }
+    nFragments += frags.size();
+  });
+}
+
+BOOST_AUTO_TEST_CASE(ZeroCopy)
+{
+  run("zero-copy", [this] (const lp::Packet& packet, size_t mtu, size_t& nFragments, size_t& nBytes) {
+    auto [isOk, frags] = m_fragmenter.fragmentPacketZeroCopy(packet, mtu);
+    BOOST_REQUIRE(isOk);
+    BOOST_REQUIRE(!frags.empty());
+    for (auto& frag : frags) {
+      frag.header.set<lp::SequenceField>(++m_lastSeqNo);
+      nBytes += frag.encode().size();
+    }
+    nFragments += frags.size();
+  });
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nfd::tests
@@ -0,0 +1,217 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmark-helpers.hpp"
+#include "common/global.hpp"
+#include "face/face.hpp"
+#include "face/generic-link-service.hpp"
+#include "face/transport.hpp"
+
+#include <iostream>
+#include <random>
+
+namespace nfd::tests {
+
+/** \brief a Transport that queues outgoing packets until the benchmark delivers them to its peer
+ */
+class LossyLinkTransport final : public face::Transport
+{
+public:
+  LossyLinkTransport()
+  {
+    this->setLocalUri(FaceUri("dummy://"));
+    this->setRemoteUri(FaceUri("dummy://"));
+    this->setScope(ndn::nfd::FACE_SCOPE_NON_LOCAL);
+    this->setPersistency(ndn::nfd::FACE_PERSISTENCY_PERMANENT);
+    this->setLinkType(ndn::nfd::LINK_TYPE_POINT_TO_POINT);
+    this->setMtu(1500);
+  }
+
+  void
+  deliver(const Block& packet)
+  {
+    this->receive(packet);
+  }
+
+public:
+  std::vector<Block> txQueue;
+
+private:
+  void
+  doClose() final
+  {
+    this->setState(face::TransportState::CLOSED);
+  }
+
+  void
+  doSend(const Block& packet) final
+  {
+    txQueue.push_back(packet);
+  }
+};
+
+/** \brief measures how fast a reliable link delivers Data packets under random loss
+ *
+ *  Two faces with LpReliability enabled are connected back to back. One face sends Data packets
+ *  as fast as possible; each LpPacket in either direction is dropped with a fixed probability.
+ *  The benchmark runs until every packet has been acknowledged or given up on, and reports the
+ *  throughput, the number of retransmitted packets, and the link overhead as octets transferred
+ *  in both directions per delivered packet.
+ */
+class LpReliabilityBenchmarkFixture
+{
+protected:
+  LpReliabilityBenchmarkFixture()
+  {
+#ifdef _DEBUG
+    std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
+#endif
+
+    m_data.setName(Name("/bench/lp-reliability"));
+    m_data.setContent(std::vector<uint8_t>(1200, 0xBB));
+    m_data.setSignatureInfo(ndn::SignatureInfo(ndn::tlv::DigestSha256));
+    m_data.setSignatureValue(std::make_shared<ndn::Buffer>(32));
+    m_data.wireEncode();
+  }
+
+  void
+  run(double lossRate, bool allowAckRanges = false)
+  {
+    const size_t nPackets = 200000;
+
+    face::GenericLinkService::Options options;
+    options.allowFragmentation = true;
+    options.allowReassembly = true;
+    options.reliabilityOptions.isEnabled = true;
+    options.reliabilityOptions.maxRetx = 7;
+    options.reliabilityOptions.allowAckRanges = allowAckRanges;
+
+    auto makeFace = [&] {
+      return make_unique<Face>(make_unique<face::GenericLinkService>(options),
+                               make_unique<LossyLinkTransport>());
+    };
+    auto sender = makeFace();
+    auto receiver = makeFace();
+    auto senderTransport = static_cast<LossyLinkTransport*>(sender->getTransport());
+    auto receiverTransport = static_cast<LossyLinkTransport*>(receiver->getTransport());
+    auto senderService = static_cast<face::GenericLinkService*>(sender->getLinkService());
+
+    size_t nReceived = 0;
+    receiver->afterReceiveData.connect([&] (auto&&...) { ++nReceived; });
+
+    std::mt19937 rng(42);
+    std::bernoulli_distribution isLost(lossRate);
+    uint64_t nOctets = 0;
+    auto transfer = [&] (LossyLinkTransport& from, LossyLinkTransport& to) {
+      auto packets = std::move(from.txQueue);
+      from.txQueue.clear();
+      for (const auto& packet : packets) {
+        nOctets += packet.size();
+        if (!isLost(rng)) {
+          to.deliver(packet);
+        }
+      }
+    };
+    auto isDone = [&] {
+      const auto& counters = senderService->getCounters();
+      return counters.nAcknowledged + counters.nRetransmitted + counters.nRetxExhausted == nPackets;
+    };
+
+    auto& io = getGlobalIoService();
+    auto t1 = time::steady_clock::now();
+    for (size_t i = 0; i < nPackets || !isDone(); ++i) {
+      if (i < nPackets) {
+        sender->sendData(m_data);
+      }
+      transfer(*senderTransport, *receiverTransport);
+      transfer(*receiverTransport, *senderTransport);
+      // run expired RTO and idle Ack timers
+#if BOOST_VERSION >= 106600
+      io.restart();
+#else
+      io.reset();
+#endif
+      io.poll();
+    }
+    auto t2 = time::steady_clock::now();
+
+    const auto& counters = senderService->getCounters();
+    auto duration = time::duration_cast<time::microseconds>(t2 - t1);
+    std::cout << (allowAckRanges ? "AckRanges " : "")
+              << "loss=" << lossRate * 100 << "% packets=" << nPackets << ' ' << duration << ", "
+              << static_cast<uint64_t>(nPackets / time::duration<double>(duration).count())
+              << " packets/s, delivered=" << nReceived
+              << " retransmitted=" << counters.nRetransmitted
+              << " exhausted=" << counters.nRetxExhausted
+              << " duplicates=" << static_cast<face::GenericLinkService*>(receiver->getLinkService())
+                                     ->getCounters().nDuplicateSequence
+              << " octets/packet=" << static_cast<double>(nOctets) / std::max<size_t>(nReceived, 1)
+              << std::endl;
+  }
+
+private:
+  Data m_data;
+};
+
+BOOST_FIXTURE_TEST_SUITE(LpReliabilityBenchmark, LpReliabilityBenchmarkFixture)
+
+BOOST_AUTO_TEST_CASE(NoLoss)
+{
+  run(0.0);
+}
+
+BOOST_AUTO_TEST_CASE(Loss0_1)
+{
+  run(0.001);
+}
+
+BOOST_AUTO_TEST_CASE(Loss1)
+{
+  run(0.01);
+}
+
+BOOST_AUTO_TEST_CASE(Loss5)
+{
+  run(0.05);
+}
+
+BOOST_AUTO_TEST_CASE(AckRangesNoLoss)
+{
+  run(0.0, true);
+}
+
+BOOST_AUTO_TEST_CASE(AckRangesLoss1)
+{
+  run(0.01, true);
+}
+
+BOOST_AUTO_TEST_CASE(AckRangesLoss5)
+{
+  run(0.05, true);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nfd::tests
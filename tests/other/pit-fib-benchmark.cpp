@@ -24,9 +24,11 @@
  */
 
 #include "benchmark-helpers.hpp"
+#include "face/null-face.hpp"
 #include "table/fib.hpp"
 #include "table/pit.hpp"
 
+#include <algorithm>
 #include <iostream>
 
 #ifdef NFD_HAVE_VALGRIND
@@ -76,6 +78,113 @@ protected:
     }
   }
 
+  /** \brief Model PIT and FIB operations with simple Interest-Data exchanges
+   *  \param withFaceRecords whether to insert an in-record and an out-record into each PIT entry
+   *
+   *  A total of nRoundTrip Interests are received and forwarded, and the same number of Data are returned.
+   */
+  void
+  runSimpleExchanges(bool withFaceRecords = false)
+  {
+    // number of Interest-Data exchanges
+    const size_t nRoundTrip = 1000000;
+    // number of iterations between processing incoming Interest and processing incoming Data
+    const size_t replyGap = 20000;
+    // total amount of FIB entries
+    // packet names are homogeneously extended from these FIB entries
+    const size_t nFibEntries = 2000;
+    // length of fibPrefix, must be >= 1
+    const size_t fibPrefixLength = 1;
+    // length of Interest Name >= fibPrefixLength
+    const size_t interestNameLength= 2;
+    // length of Data Name >= Interest Name
+    const size_t dataNameLength = 3;
+
+    generatePacketsAndPopulateFib(nRoundTrip, nFibEntries, fibPrefixLength,
+                                  interestNameLength, dataNameLength);
+
+#ifdef NFD_HAVE_VALGRIND
+    CALLGRIND_START_INSTRUMENTATION;
+#endif
+
+    auto t1 = time::steady_clock::now();
+
+    for (size_t i = 0; i < nRoundTrip + replyGap; ++i) {
+      if (i < nRoundTrip) {
+        // process incoming Interest
+        auto pitEntry = m_pit.insert(*interests[i]).first;
+        m_fib.findLongestPrefixMatch(*pitEntry);
+        if (withFaceRecords) {
+          pitEntry->insertOrUpdateInRecord(*m_inFace, *interests[i]);
+          pitEntry->insertOrUpdateOutRecord(*m_outFace, *interests[i]);
+        }
+      }
+      if (i >= replyGap) {
+        // process incoming Data
+        auto matches = m_pit.findAllDataMatches(*data[i - replyGap]);
+        // delete matching PIT entries
+        for (const auto& pitEntry : matches) {
+          m_pit.erase(pitEntry.get());
+        }
+      }
+    }
+
+    auto t2 = time::steady_clock::now();
+
+#ifdef NFD_HAVE_VALGRIND
+    CALLGRIND_STOP_INSTRUMENTATION;
+#endif
+
+    std::cout << m_nameTree.getHashtableLayout() << ' ' << m_nameTree.getHashAlgorithm() << ' '
+              << (withFaceRecords ? "with-face-records " : "")
+              << time::duration_cast<time::microseconds>(t2 - t1) << std::endl;
+    printPoolCapacity();
+  }
+
+  /** \brief Print peak number of objects held by memory pools of table entries
+   */
+  static void
+  printPoolCapacity()
+  {
+    std::cout << "  pool capacity:"
+              << " nodes=" << getSlabPool<name_tree::Node>().capacity()
+              << " pit-entries=" << getSlabPool<pit::Entry>().capacity() << std::endl;
+  }
+
+  /** \brief Measure the latency distribution of PIT insertions while the PIT keeps growing
+   *
+   *  The NameTree hashtable is expanded many times during this test case,
+   *  which shows up in the tail latency unless it is resized incrementally.
+   */
+  void
+  runInsertLatency(const std::string& label)
+  {
+    // number of PIT entries inserted
+    const size_t nInsertions = 2000000;
+
+    generatePacketsAndPopulateFib(nInsertions, 1000, 1, 2, 2);
+
+    std::vector<time::nanoseconds> latencies;
+    latencies.reserve(nInsertions);
+
+    for (size_t i = 0; i < nInsertions; ++i) {
+      auto t1 = time::steady_clock::now();
+      m_pit.insert(*interests[i]);
+      auto t2 = time::steady_clock::now();
+      latencies.push_back(time::duration_cast<time::nanoseconds>(t2 - t1));
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies] (double p) {
+      return latencies[static_cast<size_t>(p * (latencies.size() - 1))];
+    };
+    std::cout << label
+              << " p50=" << percentile(0.5)
+              << " p99=" << percentile(0.99)
+              << " p999=" << percentile(0.999)
+              << " max=" << latencies.back() << std::endl;
+  }
+
 private:
   static void
   extendName(Name& name, size_t length)
@@ -94,58 +203,42 @@ protected:
   NameTree m_nameTree;
   Fib m_fib;
   Pit m_pit;
+  shared_ptr<Face> m_inFace = face::makeNullFace();
+  shared_ptr<Face> m_outFace = face::makeNullFace();
 };
 
-// This test case models PIT and FIB operations with simple Interest-Data exchanges.
-// A total of nRoundTrip Interests are received and forwarded, and the same number of Data are returned.
 BOOST_FIXTURE_TEST_CASE(SimpleExchanges, PitFibBenchmarkFixture)
 {
-  // number of Interest-Data exchanges
-  const size_t nRoundTrip = 1000000;
-  // number of iterations between processing incoming Interest and processing incoming Data
-  const size_t replyGap = 20000;
-  // total amount of FIB entries
-  // packet names are homogeneously extended from these FIB entries
-  const size_t nFibEntries = 2000;
-  // length of fibPrefix, must be >= 1
-  const size_t fibPrefixLength = 1;
-  // length of Interest Name >= fibPrefixLength
-  const size_t interestNameLength= 2;
-  // length of Data Name >= Interest Name
-  const size_t dataNameLength = 3;
-
-  generatePacketsAndPopulateFib(nRoundTrip, nFibEntries, fibPrefixLength,
-                                interestNameLength, dataNameLength);
-
-#ifdef NFD_HAVE_VALGRIND
-  CALLGRIND_START_INSTRUMENTATION;
-#endif
+  runSimpleExchanges();
+}
 
-  auto t1 = time::steady_clock::now();
+BOOST_FIXTURE_TEST_CASE(SimpleExchangesOpenAddressing, PitFibBenchmarkFixture)
+{
+  m_nameTree.setHashtableLayout(name_tree::HashtableLayout::OPEN_ADDRESSING);
+  runSimpleExchanges();
+}
 
-  for (size_t i = 0; i < nRoundTrip + replyGap; ++i) {
-    if (i < nRoundTrip) {
-      // process incoming Interest
-      auto pitEntry = m_pit.insert(*interests[i]).first;
-      m_fib.findLongestPrefixMatch(*pitEntry);
-    }
-    if (i >= replyGap) {
-      // process incoming Data
-      auto matches = m_pit.findAllDataMatches(*data[i - replyGap]);
-      // delete matching PIT entries
-      for (const auto& pitEntry : matches) {
-        m_pit.erase(pitEntry.get());
-      }
-    }
-  }
+BOOST_FIXTURE_TEST_CASE(SimpleExchangesWyHash, PitFibBenchmarkFixture)
+{
+  m_nameTree.setHashAlgorithm(name_tree::HashAlgorithm::WYHASH);
+  m_nameTree.setHashtableLayout(name_tree::HashtableLayout::OPEN_ADDRESSING);
+  runSimpleExchanges();
+}
 
-  auto t2 = time::steady_clock::now();
+BOOST_FIXTURE_TEST_CASE(SimpleExchangesWithFaceRecords, PitFibBenchmarkFixture)
+{
+  runSimpleExchanges(true);
+}
 
-#ifdef NFD_HAVE_VALGRIND
-  CALLGRIND_STOP_INSTRUMENTATION;
-#endif
+BOOST_FIXTURE_TEST_CASE(InsertLatency, PitFibBenchmarkFixture)
+{
+  runInsertLatency("stop-the-world-resize");
+}
 
-  std::cout << time::duration_cast<time::microseconds>(t2 - t1) << std::endl;
+BOOST_FIXTURE_TEST_CASE(InsertLatencyIncremental, PitFibBenchmarkFixture)
+{
+  m_nameTree.setHashtableResizePolicy(64, 1.0f);
+  runInsertLatency("incremental-resize");
 }
 
 } // namespace nfd::tests
@@ -0,0 +1,149 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmark-helpers.hpp"
+#include "common/global.hpp"
+#include "face/face.hpp"
+#include "face/generic-link-service.hpp"
+#include "face/tcp-transport.hpp"
+
+#include <boost/asio/write.hpp>
+
+#include <iostream>
+
+namespace nfd::tests {
+
+namespace ip = boost::asio::ip;
+
+/** \brief measures how fast a TCP face receives large Data packets
+ *
+ *  A peer socket writes Data packets with 8000-octet Content as fast as the face reads them.
+ *  The benchmark reports the receive throughput and the number of octets the transport copied.
+ */
+class StreamTransportBenchmarkFixture
+{
+protected:
+  StreamTransportBenchmarkFixture()
+  {
+#ifdef _DEBUG
+    std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
+#endif
+
+    const std::vector<uint8_t> content(8000, 0xBB);
+    for (size_t i = 0; i < WRITE_PACKETS; ++i) {
+      Data data(Name("/bench/stream-transport").appendSequenceNumber(i));
+      data.setContent(content);
+      data.setSignatureInfo(ndn::SignatureInfo(ndn::tlv::DigestSha256));
+      data.setSignatureValue(std::make_shared<ndn::Buffer>(32));
+      const auto& wire = data.wireEncode();
+      m_writeBuffer.insert(m_writeBuffer.end(), wire.begin(), wire.end());
+    }
+  }
+
+  void
+  run(bool wantZeroCopyReceive)
+  {
+    const size_t nPackets = 200000;
+    auto& io = getGlobalIoService();
+
+    ip::tcp::acceptor acceptor(io, ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+    ip::tcp::socket peer(io);
+    peer.connect(acceptor.local_endpoint());
+    ip::tcp::socket sock(io);
+    acceptor.accept(sock);
+
+    auto face = std::make_shared<Face>(make_unique<face::GenericLinkService>(),
+                                       make_unique<face::TcpTransport>(std::move(sock),
+                                                                       ndn::nfd::FACE_PERSISTENCY_ON_DEMAND,
+                                                                       ndn::nfd::FACE_SCOPE_LOCAL,
+                                                                       wantZeroCopyReceive));
+    size_t nReceived = 0;
+    face->afterReceiveData.connect([&] (auto&&...) {
+      if (++nReceived == nPackets) {
+        io.stop();
+      }
+    });
+
+    std::function<void()> write = [&] {
+      boost::asio::async_write(peer, boost::asio::buffer(m_writeBuffer),
+                               [&] (const boost::system::error_code& error, size_t) {
+                                 if (!error && nReceived < nPackets) {
+                                   write();
+                                 }
+                               });
+    };
+    write();
+
+    auto t1 = time::steady_clock::now();
+#if BOOST_VERSION >= 106600
+    io.restart();
+#else
+    io.reset();
+#endif
+    io.run();
+    auto t2 = time::steady_clock::now();
+
+    const auto& counters = static_cast<face::TcpTransport*>(face->getTransport())->getCounters();
+    auto duration = time::duration_cast<time::microseconds>(t2 - t1);
+    auto nInBytes = static_cast<uint64_t>(face->getCounters().nInBytes);
+    auto nCopied = static_cast<uint64_t>(counters.nInCopiedBytes);
+    std::cout << "zero-copy-receive=" << wantZeroCopyReceive
+              << " packets=" << nReceived << ' ' << duration << '\n'
+              << "  " << static_cast<uint64_t>(nInBytes / time::duration<double>(duration).count() / 1e6)
+              << " MB/s, " << nCopied << " of " << nInBytes << " octets copied ("
+              << 100.0 * nCopied / nInBytes << "%)" << std::endl;
+
+    BOOST_CHECK_EQUAL(nReceived, nPackets);
+
+    face->close();
+    peer.close();
+#if BOOST_VERSION >= 106600
+    io.restart();
+#else
+    io.reset();
+#endif
+    io.poll();
+  }
+
+private:
+  static constexpr size_t WRITE_PACKETS = 64;
+  std::vector<uint8_t> m_writeBuffer;
+};
+
+BOOST_FIXTURE_TEST_SUITE(StreamTransportBenchmark, StreamTransportBenchmarkFixture)
+
+BOOST_AUTO_TEST_CASE(CopyReceive)
+{
+  run(false);
+}
+
+BOOST_AUTO_TEST_CASE(ZeroCopyReceive)
+{
+  run(true);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nfd::tests
@@ -0,0 +1,201 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmark-helpers.hpp"
+#include "common/global.hpp"
+#include "face/face.hpp"
+#include "face/udp-channel.hpp"
+
+#include <boost/asio/ip/udp.hpp>
+
+#include <cstdlib>
+#include <iostream>
+
+#include <sys/resource.h>
+
+namespace nfd::tests {
+
+namespace ip = boost::asio::ip;
+
+/** \brief measures how fast a UDP channel accepts many peers and receives from them
+ *
+ *  The number of peers is 10000 by default, and can be changed with the
+ *  NFD_BENCHMARK_UDP_PEERS environment variable. Each peer is a separate socket, and a channel
+ *  without shared sockets opens another socket per peer, so the open files limit is raised
+ *  as far as permitted and the number of peers is reduced if that is insufficient.
+ */
+class UdpChannelBenchmarkFixture
+{
+protected:
+  UdpChannelBenchmarkFixture()
+  {
+#ifdef _DEBUG
+    std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
+#endif
+
+    if (const char* env = std::getenv("NFD_BENCHMARK_UDP_PEERS"); env != nullptr) {
+      m_nPeers = std::strtoul(env, nullptr, 10);
+    }
+
+    rlimit lim{};
+    if (::getrlimit(RLIMIT_NOFILE, &lim) == 0) {
+      lim.rlim_cur = lim.rlim_max;
+      ::setrlimit(RLIMIT_NOFILE, &lim);
+      ::getrlimit(RLIMIT_NOFILE, &lim);
+      // two sockets per peer, plus some spare file descriptors
+      size_t maxPeers = lim.rlim_cur > 256 ? (lim.rlim_cur - 256) / 2 : 0;
+      if (m_nPeers > maxPeers) {
+        std::cerr << "Open files limit allows only " << maxPeers << " peers\n";
+        m_nPeers = maxPeers;
+      }
+    }
+
+    Interest interest("/bench/udp-channel");
+    interest.setNonce(1);
+    m_packet = interest.wireEncode();
+  }
+
+  /** \brief run the benchmark on a channel with \p nSharedSockets shared sockets
+   *
+   *  Each peer sends one packet to create its face, then every peer sends \p nRounds more packets.
+   *  Packets are sent in bursts, each of which is received before the next burst is sent.
+   */
+  void
+  run(size_t nSharedSockets, size_t batchSize)
+  {
+    const size_t nRounds = 20;
+    const size_t burstSize = 64;
+    const udp::Endpoint listenEp(ip::address_v4::loopback(), 7080);
+
+    auto channel = std::make_shared<face::UdpChannel>(listenEp, 600_s, false, ndn::MAX_NDN_PACKET_SIZE,
+                                                      batchSize, nSharedSockets);
+    std::vector<shared_ptr<Face>> faces;
+    faces.reserve(m_nPeers);
+    size_t nReceived = 0;
+    channel->listen([&] (const shared_ptr<Face>& face) {
+                      face->afterReceiveInterest.connect([&] (auto&&...) { ++nReceived; });
+                      faces.push_back(face);
+                    }, nullptr);
+
+    std::vector<ip::udp::socket> peers;
+    peers.reserve(m_nPeers);
+    for (size_t i = 0; i < m_nPeers; ++i) {
+      peers.emplace_back(getGlobalIoService(), ip::udp::v4());
+      peers.back().bind(udp::Endpoint(ip::address_v4::loopback(), 0));
+    }
+
+    // datagrams that overflow a socket receive buffer are lost, so each burst is awaited
+    // for a limited time only
+    size_t nLost = 0;
+    auto sendBurst = [&] (size_t begin, size_t end, const size_t& counter, size_t expected) {
+      for (size_t i = begin; i < end; ++i) {
+        boost::system::error_code error;
+        peers[i].send_to(boost::asio::buffer(m_packet.data(), m_packet.size()), listenEp, 0, error);
+      }
+      auto& io = getGlobalIoService();
+      auto deadline = time::steady_clock::now() + 100_ms;
+      do {
+#if BOOST_VERSION >= 106600
+        io.restart();
+#else
+        io.reset();
+#endif
+        io.poll();
+      } while (counter < expected && time::steady_clock::now() < deadline);
+      nLost += expected - std::min(counter, expected);
+    };
+
+    auto t1 = time::steady_clock::now();
+    for (size_t begin = 0; begin < m_nPeers; begin += burstSize) {
+      size_t end = std::min(begin + burstSize, m_nPeers);
+      sendBurst(begin, end, nReceived, end - nLost);
+    }
+    auto t2 = time::steady_clock::now();
+    size_t nFaces = channel->size();
+
+    size_t nSent = 0;
+    nReceived = 0;
+    nLost = 0;
+    for (size_t round = 0; round < nRounds; ++round) {
+      for (size_t begin = 0; begin < m_nPeers; begin += burstSize) {
+        size_t end = std::min(begin + burstSize, m_nPeers);
+        nSent += end - begin;
+        sendBurst(begin, end, nReceived, nSent - nLost);
+      }
+    }
+    auto t3 = time::steady_clock::now();
+
+    BOOST_CHECK_EQUAL(nFaces, m_nPeers);
+
+    auto setup = time::duration_cast<time::microseconds>(t2 - t1);
+    auto steady = time::duration_cast<time::microseconds>(t3 - t2);
+    std::cout << "shared-sockets=" << nSharedSockets << " batch-size=" << batchSize
+              << " peers=" << m_nPeers << " faces=" << nFaces << '\n'
+              << "  setup " << setup << ' '
+              << static_cast<uint64_t>(nFaces / time::duration<double>(setup).count())
+              << " faces/s\n"
+              << "  steady " << steady << ' '
+              << static_cast<uint64_t>(nReceived / time::duration<double>(steady).count())
+              << " packets/s, " << nLost << " lost" << std::endl;
+
+    for (const auto& face : faces) {
+      face->close();
+    }
+    auto& io = getGlobalIoService();
+    while (channel->size() > 0) {
+#if BOOST_VERSION >= 106600
+      io.restart();
+#else
+      io.reset();
+#endif
+      io.poll();
+    }
+  }
+
+private:
+  size_t m_nPeers = 10000;
+  Block m_packet;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UdpChannelBenchmark, UdpChannelBenchmarkFixture)
+
+BOOST_AUTO_TEST_CASE(ConnectedSockets)
+{
+  run(0, 1);
+}
+
+BOOST_AUTO_TEST_CASE(SharedSockets1)
+{
+  run(1, 32);
+}
+
+BOOST_AUTO_TEST_CASE(SharedSockets4)
+{
+  run(4, 32);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nfd::tests